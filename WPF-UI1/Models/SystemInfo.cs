@@ -147,6 +147,19 @@ namespace WPF_UI1.Models
         public List<SmartAttributeData> Attributes { get; set; } = new();
     }
 
+    // ʷеһC++ ÿη׷һ
+    public class HistorySample
+    {
+        public DateTime Timestamp { get; set; }
+        public double CpuUsage { get; set; }
+        public ulong UsedMemory { get; set; }
+        public ulong AvailableMemory { get; set; }
+        public double CpuTemperature { get; set; }
+        public double GpuTemperature { get; set; }
+        public List<ulong> AdapterSpeeds { get; set; } = new();
+        public List<ulong> DiskUsedSpace { get; set; } = new();
+    }
+
     public class TemperatureData
     {
         public string SensorName { get; set; } = string.Empty;
@@ -1,3 +1,4 @@
+using System.Diagnostics;
 using System.IO;
 using System.IO.MemoryMappedFiles;
 using System.Runtime.InteropServices;
@@ -20,8 +21,98 @@ namespace WPF_UI1.Services
         private const string GLOBAL_SHARED_MEMORY_NAME = "Global\\SystemMonitorSharedMemory";
         private const string LOCAL_SHARED_MEMORY_NAME = "Local\\SystemMonitorSharedMemory";
 
+        // ӳʼΪ 256 ֽڵ SharedMemoryHeaderSharedMemoryBlock 
+        // header  8 ֽΪ seqlock ţʾдд
+        private const int HEADER_SIZE = 256;
+        private const int SEQUENCE_OFFSET = 0;
+        private const int MAX_READ_ATTEMPTS = 100;
+
+        // ֣header ƫ 44 Ϊħ "SMSH"48 Ϊְ汾56 ΪǰӳܴС
+        // ݿλù̶䣻ݿ޵豸бλڶαı䳤
+        private const int LAYOUT_MAGIC_OFFSET = 44;
+        private const int LAYOUT_VERSION_OFFSET = 48;
+        private const uint LAYOUT_MAGIC = 0x48534D53;
+
+        // ղRCU 񣩣header ƫ 8 Ϊ publishedSnapshot = (Ԫ << 8) | ۺ
+        // λڼݿ֮󲢰 64 ֽڶ룻ÿ = 64 ֽڲͷreaders:uint32 @0, epoch:uint64 @8+  SharedMemoryBlock
+        // ˶סۺͣд˱֤дסĲ
+        private const int PUBLISHED_SNAPSHOT_OFFSET = 8;
+        private const int SNAPSHOT_SLOT_COUNT = 4;
+        private const int SNAPSHOT_SLOT_HEADER_SIZE = 64;
+        private const int MAX_PIN_ATTEMPTS = 100;
+        private long _snapshotRegionOffset;
+        private long _snapshotSlotStride;
+        private bool _canPinSnapshots;
+
+        // ʷղ64 ֽڻͷhead:uint64 @0, writing:uint64 @8, capacity:uint32 @16, sampleSize:uint32 @20
+        // ֮Ϊ capacity  152 ֽдд k ǰ writing = k+1д head = k+1
+        private const int HISTORY_HEADER_SIZE = 64;
+        private const int HISTORY_SAMPLE_SIZE = 152;
+        private const int HISTORY_CAPACITY = 3600;
+        private const int HISTORY_ADAPTERS = 4;
+        private const int HISTORY_DISKS = 8;
+        private long _historyOffset;
+
+        // ֪ͨheader ƫ 80 Ϊ publishGenerationÿη 184 Ϊȴ߼
+        // ˵Ǽǵȴߺȴź "<ӳ>_Publish"д˷󰴵ȴͷź
+        private const int PUBLISH_GENERATION_OFFSET = 80;
+        private const int WAITERS_OFFSET = 84;
+        private const string PUBLISH_SEMAPHORE_SUFFIX = "_Publish";
+        private Semaphore? _publishSemaphore;
+
+        // дԼְ汾 3 𣩣header ƫ 88 writerPid, 92 writerState1  / 2 ˳
+        // 96 heartbeatÿη 1104 lastPublishNsд steady_clock 룬 QueryPerformanceCounter112 publishIntervalMs
+        // ʱжʶȣϵͳУʱӰ죻ֻʱʱżд˽Ƿ
+        private const int WRITER_PID_OFFSET = 88;
+        private const int WRITER_STATE_OFFSET = 92;
+        private const int HEARTBEAT_OFFSET = 96;
+        private const int LAST_PUBLISH_NS_OFFSET = 104;
+        private const int PUBLISH_INTERVAL_OFFSET = 112;
+        // ˻ְ汾 8 𣩣header ƫ 16 Ϊһζȡʱ䣨 lastPublishNs ͬһʱ룩
+        // д˾ݴ˲鿴ʱ߲Ƶʣ˲鿴ʱƵ seqlock ͬһУÿ 250ms дһ
+        private const int READER_ACTIVITY_OFFSET = 16;
+        private const uint READER_ACTIVITY_MIN_VERSION = 8;
+        private const ulong READER_ACTIVITY_INTERVAL_NS = 250_000_000UL;
+        private ulong _lastActivityNs;
+        private const uint WRITER_STATE_RUNNING = 1;
+        private const uint WRITER_STATE_STOPPED = 2;
+        private const int STALE_INTERVALS = 3;
+        private uint _layoutVersion;
+
+        // ְ汾 4  SMART ֵֻĿ¼±꣬ݿ֮Сɵд˲ֲټ
+        private const uint MIN_LAYOUT_VERSION = 4;
+
+        // SMART Ŀ¼header ƫ 64 Ϊαƫƣuint6472 ΪαĿ id 10 Ϊ SMART Ŀ¼
+        // ÿĿ 420 ֽڣid:byte, isCritical:byte, reserved:uint16, name[64], description[128], units[16] ַ
+        // дֻڳʼʱдһΣʱȡһ
+        private const int SECTION_TABLE_OFFSET_OFFSET = 64;
+        private const int SECTION_TABLE_COUNT_OFFSET = 72;
+        private const int SECTION_ENTRY_SIZE = 48;
+        private const uint SECTION_SMART_CATALOG = 10;
+        private const int SMART_CATALOG_ENTRY_SIZE = 420;
+        private const ushort SMART_CATALOG_NONE = 0xFFFF;
+        private SmartCatalogItem[] _smartCatalog = Array.Empty<SmartCatalogItem>();
+
+        private sealed class SmartCatalogItem
+        {
+            public byte Id;
+            public bool IsCritical;
+            public string Name = string.Empty;
+            public string Description = string.Empty;
+            public string Units = string.Empty;
+        }
+
+        public enum WriterStatus
+        {
+            Fresh,      // з
+            Stale,      // д˽ڣʱûз翨 WMI У
+            Orphaned,   // д˳
+            Unknown     // ɰд˻δ
+        }
+
         public bool IsInitialized { get; private set; }
         public string LastError { get; private set; } = string.Empty;
+        public bool SupportsNotification => IsInitialized && _publishSemaphore != null;
 
         // C++ṹϸƥ䣨#pragma pack(1)  bool Ϊ1ֽڣ
         // ͳһָ Pack=1, ÿbool MarshalAs(UnmanagedType.I1)
@@ -61,7 +152,7 @@ namespace WPF_UI1.Services
             public int diskCount;
             public int physicalDiskCount;
             public SYSTEMTIME lastUpdate;
-            // CRITICAL_SECTION:  Win64 һ 40 ֽڣpack=1ռλֽ
+            // ԭ CRITICAL_SECTION ռλ40 ֽڣC++ ѸΪֶ
             [MarshalAs(UnmanagedType.ByValArray, SizeConst = 40)]
             public byte[] lockData;
         }
@@ -105,6 +196,7 @@ namespace WPF_UI1.Services
         }
 
         // ------------- SMART ӽṹڱƫһ£-------------
+        // ֵֶֻΣ24 ֽڣ /  / λ catalogIndex  SMART Ŀ¼
         [StructLayout(LayoutKind.Sequential, Pack = 1)]
         public struct SmartAttributeDataStruct
         {
@@ -113,12 +205,10 @@ namespace WPF_UI1.Services
             public byte current;
             public byte worst;
             public byte threshold;
-            public ulong rawValue;
-            [MarshalAs(UnmanagedType.ByValArray, SizeConst = 64)] public ushort[] name;
-            [MarshalAs(UnmanagedType.ByValArray, SizeConst = 128)] public ushort[] description;
             [MarshalAs(UnmanagedType.I1)] public bool isCritical;
+            public ushort catalogIndex;
+            public ulong rawValue;
             public double physicalValue;
-            [MarshalAs(UnmanagedType.ByValArray, SizeConst = 16)] public ushort[] units;
         }
 
         [StructLayout(LayoutKind.Sequential, Pack = 1)]
@@ -181,11 +271,55 @@ namespace WPF_UI1.Services
                         try
                         {
                             Log.Debug($"Դ򿪹ڴ: {name}");
-                            _mmf = MemoryMappedFile.OpenExisting(name, MemoryMappedFileRights.Read);
-                            // ͼʹʵṹС
-                            _accessor = _mmf.CreateViewAccessor(0, structSize, MemoryMappedFileAccess.Read);
+                            _snapshotRegionOffset = AlignTo64(HEADER_SIZE + structSize);
+                            _snapshotSlotStride = AlignTo64(SNAPSHOT_SLOT_HEADER_SIZE + structSize);
+                            _historyOffset = _snapshotRegionOffset + SNAPSHOT_SLOT_COUNT * _snapshotSlotStride;
+                            long fullSize = _historyOffset + HISTORY_HEADER_SIZE + (long)HISTORY_CAPACITY * HISTORY_SAMPLE_SIZE;
+                            try
+                            {
+                                // סҪд۵Ķ߼Զдʽ
+                                _mmf = MemoryMappedFile.OpenExisting(name, MemoryMappedFileRights.ReadWrite);
+                                _accessor = _mmf.CreateViewAccessor(0, fullSize, MemoryMappedFileAccess.ReadWrite);
+                                _canPinSnapshots = true;
+                            }
+                            catch (Exception ex) when (ex is UnauthorizedAccessException || ex is IOException || ex is ArgumentOutOfRangeException)
+                            {
+                                // ɰдˣ޿дȨޣ˻ֻ + seqlock
+                                _accessor?.Dispose();
+                                _mmf?.Dispose();
+                                _mmf = MemoryMappedFile.OpenExisting(name, MemoryMappedFileRights.Read);
+                                _accessor = _mmf.CreateViewAccessor(0, HEADER_SIZE + structSize, MemoryMappedFileAccess.Read);
+                                _canPinSnapshots = false;
+                                Log.Debug($"ղ۲ãʹ seqlock ȡ: {ex.Message}");
+                            }
+                            uint magic = _accessor.ReadUInt32(LAYOUT_MAGIC_OFFSET);
+                            uint layoutVersion = _accessor.ReadUInt32(LAYOUT_VERSION_OFFSET);
+                            _layoutVersion = magic == LAYOUT_MAGIC ? layoutVersion : 0;
+                            if (magic == LAYOUT_MAGIC && layoutVersion < MIN_LAYOUT_VERSION)
+                            {
+                                // ݿṹѱ仯½ṹд˵ݻõҵֵ
+                                Log.Warning($"ڴ沼ְ汾: {name}, 汾={layoutVersion}Ҫ >= {MIN_LAYOUT_VERSION} C++ ");
+                                _accessor.Dispose();
+                                _accessor = null;
+                                _mmf.Dispose();
+                                _mmf = null;
+                                continue;
+                            }
+                            if (magic != LAYOUT_MAGIC)
+                            {
+                                // ɰдˣֻмݿ
+                                _canPinSnapshots = false;
+                                Log.Warning($"ڴ沼ħƥ (0x{magic:X8})ʹüݿ");
+                            }
+                            else
+                            {
+                                LoadSmartCatalog();
+                            }
+                            // ȴ߼ҪдȨޣ򲻿֪ͨʱɵ÷ʱѯ
+                            if (_canPinSnapshots)
+                                OpenPublishSemaphore(names);
                             IsInitialized = true;
-                            Log.Information($"? ɹӵڴ: {name}, Size={structSize} bytes");
+                            Log.Information($"? ɹӵڴ: {name}, Size={structSize} bytes, ְ汾={layoutVersion}, ղ={_canPinSnapshots}, ֪ͨ={_publishSemaphore != null}");
                             return true;
                         }
                         catch (FileNotFoundException)
@@ -225,7 +359,9 @@ namespace WPF_UI1.Services
 
                 try
                 {
-                    return ReadCompleteSystemInfo();
+                    var info = ReadCompleteSystemInfo();
+                    if (info != null) MarkReaderActivity();
+                    return info;
                 }
                 catch (Exception ex)
                 {
@@ -238,15 +374,43 @@ namespace WPF_UI1.Services
             }
         }
 
-        private SystemInfo ReadCompleteSystemInfo()
+        private SystemInfo? ReadCompleteSystemInfo()
         {
             if (_accessor == null)
                 throw new InvalidOperationException("ڴδʼ");
 
+            if (_canPinSnapshots)
+            {
+                var pinned = ReadPinnedSnapshot();
+                if (pinned != null)
+                    return pinned;
+            }
+
             int structSize = Marshal.SizeOf<SharedMemoryBlock>();
             var raw = new byte[structSize];
-            int bytesToRead = (int)Math.Min((long)structSize, _accessor.Capacity);
-            _accessor.ReadArray(0, raw, 0, bytesToRead);
+            int bytesToRead = (int)Math.Min((long)structSize, _accessor.Capacity - HEADER_SIZE);
+
+            // seqlock ȡǰһΪżգ
+            bool consistent = false;
+            var spinner = new SpinWait();
+            for (int attempt = 0; attempt < MAX_READ_ATTEMPTS && !consistent; attempt++)
+            {
+                ulong begin = _accessor.ReadUInt64(SEQUENCE_OFFSET);
+                if ((begin & 1) == 0)
+                {
+                    _accessor.ReadArray(HEADER_SIZE, raw, 0, bytesToRead);
+                    Thread.MemoryBarrier();
+                    consistent = _accessor.ReadUInt64(SEQUENCE_OFFSET) == begin;
+                }
+                if (!consistent) spinner.SpinOnce();
+            }
+            if (!consistent)
+            {
+                // д˿ܿд;ַϿӳ
+                LastError = "ڴд˳дУδܶȡһ¿";
+                Log.Warning(LastError);
+                return null;
+            }
 
             var handle = GCHandle.Alloc(raw, GCHandleType.Pinned);
             try
@@ -260,6 +424,359 @@ namespace WPF_UI1.Services
             }
         }
 
+        // סǰĿղۺֱӴӳͼͣҲ˺ݣдҲᱻ
+        // δջʧʱ nullɵ÷˻ seqlock ȡ
+        private unsafe SystemInfo? ReadPinnedSnapshot()
+        {
+            if (_accessor == null)
+                return null;
+
+            byte* basePtr = null;
+            var viewHandle = _accessor.SafeMemoryMappedViewHandle;
+            viewHandle.AcquirePointer(ref basePtr);
+            try
+            {
+                basePtr += _accessor.PointerOffset;
+                ulong* published = (ulong*)(basePtr + PUBLISHED_SNAPSHOT_OFFSET);
+                for (int attempt = 0; attempt < MAX_PIN_ATTEMPTS; attempt++)
+                {
+                    ulong word = Volatile.Read(ref *published);
+                    if ((word >> 8) == 0)
+                        return null; // дδ
+                    int slot = (int)(word & 0xFF);
+                    if (slot >= SNAPSHOT_SLOT_COUNT)
+                        return null;
+
+                    byte* slotPtr = basePtr + _snapshotRegionOffset + slot * _snapshotSlotStride;
+                    int* readers = (int*)slotPtr;
+                    Interlocked.Increment(ref *readers);
+                    try
+                    {
+                        // ס󸴺ˣڼдѷ²ۣ򱾲ۿڱд
+                        if (Interlocked.Read(ref *(long*)published) != (long)word)
+                            continue;
+                        var data = Marshal.PtrToStructure<SharedMemoryBlock>((IntPtr)(slotPtr + SNAPSHOT_SLOT_HEADER_SIZE));
+                        return ConvertToSystemInfo(data);
+                    }
+                    finally
+                    {
+                        UnpinSlot(readers);
+                    }
+                }
+                return null;
+            }
+            finally
+            {
+                viewHandle.ReleasePointer();
+            }
+        }
+
+        private void LoadSmartCatalog()
+        {
+            _smartCatalog = Array.Empty<SmartCatalogItem>();
+            if (_mmf == null || _accessor == null)
+                return;
+            try
+            {
+                long tableOffset = (long)_accessor.ReadUInt64(SECTION_TABLE_OFFSET_OFFSET);
+                uint tableCount = _accessor.ReadUInt32(SECTION_TABLE_COUNT_OFFSET);
+                if (tableOffset <= 0 || tableCount == 0 || tableCount > 16)
+                    return;
+
+                using var table = _mmf.CreateViewAccessor(tableOffset, tableCount * SECTION_ENTRY_SIZE, MemoryMappedFileAccess.Read);
+                for (int i = 0; i < tableCount; i++)
+                {
+                    long e = (long)i * SECTION_ENTRY_SIZE;
+                    if (table.ReadUInt32(e) != SECTION_SMART_CATALOG)
+                        continue;
+                    if (table.ReadUInt32(e + 4) != SMART_CATALOG_ENTRY_SIZE)
+                    {
+                        Log.Warning("SMART Ŀ¼ĿСƥ䣬ƽ");
+                        return;
+                    }
+                    long offset = (long)table.ReadUInt64(e + 8);
+                    int count = (int)Math.Min(table.ReadUInt32(e + 20), table.ReadUInt32(e + 16));
+                    if (count <= 0)
+                        return;
+
+                    var items = new SmartCatalogItem[count];
+                    using var view = _mmf.CreateViewAccessor(offset, (long)count * SMART_CATALOG_ENTRY_SIZE, MemoryMappedFileAccess.Read);
+                    for (int k = 0; k < count; k++)
+                    {
+                        long p = (long)k * SMART_CATALOG_ENTRY_SIZE;
+                        var item = new SmartCatalogItem { Id = view.ReadByte(p), IsCritical = view.ReadByte(p + 1) != 0 };
+                        item.Name = ReadWideString(view, p + 4, 64);
+                        item.Description = ReadWideString(view, p + 4 + 128, 128);
+                        item.Units = ReadWideString(view, p + 4 + 384, 16);
+                        items[k] = item;
+                    }
+                    _smartCatalog = items;
+                    Log.Debug($"Ѽ SMART Ŀ¼: {count} ");
+                    return;
+                }
+            }
+            catch (Exception ex)
+            {
+                Log.Warning($"ȡ SMART Ŀ¼ʧܣƽ: {ex.Message}");
+            }
+        }
+
+        private string ReadWideString(MemoryMappedViewAccessor view, long offset, int length)
+        {
+            var buffer = new ushort[length];
+            view.ReadArray(offset, buffer, 0, length);
+            return SafeWideCharArrayToString(buffer) ?? string.Empty;
+        }
+
+        private void OpenPublishSemaphore(string[] names)
+        {
+            _publishSemaphore?.Dispose();
+            _publishSemaphore = null;
+            foreach (string name in names)
+            {
+                try
+                {
+                    _publishSemaphore = Semaphore.OpenExisting(name + PUBLISH_SEMAPHORE_SUFFIX);
+                    return;
+                }
+                catch (Exception ex) when (ex is WaitHandleCannotBeOpenedException || ex is UnauthorizedAccessException || ex is IOException)
+                {
+                    Log.Debug($"֪ͨź: {name}{PUBLISH_SEMAPHORE_SUFFIX}: {ex.Message}");
+                }
+            }
+        }
+
+        // ǰ֧֪ͨʱ 0
+        public uint ReadPublishGeneration()
+        {
+            lock (_lock)
+            {
+                if (!IsInitialized || _accessor == null || !_canPinSnapshots)
+                    return 0;
+                try
+                {
+                    return _accessor.ReadUInt32(PUBLISH_GENERATION_OFFSET);
+                }
+                catch (Exception ex)
+                {
+                    Log.Debug($"ȡʧ: {ex.Message}");
+                    return 0;
+                }
+            }
+        }
+
+        // ͷдԼжʶȣageMs Ϊһηĺδ֪ʱΪ -1
+        public WriterStatus ReadWriterStatus(out double ageMs)
+        {
+            ageMs = -1;
+            uint pid, state, intervalMs;
+            ulong heartbeat, lastPublishNs;
+            lock (_lock)
+            {
+                if (!IsInitialized || _accessor == null || _layoutVersion < 3)
+                    return WriterStatus.Unknown;
+                try
+                {
+                    pid = _accessor.ReadUInt32(WRITER_PID_OFFSET);
+                    state = _accessor.ReadUInt32(WRITER_STATE_OFFSET);
+                    heartbeat = _accessor.ReadUInt64(HEARTBEAT_OFFSET);
+                    lastPublishNs = _accessor.ReadUInt64(LAST_PUBLISH_NS_OFFSET);
+                    intervalMs = _accessor.ReadUInt32(PUBLISH_INTERVAL_OFFSET);
+                }
+                catch (Exception ex)
+                {
+                    Log.Debug($"ȡдԼʧ: {ex.Message}");
+                    return WriterStatus.Unknown;
+                }
+            }
+            if (pid == 0 || (state != WRITER_STATE_RUNNING && state != WRITER_STATE_STOPPED))
+                return WriterStatus.Unknown;
+
+            ulong nowNs = MonotonicNowNs();
+            ulong ageNs = nowNs > lastPublishNs ? nowNs - lastPublishNs : 0;
+            if (heartbeat != 0)
+                ageMs = ageNs / 1e6;
+            if (state == WRITER_STATE_STOPPED)
+                return WriterStatus.Orphaned;
+            if (heartbeat == 0)
+                return IsProcessAlive(pid) ? WriterStatus.Unknown : WriterStatus.Orphaned;
+            ulong staleNs = (ulong)(intervalMs != 0 ? intervalMs : 1000) * STALE_INTERVALS * 1_000_000UL;
+            if (ageNs <= staleNs)
+                return WriterStatus.Fresh;
+            return IsProcessAlive(pid) ? WriterStatus.Stale : WriterStatus.Orphaned;
+        }
+
+        // ϱ˻ֻӳ䣨дȨޣʱ޷ϱд˰˲鿴
+        private void MarkReaderActivity()
+        {
+            if (!_canPinSnapshots || _accessor == null || _layoutVersion < READER_ACTIVITY_MIN_VERSION)
+                return;
+            ulong nowNs = MonotonicNowNs();
+            if (nowNs - _lastActivityNs < READER_ACTIVITY_INTERVAL_NS)
+                return;
+            _lastActivityNs = nowNs;
+            _accessor.Write(READER_ACTIVITY_OFFSET, nowNs);
+        }
+
+        //  MSVC steady_clock ͬĻ㣺QueryPerformanceCounter ת
+        private static ulong MonotonicNowNs()
+        {
+            ulong ticks = (ulong)Stopwatch.GetTimestamp();
+            ulong freq = (ulong)Stopwatch.Frequency;
+            return ticks / freq * 1_000_000_000UL + ticks % freq * 1_000_000_000UL / freq;
+        }
+
+        private static bool IsProcessAlive(uint pid)
+        {
+            try
+            {
+                using var process = Process.GetProcessById((int)pid);
+                return !process.HasExited;
+            }
+            catch (ArgumentException)
+            {
+                return false; //  PID 
+            }
+            catch (Exception)
+            {
+                return true; // дͨԹԱȨУȨѯʱΪ
+            }
+        }
+
+        // ȴͬ lastSeenݷ trueʱ֧֪ͨ false
+        // ȴڼ䲻 _lockӰ̶߳ȡͼָ SafeHandle ü
+        public unsafe bool WaitForPublish(uint lastSeen, int timeoutMs, out uint generation)
+        {
+            generation = lastSeen;
+            MemoryMappedViewAccessor? accessor;
+            Semaphore? semaphore;
+            lock (_lock)
+            {
+                accessor = _accessor;
+                semaphore = _publishSemaphore;
+            }
+            if (accessor == null || semaphore == null)
+                return false;
+
+            var viewHandle = accessor.SafeMemoryMappedViewHandle;
+            byte* basePtr = null;
+            bool acquired = false;
+            try
+            {
+                viewHandle.AcquirePointer(ref basePtr);
+                acquired = true;
+                basePtr += accessor.PointerOffset;
+                uint* published = (uint*)(basePtr + PUBLISH_GENERATION_OFFSET);
+                int* waiters = (int*)(basePtr + WAITERS_OFFSET);
+                long deadline = Environment.TickCount64 + timeoutMs;
+                while (true)
+                {
+                    generation = Volatile.Read(ref *published);
+                    if (generation != lastSeen)
+                        return true;
+                    long remaining = deadline - Environment.TickCount64;
+                    if (remaining <= 0)
+                        return false;
+
+                    // ȵǼΪȴٸ飺дҪôȴ߲ͷźҪô˸ʱѿ´
+                    Interlocked.Increment(ref *waiters);
+                    try
+                    {
+                        if (Volatile.Read(ref *published) == lastSeen)
+                            semaphore.WaitOne((int)remaining);
+                    }
+                    finally
+                    {
+                        Interlocked.Decrement(ref *waiters);
+                    }
+                }
+            }
+            catch (ObjectDisposedException)
+            {
+                return false; // ȴڼӱر
+            }
+            finally
+            {
+                if (acquired)
+                    viewHandle.ReleasePointer();
+            }
+        }
+
+        // һȡ maxSamples ʷǰӵĽͼʱؿб
+        public List<HistorySample> ReadHistory(int maxSamples)
+        {
+            var result = new List<HistorySample>();
+            lock (_lock)
+            {
+                if (!IsInitialized || _accessor == null || !_canPinSnapshots || maxSamples <= 0)
+                    return result;
+
+                try
+                {
+                    if (_accessor.ReadUInt32(_historyOffset + 16) != HISTORY_CAPACITY ||
+                        _accessor.ReadUInt32(_historyOffset + 20) != HISTORY_SAMPLE_SIZE)
+                        return result;
+
+                    ulong head = _accessor.ReadUInt64(_historyOffset);
+                    ulong count = Math.Min(Math.Min(head, (ulong)(HISTORY_CAPACITY - 1)), (ulong)maxSamples);
+                    ulong first = head - count;
+                    var raw = new byte[HISTORY_SAMPLE_SIZE];
+                    var samples = new List<HistorySample>((int)count);
+                    for (ulong i = 0; i < count; i++)
+                    {
+                        long pos = _historyOffset + HISTORY_HEADER_SIZE + (long)((first + i) % HISTORY_CAPACITY) * HISTORY_SAMPLE_SIZE;
+                        _accessor.ReadArray(pos, raw, 0, raw.Length);
+                        samples.Add(ParseHistorySample(raw));
+                    }
+
+                    // ڼд˿ƻظɵļ֮
+                    Thread.MemoryBarrier();
+                    ulong writing = _accessor.ReadUInt64(_historyOffset + 8);
+                    ulong oldestValid = writing > HISTORY_CAPACITY ? writing - HISTORY_CAPACITY : 0;
+                    int dropped = first >= oldestValid ? 0 : (int)Math.Min(oldestValid - first, count);
+                    result.AddRange(samples.Skip(dropped));
+                }
+                catch (Exception ex)
+                {
+                    Log.Warning($"ȡʷʧ: {ex.Message}");
+                }
+            }
+            return result;
+        }
+
+        private static HistorySample ParseHistorySample(byte[] raw)
+        {
+            var sample = new HistorySample
+            {
+                Timestamp = DateTimeOffset.FromUnixTimeMilliseconds((long)BitConverter.ToUInt64(raw, 0)).LocalDateTime,
+                CpuUsage = BitConverter.ToDouble(raw, 8),
+                UsedMemory = BitConverter.ToUInt64(raw, 16),
+                AvailableMemory = BitConverter.ToUInt64(raw, 24),
+                CpuTemperature = BitConverter.ToDouble(raw, 32),
+                GpuTemperature = BitConverter.ToDouble(raw, 40)
+            };
+            int adapterCount = (int)Math.Min(BitConverter.ToUInt32(raw, 48), (uint)HISTORY_ADAPTERS);
+            int diskCount = (int)Math.Min(BitConverter.ToUInt32(raw, 52), (uint)HISTORY_DISKS);
+            for (int i = 0; i < adapterCount; i++)
+                sample.AdapterSpeeds.Add(BitConverter.ToUInt64(raw, 56 + i * 8));
+            for (int i = 0; i < diskCount; i++)
+                sample.DiskUsedSpace.Add(BitConverter.ToUInt64(raw, 56 + HISTORY_ADAPTERS * 8 + i * 8));
+            return sample;
+        }
+
+        //  0 £д˿ѻĶס
+        private static unsafe void UnpinSlot(int* readers)
+        {
+            while (true)
+            {
+                int current = Volatile.Read(ref *readers);
+                if (current <= 0 || Interlocked.CompareExchange(ref *readers, current - 1, current) == current)
+                    return;
+            }
+        }
+
+        private static long AlignTo64(long value) => (value + 63) & ~63L;
+
         // 򻯶ȡṹƥͨٴ
         private SystemInfo ReadSimplifiedSystemInfo()
         {
@@ -420,6 +937,9 @@ namespace WPF_UI1.Services
                             for (int a = 0; a < attrCount; a++)
                             {
                                 var sa = pd.attributes[a];
+                                // Ŀ¼δ¼ԣԶ IDûıֻʾ ID
+                                var info = sa.catalogIndex != SMART_CATALOG_NONE && sa.catalogIndex < _smartCatalog.Length
+                                    ? _smartCatalog[sa.catalogIndex] : null;
                                 var attr = new SmartAttributeData
                                 {
                                     Id = sa.id,
@@ -427,11 +947,11 @@ namespace WPF_UI1.Services
                                     Worst = sa.worst,
                                     Threshold = sa.threshold,
                                     RawValue = sa.rawValue,
-                                    Name = SafeWideCharArrayToString(sa.name) ?? $"Attr {sa.id}",
-                                    Description = SafeWideCharArrayToString(sa.description) ?? string.Empty,
+                                    Name = info?.Name ?? $"δ֪ (0x{sa.id:X2})",
+                                    Description = info?.Description ?? string.Empty,
                                     IsCritical = sa.isCritical,
                                     PhysicalValue = sa.physicalValue,
-                                    Units = SafeWideCharArrayToString(sa.units) ?? string.Empty
+                                    Units = info?.Units ?? string.Empty
                                 };
                                 physicalDisk.Attributes.Add(attr);
                             }
@@ -509,8 +1029,10 @@ namespace WPF_UI1.Services
             {
                 _accessor?.Dispose();
                 _mmf?.Dispose();
+                _publishSemaphore?.Dispose();
                 _accessor = null;
                 _mmf = null;
+                _publishSemaphore = null;
                 IsInitialized = false;
                 _disposed = true;
             }
@@ -22,6 +22,13 @@ namespace WPF_UI1.ViewModels
         private const int MAX_CHART_POINTS = 60;
         private int _consecutiveErrors = 0;
         private const int MAX_CONSECUTIVE_ERRORS = 5;
+        // ֪ͨдÿηѵȴѭʱֻڴ仯ʱȡ߼⣩
+        private const int PUBLISH_WAIT_TIMEOUT_MS = 1000;
+        private uint _lastGeneration;
+        private bool _isUpdating;
+        private Task? _publishWaitLoop;
+        // дԼ״̬ÿζʱʱ飨ֻͷֶΣд˿ס˳ʱ״̬ʾ
+        private SharedMemoryService.WriterStatus _writerStatus = SharedMemoryService.WriterStatus.Unknown;
 
         [ObservableProperty]
         private bool isConnected;
@@ -163,18 +170,34 @@ namespace WPF_UI1.ViewModels
 
         private async void UpdateTimer_Tick(object? sender, EventArgs e)
         {
+            if (IsConnected)
+                UpdateWriterStatus();
+            // з֪ͨʱδ仯˵дδݣЧȡ
+            if (IsConnected && _sharedMemoryService.SupportsNotification &&
+                _sharedMemoryService.ReadPublishGeneration() == _lastGeneration)
+                return;
             await UpdateSystemInfoAsync();
         }
 
         private async Task UpdateSystemInfoAsync()
         {
+            if (_isUpdating)
+                return;
+            _isUpdating = true;
             try
             {
-                var systemInfo = await Task.Run(() => _sharedMemoryService.ReadSystemInfo());
+                uint generation = 0;
+                var systemInfo = await Task.Run(() =>
+                {
+                    // ȡٶȡݲȸô
+                    generation = _sharedMemoryService.ReadPublishGeneration();
+                    return _sharedMemoryService.ReadSystemInfo();
+                });
                 
                 if (systemInfo != null)
                 {
                     _consecutiveErrors = 0; // ô
+                    _lastGeneration = generation;
 
                     if (!IsConnected)
                     {
@@ -219,6 +242,75 @@ namespace WPF_UI1.ViewModels
                     ShowErrorState(ex.Message);
                 }
             }
+            finally
+            {
+                _isUpdating = false;
+            }
+        }
+
+        private void UpdateWriterStatus()
+        {
+            var status = _sharedMemoryService.ReadWriterStatus(out double ageMs);
+            // Stale ʱÿˢѹڵ״ֻ̬ڱ仯ʱ
+            if (status == _writerStatus && status != SharedMemoryService.WriterStatus.Stale)
+                return;
+            if (status != _writerStatus)
+                Log.Information($"д״̬: {_writerStatus} -> {status}");
+            _writerStatus = status;
+            switch (status)
+            {
+                case SharedMemoryService.WriterStatus.Stale:
+                    ConnectionStatus = $"дӦ -  {ageMs / 1000:F0} δ";
+                    WindowTitle = "ϵͳӲ - ѹ";
+                    break;
+                case SharedMemoryService.WriterStatus.Orphaned:
+                    ConnectionStatus = "д˳ - ȴ";
+                    WindowTitle = "ϵͳӲ - д˳";
+                    break;
+                default:
+                    ConnectionStatus = "";
+                    WindowTitle = "ϵͳӲ";
+                    break;
+            }
+        }
+
+        // ̨ȴд˵ķ֪ͨʱ UI ߳ˢ£Ӳ֧֪ͨʱ˻ضʱѯ
+        private void StartPublishWaitLoop()
+        {
+            if (_publishWaitLoop != null || !_sharedMemoryService.SupportsNotification)
+                return;
+
+            var dispatcher = System.Windows.Application.Current?.Dispatcher;
+            if (dispatcher == null)
+                return;
+
+            Log.Information("ùڴ淢֪ͨ");
+            _publishWaitLoop = Task.Run(async () =>
+            {
+                while (true)
+                {
+                    try
+                    {
+                        if (!_sharedMemoryService.SupportsNotification)
+                        {
+                            await Task.Delay(PUBLISH_WAIT_TIMEOUT_MS);
+                            continue;
+                        }
+                        uint seen = _lastGeneration;
+                        if (!_sharedMemoryService.WaitForPublish(seen, PUBLISH_WAIT_TIMEOUT_MS, out _))
+                            continue;
+                        await dispatcher.InvokeAsync(UpdateSystemInfoAsync).Task.Unwrap();
+                        // ȡʧܣ붨ʱˢײʱδƽԺת
+                        if (_lastGeneration == seen)
+                            await Task.Delay(100);
+                    }
+                    catch (Exception ex)
+                    {
+                        Log.Warning($"ȴ֪ͨʧ: {ex.Message}");
+                        await Task.Delay(PUBLISH_WAIT_TIMEOUT_MS);
+                    }
+                }
+            });
         }
 
         private void TryConnect()
@@ -231,7 +323,10 @@ namespace WPF_UI1.ViewModels
                 ConnectionStatus = "";
                 WindowTitle = "ϵͳӲ";
                 _consecutiveErrors = 0;
+                _writerStatus = SharedMemoryService.WriterStatus.Unknown;
                 Log.Information("ڴӳɹ");
+                PrefillTemperatureCharts();
+                StartPublishWaitLoop();
             }
             else
             {
@@ -494,6 +589,27 @@ namespace WPF_UI1.ViewModels
             }
         }
 
+        // Ӻùڴеʷ¶ͼȴԼܹݵ
+        private void PrefillTemperatureCharts()
+        {
+            try
+            {
+                var history = _sharedMemoryService.ReadHistory(MAX_CHART_POINTS);
+                if (history.Count == 0)
+                    return;
+
+                _cpuTempData.Clear();
+                _gpuTempData.Clear();
+                foreach (var sample in history)
+                    UpdateTemperatureCharts(sample.CpuTemperature, sample.GpuTemperature);
+                Log.Debug($"Ѵʷ {history.Count} ¶ݵ");
+            }
+            catch (Exception ex)
+            {
+                Log.Warning($"¶ͼʧ: {ex.Message}");
+            }
+        }
+
         private void UpdateTemperatureCharts(double cpuTemp, double gpuTemp)
         {
             try
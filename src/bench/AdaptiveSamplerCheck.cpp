@@ -0,0 +1,101 @@
+// AdaptiveSamplerCheck.cpp
+// 自适应采样策略的模式切换检查：用合成的时间点与指标序列驱动 AdaptiveSampler::Update，
+// 逐步核对加速 / 常规 / 降频与减载的转换（指标快速变化或有读端时加速、无读端且平稳时降频、
+// 过载时不加速且滞回后恢复）。任一步与预期不符时以非零状态退出
+//
+// 构建:
+//   g++ -std=c++17 -O2 -pthread -Isrc/core -o sampler_check src/bench/AdaptiveSamplerCheck.cpp
+//       src/core/collector/AdaptiveSampler.cpp src/core/Utils/Logger.cpp
+// 运行:
+//   ./sampler_check
+
+#include "DataStruct/DataStruct.h"
+#include "Utils/Logger.h"
+#include "collector/AdaptiveSampler.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+using Mode = AdaptiveSampler::Mode;
+using Clock = AdaptiveSampler::Clock;
+
+class Checker {
+public:
+    Checker() : start(Clock::now()) {
+        info.totalMemory = 16ull << 30;
+        info.usedMemory = 4ull << 30;
+        info.cpuUsage = 10.0;
+        info.cpuTemperature = 50.0;
+        info.gpuTemperature = 40.0;
+    }
+
+    // 在启动后第 seconds 秒观测一次，核对模式与减载状态
+    void Step(const char* what, double seconds, bool reader, double hostCpu, Mode expected, bool expectedShed = false) {
+        const auto now = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        const AdaptiveSampler::Decision d = sampler.Update(info, hostCpu, reader, now);
+        const bool ok = d.mode == expected && d.shed == expectedShed;
+        std::printf("%-6s t=%5.1fs reader=%d hostCpu=%3.0f%% -> %s%s  %s\n", ok ? "ok" : "FAIL", seconds, reader ? 1 : 0,
+                    hostCpu, AdaptiveSampler::ModeName(d.mode), d.shed ? "+减载" : "", what);
+        if (!ok) {
+            std::printf("       预期 %s%s\n", AdaptiveSampler::ModeName(expected), expectedShed ? "+减载" : "");
+            ++failures;
+        }
+    }
+
+    SystemInfo info{};
+    int failures = 0;
+
+private:
+    const Clock::time_point start;
+    AdaptiveSampler sampler;    // 缺省配置：fastHold 10s，idleAfter 30s，上限 90%，shedAfter 3s，restoreAfter 10s
+};
+
+} // namespace
+
+int main() {
+    Logger::EnableConsoleOutput(false);
+    Logger::Initialize("sampler_check.log");
+    Logger::SetLogLevel(LOG_ERROR);
+
+    Checker c;
+    // 无读端、指标平稳：启动时按常规，从启动算起平稳 idleAfter 后降频
+    c.Step("启动", 0.0, false, 10.0, Mode::Normal);
+    c.Step("平稳", 20.0, false, 10.0, Mode::Normal);
+    c.Step("平稳超过 idleAfter", 31.0, false, 10.0, Mode::Idle);
+
+    // 无读端时指标快速变化也加速，保持 fastHold 后回到常规，再平稳 idleAfter 后降频
+    c.info.cpuUsage = 60.0;
+    c.Step("CPU 跳变（无读端）", 32.0, false, 60.0, Mode::Fast);
+    c.Step("仍在 fastHold 内", 41.0, false, 60.0, Mode::Fast);
+    c.Step("超过 fastHold", 43.0, false, 60.0, Mode::Normal);
+    c.Step("变化后平稳 idleAfter", 63.0, false, 60.0, Mode::Idle);
+
+    // 有读端时即使指标平稳也加速，读端离开后按平稳时长降频
+    c.Step("读端接入（平稳）", 64.0, true, 60.0, Mode::Fast);
+    c.Step("读端持续", 120.0, true, 60.0, Mode::Fast);
+    c.Step("读端离开", 121.0, false, 60.0, Mode::Idle);
+
+    // 内存与温度变化同样触发加速
+    c.info.usedMemory = 8ull << 30;
+    c.Step("内存占用跳变", 122.0, false, 60.0, Mode::Fast);
+    c.Step("超过 fastHold", 133.0, false, 60.0, Mode::Normal);
+    c.info.gpuTemperature = 70.0;
+    c.Step("GPU 温度跳变", 134.0, false, 60.0, Mode::Fast);
+
+    // 主机过载：持续 shedAfter 后减载且不加速；回落到 上限 - 滞回 以下持续 restoreAfter 后恢复
+    c.info.cpuUsage = 95.0;
+    c.Step("过载开始", 140.0, true, 95.0, Mode::Fast);
+    c.Step("过载未满 shedAfter", 142.0, true, 95.0, Mode::Fast);
+    c.Step("过载满 shedAfter", 143.5, true, 95.0, Mode::Normal, true);
+    c.info.cpuUsage = 85.0;
+    c.Step("回落但在滞回区间内", 150.0, true, 85.0, Mode::Normal, true);
+    c.info.cpuUsage = 50.0;
+    c.Step("低于恢复阈值", 151.0, true, 50.0, Mode::Normal, true);
+    c.Step("未满 restoreAfter", 160.0, true, 50.0, Mode::Normal, true);
+    c.Step("满 restoreAfter", 161.5, true, 50.0, Mode::Fast);
+
+    std::printf("RESULT sampler_check failures=%d\n", c.failures);
+    return c.failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+// AsyncCollectBench.cpp
+// 在单个线程上用 AsyncExecutor 复用全部 Linux 采集协程（/proc 负载与内存、cpufreq、hwmon 温度），
+// 另加 N 个等待管道可读的模拟 I/O 数据源，统计各数据源的执行次数与耗时、定时器唤醒延迟
+// 以及 I/O 就绪到协程恢复的延迟，验证多个数据源不需要各占一个线程
+//
+// 构建:
+//   g++ -std=c++20 -O2 -pthread -Isrc/core -o async_bench src/bench/AsyncCollectBench.cpp
+//       src/core/collector/AsyncExecutor.cpp src/core/collector/LinuxCollectors.cpp src/core/cpu/CoreUsage.cpp src/core/cpu/UsageFilter.cpp
+//       src/core/Utils/Logger.cpp
+// 运行:
+//   ./async_bench [秒数=5] [模拟 I/O 数据源数=64]
+#ifndef __linux__
+#error "AsyncCollectBench 仅用于 Linux（依赖 /proc、/sys 与 epoll）"
+#endif
+
+#include "collector/AsyncExecutor.h"
+#include "collector/LinuxCollectors.h"
+#include "Utils/Logger.h"
+#include "BenchStats.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using Clock = AsyncExecutor::Clock;
+
+struct SourceStats {
+    const char* name;
+    uint64_t runs = 0;
+    double totalUs = 0.0;
+    double maxUs = 0.0;
+};
+
+void Record(SourceStats& stats, Clock::time_point start) {
+    const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    ++stats.runs;
+    stats.totalUs += us;
+    if (us > stats.maxUs) stats.maxUs = us;
+}
+
+// 按固定周期执行一个采集协程
+template <typename Collect>
+Task<void> Periodic(AsyncExecutor& executor, std::chrono::milliseconds period, Clock::time_point end,
+                    SourceStats& stats, Collect collect) {
+    Clock::time_point next = Clock::now();
+    while (next < end) {
+        const Clock::time_point start = Clock::now();
+        co_await collect();
+        Record(stats, start);
+        next += period;
+        co_await executor.SleepUntil(next);
+    }
+}
+
+struct PipeSource {
+    int fds[2] = { -1, -1 };
+    Clock::time_point writtenAt;
+};
+
+// 模拟 I/O 数据源：等待管道可读，记录“写入 -> 协程恢复”的延迟
+Task<void> PipeReader(AsyncExecutor& executor, PipeSource& source, Clock::time_point end, LatencyHistogram& latency) {
+    while (Clock::now() < end) {
+        const AsyncExecutor::WaitResult result = co_await executor.WaitFd(source.fds[0], EPOLLIN, end);
+        if (result.timedOut) break;
+        char byte;
+        if (read(source.fds[0], &byte, 1) == 1) {
+            latency.Add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - source.writtenAt).count()));
+        }
+    }
+}
+
+// 每 100ms 向所有管道写入一个字节
+Task<void> PipeWriter(AsyncExecutor& executor, std::vector<PipeSource>& sources, Clock::time_point end) {
+    Clock::time_point next = Clock::now();
+    while (next < end) {
+        for (PipeSource& source : sources) {
+            source.writtenAt = Clock::now();
+            const char byte = 1;
+            if (write(source.fds[1], &byte, 1) != 1) perror("write");
+        }
+        next += std::chrono::milliseconds(100);
+        co_await executor.SleepUntil(next);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int seconds = argc > 1 ? std::atoi(argv[1]) : 5;
+    const int pipeSources = argc > 2 ? std::atoi(argv[2]) : 64;
+
+    Logger::EnableConsoleOutput(false);
+    Logger::Initialize("async_bench.log");
+
+    SystemInfo info{};
+    LinuxCollectors::FillStaticInfo(info);
+
+    AsyncExecutor executor;
+    LinuxCollectors collectors(executor);
+    const Clock::time_point end = Clock::now() + std::chrono::seconds(seconds);
+
+    SourceStats load{ "load" }, memory{ "memory" }, frequency{ "cpufreq" }, sensors{ "sensors" };
+    executor.Spawn("load", Periodic(executor, std::chrono::milliseconds(250), end, load, [&] { return collectors.CollectLoad(info); }));
+    executor.Spawn("memory", Periodic(executor, std::chrono::milliseconds(500), end, memory, [&] { return collectors.CollectMemory(info); }));
+    executor.Spawn("cpufreq", Periodic(executor, std::chrono::milliseconds(500), end, frequency, [&] { return collectors.CollectCpuFrequency(info); }));
+    executor.Spawn("sensors", Periodic(executor, std::chrono::milliseconds(1000), end, sensors, [&] { return collectors.CollectTemperatures(info); }));
+
+    std::vector<PipeSource> pipes(static_cast<size_t>(pipeSources));
+    LatencyHistogram ioLatency{};
+    for (size_t i = 0; i < pipes.size(); ++i) {
+        if (pipe(pipes[i].fds) != 0) {
+            perror("pipe");
+            return 1;
+        }
+        executor.Spawn("pipe" + std::to_string(i), PipeReader(executor, pipes[i], end, ioLatency));
+    }
+    if (!pipes.empty()) executor.Spawn("pipeWriter", PipeWriter(executor, pipes, end));
+
+    executor.Run();
+
+    printf("threads=1  seconds=%d  io sources=%d  timer wakeups=%llu  max timer lateness=%.1f us\n", seconds, pipeSources,
+           static_cast<unsigned long long>(executor.TimerWakeups()), executor.MaxTimerLatenessUs());
+    for (const SourceStats* stats : { &load, &memory, &frequency, &sensors }) {
+        printf("%-8s runs=%-4llu avg=%.1f us  max=%.1f us\n", stats->name, static_cast<unsigned long long>(stats->runs),
+               stats->runs ? stats->totalUs / stats->runs : 0.0, stats->maxUs);
+    }
+    if (!pipes.empty()) {
+        printf("io ready->resume: samples=%llu  avg=%.1f us  p50<=%.1f us  p99<=%.1f us  max=%.1f us\n",
+               static_cast<unsigned long long>(ioLatency.count), ioLatency.AvgNs() / 1000.0, ioLatency.Percentile(0.5) / 1000.0,
+               ioLatency.Percentile(0.99) / 1000.0, ioLatency.maxNs / 1000.0);
+    }
+    printf("cpu=\"%s\" cores=%d/%d usage=%.1f%% (raw %.1f%%) freq=%.0f/%.0f MHz mem=%llu/%llu MB sensors=%zu cpuTemp=%.1f\n",
+           info.cpuName.c_str(), info.physicalCores, info.logicalCores, info.cpuUsage, info.cpuUsageRaw, info.performanceCoreFreq,
+           info.efficiencyCoreFreq, static_cast<unsigned long long>(info.usedMemory >> 20),
+           static_cast<unsigned long long>(info.totalMemory >> 20), info.temperatures.size(), info.cpuTemperature);
+    printf("os=%s\n", info.osVersion.c_str());
+
+    for (PipeSource& source : pipes) {
+        close(source.fds[0]);
+        close(source.fds[1]);
+    }
+    return 0;
+}
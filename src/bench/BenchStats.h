@@ -0,0 +1,43 @@
+// BenchStats.h
+// 基准程序共用的延迟统计：按 2 的幂分桶的直方图，POD 结构，可直接放在 fork 前映射的共享统计区中
+#pragma once
+#include <algorithm>
+#include <cstdint>
+
+struct LatencyHistogram {
+    static constexpr int kBuckets = 40;   // 桶 b 覆盖 [2^b, 2^(b+1)) 纳秒
+
+    uint64_t count;
+    uint64_t totalNs;
+    uint64_t maxNs;
+    uint64_t buckets[kBuckets];
+
+    void Add(uint64_t ns) {
+        int b = 0;
+        for (uint64_t v = ns; v > 1 && b < kBuckets - 1; v >>= 1) ++b;
+        ++buckets[b];
+        ++count;
+        totalNs += ns;
+        maxNs = std::max(maxNs, ns);
+    }
+
+    void Merge(const LatencyHistogram& other) {
+        for (int b = 0; b < kBuckets; ++b) buckets[b] += other.buckets[b];
+        count += other.count;
+        totalNs += other.totalNs;
+        maxNs = std::max(maxNs, other.maxNs);
+    }
+
+    double AvgNs() const { return count ? static_cast<double>(totalNs) / count : 0.0; }
+
+    // 返回第 p 分位所在桶的上界（纳秒），精度为 2 倍
+    uint64_t Percentile(double p) const {
+        const uint64_t target = static_cast<uint64_t>(static_cast<double>(count) * p);
+        uint64_t seen = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            seen += buckets[b];
+            if (seen > target) return 1ULL << (b + 1);
+        }
+        return 1ULL << kBuckets;
+    }
+};
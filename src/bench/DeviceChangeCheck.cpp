@@ -0,0 +1,225 @@
+// DeviceChangeCheck.cpp
+// 设备热插拔监听的检查：经 socketpair 向 DeviceChangeMonitor::StartFromSocket 注入合成的 uevent
+// （内核格式 "ACTION@DEVPATH\0KEY=VALUE\0..." 与 libudev 格式），核对：
+//  - 子系统到设备类别掩码的归类（net / block / nvme / scsi_disk / drm / PCI 显示控制器），移除事件同样触发，
+//    无关子系统与格式不符的消息不触发
+//  - 一串事件在最后一个事件之后 settle（500ms）内没有新事件才由 TakeChanges 返回，且合并为一个掩码
+//  - 只有无关子系统的事件不计入事件数，也不产生变化
+//  - Start 打开的 netlink 套接字丢弃用户态进程单播的伪造 uevent（环境不支持 netlink 时跳过）
+// 任一项与预期不符时以非零状态退出
+//
+// 构建:
+//   g++ -std=c++17 -O2 -pthread -Isrc/core -o device_check src/bench/DeviceChangeCheck.cpp
+//       src/core/collector/DeviceChangeMonitor.cpp src/core/Utils/Logger.cpp
+// 运行:
+//   ./device_check
+#ifdef _WIN32
+#error "DeviceChangeCheck 仅用于 Linux（依赖 uevent 套接字后端）"
+#endif
+
+#include "Utils/Logger.h"
+#include "collector/DeviceChangeMonitor.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <thread>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = DeviceChangeMonitor::Clock;
+
+int failures = 0;
+
+void Expect(const char* what, uint32_t actual, uint32_t expected) {
+    const bool ok = actual == expected;
+    std::printf("%-6s %-44s 0x%x", ok ? "ok" : "FAIL", what, actual);
+    if (!ok) {
+        std::printf("（预期 0x%x）", expected);
+        ++failures;
+    }
+    std::printf("\n");
+}
+
+// 内核格式：首个字段 ACTION@DEVPATH，之后为 \0 分隔的属性
+std::string KernelEvent(const char* action, const char* devpath, std::initializer_list<const char*> properties) {
+    std::string message = std::string(action) + "@" + devpath;
+    message.push_back('\0');
+    message += std::string("ACTION=") + action;
+    message.push_back('\0');
+    message += std::string("DEVPATH=") + devpath;
+    message.push_back('\0');
+    for (const char* property : properties) {
+        message += property;
+        message.push_back('\0');
+    }
+    return message;
+}
+
+// libudev 格式：40 字节头（"libudev\0"、魔数、头长度、属性偏移与长度、过滤字段），之后为属性列表
+std::string UdevEvent(std::initializer_list<const char*> properties) {
+    std::string list;
+    for (const char* property : properties) {
+        list += property;
+        list.push_back('\0');
+    }
+    char header[40] = {};
+    std::memcpy(header, "libudev", 8);
+    const uint32_t magic = 0xcafe1dea;  // 网络字节序的 0xfeedcafe，解析时不校验
+    const uint32_t headerSize = sizeof(header);
+    const uint32_t propertiesOffset = sizeof(header);
+    const uint32_t propertiesLength = static_cast<uint32_t>(list.size());
+    std::memcpy(header + 8, &magic, 4);
+    std::memcpy(header + 12, &headerSize, 4);
+    std::memcpy(header + 16, &propertiesOffset, 4);
+    std::memcpy(header + 20, &propertiesLength, 4);
+    return std::string(header, sizeof(header)) + list;
+}
+
+uint32_t Classify(const std::string& message) {
+    return DeviceChangeMonitor::ClassifyUevent(message.data(), message.size());
+}
+
+bool Send(int fd, const std::string& message) {
+    return send(fd, message.data(), message.size(), 0) == static_cast<ssize_t>(message.size());
+}
+
+void CheckClassification() {
+    Expect("内核 add net", Classify(KernelEvent("add", "/devices/virtual/net/veth0", { "SUBSYSTEM=net", "INTERFACE=veth0" })),
+           DEVICE_CLASS_NETWORK);
+    Expect("内核 remove net", Classify(KernelEvent("remove", "/devices/virtual/net/veth0", { "SUBSYSTEM=net" })),
+           DEVICE_CLASS_NETWORK);
+    Expect("内核 add block", Classify(KernelEvent("add", "/devices/pci0000:00/0000:00:14.0/usb2/2-1/block/sdb",
+                                                    { "SUBSYSTEM=block", "DEVTYPE=disk" })), DEVICE_CLASS_DISK);
+    Expect("内核 remove block（分区）", Classify(KernelEvent("remove", "/devices/virtual/block/sdb/sdb1",
+                                                         { "SUBSYSTEM=block", "DEVTYPE=partition" })), DEVICE_CLASS_DISK);
+    Expect("内核 add nvme", Classify(KernelEvent("add", "/devices/pci0000:00/0000:00:1d.0/nvme/nvme1", { "SUBSYSTEM=nvme" })),
+           DEVICE_CLASS_DISK);
+    Expect("内核 change scsi_disk", Classify(KernelEvent("change", "/devices/scsi_disk/2:0:0:0", { "SUBSYSTEM=scsi_disk" })),
+           DEVICE_CLASS_DISK);
+    Expect("内核 add drm", Classify(KernelEvent("add", "/devices/pci0000:00/0000:00:02.0/drm/card1", { "SUBSYSTEM=drm" })),
+           DEVICE_CLASS_GPU);
+    Expect("内核 bind PCI 显示控制器", Classify(KernelEvent("bind", "/devices/pci0000:00/0000:01:00.0",
+                                                        { "SUBSYSTEM=pci", "PCI_CLASS=30000", "DRIVER=amdgpu" })), DEVICE_CLASS_GPU);
+    Expect("内核 add PCI 存储控制器（非显卡）", Classify(KernelEvent("add", "/devices/pci0000:00/0000:02:00.0",
+                                                             { "SUBSYSTEM=pci", "PCI_CLASS=10802" })), 0);
+    Expect("内核 add usb（无关子系统）", Classify(KernelEvent("add", "/devices/pci0000:00/0000:00:14.0/usb1/1-2",
+                                                          { "SUBSYSTEM=usb", "DEVTYPE=usb_device" })), 0);
+    Expect("内核 add input（无关子系统）", Classify(KernelEvent("add", "/devices/virtual/input/input9", { "SUBSYSTEM=input" })), 0);
+    Expect("属性前缀相同的子系统不误判", Classify(KernelEvent("add", "/devices/virtual/netdev/x", { "SUBSYSTEM=network" })), 0);
+
+    Expect("libudev add net", Classify(UdevEvent({ "ACTION=add", "SUBSYSTEM=net", "INTERFACE=wlan1" })), DEVICE_CLASS_NETWORK);
+    Expect("libudev remove block", Classify(UdevEvent({ "ACTION=remove", "SUBSYSTEM=block", "DEVNAME=/dev/sdc" })),
+           DEVICE_CLASS_DISK);
+    Expect("libudev change drm", Classify(UdevEvent({ "ACTION=change", "SUBSYSTEM=drm", "HOTPLUG=1" })), DEVICE_CLASS_GPU);
+    Expect("libudev add hidraw（无关子系统）", Classify(UdevEvent({ "ACTION=add", "SUBSYSTEM=hidraw" })), 0);
+
+    // 格式不符：内核格式缺少 @、libudev 头不完整、属性越界
+    const std::string noAt = std::string("add\0SUBSYSTEM=net\0", 18);
+    Expect("内核格式缺少 ACTION@DEVPATH", Classify(noAt), 0);
+    Expect("libudev 头不完整", Classify(UdevEvent({ "SUBSYSTEM=net" }).substr(0, 24)), 0);
+    std::string outOfRange = UdevEvent({ "SUBSYSTEM=net" });
+    const uint32_t hugeLength = 4096;
+    std::memcpy(&outOfRange[20], &hugeLength, 4);
+    Expect("libudev 属性长度越界", Classify(outOfRange), 0);
+    Expect("空消息", DeviceChangeMonitor::ClassifyUevent(nullptr, 0), 0);
+}
+
+void CheckSettleWindow() {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_DGRAM, 0, fds) != 0) {
+        std::perror("socketpair");
+        ++failures;
+        return;
+    }
+    const auto settle = std::chrono::milliseconds(500);
+    DeviceChangeMonitor monitor(settle);
+    if (!monitor.StartFromSocket(fds[0])) {
+        std::printf("FAIL   StartFromSocket\n");
+        ++failures;
+        close(fds[1]);
+        return;
+    }
+    const int sender = fds[1];
+
+    // 一次热插拔的一串事件：网卡（内核格式）与其后 100ms 的磁盘（libudev 格式），中间夹着无关子系统
+    Send(sender, KernelEvent("add", "/devices/pci0000:00/0000:00:14.0/usb2/2-3/net/eth1", { "SUBSYSTEM=net" }));
+    Send(sender, KernelEvent("add", "/devices/pci0000:00/0000:00:14.0/usb2/2-3", { "SUBSYSTEM=usb" }));
+    const Clock::time_point first = Clock::now();
+    Expect("突发开始：尚未稳定", monitor.TakeChanges(first), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    Send(sender, UdevEvent({ "ACTION=add", "SUBSYSTEM=block", "DEVNAME=/dev/sdd" }));
+    const Clock::time_point second = Clock::now();
+    Expect("突发继续：尚未稳定", monitor.TakeChanges(second), 0);
+    // 距第一个事件已超过 settle，但距最后一个事件不足：继续等待
+    Expect("首个事件后 settle+50ms（末个事件后不足 settle）", monitor.TakeChanges(first + settle + std::chrono::milliseconds(50)), 0);
+    const Clock::time_point settled = Clock::now() + settle + std::chrono::milliseconds(10);
+    Expect("末个事件后超过 settle：合并为一个掩码", monitor.TakeChanges(settled), DEVICE_CLASS_NETWORK | DEVICE_CLASS_DISK);
+    Expect("已取走：不再返回", monitor.TakeChanges(settled + settle), 0);
+    Expect("事件数（无关子系统不计）", static_cast<uint32_t>(monitor.EventCount()), 2);
+
+    // 只有无关子系统：不产生变化
+    Send(sender, KernelEvent("add", "/devices/virtual/input/input12", { "SUBSYSTEM=input" }));
+    Send(sender, UdevEvent({ "ACTION=add", "SUBSYSTEM=sound" }));
+    Expect("只有无关子系统", monitor.TakeChanges(Clock::now() + settle * 2), 0);
+    Expect("事件数不变", static_cast<uint32_t>(monitor.EventCount()), 2);
+
+    // 移除显卡：同样触发重新枚举
+    Send(sender, KernelEvent("remove", "/devices/pci0000:00/0000:00:02.0/drm/card1", { "SUBSYSTEM=drm" }));
+    Expect("移除显卡：尚未稳定", monitor.TakeChanges(Clock::now()), 0);
+    Expect("移除显卡：稳定后", monitor.TakeChanges(Clock::now() + settle + std::chrono::milliseconds(10)), DEVICE_CLASS_GPU);
+
+    monitor.Stop();
+    close(sender);
+}
+
+// 非特权进程可以向任意 uevent 套接字单播：发送方 nl_pid 不为 0，Start 打开的套接字应丢弃
+void CheckSenderFilter() {
+    const auto settle = std::chrono::milliseconds(50);
+    DeviceChangeMonitor monitor(settle);
+    if (!monitor.Start()) {
+        std::printf("skip   netlink uevent 套接字不可用，跳过发送方校验\n");
+        return;
+    }
+    sockaddr_nl target{};
+    socklen_t targetLength = sizeof(target);
+    const int sender = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (sender < 0 || getsockname(monitor.Fd(), reinterpret_cast<sockaddr*>(&target), &targetLength) != 0) {
+        std::printf("skip   无法创建发送端套接字，跳过发送方校验\n");
+        if (sender >= 0) close(sender);
+        return;
+    }
+    const std::string forged = KernelEvent("add", "/devices/virtual/net/fake0", { "SUBSYSTEM=net" });
+    target.nl_groups = 0;   // 单播到监听套接字
+    if (sendto(sender, forged.data(), forged.size(), 0, reinterpret_cast<sockaddr*>(&target), sizeof(target)) !=
+        static_cast<ssize_t>(forged.size())) {
+        std::printf("skip   单播 uevent 失败，跳过发送方校验\n");
+        close(sender);
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    Expect("用户态单播的伪造 uevent 被丢弃", monitor.TakeChanges(Clock::now() + settle * 2), 0);
+    Expect("伪造事件不计入事件数", static_cast<uint32_t>(monitor.EventCount()), 0);
+    close(sender);
+    monitor.Stop();
+}
+
+} // namespace
+
+int main() {
+    Logger::EnableConsoleOutput(false);
+    Logger::Initialize("device_check.log");
+    Logger::SetLogLevel(LOG_ERROR);
+
+    CheckClassification();
+    CheckSettleWindow();
+    CheckSenderFilter();
+    std::printf("RESULT device_check failures=%d\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// DirtyTrackingBench.cpp
+// 测量 WriteToSharedMemory 每轮写入共享内存的字节数与耗时：全量重写（旧行为） vs 按分区脏跟踪
+// 负载模拟真实主循环：CPU 使用率 / 内存 / 温度每轮变化，逻辑磁盘已用空间每 60 轮变化，
+// 适配器 / GPU / SMART（8 块盘 x 32 个属性）基本不变，SMART 每 600 轮刷新一次；
+// 另测一轮只有热点指标变化的稳态写入量
+//
+// 构建:
+//   g++ -std=c++17 -O2 -pthread -Isrc/core -o dirty_bench src/bench/DirtyTrackingBench.cpp
+//       src/core/DataStruct/SharedMemoryManager.cpp src/core/DataStruct/SharedMemoryBackend.cpp
+//       src/core/DataStruct/PublishNotifier.cpp src/core/DataStruct/WriterLease.cpp src/core/DataStruct/SectionOwnership.cpp
+//       src/core/disk/SmartCatalog.cpp src/core/Utils/Logger.cpp -lrt
+// 运行:
+//   ./dirty_bench [轮数=3000]
+#ifdef _WIN32
+#error "DirtyTrackingBench 仅用于 Linux（依赖 POSIX 共享内存后端）"
+#endif
+
+#include "DataStruct/DataStruct.h"
+#include "DataStruct/SharedMemoryBackend.h"
+#include "DataStruct/SharedMemoryManager.h"
+#include "Utils/Logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cwchar>
+#include <string>
+
+namespace {
+
+SystemInfo MakeBaseline() {
+    SystemInfo info{};
+    info.cpuName = "Intel(R) Core(TM) i9-13900K";
+    info.physicalCores = 24;
+    info.logicalCores = 32;
+    info.performanceCores = 8;
+    info.efficiencyCores = 16;
+    info.performanceCoreFreq = 5.4;
+    info.efficiencyCoreFreq = 4.3;
+    info.hyperThreading = true;
+    info.virtualization = true;
+    info.totalMemory = 64ULL << 30;
+    info.gpuName = "NVIDIA GeForce RTX 4090";
+    info.gpuBrand = "NVIDIA";
+    info.gpuMemory = 24ULL << 30;
+    info.gpuCoreFreq = 2520.0;
+    for (int i = 0; i < 4; ++i) {
+        NetworkAdapterData a{};
+        swprintf(a.name, 128, L"Ethernet Adapter %d", i);
+        swprintf(a.mac, 32, L"00:11:22:33:44:%02d", i);
+        swprintf(a.ipAddress, 64, L"192.168.1.%d", 10 + i);
+        swprintf(a.adapterType, 32, L"有线");
+        a.speed = 1000000000ULL;
+        info.adapters.push_back(a);
+    }
+    for (int i = 0; i < 8; ++i) {
+        DiskData d;
+        d.letter = static_cast<char>('C' + i);
+        d.label = "Volume" + std::to_string(i);
+        d.fileSystem = "NTFS";
+        d.totalSize = 1ULL << 40;
+        d.usedSpace = 1ULL << 39;
+        d.freeSpace = d.totalSize - d.usedSpace;
+        info.disks.push_back(d);
+    }
+    for (int i = 0; i < 8; ++i) {
+        PhysicalDiskSmartData pd{};
+        swprintf(pd.model, 128, L"Samsung SSD 990 PRO 2TB #%d", i);
+        swprintf(pd.serialNumber, 64, L"S6Z2NJ0W%06d", i);
+        swprintf(pd.interfaceType, 32, L"NVMe");
+        swprintf(pd.diskType, 16, L"SSD");
+        pd.capacity = 2ULL << 40;
+        pd.smartSupported = pd.smartEnabled = true;
+        pd.attributeCount = 32;
+        for (int a = 0; a < 32; ++a) {
+            pd.attributes[a].id = static_cast<uint8_t>(a + 1);
+            pd.attributes[a].current = 100;
+            swprintf(pd.attributes[a].name, 64, L"Attribute %d", a + 1);
+            swprintf(pd.attributes[a].description, 128, L"Vendor specific SMART attribute number %d", a + 1);
+        }
+        info.physicalDisks.push_back(pd);
+    }
+    for (int i = 0; i < 10; ++i) {
+        info.temperatures.emplace_back("Sensor " + std::to_string(i), 40.0);
+    }
+    return info;
+}
+
+// hotOnly 为 true 时只改变每轮变化的数值（CPU 占用 / 内存 / 温度），用于测量稳态写入量
+void Tick(SystemInfo& info, uint64_t n, bool hotOnly) {
+    info.cpuUsage = static_cast<double>(n * 37 % 1000) / 10.0;
+    info.cpuUsageSampleIntervalMs = 1000.0 + static_cast<double>(n % 7);
+    info.usedMemory = (32ULL << 30) + n * 4096;
+    info.availableMemory = info.totalMemory - info.usedMemory;
+    info.cpuTemperature = 45.0 + static_cast<double>(n % 20);
+    info.gpuTemperature = 50.0 + static_cast<double>(n % 15);
+    for (size_t i = 0; i < info.temperatures.size(); ++i) info.temperatures[i].second = 40.0 + static_cast<double>((n + i) % 30);
+    if (hotOnly) return;
+    if (n % 60 == 0) {
+        for (auto& d : info.disks) { d.usedSpace += 1 << 20; d.freeSpace -= 1 << 20; }
+    }
+    if (n % 600 == 0) {
+        for (auto& pd : info.physicalDisks) { pd.powerOnHours = n / 600; pd.temperature = 35.0 + static_cast<double>(n % 10); }
+    }
+}
+
+struct Result {
+    double avgBytes;
+    double avgMicros;
+};
+
+Result Run(bool dirtyTracking, int cycles, bool hotOnly = false) {
+    SharedMemoryManager::SetDirtyTracking(dirtyTracking);
+    SystemInfo info = MakeBaseline();
+    uint64_t totalBytes = 0;
+    uint64_t totalNs = 0;
+    for (int n = 1; n <= cycles; ++n) {
+        Tick(info, static_cast<uint64_t>(n), hotOnly);
+        auto t0 = std::chrono::steady_clock::now();
+        SharedMemoryManager::WriteToSharedMemory(info);
+        totalNs += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count());
+        totalBytes += SharedMemoryManager::GetLastWriteBytes();
+    }
+    return { static_cast<double>(totalBytes) / cycles, totalNs / 1000.0 / cycles };
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int cycles = argc > 1 ? std::atoi(argv[1]) : 3000;
+    if (cycles < 1) {
+        std::fprintf(stderr, "用法: %s [轮数]\n", argv[0]);
+        return 2;
+    }
+
+    Logger::EnableConsoleOutput(false);
+    Logger::Initialize("dirty_bench.log");
+    Logger::SetLogLevel(LOG_ERROR);
+
+    SharedMemoryBackend::Unlink();
+    if (!SharedMemoryManager::InitSharedMemory()) {
+        std::fprintf(stderr, "共享内存初始化失败: %s\n", SharedMemoryManager::GetLastError().c_str());
+        return 1;
+    }
+
+    const Result full = Run(false, cycles);
+    const Result dirty = Run(true, cycles);
+    const Result steady = Run(true, cycles, true);
+
+    std::printf("block=%zu bytes, cycles=%d\n", sizeof(SharedMemoryBlock), cycles);
+    std::printf("全量重写:   %10.0f bytes/cycle  %8.1f us/cycle\n", full.avgBytes, full.avgMicros);
+    std::printf("脏分区跟踪: %10.0f bytes/cycle  %8.1f us/cycle\n", dirty.avgBytes, dirty.avgMicros);
+    std::printf("写入量降低 %.1f%%\n", full.avgBytes > 0 ? 100.0 * (1.0 - dirty.avgBytes / full.avgBytes) : 0.0);
+    std::printf("稳态（仅热点指标变化）: %6.0f bytes/cycle  %8.1f us/cycle\n", steady.avgBytes, steady.avgMicros);
+
+    SharedMemoryManager::CleanupSharedMemory();
+    SharedMemoryBackend::Unlink();
+    return 0;
+}
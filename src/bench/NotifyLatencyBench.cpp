@@ -0,0 +1,185 @@
+// NotifyLatencyBench.cpp
+// 比较读端两种取数方式：定时轮询（WPF 旧行为，默认 500ms）与阻塞等待发布通知（PublishNotifier）
+// 写端按固定频率调用真实的 SharedMemoryManager::WriteToSharedMemory；N 个读进程（fork）
+// 统计“发布开始 -> 读端发现新数据”的延迟，以及代数未变化的无效读取次数
+//
+// 构建:
+//   g++ -std=c++17 -O2 -pthread -Isrc/core -o notify_bench src/bench/NotifyLatencyBench.cpp
+//       src/core/DataStruct/SharedMemoryManager.cpp src/core/DataStruct/SharedMemoryBackend.cpp
+//       src/core/DataStruct/PublishNotifier.cpp src/core/DataStruct/WriterLease.cpp src/core/DataStruct/SectionOwnership.cpp
+//       src/core/disk/SmartCatalog.cpp src/core/Utils/Logger.cpp -lrt
+// 运行:
+//   ./notify_bench [读进程数=4] [每种模式秒数=5] [写频率Hz=1] [轮询间隔ms=500]
+#ifdef _WIN32
+#error "NotifyLatencyBench 仅用于 Linux（依赖 fork 与 POSIX 共享内存）"
+#endif
+
+#include "DataStruct/DataStruct.h"
+#include "DataStruct/PublishNotifier.h"
+#include "DataStruct/SharedMemoryBackend.h"
+#include "DataStruct/SharedMemoryManager.h"
+#include "Utils/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct ReaderStats {
+    uint64_t reads;          // 读端检查代数的次数（轮询一次或被唤醒一次）
+    uint64_t wasted;         // 代数未变化的检查
+    uint64_t observed;       // 发现的新代数
+    uint64_t latencyNsTotal;
+    uint64_t latencyNsMax;
+};
+
+struct SharedStats {
+    std::atomic<bool> stop;
+    // 写端在每次发布前记录时间，按代数取模索引（代数在 Notify 中加 1）
+    std::atomic<int64_t> publishStartNs[64];
+    ReaderStats readers[64];
+};
+
+int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+void Observe(SharedStats* stats, ReaderStats& rs, uint32_t generation) {
+    const int64_t start = stats->publishStartNs[generation % 64].load(std::memory_order_acquire);
+    if (start <= 0) return;
+    const uint64_t latency = static_cast<uint64_t>(std::max<int64_t>(NowNs() - start, 0));
+    ++rs.observed;
+    rs.latencyNsTotal += latency;
+    rs.latencyNsMax = std::max(rs.latencyNsMax, latency);
+}
+
+int RunReader(SharedStats* stats, int index, bool notified, int pollMs) {
+    SharedMemoryBackend shm;
+    // 等待者计数位于头部，需要以读写方式映射
+    while (!shm.Open(0, false)) {
+        if (stats->stop.load()) return 1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto* layout = static_cast<SharedMemoryLayout*>(shm.Data());
+    PublishNotifier notifier;
+    if (notified && !notifier.Open()) return 1;
+    ReaderStats& rs = stats->readers[index];
+    uint32_t lastSeen = layout->header.publishGeneration.load(std::memory_order_acquire);
+
+    while (!stats->stop.load(std::memory_order_relaxed)) {
+        uint32_t generation = 0;
+        if (notified) {
+            // 超时仅用于检查退出标志，不读取数据，因此不计入读取次数
+            const auto result = notifier.Wait(layout->header, lastSeen, 200, &generation);
+            if (result == PublishNotifier::WaitResult::Error) return 1;
+            if (result == PublishNotifier::WaitResult::Timeout) continue;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(pollMs));
+            generation = layout->header.publishGeneration.load(std::memory_order_acquire);
+        }
+        ++rs.reads;
+        if (generation == lastSeen) {
+            ++rs.wasted;
+            continue;
+        }
+        Observe(stats, rs, generation);
+        lastSeen = generation;
+    }
+    return 0;
+}
+
+ReaderStats RunMode(SharedStats* stats, int readers, int seconds, int writeHz, bool notified, int pollMs) {
+    std::memset(static_cast<void*>(stats->readers), 0, sizeof(stats->readers));
+    stats->stop.store(false);
+
+    std::vector<pid_t> children;
+    for (int i = 0; i < readers; ++i) {
+        pid_t pid = fork();
+        if (pid == 0) _exit(RunReader(stats, i, notified, pollMs));
+        if (pid > 0) children.push_back(pid);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    SystemInfo info{};
+    info.cpuName = "bench";
+    info.totalMemory = 16ULL << 30;
+    const auto period = std::chrono::nanoseconds(1000000000LL / writeHz);
+    const auto end = Clock::now() + std::chrono::seconds(seconds);
+    auto next = Clock::now();
+    const SharedMemoryHeader* header = SharedMemoryManager::GetHeader();
+    while (Clock::now() < end) {
+        info.cpuUsage = static_cast<double>(next.time_since_epoch().count() % 1000) / 10.0;
+        const uint32_t nextGeneration = header->publishGeneration.load() + 1;
+        stats->publishStartNs[nextGeneration % 64].store(NowNs(), std::memory_order_release);
+        SharedMemoryManager::WriteToSharedMemory(info);
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+    stats->stop.store(true);
+    for (pid_t pid : children) waitpid(pid, nullptr, 0);
+
+    ReaderStats total{};
+    for (int i = 0; i < readers; ++i) {
+        const auto& r = stats->readers[i];
+        total.reads += r.reads; total.wasted += r.wasted; total.observed += r.observed;
+        total.latencyNsTotal += r.latencyNsTotal;
+        total.latencyNsMax = std::max(total.latencyNsMax, r.latencyNsMax);
+    }
+    return total;
+}
+
+void Print(const char* label, const ReaderStats& s) {
+    std::printf("%s reads=%llu  wasted=%llu  observed=%llu  avg latency=%.3f ms  max latency=%.3f ms\n", label,
+        static_cast<unsigned long long>(s.reads), static_cast<unsigned long long>(s.wasted),
+        static_cast<unsigned long long>(s.observed),
+        s.observed ? s.latencyNsTotal / 1e6 / s.observed : 0.0, s.latencyNsMax / 1e6);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int readers = argc > 1 ? std::atoi(argv[1]) : 4;
+    const int seconds = argc > 2 ? std::atoi(argv[2]) : 5;
+    const int writeHz = argc > 3 ? std::atoi(argv[3]) : 1;
+    const int pollMs = argc > 4 ? std::atoi(argv[4]) : 500;
+    if (readers < 1 || readers > 64 || seconds < 1 || writeHz < 1 || pollMs < 1) {
+        std::fprintf(stderr, "用法: %s [读进程数 1-64] [每种模式秒数] [写频率Hz] [轮询间隔ms]\n", argv[0]);
+        return 2;
+    }
+
+    Logger::EnableConsoleOutput(false);
+    Logger::Initialize("notify_bench.log");
+    Logger::SetLogLevel(LOG_ERROR);
+
+    SharedMemoryBackend::Unlink();
+    if (!SharedMemoryManager::InitSharedMemory()) {
+        std::fprintf(stderr, "共享内存初始化失败: %s\n", SharedMemoryManager::GetLastError().c_str());
+        return 1;
+    }
+
+    auto* stats = static_cast<SharedStats*>(mmap(nullptr, sizeof(SharedStats), PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    if (stats == MAP_FAILED) { std::perror("mmap"); return 1; }
+    std::memset(static_cast<void*>(stats), 0, sizeof(SharedStats));
+
+    std::printf("readers=%d, seconds=%d, writeHz=%d, pollMs=%d\n", readers, seconds, writeHz, pollMs);
+    const ReaderStats polled = RunMode(stats, readers, seconds, writeHz, false, pollMs);
+    Print("轮询:     ", polled);
+    const ReaderStats notified = RunMode(stats, readers, seconds, writeHz, true, pollMs);
+    Print("发布通知: ", notified);
+
+    SharedMemoryManager::CleanupSharedMemory();
+    SharedMemoryBackend::Unlink();
+    return 0;
+}
@@ -0,0 +1,211 @@
+// ReaderBench.cpp
+// SharedMemoryReader 读延迟 / 吞吐基准：1 个写进程 + N 个读进程（fork），POSIX shm 后端
+// 分别测量两种读取方式：
+//   pinned  读写映射，钉住快照槽后零拷贝访问
+//   copy    只读映射，seqlock 下只复制代数变化过的分区
+// 每次读取 = Acquire + 访问 CPU 名称 / 内存 / 全部温度 + ReadDisks（经段表的完整列表）
+//
+// 构建:
+//   g++ -std=c++17 -O2 -pthread -Isrc/core -o reader_bench src/bench/ReaderBench.cpp
+//       src/core/DataStruct/SharedMemoryReader.cpp src/core/DataStruct/SharedMemoryManager.cpp
+//       src/core/DataStruct/SharedMemoryBackend.cpp src/core/DataStruct/PublishNotifier.cpp
+//       src/core/DataStruct/WriterLease.cpp src/core/DataStruct/SectionOwnership.cpp
+//       src/core/disk/SmartCatalog.cpp src/core/Utils/Logger.cpp -lrt
+// 运行:
+//   ./reader_bench [读进程数=8] [每种模式秒数=5] [写频率Hz=100]
+#ifdef _WIN32
+#error "ReaderBench 仅用于 Linux（依赖 fork 与 POSIX 共享内存）"
+#endif
+
+#include "BenchStats.h"
+#include "DataStruct/DataStruct.h"
+#include "DataStruct/SharedMemoryBackend.h"
+#include "DataStruct/SharedMemoryManager.h"
+#include "DataStruct/SharedMemoryReader.h"
+#include "Utils/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct ReaderStats {
+    uint64_t failed;
+    uint64_t pinned;
+    LatencyHistogram latency;
+    double ageMsTotal;
+    uint64_t notFresh;   // 抽样检查写端租约时为 Stale / Orphaned 的次数（写端持续发布，应为 0）
+    uint64_t sink; // 防止访问被优化掉
+};
+
+struct SharedStats {
+    std::atomic<bool> stop;
+    std::atomic<int> ready;
+    ReaderStats readers[256];
+};
+
+SystemInfo MakeSystemInfo(uint64_t n) {
+    SystemInfo info{};
+    info.cpuName = "Intel(R) Core(TM) i9-13900K";
+    info.physicalCores = 24;
+    info.logicalCores = 32;
+    info.cpuUsage = static_cast<double>(n % 1000) / 10.0;
+    info.totalMemory = 64ULL << 30;
+    info.usedMemory = (32ULL << 30) + n * 4096;
+    info.availableMemory = info.totalMemory - info.usedMemory;
+    info.cpuTemperature = 45.0 + static_cast<double>(n % 20);
+    info.gpuTemperature = 50.0 + static_cast<double>(n % 15);
+    for (int i = 0; i < 12; ++i) {
+        DiskData d;
+        d.letter = static_cast<char>('C' + i);
+        d.label = "Volume" + std::to_string(i);
+        d.fileSystem = "NTFS";
+        d.totalSize = 1ULL << 40;
+        d.usedSpace = (1ULL << 39) + (n / 100) * 4096;
+        d.freeSpace = d.totalSize - d.usedSpace;
+        info.disks.push_back(d);
+    }
+    for (int i = 0; i < 16; ++i) {
+        info.temperatures.emplace_back("Sensor " + std::to_string(i), 40.0 + static_cast<double>((n + i) % 30));
+    }
+    return info;
+}
+
+int RunReader(SharedStats* stats, int index, bool readOnly) {
+    SharedMemoryReader reader;
+    while (!reader.Open(readOnly)) {
+        if (stats->stop.load()) return 1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::vector<SharedMemoryBlock::SharedDiskData> disks;
+    ReaderStats& rs = stats->readers[index];
+    stats->ready.fetch_add(1);
+
+    while (!stats->stop.load(std::memory_order_relaxed)) {
+        const auto t0 = Clock::now();
+        {
+            SharedMemoryReader::Snapshot snapshot = reader.Acquire();
+            if (!snapshot || !reader.ReadDisks(disks)) {
+                ++rs.failed;
+                continue;
+            }
+            uint64_t sink = std::wcslen(snapshot.CpuName()) + snapshot.UsedMemory();
+            for (const auto& t : snapshot.Temperatures()) sink += static_cast<uint64_t>(t.temperature);
+            for (const auto& d : disks) sink += d.usedSpace;
+            rs.sink += sink;
+            if (snapshot.IsPinned()) ++rs.pinned;
+            if ((rs.latency.count & 1023) == 0) {
+                rs.ageMsTotal += snapshot.AgeMs();
+                // 首次发布前为 Unknown，不计入
+                const WriterLease::Status status = reader.GetWriterStatus();
+                if (status == WriterLease::Status::Stale || status == WriterLease::Status::Orphaned) ++rs.notFresh;
+            }
+        }
+        rs.latency.Add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count()));
+    }
+    return 0;
+}
+
+void RunMode(SharedStats* stats, int readers, int seconds, int writeHz, bool readOnly, uint64_t& n) {
+    std::memset(static_cast<void*>(stats->readers), 0, sizeof(stats->readers));
+    stats->stop.store(false);
+    stats->ready.store(0);
+
+    std::vector<pid_t> children;
+    for (int i = 0; i < readers; ++i) {
+        pid_t pid = fork();
+        if (pid == 0) _exit(RunReader(stats, i, readOnly));
+        if (pid > 0) children.push_back(pid);
+    }
+    while (stats->ready.load() < static_cast<int>(children.size())) {
+        SharedMemoryManager::WriteToSharedMemory(MakeSystemInfo(++n));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::seconds(seconds);
+    const auto period = std::chrono::nanoseconds(1000000000LL / writeHz);
+    auto next = start;
+    while (Clock::now() < end) {
+        SharedMemoryManager::WriteToSharedMemory(MakeSystemInfo(++n));
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+    stats->stop.store(true);
+    for (pid_t pid : children) waitpid(pid, nullptr, 0);
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    ReaderStats total{};
+    for (int i = 0; i < readers; ++i) {
+        const auto& r = stats->readers[i];
+        total.failed += r.failed; total.pinned += r.pinned;
+        total.latency.Merge(r.latency);
+        total.ageMsTotal += r.ageMsTotal;
+        total.notFresh += r.notFresh;
+    }
+    const uint64_t reads = total.latency.count;
+    const uint64_t ageSamples = std::max<uint64_t>(1, (reads + 1023) / 1024);
+    std::printf("%-7s reads=%llu (%.0f/s)  failed=%llu  pinned=%llu  avg=%.0f ns  p50<=%llu ns  p99<=%llu ns  max=%.1f us  avg age=%.1f ms  not fresh=%llu\n",
+        readOnly ? "copy" : "pinned",
+        static_cast<unsigned long long>(reads), reads / elapsed,
+        static_cast<unsigned long long>(total.failed), static_cast<unsigned long long>(total.pinned),
+        total.latency.AvgNs(),
+        static_cast<unsigned long long>(total.latency.Percentile(0.50)),
+        static_cast<unsigned long long>(total.latency.Percentile(0.99)),
+        total.latency.maxNs / 1000.0, total.ageMsTotal / ageSamples, static_cast<unsigned long long>(total.notFresh));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int readers = argc > 1 ? std::atoi(argv[1]) : 8;
+    const int seconds = argc > 2 ? std::atoi(argv[2]) : 5;
+    const int writeHz = argc > 3 ? std::atoi(argv[3]) : 100;
+    if (readers < 1 || readers > 256 || seconds < 1 || writeHz < 1) {
+        std::fprintf(stderr, "用法: %s [读进程数 1-256] [每种模式秒数] [写频率Hz]\n", argv[0]);
+        return 2;
+    }
+
+    Logger::EnableConsoleOutput(false);
+    Logger::Initialize("reader_bench.log");
+    Logger::SetLogLevel(LOG_ERROR);
+
+    SharedMemoryBackend::Unlink();
+    if (!SharedMemoryManager::InitSharedMemory()) {
+        std::fprintf(stderr, "共享内存初始化失败: %s\n", SharedMemoryManager::GetLastError().c_str());
+        return 1;
+    }
+
+    auto* stats = static_cast<SharedStats*>(mmap(nullptr, sizeof(SharedStats), PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    if (stats == MAP_FAILED) { std::perror("mmap"); return 1; }
+    std::memset(static_cast<void*>(stats), 0, sizeof(SharedStats));
+
+    std::printf("block=%zu bytes, readers=%d, seconds=%d, writeHz=%d\n", sizeof(SharedMemoryBlock), readers, seconds, writeHz);
+    uint64_t n = 0;
+    RunMode(stats, readers, seconds, writeHz, false, n);
+    RunMode(stats, readers, seconds, writeHz, true, n);
+
+    // 写端正常退出后，仍映射着的读端应立即看到 Orphaned
+    SharedMemoryReader observer;
+    observer.Open(true);
+    const char* before = WriterLease::ToString(observer.GetWriterStatus());
+    SharedMemoryManager::CleanupSharedMemory();
+    std::printf("writer status: running=%s  after cleanup=%s\n", before, WriterLease::ToString(observer.GetWriterStatus()));
+    observer.Close();
+    SharedMemoryBackend::Unlink();
+    return 0;
+}
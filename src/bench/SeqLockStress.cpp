@@ -0,0 +1,420 @@
+// SeqLockStress.cpp
+// Linux 下的共享内存 IPC 基准 / 压力测试：1 个写进程 + N 个读进程（fork），写端与读端频率均可配置
+// 报告写端延迟分位数与每轮写入字节数、读端 seqlock / 钉住快照读取延迟分位数，以及撕裂读取率；
+// 末行输出 key=value 形式的汇总，便于脚本跟踪 IPC 路径的性能回退（见 run_benchmarks.sh）
+// 写端调用真实的 SharedMemoryManager::WriteToSharedMemory（POSIX shm 后端），
+// 读端按 seqlock 协议复制整个 SharedMemoryBlock，并用写端数据的内在关系校验是否撕裂；
+// 不加保护的对照组跨越写入复制，必须检测到撕裂，否则视为校验失效并以非零状态退出；
+// 同时以“钉住快照槽 + 分段慢速复制”的方式模拟慢读者，校验钉住期间快照不被改写；
+// 并周期性读取历史环，校验样本未撕裂且按序递增；
+// 逻辑磁盘与温度数量会超过兼容块上限，触发变长段扩容，读端经段表读取并校验完整列表
+//
+// 构建:
+//   g++ -std=c++17 -O2 -pthread -Isrc/core -o seqlock_stress src/bench/SeqLockStress.cpp
+//       src/core/DataStruct/SharedMemoryManager.cpp src/core/DataStruct/SharedMemoryBackend.cpp
+//       src/core/DataStruct/PublishNotifier.cpp src/core/DataStruct/WriterLease.cpp src/core/DataStruct/SectionOwnership.cpp
+//       src/core/disk/SmartCatalog.cpp src/core/Utils/Logger.cpp -lrt
+// 运行:
+//   ./seqlock_stress [读进程数=8] [秒数=10] [写频率Hz=0 表示不限速] [每个读进程读取频率Hz=0 表示不限速]
+#ifdef _WIN32
+#error "SeqLockStress 仅用于 Linux（依赖 fork 与 POSIX 共享内存）"
+#endif
+
+#include "BenchStats.h"
+#include "DataStruct/DataStruct.h"
+#include "DataStruct/HistoryRing.h"
+#include "DataStruct/SeqLock.h"
+#include "DataStruct/SharedMemoryBackend.h"
+#include "DataStruct/SharedMemoryManager.h"
+#include "DataStruct/SnapshotSlots.h"
+#include "disk/SmartCatalog.h"
+#include "Utils/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+struct ReaderStats {
+    uint64_t reads;             // 成功的 seqlock 读取
+    uint64_t retries;           // seqlock 重试次数
+    uint64_t failed;            // 超过重试上限仍未读到稳定快照
+    uint64_t torn;              // 通过 seqlock 校验但内容不一致（必须为 0）
+    uint64_t unprotectedReads;  // 对照组：不走 seqlock 直接复制
+    uint64_t unprotectedTorn;   // 对照组中检测到的撕裂
+    uint64_t snapshotReads;     // 钉住快照槽后的慢速读取
+    uint64_t snapshotTorn;      // 钉住期间内容不一致（必须为 0）
+    uint64_t pinFailed;         // 未能钉住（尚未发布或竞争失败）
+    uint64_t historyReads;      // 历史环读取次数
+    uint64_t historySamples;    // 读到的历史样本总数
+    uint64_t historyTorn;       // 样本内容不一致或顺序错误（必须为 0）
+    LatencyHistogram seqlockLatency;   // 一次 seqlock 读取（含重试）的耗时
+    LatencyHistogram snapshotLatency;  // 钉住 + 慢速复制 + 释放的耗时
+};
+
+struct SharedStats {
+    std::atomic<bool> stop;
+    LatencyHistogram writeLatency;
+    uint64_t bytesTotal;        // WriteToSharedMemory 写入共享内存的总字节数
+    ReaderStats readers[256];
+};
+
+// 所有字段都由序号 n 推导，读端可据此判断一份副本是否来自同一次写入
+SystemInfo MakeSystemInfo(uint64_t n) {
+    SystemInfo info{};
+    info.cpuName = "CPU-" + std::to_string(n);
+    info.physicalCores = static_cast<int>(n % 64);
+    info.logicalCores = static_cast<int>(n % 128);
+    info.cpuUsage = static_cast<double>(n % 1000) / 10.0;
+    info.totalMemory = n;
+    info.usedMemory = n * 3;
+    info.availableMemory = n * 5;
+    info.cpuTemperature = static_cast<double>(n % 97);
+    info.gpuTemperature = static_cast<double>(n % 89);
+    info.gpuName = "GPU-" + std::to_string(n);
+    info.gpuMemory = n * 7;
+
+    for (uint64_t i = 0; i < n % 4 + 1; ++i) {
+        NetworkAdapterData a{};
+        swprintf(a.name, 128, L"eth-%llu-%llu", static_cast<unsigned long long>(n), static_cast<unsigned long long>(i));
+        a.speed = n * 10 + i;
+        info.adapters.push_back(a);
+    }
+    for (uint64_t i = 0; i < n % 20 + 1; ++i) {
+        DiskData d;
+        d.letter = static_cast<char>('C' + i);
+        d.label = "D" + std::to_string(n);
+        d.fileSystem = "NTFS";
+        d.totalSize = n + i;
+        d.usedSpace = n * 2 + i;
+        d.freeSpace = n * 4 + i;
+        info.disks.push_back(d);
+    }
+    for (uint64_t i = 0; i < n % 8 + 1; ++i) {
+        PhysicalDiskSmartData pd{};
+        swprintf(pd.model, 128, L"MODEL-%llu", static_cast<unsigned long long>(n));
+        pd.capacity = n + i;
+        pd.attributeCount = static_cast<int>(n % 32 + 1);
+        for (int a = 0; a < pd.attributeCount; ++a) {
+            pd.attributes[a].id = static_cast<uint8_t>(a + 1);
+            pd.attributes[a].rawValue = n * 100 + a;
+            swprintf(pd.attributes[a].name, 64, L"attr-%llu", static_cast<unsigned long long>(n));
+        }
+        info.physicalDisks.push_back(pd);
+    }
+    for (uint64_t i = 0; i < n % 16 + 1; ++i) {
+        info.temperatures.emplace_back("T" + std::to_string(n), static_cast<double>(n + i));
+    }
+    return info;
+}
+
+// 历史样本的字段同样由 n 推导：usedMemory = 3n, availableMemory = 5n
+bool IsConsistentSample(const HistorySample& h) {
+    const uint64_t n = h.usedMemory / 3;
+    return h.usedMemory == n * 3 && h.availableMemory == n * 5 &&
+        h.cpuTemperature == static_cast<double>(n % 97) && h.adapterCount == n % 4 + 1 &&
+        h.diskCount == std::min<uint64_t>(n % 20 + 1, 8) && h.adapterSpeed[0] == n * 10;
+}
+
+bool WideEquals(const wchar_t* s, const std::wstring& expected) {
+    return std::wcscmp(s, expected.c_str()) == 0;
+}
+
+// 返回 true 表示副本与某一次完整写入一致
+bool IsConsistent(const SharedMemoryBlock& b) {
+    const uint64_t n = b.totalMemory;
+    if (n == 0) return true; // 写端尚未写入
+    const std::wstring ns = std::to_wstring(n);
+    if (b.usedMemory != n * 3 || b.availableMemory != n * 5) return false;
+    if (b.cpuUsage != static_cast<double>(n % 1000) / 10.0) return false;
+    if (b.cpuTemperature != static_cast<double>(n % 97) || b.gpuTemperature != static_cast<double>(n % 89)) return false;
+    if (!WideEquals(b.cpuName, L"CPU-" + ns)) return false;
+    if (b.gpuCount != 1 || !WideEquals(b.gpus[0].name, L"GPU-" + ns) || b.gpus[0].memory != n * 7) return false;
+    if (b.adapterCount != static_cast<int>(n % 4 + 1)) return false;
+    for (int i = 0; i < b.adapterCount; ++i) {
+        if (b.adapters[i].speed != n * 10 + i) return false;
+        if (!WideEquals(b.adapters[i].name, L"eth-" + ns + L"-" + std::to_wstring(i))) return false;
+    }
+    if (b.diskCount != static_cast<int>(std::min<uint64_t>(n % 20 + 1, 8))) return false;
+    for (int i = 0; i < b.diskCount; ++i) {
+        const auto& d = b.disks[i];
+        if (d.totalSize != n + i || d.usedSpace != n * 2 + i || d.freeSpace != n * 4 + i) return false;
+        if (!WideEquals(d.label, L"D" + ns)) return false;
+    }
+    if (b.physicalDiskCount != static_cast<int>(n % 8 + 1)) return false;
+    for (int i = 0; i < b.physicalDiskCount; ++i) {
+        const auto& pd = b.physicalDisks[i];
+        if (pd.capacity != n + i || !WideEquals(pd.model, L"MODEL-" + ns)) return false;
+        if (pd.attributeCount != static_cast<int>(n % 32 + 1)) return false;
+        for (int a = 0; a < pd.attributeCount; ++a) {
+            if (pd.attributes[a].rawValue != n * 100 + a) return false;
+            if (pd.attributes[a].catalogIndex != SmartCatalog::IndexOf(static_cast<uint8_t>(a + 1))) return false;
+        }
+    }
+    if (b.tempCount != static_cast<int>(std::min<uint64_t>(n % 16 + 1, 10))) return false;
+    for (int i = 0; i < b.tempCount; ++i) {
+        if (b.temperatures[i].temperature != static_cast<double>(n + i)) return false;
+        if (!WideEquals(b.temperatures[i].sensorName, L"T" + ns)) return false;
+    }
+    return true;
+}
+
+// 变长段副本：在 seqlock 读取中经段表复制的完整逻辑磁盘 / 温度列表
+struct VariableCopy {
+    std::vector<SharedMemoryBlock::SharedDiskData> disks;
+    std::vector<TemperatureData> temperatures;
+};
+
+template <typename T>
+void CopySection(const char* base, size_t mappedSize, const SharedMemorySectionEntry& e, std::vector<T>& out) {
+    out.clear();
+    // 写端可能正在重新排布：段表内容不可信时直接放弃，seqlock 校验会让本次读取重试
+    if (e.elementSize != sizeof(T) || e.count > e.capacity || e.offset + static_cast<uint64_t>(e.capacity) * sizeof(T) > mappedSize) return;
+    out.resize(e.count);
+    if (e.count) std::memcpy(static_cast<void*>(out.data()), base + e.offset, e.count * sizeof(T));
+}
+
+void CopyVariableSections(const SharedMemoryLayout* layout, size_t mappedSize, VariableCopy& out) {
+    const char* base = reinterpret_cast<const char*>(layout);
+    const uint32_t count = std::min<uint32_t>(layout->header.sectionTableCount, SHM_MAX_SECTION_ENTRIES);
+    for (uint32_t i = 0; i < count; ++i) {
+        const SharedMemorySectionEntry e = layout->sectionTable[i];
+        if (e.id == SHM_SEC_DISKS) CopySection(base, mappedSize, e, out.disks);
+        else if (e.id == SHM_SEC_TEMPERATURES) CopySection(base, mappedSize, e, out.temperatures);
+    }
+}
+
+bool IsConsistentVariable(uint64_t n, const VariableCopy& v) {
+    if (n == 0) return true;
+    const std::wstring ns = std::to_wstring(n);
+    if (v.disks.size() != n % 20 + 1 || v.temperatures.size() != n % 16 + 1) return false;
+    for (size_t i = 0; i < v.disks.size(); ++i) {
+        const auto& d = v.disks[i];
+        if (d.totalSize != n + i || d.usedSpace != n * 2 + i || !WideEquals(d.label, L"D" + ns)) return false;
+    }
+    for (size_t i = 0; i < v.temperatures.size(); ++i) {
+        if (v.temperatures[i].temperature != static_cast<double>(n + i)) return false;
+        if (!WideEquals(v.temperatures[i].sensorName, L"T" + ns)) return false;
+    }
+    return true;
+}
+
+int RunReader(SharedStats* stats, int index, int readHz) {
+    SharedMemoryBackend shm;
+    // 钉住快照需要写 readers 计数，因此以读写方式映射
+    while (!shm.Open(0, false)) {
+        if (stats->stop.load()) return 1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto* layout = static_cast<SharedMemoryLayout*>(shm.Data());
+    auto local = std::make_unique<SharedMemoryBlock>();
+    std::vector<HistorySample> history(512);
+    VariableCopy variable;
+    ReaderStats& rs = stats->readers[index];
+    const auto period = readHz > 0 ? std::chrono::nanoseconds(1000000000LL / readHz) : std::chrono::nanoseconds(0);
+    auto next = std::chrono::steady_clock::now();
+
+    while (!stats->stop.load(std::memory_order_relaxed)) {
+        if (readHz > 0) {
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        bool ok = SeqLock::Read(layout->header.sequence,
+            [&] {
+                std::memcpy(static_cast<void*>(local.get()), &layout->block, sizeof(SharedMemoryBlock));
+                CopyVariableSections(layout, shm.Size(), variable);
+            },
+            SeqLock::kDefaultReadAttempts, &rs.retries);
+        if (!ok) { ++rs.failed; continue; }
+        rs.seqlockLatency.Add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count()));
+        ++rs.reads;
+        if (!IsConsistent(*local) || !IsConsistentVariable(local->totalMemory, variable)) ++rs.torn;
+
+        // 对照组：每 16 次做一次不加保护的复制，证明校验逻辑确实能发现撕裂。
+        // 整块 memcpy 只要几微秒，很少恰好与写入重叠；这里分前后两半复制，
+        // 中间等写端完成至少一整轮写入（最多 50ms），让副本必然跨越一次写入
+        if ((rs.reads & 15) == 0) {
+            const auto* src = reinterpret_cast<const char*>(&layout->block);
+            auto* dst = reinterpret_cast<char*>(local.get());
+            const size_t half = sizeof(SharedMemoryBlock) / 2;
+            const uint64_t before = layout->header.sequence.load(std::memory_order_acquire);
+            std::memcpy(dst, src, half);
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+            while (layout->header.sequence.load(std::memory_order_acquire) - before < 2 + (before & 1) &&
+                   std::chrono::steady_clock::now() < deadline && !stats->stop.load(std::memory_order_relaxed)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(20));
+            }
+            std::memcpy(dst + half, src + half, sizeof(SharedMemoryBlock) - half);
+            ++rs.unprotectedReads;
+            if (!IsConsistent(*local)) ++rs.unprotectedTorn;
+        }
+
+        // 慢读者：每 8 次钉住一个快照，分段复制并在段间让出 CPU，让写端有机会完成多轮发布
+        if ((rs.reads & 7) == 0) {
+            const auto p0 = std::chrono::steady_clock::now();
+            uint64_t epoch = 0;
+            const int slot = SnapshotSlots::Pin(*layout, &epoch);
+            if (slot < 0) {
+                // 写端尚未发布第一份快照时不计为失败
+                if (SnapshotSlots::EpochOf(layout->header.publishedSnapshot.load()) != 0) ++rs.pinFailed;
+                continue;
+            }
+            const auto* src = reinterpret_cast<const char*>(&layout->snapshots[slot].block);
+            auto* dst = reinterpret_cast<char*>(local.get());
+            const size_t chunk = sizeof(SharedMemoryBlock) / 8 + 1;
+            for (size_t off = 0; off < sizeof(SharedMemoryBlock); off += chunk) {
+                std::memcpy(dst + off, src + off, std::min(chunk, sizeof(SharedMemoryBlock) - off));
+                std::this_thread::yield();
+            }
+            // 钉住期间槽的纪元不应改变，内容必须来自同一次写入
+            const bool stable = layout->snapshots[slot].epoch.load() == epoch;
+            SnapshotSlots::Unpin(*layout, slot);
+            rs.snapshotLatency.Add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - p0).count()));
+            ++rs.snapshotReads;
+            if (!stable || !IsConsistent(*local)) ++rs.snapshotTorn;
+        }
+
+        if ((rs.reads & 7) == 4) {
+            const size_t count = HistoryRing::ReadLatest(layout->history, history.data(), history.size());
+            ++rs.historyReads;
+            rs.historySamples += count;
+            for (size_t i = 0; i < count; ++i) {
+                if (!IsConsistentSample(history[i]) ||
+                    (i > 0 && history[i].usedMemory != history[i - 1].usedMemory + 3)) {
+                    ++rs.historyTorn;
+                    break;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+void RunWriter(SharedStats* stats, int seconds, int writeHz) {
+    using Clock = std::chrono::steady_clock;
+    const auto end = Clock::now() + std::chrono::seconds(seconds);
+    const auto period = writeHz > 0 ? std::chrono::nanoseconds(1000000000LL / writeHz) : std::chrono::nanoseconds(0);
+    auto next = Clock::now();
+    uint64_t n = 0;
+    while (Clock::now() < end) {
+        SystemInfo info = MakeSystemInfo(++n);
+        auto t0 = Clock::now();
+        SharedMemoryManager::WriteToSharedMemory(info);
+        stats->writeLatency.Add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count()));
+        stats->bytesTotal += SharedMemoryManager::GetLastWriteBytes();
+        if (writeHz > 0) {
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int readers = argc > 1 ? std::atoi(argv[1]) : 8;
+    const int seconds = argc > 2 ? std::atoi(argv[2]) : 10;
+    const int writeHz = argc > 3 ? std::atoi(argv[3]) : 0;
+    const int readHz = argc > 4 ? std::atoi(argv[4]) : 0;
+    if (readers < 1 || readers > 256 || seconds < 1 || writeHz < 0 || readHz < 0) {
+        std::fprintf(stderr, "用法: %s [读进程数 1-256] [秒数] [写频率Hz] [读取频率Hz]\n", argv[0]);
+        return 2;
+    }
+
+    Logger::EnableConsoleOutput(false);
+    Logger::Initialize("seqlock_stress.log");
+    Logger::SetLogLevel(LOG_ERROR);
+
+    SharedMemoryBackend::Unlink();
+    if (!SharedMemoryManager::InitSharedMemory()) {
+        std::fprintf(stderr, "共享内存初始化失败: %s\n", SharedMemoryManager::GetLastError().c_str());
+        return 1;
+    }
+
+    auto* stats = static_cast<SharedStats*>(mmap(nullptr, sizeof(SharedStats), PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    if (stats == MAP_FAILED) { std::perror("mmap"); return 1; }
+    std::memset(static_cast<void*>(stats), 0, sizeof(SharedStats));
+
+    std::vector<pid_t> children;
+    for (int i = 0; i < readers; ++i) {
+        pid_t pid = fork();
+        if (pid == 0) _exit(RunReader(stats, i, readHz));
+        if (pid > 0) children.push_back(pid);
+    }
+
+    RunWriter(stats, seconds, writeHz);
+    stats->stop.store(true);
+    for (pid_t pid : children) waitpid(pid, nullptr, 0);
+
+    ReaderStats total{};
+    for (int i = 0; i < readers; ++i) {
+        const auto& r = stats->readers[i];
+        total.reads += r.reads; total.retries += r.retries; total.failed += r.failed;
+        total.torn += r.torn; total.unprotectedReads += r.unprotectedReads; total.unprotectedTorn += r.unprotectedTorn;
+        total.snapshotReads += r.snapshotReads; total.snapshotTorn += r.snapshotTorn; total.pinFailed += r.pinFailed;
+        total.historyReads += r.historyReads; total.historySamples += r.historySamples; total.historyTorn += r.historyTorn;
+        total.seqlockLatency.Merge(r.seqlockLatency); total.snapshotLatency.Merge(r.snapshotLatency);
+    }
+    const LatencyHistogram& w = stats->writeLatency;
+    const double bytesPerCycle = w.count ? static_cast<double>(stats->bytesTotal) / w.count : 0.0;
+    const uint64_t checked = total.reads + total.snapshotReads + total.historyReads;
+    const uint64_t tornTotal = total.torn + total.snapshotTorn + total.historyTorn;
+    std::printf("block=%zu bytes, readers=%d, seconds=%d, writeHz=%d, readHz=%d\n",
+        sizeof(SharedMemoryBlock), readers, seconds, writeHz, readHz);
+    std::printf("writes=%llu  write avg=%.1f us  p50<=%.1f us  p99<=%.1f us  max=%.1f us  bytes/cycle=%.0f\n",
+        static_cast<unsigned long long>(w.count), w.AvgNs() / 1000.0, w.Percentile(0.50) / 1000.0,
+        w.Percentile(0.99) / 1000.0, w.maxNs / 1000.0, bytesPerCycle);
+    std::printf("seqlock reads=%llu  retries=%llu  failed=%llu  torn=%llu  avg=%.0f ns  p50<=%llu ns  p99<=%llu ns\n",
+        static_cast<unsigned long long>(total.reads), static_cast<unsigned long long>(total.retries),
+        static_cast<unsigned long long>(total.failed), static_cast<unsigned long long>(total.torn),
+        total.seqlockLatency.AvgNs(), static_cast<unsigned long long>(total.seqlockLatency.Percentile(0.50)),
+        static_cast<unsigned long long>(total.seqlockLatency.Percentile(0.99)));
+    std::printf("unprotected reads=%llu  unprotected torn=%llu (对照组)\n",
+        static_cast<unsigned long long>(total.unprotectedReads), static_cast<unsigned long long>(total.unprotectedTorn));
+
+    std::printf("snapshot reads=%llu  snapshot torn=%llu  pin failed=%llu  avg=%.1f us  p99<=%.1f us\n",
+        static_cast<unsigned long long>(total.snapshotReads), static_cast<unsigned long long>(total.snapshotTorn),
+        static_cast<unsigned long long>(total.pinFailed), total.snapshotLatency.AvgNs() / 1000.0,
+        total.snapshotLatency.Percentile(0.99) / 1000.0);
+
+    const SharedMemoryHeader* header = SharedMemoryManager::GetHeader();
+    std::printf("layout v%u totalSize=%llu bytes\n", header->layoutVersion,
+        static_cast<unsigned long long>(header->totalSize.load()));
+    std::printf("history reads=%llu  samples=%llu  history torn=%llu\n",
+        static_cast<unsigned long long>(total.historyReads), static_cast<unsigned long long>(total.historySamples),
+        static_cast<unsigned long long>(total.historyTorn));
+    // 机器可读汇总（单位：纳秒 / 字节）
+    std::printf("RESULT readers=%d writeHz=%d readHz=%d writes=%llu write_p50_ns=%llu write_p99_ns=%llu write_max_ns=%llu "
+                "bytes_per_cycle=%.0f read_p50_ns=%llu read_p99_ns=%llu snapshot_p99_ns=%llu reads=%llu torn=%llu torn_rate=%.3g\n",
+        readers, writeHz, readHz, static_cast<unsigned long long>(w.count),
+        static_cast<unsigned long long>(w.Percentile(0.50)), static_cast<unsigned long long>(w.Percentile(0.99)),
+        static_cast<unsigned long long>(w.maxNs), bytesPerCycle,
+        static_cast<unsigned long long>(total.seqlockLatency.Percentile(0.50)),
+        static_cast<unsigned long long>(total.seqlockLatency.Percentile(0.99)),
+        static_cast<unsigned long long>(total.snapshotLatency.Percentile(0.99)),
+        static_cast<unsigned long long>(checked), static_cast<unsigned long long>(tornTotal),
+        checked ? static_cast<double>(tornTotal) / checked : 0.0);
+
+    // 对照组一次撕裂都没发现，说明校验逻辑或对照组本身失效，上面的 torn=0 也就不可信
+    const bool controlBlind = total.unprotectedReads > 0 && total.unprotectedTorn == 0;
+    if (controlBlind) std::printf("对照组未检测到撕裂，校验失效\n");
+
+    SharedMemoryManager::CleanupSharedMemory();
+    SharedMemoryBackend::Unlink();
+    return tornTotal == 0 && !controlBlind ? 0 : 1;
+}
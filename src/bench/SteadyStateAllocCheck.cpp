@@ -0,0 +1,272 @@
+// SteadyStateAllocCheck.cpp
+// 稳态分配检查：按主循环的结构运行一轮轮采集与发布（CollectorScheduler::RunCycle、AdaptiveSampler、
+// 采集器状态表、OverheadMonitor、WriteToSharedMemory），预热之后任何一轮在主线程或本轮等待的数据源上
+// 有堆分配即判定失败（退出码 1）。与 --check-allocations 相同，调用过日志（含被等级过滤的）或合并了后台源的轮次不计入稳态。
+// 等待的数据源读取 /proc/stat 与 /proc/meminfo（pread 到栈上缓冲区），温度数据源原地改写传感器名称；
+// 另有一个每次都重新构造磁盘列表的后台源与一个派发时经 prepare 复制磁盘列表的后台源（同物理磁盘数据源），
+// 验证后台源的分配既不混入主线程的统计，也不会被误判为稳态分配。
+// --inject 让温度数据源每轮构造一个临时字符串，用于确认检查本身能发现分配
+//
+// 构建:
+//   g++ -std=c++17 -O2 -pthread -Isrc/core -o alloc_check src/bench/SteadyStateAllocCheck.cpp
+//       src/core/collector/CollectorScheduler.cpp src/core/collector/AdaptiveSampler.cpp src/core/collector/OverheadMonitor.cpp
+//       src/core/Utils/AllocationCounter.cpp src/core/DataStruct/SharedMemoryManager.cpp src/core/DataStruct/SharedMemoryBackend.cpp
+//       src/core/DataStruct/PublishNotifier.cpp src/core/DataStruct/WriterLease.cpp src/core/DataStruct/SectionOwnership.cpp
+//       src/core/disk/SmartCatalog.cpp src/core/Utils/Logger.cpp -lrt
+// 运行:
+//   ./alloc_check [轮数=300] [周期ms=10] [--inject]
+#ifdef _WIN32
+#error "SteadyStateAllocCheck 仅用于 Linux（依赖 POSIX 共享内存后端与 /proc）"
+#endif
+
+#include "DataStruct/DataStruct.h"
+#include "DataStruct/SharedMemoryBackend.h"
+#include "DataStruct/SharedMemoryManager.h"
+#include "Utils/AllocationCounter.h"
+#include "Utils/Logger.h"
+#include "collector/AdaptiveSampler.h"
+#include "collector/CollectorScheduler.h"
+#include "collector/OverheadMonitor.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+// 以 pread 重复读取的 /proc 文件：打开一次，内容读到定长缓冲区
+class ProcFile {
+public:
+    explicit ProcFile(const char* path) : fd(open(path, O_RDONLY | O_CLOEXEC)) {}
+    ~ProcFile() { if (fd >= 0) close(fd); }
+    ProcFile(const ProcFile&) = delete;
+    ProcFile& operator=(const ProcFile&) = delete;
+
+    const char* Read() {
+        size_t length = 0;
+        while (fd >= 0 && length < sizeof(buffer) - 1) {
+            const ssize_t n = pread(fd, buffer + length, sizeof(buffer) - 1 - length, static_cast<off_t>(length));
+            if (n <= 0) break;
+            length += static_cast<size_t>(n);
+        }
+        buffer[length] = '\0';
+        return buffer;
+    }
+
+private:
+    int fd;
+    char buffer[8192];
+};
+
+uint64_t FieldAfter(const char* text, const char* key) {
+    const char* pos = strstr(text, key);
+    return pos ? strtoull(pos + strlen(key), nullptr, 10) : 0;
+}
+
+struct LoadSource {
+    ProcFile stat{ "/proc/stat" };
+    uint64_t lastBusy = 0;
+    uint64_t lastTotal = 0;
+
+    void Sample(SystemInfo& info) {
+        // 首行: cpu user nice system idle iowait irq softirq steal
+        const char* text = stat.Read();
+        char* cursor = const_cast<char*>(text) + 3;
+        uint64_t values[8] = {};
+        for (uint64_t& value : values) value = strtoull(cursor, &cursor, 10);
+        uint64_t total = 0;
+        for (uint64_t value : values) total += value;
+        const uint64_t busy = total - values[3] - values[4];
+        if (lastTotal > 0 && total > lastTotal) {
+            info.cpuUsage = 100.0 * static_cast<double>(busy - lastBusy) / static_cast<double>(total - lastTotal);
+        }
+        lastBusy = busy;
+        lastTotal = total;
+        info.performanceCoreFreq = 3000.0 + static_cast<double>(total % 100);
+    }
+};
+
+struct MemorySource {
+    ProcFile meminfo{ "/proc/meminfo" };
+
+    void Sample(SystemInfo& info) {
+        const char* text = meminfo.Read();
+        info.totalMemory = FieldAfter(text, "MemTotal:") * 1024;
+        info.availableMemory = FieldAfter(text, "MemAvailable:") * 1024;
+        info.usedMemory = info.totalMemory > info.availableMemory ? info.totalMemory - info.availableMemory : 0;
+    }
+};
+
+// 模拟 SensorCollector：名称在暂存区中原地改写，读数每轮变化
+struct SensorSource {
+    bool inject = false;
+    uint64_t runs = 0;
+
+    void Sample(SystemInfo& info) {
+        static const char* const names[] = { "CPU Package", "Core Max", "Core Average", "GPU Core", "GPU Hot Spot", "Motherboard" };
+        const size_t count = sizeof(names) / sizeof(names[0]);
+        info.temperatures.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            info.temperatures[i].first.assign(names[i]);
+            info.temperatures[i].second = 40.0 + static_cast<double>((runs + i) % 30);
+        }
+        info.cpuTemperature = info.temperatures[0].second;
+        info.gpuTemperature = info.temperatures[3].second;
+        if (inject) {
+            const std::string scratch = "injected allocation for self-test #" + std::to_string(runs);
+            info.gpuTemperature += static_cast<double>(scratch.size() % 2);
+        }
+        ++runs;
+    }
+};
+
+// 清单类后台源：每次都重新构造列表（合并时分配，不属于稳态）
+void SampleInventory(SystemInfo& info) {
+    info.disks.clear();
+    for (int i = 0; i < 4; ++i) {
+        DiskData disk;
+        disk.letter = static_cast<char>('C' + i);
+        disk.label = "Volume label that does not fit SSO #" + std::to_string(i);
+        disk.fileSystem = "NTFS";
+        disk.totalSize = 1ULL << 40;
+        disk.usedSpace = 1ULL << 39;
+        disk.freeSpace = disk.totalSize - disk.usedSpace;
+        info.disks.push_back(disk);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int cycles = 300;
+    int periodMs = 10;
+    bool inject = false;
+    int positional = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--inject") == 0) inject = true;
+        else if (positional++ == 0) cycles = std::atoi(argv[i]);
+        else periodMs = std::atoi(argv[i]);
+    }
+    if (cycles < 1 || periodMs < 1) {
+        std::fprintf(stderr, "用法: %s [轮数] [周期ms] [--inject]\n", argv[0]);
+        return 2;
+    }
+    const int warmupCycles = 20;
+
+    Logger::EnableConsoleOutput(false);
+    Logger::Initialize("alloc_check.log");
+    Logger::SetLogLevel(LOG_WARNING);
+
+    SharedMemoryBackend::Unlink();
+    if (!SharedMemoryManager::InitSharedMemory()) {
+        std::fprintf(stderr, "共享内存初始化失败: %s\n", SharedMemoryManager::GetLastError().c_str());
+        return 1;
+    }
+
+    LoadSource load;
+    MemorySource memory;
+    SensorSource sensors;
+    sensors.inject = inject;
+
+    const std::chrono::milliseconds period(periodMs);
+    CollectorScheduler scheduler(3, std::chrono::milliseconds(200));
+    CollectorScheduler::Options options;
+    options.period = period;
+    options.wait = true;
+    options.priority = 0;
+    options.sections = (1u << SHM_SECTION_CPU) | (1u << SHM_SECTION_LOAD);
+    scheduler.Add("load", options, [&](SystemInfo& info, const CollectorScheduler::RunInfo&) { load.Sample(info); },
+        [](SystemInfo& dst, const SystemInfo& src) {
+            dst.cpuUsage = src.cpuUsage;
+            dst.performanceCoreFreq = src.performanceCoreFreq;
+        });
+    options.priority = 1;
+    options.sections = 1u << SHM_SECTION_LOAD;
+    scheduler.Add("memory", options, [&](SystemInfo& info, const CollectorScheduler::RunInfo&) { memory.Sample(info); },
+        [](SystemInfo& dst, const SystemInfo& src) {
+            dst.totalMemory = src.totalMemory;
+            dst.usedMemory = src.usedMemory;
+            dst.availableMemory = src.availableMemory;
+        });
+    options.priority = 2;
+    options.sections = (1u << SHM_SECTION_TEMPERATURES) | (1u << SHM_SECTION_SENSORS);
+    options.minPeriod = period;
+    options.maxPeriod = period * 4;
+    scheduler.Add("sensors", options, [&](SystemInfo& info, const CollectorScheduler::RunInfo&) { sensors.Sample(info); },
+        [](SystemInfo& dst, const SystemInfo& src) {
+            dst.temperatures = src.temperatures;
+            dst.cpuTemperature = src.cpuTemperature;
+            dst.gpuTemperature = src.gpuTemperature;
+        });
+    CollectorScheduler::Options background;
+    background.period = period * 20;
+    background.priority = 5;
+    background.sections = 1u << SHM_SECTION_DISKS;
+    scheduler.Add("inventory", background, [](SystemInfo& info, const CollectorScheduler::RunInfo&) { SampleInventory(info); },
+        [](SystemInfo& dst, const SystemInfo& src) { dst.disks = src.disks; });
+    background.period = period * 15;
+    background.priority = 6;
+    background.sections = 1u << SHM_SECTION_SMART;
+    scheduler.Add("smart", background,
+        [](SystemInfo& info, const CollectorScheduler::RunInfo&) { info.physicalDisks.resize(info.disks.size()); },
+        [](SystemInfo& dst, const SystemInfo& src) { dst.physicalDisks = src.physicalDisks; },
+        [](SystemInfo& scratch, const SystemInfo& current) { scratch.disks = current.disks; });
+
+    SystemInfo info{};
+    info.cpuName = "Simulated CPU with a name longer than the small string buffer";
+    info.osVersion = "Linux";
+    AdaptiveSampler sampler{ AdaptiveSampler::Config() };
+    OverheadMonitor overhead;
+    SharedCollectorStatus collectorStatus[SHM_MAX_COLLECTORS];
+
+    int steady = 0;
+    int allocating = 0;
+    uint64_t worst = 0;
+    for (int n = 1; n <= cycles; ++n) {
+        const uint64_t logsBefore = Logger::CallCount();
+        const uint64_t allocationsBefore = AllocationCounter::ThreadCount();
+        overhead.BeginCycle();
+        scheduler.RunCycle(info);
+        const AdaptiveSampler::Decision decision =
+            sampler.Update(info, info.cpuUsage, SharedMemoryManager::IsReaderAttached(std::chrono::seconds(3)), CollectorScheduler::Clock::now());
+        scheduler.SetRateScale(decision.rateScale);
+        scheduler.SetShedding(decision.shed);
+        const int count = scheduler.ExportStatus(collectorStatus, SHM_MAX_COLLECTORS);
+        SharedMemoryManager::SetCollectorStatus(collectorStatus, count);
+        SharedMemoryManager::SetSelfOverhead(overhead.Snapshot());
+        SharedMemoryManager::WriteToSharedMemory(info);
+        overhead.EndCycle();
+
+        const CollectorScheduler::CycleStats cycle = scheduler.LastCycle();
+        const uint64_t allocations =
+            AllocationCounter::ThreadCount() - allocationsBefore - cycle.backgroundAllocations + cycle.allocations;
+        const bool isSteady = n > warmupCycles && !cycle.mergedBackground && Logger::CallCount() == logsBefore;
+        if (isSteady) {
+            ++steady;
+            if (allocations > 0) {
+                ++allocating;
+                if (allocations > worst) worst = allocations;
+                if (allocating <= 5) {
+                    std::printf("第 %d 轮分配 %llu 次（等待的数据源 %llu 次）\n", n, static_cast<unsigned long long>(allocations),
+                                static_cast<unsigned long long>(cycle.allocations));
+                }
+            }
+        }
+        std::this_thread::sleep_until((std::max)(scheduler.NextDue(), CollectorScheduler::Clock::now()));
+    }
+    scheduler.Stop();
+
+    std::printf("RESULT alloc_check cycles=%d steady=%d allocating=%d worst=%llu total_allocations=%llu inject=%d\n", cycles, steady,
+                allocating, static_cast<unsigned long long>(worst), static_cast<unsigned long long>(AllocationCounter::Count()),
+                inject ? 1 : 0);
+    std::printf("%s\n", steady == 0 ? "没有稳态轮次，检查无效" : allocating == 0 ? "稳态无分配: 通过" : "稳态有分配: 失败");
+
+    SharedMemoryManager::CleanupSharedMemory();
+    SharedMemoryBackend::Unlink();
+    return steady > 0 && allocating == 0 ? 0 : 1;
+}
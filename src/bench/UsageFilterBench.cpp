@@ -0,0 +1,114 @@
+// UsageFilterBench.cpp
+// 验证占用率平滑与采样周期无关：对 0 -> 100% 的阶跃输入分别以 250ms / 1000ms / 4000ms 周期采样，
+// 比较旧的固定权重 EMA（0.8 * 旧值 + 0.2 * 新值）与按实际间隔折算权重的各平滑级达到 63% 所需的时间；
+// 另以抖动的周期（自适应采样）测量一段 2 秒的 100% 尖峰在窗口最大值 / 百分位下是否被保留
+//
+// 构建:
+//   g++ -std=c++17 -O2 -Isrc/core -o filter_bench src/bench/UsageFilterBench.cpp src/core/cpu/UsageFilter.cpp
+// 运行:
+//   ./filter_bench
+// 时间常数 EMA 在各周期下的 63% 时间与时间常数之差超过一个周期，或尖峰被窗口最大值漏掉时以非零状态退出
+
+#include "cpu/UsageFilter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+namespace {
+
+constexpr double kTimeConstantMs = 4480.0;
+
+// 旧实现：与采样周期无关的固定权重
+class FixedWeightEma : public UsageFilter {
+public:
+    double Update(double value, double) override {
+        state = state > 0.0 ? state * 0.8 + value * 0.2 : value;
+        return state;
+    }
+    void Reset() override { state = 0.0; }
+
+private:
+    double state = 0.0;
+};
+
+// 先以 0% 稳定 30 秒，再输入 100%；返回输出首次达到 63.2% 的时间（相对阶跃，毫秒）
+double StepRiseMs(UsageFilter& filter, double periodMs) {
+    filter.Reset();
+    double t = 0.0;
+    // 第一个采样为 0 之上的极小值：旧实现把 0 当作"未初始化"
+    for (; t < 30000.0; t += periodMs) filter.Update(t == 0.0 ? 1e-9 : 0.0, periodMs);
+    for (double elapsed = periodMs; elapsed < 120000.0; elapsed += periodMs) {
+        if (filter.Update(100.0, periodMs) >= 63.2) return elapsed;
+    }
+    return -1.0;
+}
+
+// 周期在 250ms 与 1750ms 之间交替；第 10 秒起的 2 秒为 100%，其余为 10%。返回尖峰之后 1 秒内输出的最大值
+double SpikeResponse(UsageFilter& filter) {
+    filter.Reset();
+    double t = 0.0, peak = 0.0;
+    for (int n = 0; t < 20000.0; ++n) {
+        const double dt = n % 2 ? 1750.0 : 250.0;
+        t += dt;
+        // 采样值是 [t - dt, t] 内的平均占用率
+        const double overlap = std::fmax(0.0, std::fmin(t, 12000.0) - std::fmax(t - dt, 10000.0));
+        const double value = 10.0 + 90.0 * overlap / dt;
+        const double out = filter.Update(value, dt);
+        if (t >= 10000.0 && t <= 13000.0) peak = std::fmax(peak, out);
+    }
+    return peak;
+}
+
+} // namespace
+
+int main() {
+    const double periods[] = { 250.0, 1000.0, 4000.0 };
+    int status = 0;
+
+    struct Case {
+        const char* spec;
+        std::unique_ptr<UsageFilter> filter;
+    };
+    Case cases[] = {
+        { "fixed 0.8/0.2", std::make_unique<FixedWeightEma>() },
+        { "ema:4480", nullptr },
+        { "mean:4480", nullptr },
+        { "max:4480", nullptr },
+        { "p90:4480", nullptr },
+        { "raw", nullptr },
+    };
+    for (Case& c : cases) {
+        if (c.filter) continue;
+        UsageFilterConfig config;
+        if (!UsageFilterConfig::Parse(c.spec, config)) {
+            std::fprintf(stderr, "无法解析 %s\n", c.spec);
+            return 2;
+        }
+        c.filter = UsageFilter::Create(config);
+    }
+
+    std::printf("阶跃 0 -> 100%%，达到 63.2%% 的时间（ms）\n%-14s", "filter");
+    for (double period : periods) std::printf("  period=%-6.0f", period);
+    std::printf("\n");
+    for (Case& c : cases) {
+        std::printf("%-14s", c.spec);
+        for (double period : periods) {
+            const double rise = StepRiseMs(*c.filter, period);
+            std::printf("  %-13.0f", rise);
+            if (std::string(c.spec) == "ema:4480" && std::fabs(rise - kTimeConstantMs) > period) status = 1;
+        }
+        std::printf("\n");
+    }
+
+    std::printf("2 秒 100%% 尖峰（基线 10%%，周期 250/1750ms 交替）的最大输出\n");
+    for (Case& c : cases) {
+        const double peak = SpikeResponse(*c.filter);
+        std::printf("%-14s  %.1f%%\n", c.spec, peak);
+        if (std::string(c.spec) == "max:4480" && peak < 99.0) status = 1;
+    }
+    std::printf("RESULT filter_bench status=%d\n", status);
+    return status;
+}
@@ -0,0 +1,71 @@
+#!/bin/sh
+# run_benchmarks.sh
+# 构建并运行 src/bench 下的全部 IPC 基准（Linux，g++），用于对比改动前后的共享内存路径性能；
+# 最后运行稳态分配检查；任一基准或检查以非零状态退出（撕裂、对照组未检测到撕裂、稳态轮次有堆分配等）时，
+# 其余项照常运行，脚本最后以非零状态退出
+# 用法（在仓库根目录）:
+#   sh src/bench/run_benchmarks.sh [输出目录=_bench] [读进程数=8] [秒数=5] [写频率Hz=100] [读取频率Hz=0]
+# 各基准的完整输出写入 <输出目录>/*.txt；SeqLockStress 的 RESULT 行汇总到 <输出目录>/results.txt
+set -e
+
+OUT=${1:-_bench}
+READERS=${2:-8}
+SECONDS_PER_RUN=${3:-5}
+WRITE_HZ=${4:-100}
+READ_HZ=${5:-0}
+
+CXX=${CXX:-g++}
+CXXFLAGS="-std=c++17 -O2 -pthread -Isrc/core"
+CORE="src/core/DataStruct/SharedMemoryManager.cpp src/core/DataStruct/SharedMemoryBackend.cpp
+      src/core/DataStruct/PublishNotifier.cpp src/core/DataStruct/WriterLease.cpp src/core/DataStruct/SectionOwnership.cpp
+      src/core/disk/SmartCatalog.cpp src/core/Utils/Logger.cpp"
+
+mkdir -p "$OUT"
+$CXX $CXXFLAGS -o "$OUT/seqlock_stress" src/bench/SeqLockStress.cpp $CORE -lrt
+$CXX $CXXFLAGS -o "$OUT/dirty_bench" src/bench/DirtyTrackingBench.cpp $CORE -lrt
+$CXX $CXXFLAGS -o "$OUT/notify_bench" src/bench/NotifyLatencyBench.cpp $CORE -lrt
+$CXX $CXXFLAGS -o "$OUT/reader_bench" src/bench/ReaderBench.cpp src/core/DataStruct/SharedMemoryReader.cpp $CORE -lrt
+# 协程采集需要 C++20
+$CXX -std=c++20 -O2 -pthread -Isrc/core -o "$OUT/async_bench" src/bench/AsyncCollectBench.cpp \
+     src/core/collector/AsyncExecutor.cpp src/core/collector/LinuxCollectors.cpp src/core/cpu/CoreUsage.cpp src/core/cpu/UsageFilter.cpp \
+     src/core/Utils/Logger.cpp
+# GCC 在 -O2 下不向量化逐处理器求差的循环
+$CXX -std=c++17 -O3 -pthread -Isrc/core -o "$OUT/core_bench" src/bench/CoreUsageBench.cpp src/core/cpu/CoreUsage.cpp \
+     src/core/DataStruct/SharedMemoryReader.cpp $CORE -lrt
+$CXX $CXXFLAGS -o "$OUT/filter_bench" src/bench/UsageFilterBench.cpp src/core/cpu/UsageFilter.cpp
+$CXX $CXXFLAGS -o "$OUT/sampler_check" src/bench/AdaptiveSamplerCheck.cpp src/core/collector/AdaptiveSampler.cpp \
+     src/core/Utils/Logger.cpp
+$CXX $CXXFLAGS -o "$OUT/device_check" src/bench/DeviceChangeCheck.cpp src/core/collector/DeviceChangeMonitor.cpp \
+     src/core/Utils/Logger.cpp
+$CXX $CXXFLAGS -o "$OUT/alloc_check" src/bench/SteadyStateAllocCheck.cpp src/core/collector/CollectorScheduler.cpp \
+     src/core/collector/AdaptiveSampler.cpp src/core/collector/OverheadMonitor.cpp src/core/Utils/AllocationCounter.cpp $CORE -lrt
+
+cd "$OUT"
+# 逐个运行并把输出写入 <名称>.txt；sh 的管道只返回 tee 的状态，因此不用 | tee，而是记下失败的项最后统一退出
+FAILED=""
+run() {
+    name=$1
+    shift
+    status=0
+    "$@" > "$name.txt" || status=$?
+    cat "$name.txt"
+    if [ "$status" -ne 0 ]; then FAILED="$FAILED $name"; fi
+}
+# 不限速写入（最坏情况的撕裂检测）与按给定频率写入（接近真实负载的延迟分布）各跑一次
+run seqlock_unlimited ./seqlock_stress "$READERS" "$SECONDS_PER_RUN" 0 "$READ_HZ"
+run seqlock_rated ./seqlock_stress "$READERS" "$SECONDS_PER_RUN" "$WRITE_HZ" "$READ_HZ"
+run dirty ./dirty_bench
+run notify ./notify_bench 4 "$SECONDS_PER_RUN" 2
+run reader ./reader_bench "$READERS" "$SECONDS_PER_RUN" "$WRITE_HZ"
+run async ./async_bench "$SECONDS_PER_RUN"
+run core ./core_bench
+run filter ./filter_bench
+run sampler ./sampler_check
+run device ./device_check
+run alloc_check ./alloc_check
+grep -h '^RESULT' seqlock_unlimited.txt seqlock_rated.txt > results.txt
+echo "汇总: $OUT/results.txt"
+if [ -n "$FAILED" ]; then
+    echo "失败:$FAILED"
+    exit 1
+fi
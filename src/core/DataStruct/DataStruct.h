@@ -1,6 +1,13 @@
 ﻿// DataStruct.h
 #pragma once
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include "../Utils/PosixCompat.h"
+#endif
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -56,6 +63,54 @@ struct PhysicalDiskSmartData {
     SYSTEMTIME lastScanTime;       // 最后扫描时间
 };
 
+// 共享内存中的 SMART 属性：只保存数值字段，名称 / 描述 / 单位按属性 ID 固定，
+// 由写端在初始化时一次性发布到 SMART 目录（SharedSmartCatalog），这里只记录目录下标
+constexpr uint16_t SHM_SMART_CATALOG_NONE = 0xFFFF;   // 目录中没有该属性 ID
+
+struct SharedSmartAttribute {
+    uint8_t id;                    // 属性ID
+    uint8_t flags;                 // 状态标志
+    uint8_t current;               // 当前值
+    uint8_t worst;                 // 最坏值
+    uint8_t threshold;             // 阈值
+    bool isCritical;               // 是否关键属性
+    uint16_t catalogIndex;         // SMART 目录下标，SHM_SMART_CATALOG_NONE 表示未收录
+    uint64_t rawValue;             // 原始值
+    double physicalValue;          // 物理值（经过转换）
+};
+
+// 共享内存中的物理磁盘：与 PhysicalDiskSmartData 字段一致，属性改为紧凑的 SharedSmartAttribute
+struct SharedPhysicalDiskData {
+    wchar_t model[128];            // 磁盘型号
+    wchar_t serialNumber[64];      // 序列号
+    wchar_t firmwareVersion[32];   // 固件版本
+    wchar_t interfaceType[32];     // 接口类型 (SATA/NVMe/etc)
+    wchar_t diskType[16];          // 磁盘类型 (SSD/HDD)
+    uint64_t capacity;             // 总容量（字节）
+    double temperature;            // 温度
+    uint8_t healthPercentage;      // 健康百分比
+    bool isSystemDisk;             // 是否系统盘
+    bool smartEnabled;             // SMART是否启用
+    bool smartSupported;           // 是否支持SMART
+
+    SharedSmartAttribute attributes[32];
+    int attributeCount;            // 实际属性数量
+
+    uint64_t powerOnHours;         // 通电时间（小时）
+    uint64_t powerCycleCount;      // 开机次数
+    uint64_t reallocatedSectorCount; // 重新分配扇区数
+    uint64_t currentPendingSector; // 当前待处理扇区
+    uint64_t uncorrectableErrors;  // 不可纠正错误
+    double wearLeveling;           // 磨损均衡（SSD）
+    uint64_t totalBytesWritten;    // 总写入字节数
+    uint64_t totalBytesRead;       // 总读取字节数
+
+    char logicalDriveLetters[8];   // 关联的驱动器盘符
+    int logicalDriveCount;         // 关联驱动器数量
+
+    SYSTEMTIME lastScanTime;       // 最后扫描时间
+};
+
 // GPU信息
 struct GPUData {
     wchar_t name[128];    // GPU名称
@@ -90,6 +145,21 @@ struct TemperatureData {
     double temperature;     // 温度（摄氏度）
 };
 
+// 整体 CPU 占用率的平滑方式（见 UsageFilterConfig）：cpuUsage 为平滑后的值，cpuUsageRaw 为两次采样之间的原始值
+enum SharedUsageFilterKind : uint32_t {
+    SHM_FILTER_RAW = 0,
+    SHM_FILTER_EMA = 1,                 // periodMs 为时间常数
+    SHM_FILTER_WINDOW_MEAN = 2,         // periodMs 为窗口长度
+    SHM_FILTER_WINDOW_PERCENTILE = 3,   // periodMs 为窗口长度，percentile 为 100 时即窗口最大值
+};
+
+struct SharedUsageFilter {
+    uint32_t kind;                  // SharedUsageFilterKind
+    float percentile;
+    double periodMs;
+};
+static_assert(sizeof(SharedUsageFilter) == 16, "SharedUsageFilter 必须固定为 16 字节");
+
 // SystemInfo结构
 struct SystemInfo {
     std::string cpuName;
@@ -124,6 +194,11 @@ struct SystemInfo {
     double cpuTemperature; // 新增：CPU温度
     double gpuTemperature; // 新增：GPU温度
     double cpuUsageSampleIntervalMs = 0.0; // 新增：CPU使用率采样间隔（毫秒）
+    double cpuUsageRaw = 0.0;              // 未平滑的 CPU 使用率；cpuUsage 按 cpuUsageFilter 平滑
+    SharedUsageFilter cpuUsageFilter{};
+    // 各逻辑处理器（下标为逻辑处理器编号）的占用率与核心类型（SharedCoreClass），两者等长；属于 LOAD 分区
+    std::vector<float> coreUsage;
+    std::vector<uint8_t> coreClasses;
     SYSTEMTIME lastUpdate;
 };
 
@@ -162,8 +237,8 @@ struct SharedMemoryBlock {
         uint64_t freeSpace;      // 可用空间（字节）
     } disks[8];
 
-    // 物理磁盘SMART信息（支持最多8个物理磁盘）
-    PhysicalDiskSmartData physicalDisks[8];
+    // 物理磁盘SMART信息（支持最多8个物理磁盘，属性文本见 SMART 目录）
+    SharedPhysicalDiskData physicalDisks[8];
 
     // 温度数据（支持10个传感器）
     TemperatureData temperatures[10];
@@ -174,6 +249,382 @@ struct SharedMemoryBlock {
     int diskCount;
     int physicalDiskCount;       // 新增：物理磁盘数量
     SYSTEMTIME lastUpdate;
-    CRITICAL_SECTION lock;
+    uint8_t reserved[40];        // 原 CRITICAL_SECTION 占位（Win64 下 40 字节），保持旧布局大小不变
+};
+#pragma pack(pop)
+
+// 数据分区：每个分区对应 SharedMemoryBlock 中的一组字段，内容变化时其代数加 1
+// 读端可比较代数跳过未变化的分区（字段范围见 SharedMemorySections.h）
+// 除 SHM_SECTION_LOAD / SHM_SECTION_SENSORS 外都是几乎不变的清单数据（名称、型号、MAC、卷标等）；
+// 每轮变化的数值中，CPU 占用与内存用量归入 LOAD（无需特权即可采集），各温度值归入 SENSORS（需要特权），
+// 两者可由不同的写端进程发布（见 SectionOwnership）
+enum SharedMemorySection {
+    SHM_SECTION_CPU = 0,
+    SHM_SECTION_LOAD,
+    SHM_SECTION_GPU,
+    SHM_SECTION_ADAPTERS,
+    SHM_SECTION_DISKS,
+    SHM_SECTION_SMART,
+    SHM_SECTION_TEMPERATURES,
+    SHM_SECTION_SENSORS,
+    SHM_SECTION_COUNT
+};
+constexpr uint32_t SHM_ALL_SECTIONS = (1u << SHM_SECTION_COUNT) - 1;
+
+// 写端租约（见 WriterLease）：读端据此判断数据新鲜 / 过期 / 写端已退出，不依赖墙上时间
+// 头部的 writer 为创建布局的主写端；附加写端的租约位于 SharedProducerTable
+struct SharedLease {
+    std::atomic<uint32_t> pid;              // 持有租约的写端进程 ID，0 表示从未有写端
+    std::atomic<uint32_t> state;            // WriterLease::State
+    std::atomic<uint64_t> heartbeat;        // 每次发布加 1
+    std::atomic<uint64_t> lastPublishNs;    // 最近一次发布的单调时钟（纳秒，steady_clock，同一主机上跨进程可比）
+    uint32_t publishIntervalMs;             // 写端标称发布周期
+    std::atomic<uint32_t> sectionMask;      // 该写端拥有的分区（1 << SharedMemorySection）
+};
+static_assert(sizeof(SharedLease) == 32, "SharedLease 必须固定为 32 字节");
+
+// 分区状态：每个分区有独立的 seqlock 序号，只读取部分分区的读端不受其他写端发布的影响
+struct SharedSectionState {
+    std::atomic<uint64_t> sequence;         // 分区 seqlock 序号（奇数 = 该分区正在写入）
+    std::atomic<uint32_t> generation;       // 分区内容代数
+    std::atomic<uint32_t> owner;            // 拥有该分区的写端编号 + 1（见 SectionOwnership），0 表示无人拥有
+};
+static_assert(sizeof(SharedSectionState) == 16, "SharedSectionState 必须固定为 16 字节");
+
+// 共享内存头部：位于映射起始处，固定 256 字节，预留字段供后续扩展且不移动数据区偏移
+// 写端以 seqlock 方式发布 SharedMemoryBlock：写前 sequence 置为奇数，写完置为偶数；
+// 读端在复制前后各读一次 sequence，两次相同且为偶数才是一致快照，否则重试
+// 多个写端各自发布自己拥有的分区，写临界区（只有内存复制）由 publishLock 串行化，
+// 因此 sequence 与各分区序号在任一时刻都只有一个写者
+struct alignas(64) SharedMemoryHeader {
+    std::atomic<uint64_t> sequence;          // 发布序号（奇数 = 正在写入），任一写端发布任一分区都会推进
+    std::atomic<uint64_t> publishedSnapshot; // 当前发布的快照：(纪元 << 8) | 槽号，纪元为 0 表示尚未发布
+    std::atomic<uint64_t> readerActivityNs;  // 读端最近一次读取的单调时间（读写映射的读端至多每 250ms 写一次），写端据此判断是否有人在看
+    uint32_t reserved2[5];                   // 布局版本 5 之前的分区代数，已移至 sections
+    // 自描述信息：读端据此校验布局并通过段表定位各区域（偏移均相对映射起始处）
+    uint32_t magic;                 // SHM_LAYOUT_MAGIC
+    uint32_t layoutVersion;         // SHM_LAYOUT_VERSION
+    uint32_t headerSize;            // sizeof(SharedMemoryHeader)
+    std::atomic<uint64_t> totalSize;  // 当前已提交（可读）的映射字节数，随主机规模增长
+    uint64_t sectionTableOffset;    // 段表偏移
+    uint32_t sectionTableCount;     // 段表有效条目数
+    uint32_t reserved0;
+    // 发布通知：每次发布后 publishGeneration 加 1；waiters 为正在阻塞等待的读者数，写端为 0 时跳过唤醒
+    // Linux 下读端直接在 publishGeneration 上 futex 等待，Windows 下等待命名信号量（见 PublishNotifier）
+    std::atomic<uint32_t> publishGeneration;
+    std::atomic<uint32_t> waiters;
+    SharedLease writer;                     // 主写端租约（偏移 88，WPF 端按此读取）
+    SharedSectionState sections[SHM_SECTION_COUNT]; // 各分区序号 / 代数 / 所有者
+    std::atomic<uint32_t> publishLock;      // 持有发布锁的写端进程 ID，0 表示空闲
+    uint32_t reserved3;
+};
+static_assert(sizeof(SharedMemoryHeader) == 256, "SharedMemoryHeader 必须固定为 256 字节");
+static_assert(offsetof(SharedMemoryHeader, readerActivityNs) == 16 && offsetof(SharedMemoryHeader, magic) == 44 && offsetof(SharedMemoryHeader, totalSize) == 56 &&
+              offsetof(SharedMemoryHeader, sectionTableOffset) == 64 &&
+              offsetof(SharedMemoryHeader, publishGeneration) == 80 && offsetof(SharedMemoryHeader, writer) == 88 &&
+              offsetof(SharedMemoryHeader, writer) + offsetof(SharedLease, heartbeat) == 96 &&
+              offsetof(SharedMemoryHeader, writer) + offsetof(SharedLease, lastPublishNs) == 104 &&
+              offsetof(SharedMemoryHeader, writer) + offsetof(SharedLease, publishIntervalMs) == 112,
+              "头部自描述字段偏移必须固定");
+
+constexpr uint32_t SHM_LAYOUT_MAGIC = 0x48534D53;   // "SMSH"（小端）
+constexpr uint32_t SHM_LAYOUT_VERSION = 13;       // 2: 增加热点指标区；3: 头部增加写端租约，快照槽记录发布时间；
+                                                 // 4: SMART 属性改为数值 + 目录下标，兼容块随之缩小；
+                                                 // 5: 多写端分区所有权，分区序号 / 代数移入头部 sections；
+                                                 // 6: 增加采集器状态表；7: 采集器状态增加调度抖动 / 超时直方图；
+                                                 // 8: 头部增加读端活动时间，采集器状态增加基准周期（自适应采样 / 减载）；
+                                                 // 9: 采集器状态增加失败次数与累计耗时；10: 增加写端自身开销表；
+                                                 // 11: 增加逐逻辑处理器占用率变长段，热点指标区增加大小核汇总；
+                                                 // 12: 热点指标区增加未平滑的 CPU 占用率与平滑方式；
+                                                 // 13: 增加钉住快照槽的读端进程表，写端按进程存活回收遗留的钉住
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "共享内存中的原子计数器必须与 uint64_t 同宽");
+
+// 快照槽（RCU 风格）：写端填满一个空闲槽后原子推进 publishedSnapshot 发布，
+// 读端复制期间通过 readers 钉住该槽，写端不会复用仍被钉住或当前已发布的槽
+constexpr int SHM_SNAPSHOT_SLOTS = 4;
+
+struct alignas(64) SnapshotSlot {
+    std::atomic<uint32_t> readers;   // 当前钉住该槽的读者数
+    uint32_t reserved0;
+    std::atomic<uint64_t> epoch;     // 槽内容对应的发布纪元
+    uint32_t sectionGeneration[SHM_SECTION_COUNT]; // 槽内各分区代数，发布前写好
+    uint8_t reserved1[40 - 4 * SHM_SECTION_COUNT];
+    uint64_t publishNs;              // 槽内容发布时的单调时钟（纳秒），与头部 lastPublishNs 同源
+    SharedMemoryBlock block;
+};
+static_assert(offsetof(SnapshotSlot, publishNs) == 56 && offsetof(SnapshotSlot, block) == 64,
+              "快照槽头必须固定为 64 字节（WPF 端按此偏移读取）");
+
+// 热点指标历史环：每次发布追加一条紧凑样本，晚连接的读者可一次取回最近 N 分钟数据
+constexpr int SHM_HISTORY_CAPACITY = 3600;   // 1 Hz 下约 1 小时
+constexpr int SHM_HISTORY_ADAPTERS = 4;
+constexpr int SHM_HISTORY_DISKS = 8;
+
+struct HistorySample {
+    uint64_t timestampMs;          // Unix 时间（毫秒）
+    double cpuUsage;
+    uint64_t usedMemory;
+    uint64_t availableMemory;
+    double cpuTemperature;
+    double gpuTemperature;
+    uint32_t adapterCount;
+    uint32_t diskCount;
+    uint64_t adapterSpeed[SHM_HISTORY_ADAPTERS];   // 各适配器速度（bps），与兼容区 adapters 顺序一致
+    uint64_t diskUsedSpace[SHM_HISTORY_DISKS];     // 各逻辑磁盘已用空间（字节），与兼容区 disks 顺序一致
+};
+static_assert(sizeof(HistorySample) == 152, "HistorySample 布局必须固定（WPF 端按此读取）");
+
+// 写端写样本 k 前先把 writing 置为 k+1，写完再把 head 置为 k+1；
+// 读端复制后重读 writing，序号小于 writing - capacity 的样本可能已被覆盖，需丢弃
+struct alignas(64) SharedHistoryRing {
+    std::atomic<uint64_t> head;     // 已发布样本总数
+    std::atomic<uint64_t> writing;  // 正在写入的样本序号 + 1（空闲时等于 head）
+    uint32_t capacity;
+    uint32_t sampleSize;
+    uint8_t reserved[40];
+    HistorySample samples[SHM_HISTORY_CAPACITY];
+};
+
+// 段表：描述映射中的每个区域。固定区域（兼容块 / 快照槽 / 历史环）位置不变；
+// 变长区域（GPU / 适配器 / 逻辑磁盘 / 物理磁盘 / 温度）保存全部元素，不受兼容块固定上限约束，
+// 容量不足时写端在 seqlock 写临界区内扩容并重新排布，读端需在 seqlock 读取中访问段表与变长区域
+enum SharedMemorySectionId : uint32_t {
+    SHM_SEC_COMPAT_BLOCK = 1,       // SharedMemoryBlock（固定布局，旧读者使用）
+    SHM_SEC_SNAPSHOTS,              // SnapshotSlot[SHM_SNAPSHOT_SLOTS]
+    SHM_SEC_HISTORY,                // SharedHistoryRing
+    SHM_SEC_GPUS,                   // GPUData[]
+    SHM_SEC_ADAPTERS,               // NetworkAdapterData[]
+    SHM_SEC_DISKS,                  // SharedMemoryBlock::SharedDiskData[]
+    SHM_SEC_PHYSICAL_DISKS,         // SharedPhysicalDiskData[]
+    SHM_SEC_TEMPERATURES,           // TemperatureData[]
+    SHM_SEC_HOT_METRICS,            // SharedHotMetrics
+    SHM_SEC_SMART_CATALOG,          // SharedSmartCatalog
+    SHM_SEC_PRODUCERS,              // SharedLease[SHM_MAX_PRODUCERS - 1]（附加写端租约）
+    SHM_SEC_COLLECTORS,             // SharedCollectorStatus[SHM_MAX_PRODUCERS * SHM_MAX_COLLECTORS]
+    SHM_SEC_OVERHEAD,               // SharedSelfOverhead[SHM_MAX_PRODUCERS]
+    SHM_SEC_CORES,                  // SharedCoreUsage[]（各逻辑处理器占用率，属于 LOAD 分区）
+    SHM_SEC_PIN_OWNERS,             // SharedPinOwner[SHM_MAX_PIN_OWNERS]（钉住快照槽的读端进程）
+};
+
+struct SharedMemorySectionEntry {
+    uint32_t id;                    // SharedMemorySectionId
+    uint32_t elementSize;           // 单个元素字节数
+    uint64_t offset;                // 相对映射起始处的偏移
+    uint32_t capacity;              // 可容纳元素数
+    uint32_t count;                 // 当前有效元素数
+    uint32_t generation;            // 内容代数（与对应分区代数一致）
+    uint32_t reserved;
+    char name[16];
+};
+static_assert(sizeof(SharedMemorySectionEntry) == 48, "段表条目必须固定为 48 字节");
+
+constexpr int SHM_MAX_SECTION_ENTRIES = 16;
+constexpr size_t SHM_MAX_MAPPING_SIZE = 64ull << 20; // 预留的最大映射（按需提交）
+
+// 逻辑处理器的核心类型：混合架构（大小核）下区分性能核与能效核，非混合架构全部为性能核
+enum SharedCoreClass : uint8_t {
+    SHM_CORE_UNKNOWN = 0,
+    SHM_CORE_PERFORMANCE = 1,
+    SHM_CORE_EFFICIENCY = 2,
+};
+
+// 变长段 SHM_SEC_CORES 的元素：下标为逻辑处理器编号（Windows 下按处理器组依次编号）
+struct SharedCoreUsage {
+    float usage;                    // 两次采样之间的占用率（%）
+    uint8_t coreClass;              // SharedCoreClass
+    uint8_t reserved[3];
+};
+static_assert(sizeof(SharedCoreUsage) == 8, "SharedCoreUsage 必须固定为 8 字节");
+
+// 一类核心的占用率汇总：单个满载的核心在整体平均中会被稀释，maximum / busiest 可直接看出
+struct SharedCoreClassSummary {
+    uint32_t count;                 // 该类逻辑处理器数，0 表示本机没有该类核心
+    uint32_t busiest;               // 占用率最高的逻辑处理器编号
+    float average;                  // 平均占用率（%）
+    float maximum;                  // 最高占用率（%）
+};
+
+// 热点指标区：SHM_SECTION_LOAD 与 SHM_SECTION_SENSORS 分区的自然对齐副本，独占缓存行，不含任何字符串
+// 两个分区可能属于不同写端，各自只写自己的字段；读端需同时校验两个分区的序号
+// 稳态下每轮只写这里与兼容块 / 快照槽中的对应字段；传感器顺序与变长温度段一致
+constexpr int SHM_HOT_SENSORS = 32;
+
+struct alignas(64) SharedHotMetrics {
+    uint32_t generation;            // 与 SHM_SECTION_LOAD 分区代数一致
+    uint32_t sensorCount;           // 以下温度字段属于 SHM_SECTION_SENSORS
+    double cpuUsage;
+    double cpuUsageSampleIntervalMs;
+    uint64_t totalMemory;
+    uint64_t usedMemory;
+    uint64_t availableMemory;
+    double cpuTemperature;
+    double gpuTemperature;
+    double sensorTemperatures[SHM_HOT_SENSORS];
+    // 以下属于 SHM_SECTION_LOAD：[0] 性能核（非混合架构为全部逻辑处理器），[1] 能效核；逐处理器的值见 SHM_SEC_CORES
+    SharedCoreClassSummary coreSummary[2];
+    // 以下属于 SHM_SECTION_LOAD：未平滑的占用率（cpuUsage 为按 cpuUsageFilter 平滑后的值）
+    double cpuUsageRaw;
+    SharedUsageFilter cpuUsageFilter;
+};
+static_assert(offsetof(SharedHotMetrics, sensorTemperatures) == 64, "热点标量必须恰好占满第一条缓存行");
+
+// SMART 目录：属性 ID 对应的名称 / 描述 / 单位，写端初始化时写入一次，之后不再变化
+// 各磁盘的 SharedSmartAttribute::catalogIndex 指向 entries 中的下标
+constexpr int SHM_SMART_CATALOG_CAPACITY = 64;
+
+struct SmartCatalogEntry {
+    uint8_t id;
+    bool isCritical;               // 该属性通常视为关键健康指标
+    uint16_t reserved;
+    wchar_t name[64];
+    wchar_t description[128];
+    wchar_t units[16];
+};
+
+struct alignas(64) SharedSmartCatalog {
+    uint32_t count;                 // 有效条目数
+    uint32_t entrySize;             // sizeof(SmartCatalogEntry)，读端据此校验
+    uint8_t reserved[56];
+    SmartCatalogEntry entries[SHM_SMART_CATALOG_CAPACITY];
+};
+
+// 附加写端：主写端之外最多 SHM_MAX_PRODUCERS - 1 个进程可以附着到已有映射，各自认领并发布一部分分区
+// 例如特权辅助进程发布 SMART 与温度传感器，非特权进程发布 CPU / 内存等热点指标
+constexpr int SHM_MAX_PRODUCERS = 4;   // 含主写端
+
+struct alignas(64) SharedProducerTable {
+    uint32_t capacity;              // SHM_MAX_PRODUCERS - 1
+    uint32_t leaseSize;             // sizeof(SharedLease)
+    uint8_t reserved[56];
+    SharedLease producers[SHM_MAX_PRODUCERS - 1];
 };
-#pragma pack(pop)
\ No newline at end of file
+
+// 采集器状态表：写端的每个数据源一条，记录最近一次成功采集的时间与是否过期
+// 数据源错过本轮截止时间时写端照常发布其上一次的值，读端据此判断对应分区数据的年龄
+// 写端 p 使用 entries[p * SHM_MAX_COLLECTORS, (p + 1) * SHM_MAX_COLLECTORS)，由全局 seqlock 保护
+constexpr int SHM_MAX_COLLECTORS = 8;   // 每个写端
+
+enum SharedCollectorFlags : uint32_t {
+    SHM_COLLECTOR_RUNNING = 1u << 0,    // 正在采集
+    SHM_COLLECTOR_STALE = 1u << 1,      // 超过截止时间仍未完成，或最近一次采集失败：已发布的是旧值
+    SHM_COLLECTOR_FAILED = 1u << 2,     // 最近一次采集抛出异常
+    SHM_COLLECTOR_SHED = 1u << 3,       // 主机 CPU 超过上限，该（昂贵的）数据源暂停采集：已发布的是暂停前的值
+    SHM_COLLECTOR_INITIALIZING = 1u << 4, // 仍在后台初始化：负责的分区尚无数据（不可用），不同于数值为 0
+};
+
+// 调度直方图的分桶上界（微秒）：桶 i 统计 [SHM_TIMING_BUCKET_US[i-1], SHM_TIMING_BUCKET_US[i])，最后一桶无上界
+constexpr int SHM_TIMING_BUCKETS = 6;
+constexpr uint32_t SHM_TIMING_BUCKET_US[SHM_TIMING_BUCKETS - 1] = { 100, 500, 1000, 5000, 20000 };
+
+struct SharedCollectorStatus {
+    char name[16];
+    uint32_t sections;              // 该数据源负责的分区掩码（1 << SharedMemorySection）
+    uint32_t periodMs;              // 当前采样周期（自适应采样时随负载与读者变化）
+    uint32_t flags;                 // SharedCollectorFlags
+    uint32_t lastDurationUs;        // 最近一次采集耗时
+    uint64_t lastSuccessNs;         // 最近一次成功采集完成的单调时间（与 SharedLease::lastPublishNs 同一时基），0 表示尚未完成
+    uint64_t runs;                  // 已完成的采集次数
+    uint64_t missedDeadlines;       // 错过截止时间的次数
+    // 调度时钟：采样时刻按 起点 + k * 周期 的绝对时间排定，以下统计实际开始时间相对排定时间的偏差
+    uint32_t lastIntervalUs;        // 最近两次实际开始之间的间隔（真实采样间隔）
+    uint32_t lastJitterUs;          // 最近一次开始时间晚于排定时间的量
+    uint32_t maxJitterUs;
+    uint32_t overruns;              // 采集耗时超过一个周期（完成时已过下一个排定时间）的次数
+    uint32_t skippedPeriods;        // 因落后整周期（或减载暂停）而跳过的排定采样数
+    uint32_t basePeriodMs;          // 配置的基准周期
+    uint32_t jitterHistogram[SHM_TIMING_BUCKETS];   // 开始偏差分布
+    uint32_t overrunHistogram[SHM_TIMING_BUCKETS];  // 超时量（完成时间 - 下一个排定时间）分布
+    uint64_t failures;              // 采集抛出异常的次数
+    uint64_t totalDurationUs;       // 累计采集耗时：除以 runs 即该数据源的平均开销
+};
+static_assert(sizeof(SharedCollectorStatus) == 144, "采集器状态条目必须固定为 144 字节");
+
+struct alignas(64) SharedCollectorTable {
+    uint32_t capacity;              // SHM_MAX_PRODUCERS * SHM_MAX_COLLECTORS
+    uint32_t entrySize;             // sizeof(SharedCollectorStatus)
+    uint32_t perProducer;           // SHM_MAX_COLLECTORS
+    uint32_t counts[SHM_MAX_PRODUCERS]; // 各写端的有效条目数
+    uint8_t reserved[36];
+    SharedCollectorStatus entries[SHM_MAX_PRODUCERS * SHM_MAX_COLLECTORS];
+};
+
+// 每轮主循环耗时直方图的分桶上界（微秒），含义同 SHM_TIMING_BUCKET_US
+constexpr int SHM_CYCLE_BUCKETS = 8;
+constexpr uint32_t SHM_CYCLE_BUCKET_US[SHM_CYCLE_BUCKETS - 1] = { 1000, 2000, 5000, 10000, 20000, 50000, 100000 };
+
+// 写端自身开销表：每个写端进程一条，发布监视器本身消耗的 CPU、内存、堆分配、句柄与系统调用，
+// 以及每轮主循环的耗时分布；各数据源的耗时见采集器状态表。写端 p 使用 entries[p]，由全局 seqlock 保护
+
+struct SharedSelfOverhead {
+    uint32_t pid;                   // 写端进程 ID，0 表示该写端尚未发布
+    uint32_t sampleIntervalMs;      // 进程级计数（内存 / 句柄 / 系统调用）的刷新周期
+    uint64_t updatedNs;             // 最近一次更新的单调时间（与 SharedLease::lastPublishNs 同一时基）
+    uint64_t cycles;                // 已完成的主循环轮数
+    // CPU：进程所有线程（含采集工作线程）的用户 + 内核时间
+    uint64_t cpuTimeUs;             // 累计
+    uint32_t lastCycleCpuUs;        // 最近一轮（相邻两轮开始之间）消耗的 CPU 时间
+    uint32_t maxCycleCpuUs;
+    double cpuPercent;              // 最近一个刷新周期内的 CPU 占用（单个逻辑核的百分比）
+    // 一轮的墙钟耗时：派发并等待每轮等待的数据源、合并与发布，不含空闲休眠
+    uint32_t lastCycleWallUs;
+    uint32_t maxCycleWallUs;
+    uint64_t totalCycleWallUs;
+    // 内存
+    uint64_t residentBytes;         // 工作集（Windows）/ RSS（Linux）
+    uint64_t peakResidentBytes;
+    uint64_t privateBytes;          // 提交的私有内存（Windows PrivateUsage，Linux 数据段）
+    // 堆分配（全局 operator new，见 AllocationCounter）
+    uint64_t allocations;           // 累计次数
+    uint64_t allocatedBytes;        // 累计申请字节数
+    uint32_t lastCycleAllocations;  // 最近一轮（相邻两轮开始之间）的分配次数
+    uint32_t maxCycleAllocations;
+    // 内核对象与系统调用
+    uint32_t handles;               // 句柄数（Windows）/ 打开的文件描述符数（Linux）
+    uint32_t threads;               // 线程数（Linux；Windows 为 0）
+    uint64_t ioSyscalls;            // I/O 系统调用次数（Linux 读写类系统调用，Windows 为 I/O 操作次数）
+    uint64_t pageFaults;
+    uint64_t contextSwitches;       // 自愿 + 非自愿上下文切换（Linux；Windows 为 0）
+    uint32_t cycleHistogram[SHM_CYCLE_BUCKETS];     // 每轮墙钟耗时分布
+};
+static_assert(sizeof(SharedSelfOverhead) == 176, "写端开销条目必须固定为 176 字节");
+
+struct alignas(64) SharedOverheadTable {
+    uint32_t capacity;              // SHM_MAX_PRODUCERS
+    uint32_t entrySize;             // sizeof(SharedSelfOverhead)
+    uint8_t reserved[56];
+    SharedSelfOverhead entries[SHM_MAX_PRODUCERS];
+};
+
+// 钉住快照槽的读端进程：读端打开映射时认领一条，钉住时先记入 pins 再增加槽的 readers，释放时顺序相反，
+// 因此任一时刻各条目 pins 之和不小于登记读端在该槽上的实际钉住数。写端只回收已退出进程的条目（与写端租约相同按 PID 判断），
+// 存活读端持有快照的时间不受限制；未登记的钉住（表满，或不使用该表的旧读端）只能按持续时间回收
+constexpr int SHM_MAX_PIN_OWNERS = 64;
+
+struct SharedPinOwner {
+    std::atomic<uint32_t> pid;                          // 0 表示空闲
+    std::atomic<uint32_t> pins[SHM_SNAPSHOT_SLOTS];     // 该读端在各槽上的钉住数
+    uint32_t reserved[3];
+};
+static_assert(sizeof(SharedPinOwner) == 32, "SharedPinOwner 必须固定为 32 字节");
+
+struct alignas(64) SharedPinTable {
+    uint32_t capacity;              // SHM_MAX_PIN_OWNERS
+    uint32_t entrySize;             // sizeof(SharedPinOwner)
+    uint8_t reserved[56];
+    SharedPinOwner owners[SHM_MAX_PIN_OWNERS];
+};
+
+// 共享内存整体布局（固定部分，变长区域紧随其后）
+struct SharedMemoryLayout {
+    SharedMemoryHeader header;
+    SharedMemoryBlock block;                        // 最新数据（seqlock 保护，兼容旧读者）
+    SnapshotSlot snapshots[SHM_SNAPSHOT_SLOTS];     // 供慢读者钉住的完整快照
+    SharedHistoryRing history;                      // 热点指标历史
+    SharedMemorySectionEntry sectionTable[SHM_MAX_SECTION_ENTRIES];
+    SharedHotMetrics hot;                           // 每轮变化的数值（自然对齐）
+    SharedSmartCatalog smartCatalog;                // SMART 属性文本（初始化时写入一次）
+    SharedProducerTable producerTable;              // 附加写端租约
+    SharedCollectorTable collectors;                // 采集器状态
+    SharedOverheadTable overhead;                   // 写端自身开销
+    SharedPinTable pinOwners;                       // 钉住快照槽的读端进程
+};
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include "DataStruct.h"
+#include <algorithm>
+#include <cstring>
+
+// 历史环读写（单写多读，无锁）
+// 写端: Append 覆盖最旧的样本；读端: ReadLatest 复制最近的样本并丢弃复制期间被覆盖的部分
+class HistoryRing {
+public:
+    static void Reset(SharedHistoryRing& ring) {
+        ring.head.store(0, std::memory_order_relaxed);
+        ring.writing.store(0, std::memory_order_relaxed);
+        ring.capacity = SHM_HISTORY_CAPACITY;
+        ring.sampleSize = sizeof(HistorySample);
+    }
+
+    static void Append(SharedHistoryRing& ring, const HistorySample& sample) {
+        const uint64_t index = ring.head.load(std::memory_order_relaxed);
+        ring.writing.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        ring.samples[index % SHM_HISTORY_CAPACITY] = sample;
+        ring.head.store(index + 1, std::memory_order_release);
+    }
+
+    // 按时间顺序（最旧在前）复制最多 maxSamples 条最近样本到 out，返回实际条数
+    // 最多返回 capacity - 1 条：head 所在的槽可能正被写端覆盖
+    static size_t ReadLatest(const SharedHistoryRing& ring, HistorySample* out, size_t maxSamples) {
+        const uint64_t head = ring.head.load(std::memory_order_acquire);
+        const uint64_t available = std::min<uint64_t>(head, SHM_HISTORY_CAPACITY - 1);
+        const uint64_t count = std::min<uint64_t>(available, maxSamples);
+        const uint64_t first = head - count;
+        for (uint64_t i = 0; i < count; ++i) {
+            std::memcpy(&out[i], &ring.samples[(first + i) % SHM_HISTORY_CAPACITY], sizeof(HistorySample));
+        }
+
+        // 复制期间写端可能已绕回覆盖了最旧的几条，只保留仍然有效的尾部
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t writing = ring.writing.load(std::memory_order_relaxed);
+        const uint64_t oldestValid = writing > SHM_HISTORY_CAPACITY ? writing - SHM_HISTORY_CAPACITY : 0;
+        if (first >= oldestValid) return static_cast<size_t>(count);
+        const uint64_t dropped = std::min<uint64_t>(oldestValid - first, count);
+        std::memmove(out, out + dropped, static_cast<size_t>(count - dropped) * sizeof(HistorySample));
+        return static_cast<size_t>(count - dropped);
+    }
+};
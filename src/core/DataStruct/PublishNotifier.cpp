@@ -0,0 +1,162 @@
+#include "PublishNotifier.h"
+#include "../Utils/Logger.h"
+#include <chrono>
+#include <climits>
+
+#ifdef _WIN32
+#include "../Utils/WinUtils.h"
+#else
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 单次 Notify 最多释放的信号量计数：崩溃读者遗留的 waiters 只会造成有限次数的空唤醒
+constexpr uint32_t kMaxWakeCount = 64;
+
+#ifndef _WIN32
+// 跨进程 futex（不使用 FUTEX_PRIVATE_FLAG，因为字位于共享映射中）
+long FutexWait(std::atomic<uint32_t>* word, uint32_t expected, int timeoutMs) {
+    timespec ts{};
+    timespec* pts = nullptr;
+    if (timeoutMs >= 0) {
+        ts.tv_sec = timeoutMs / 1000;
+        ts.tv_nsec = static_cast<long>(timeoutMs % 1000) * 1000000L;
+        pts = &ts;
+    }
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, pts, nullptr, 0);
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+#endif
+
+} // namespace
+
+PublishNotifier::PublishNotifier(const std::string& name) : name(name) {}
+
+PublishNotifier::~PublishNotifier() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool PublishNotifier::Create() {
+    Close();
+    // 与共享内存相同：NULL DACL 允许非提升权限的读端打开
+    SECURITY_DESCRIPTOR securityDescriptor;
+    SECURITY_ATTRIBUTES securityAttributes{ sizeof(SECURITY_ATTRIBUTES), nullptr, FALSE };
+    if (InitializeSecurityDescriptor(&securityDescriptor, SECURITY_DESCRIPTOR_REVISION) &&
+        SetSecurityDescriptorDacl(&securityDescriptor, TRUE, NULL, FALSE)) {
+        securityAttributes.lpSecurityDescriptor = &securityDescriptor;
+    }
+    const std::wstring baseName = WinUtils::StringToWstring(name) + L"_Publish";
+    const std::wstring names[] = { L"Global\\" + baseName, L"Local\\" + baseName, baseName };
+    for (const auto& n : names) {
+        hSemaphore = CreateSemaphoreW(&securityAttributes, 0, LONG_MAX, n.c_str());
+        if (hSemaphore != NULL) break;
+    }
+    if (hSemaphore == NULL) {
+        lastError = "未能创建发布通知信号量: " + WinUtils::FormatWindowsErrorMessage(::GetLastError());
+        return false;
+    }
+    return true;
+}
+
+bool PublishNotifier::Open() {
+    Close();
+    const std::wstring baseName = WinUtils::StringToWstring(name) + L"_Publish";
+    const std::wstring names[] = { L"Global\\" + baseName, L"Local\\" + baseName, baseName };
+    for (const auto& n : names) {
+        hSemaphore = OpenSemaphoreW(SYNCHRONIZE, FALSE, n.c_str());
+        if (hSemaphore != NULL) break;
+    }
+    if (hSemaphore == NULL) {
+        lastError = "未能打开发布通知信号量: " + WinUtils::FormatWindowsErrorMessage(::GetLastError());
+        return false;
+    }
+    return true;
+}
+
+void PublishNotifier::Close() {
+    if (hSemaphore) {
+        CloseHandle(hSemaphore);
+        hSemaphore = NULL;
+    }
+}
+
+#else
+
+bool PublishNotifier::Create() { return true; }
+bool PublishNotifier::Open() { return true; }
+void PublishNotifier::Close() {}
+
+#endif
+
+void PublishNotifier::Notify(SharedMemoryHeader& header) {
+    header.publishGeneration.fetch_add(1, std::memory_order_seq_cst);
+    const uint32_t waiting = header.waiters.load(std::memory_order_seq_cst);
+    if (waiting == 0) return;
+#ifdef _WIN32
+    if (hSemaphore) {
+        ReleaseSemaphore(hSemaphore, static_cast<LONG>(waiting < kMaxWakeCount ? waiting : kMaxWakeCount), nullptr);
+    }
+#else
+    FutexWakeAll(&header.publishGeneration);
+#endif
+}
+
+PublishNotifier::WaitResult PublishNotifier::Wait(SharedMemoryHeader& header, uint32_t lastSeen, int timeoutMs,
+                                                  uint32_t* generationOut) {
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs < 0 ? 0 : timeoutMs);
+    WaitResult result = WaitResult::Timeout;
+
+    for (;;) {
+        uint32_t generation = header.publishGeneration.load(std::memory_order_acquire);
+        if (generation != lastSeen) {
+            result = WaitResult::NewGeneration;
+            break;
+        }
+        int remainingMs = -1;
+        if (timeoutMs >= 0) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            if (remaining <= 0) break;
+            remainingMs = static_cast<int>(remaining);
+        }
+
+        // 先登记为等待者再复查代数：写端要么看到 waiters > 0 并唤醒，要么本端复查时已看到新代数
+        header.waiters.fetch_add(1, std::memory_order_seq_cst);
+        bool waitFailed = false;
+        if (header.publishGeneration.load(std::memory_order_seq_cst) == lastSeen) {
+#ifdef _WIN32
+            if (!hSemaphore) {
+                lastError = "发布通知信号量未打开";
+                waitFailed = true;
+            } else if (WaitForSingleObject(hSemaphore, remainingMs < 0 ? INFINITE : static_cast<DWORD>(remainingMs)) == WAIT_FAILED) {
+                lastError = "等待发布通知失败: " + WinUtils::FormatWindowsErrorMessage(::GetLastError());
+                waitFailed = true;
+            }
+#else
+            if (FutexWait(&header.publishGeneration, lastSeen, remainingMs) != 0 &&
+                errno != EAGAIN && errno != EINTR && errno != ETIMEDOUT) {
+                lastError = "futex 等待失败, errno: " + std::to_string(errno);
+                waitFailed = true;
+            }
+#endif
+        }
+        header.waiters.fetch_sub(1, std::memory_order_seq_cst);
+        if (waitFailed) {
+            result = WaitResult::Error;
+            break;
+        }
+    }
+
+    if (generationOut) *generationOut = header.publishGeneration.load(std::memory_order_acquire);
+    return result;
+}
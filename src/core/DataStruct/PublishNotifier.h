@@ -0,0 +1,44 @@
+#pragma once
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include "DataStruct.h"
+#include <string>
+
+// 发布通知：读端可阻塞等待新一代数据，而不必轮询
+// Linux: 在共享内存头部的 publishGeneration 上使用跨进程 futex
+// Windows: 命名信号量，写端按 waiters 计数释放，读端醒来后再比较 publishGeneration
+class PublishNotifier {
+public:
+    enum class WaitResult {
+        NewGeneration,   // 已有比 lastSeen 更新的数据
+        Timeout,
+        Error
+    };
+
+    explicit PublishNotifier(const std::string& name = "SystemMonitorSharedMemory");
+    ~PublishNotifier();
+    PublishNotifier(const PublishNotifier&) = delete;
+    PublishNotifier& operator=(const PublishNotifier&) = delete;
+
+    // 写端创建 / 读端打开通知对象（Linux 下无需额外对象，始终成功）
+    bool Create();
+    bool Open();
+    void Close();
+
+    // 写端：发布完成后调用，推进 publishGeneration 并唤醒所有等待者
+    void Notify(SharedMemoryHeader& header);
+
+    // 读端：等待 publishGeneration 不同于 lastSeen，timeoutMs < 0 表示无限等待
+    // generationOut 返回当前代数（超时时也会填写）
+    WaitResult Wait(SharedMemoryHeader& header, uint32_t lastSeen, int timeoutMs, uint32_t* generationOut = nullptr);
+
+    const std::string& GetLastError() const { return lastError; }
+
+private:
+    std::string name;
+    std::string lastError;
+#ifdef _WIN32
+    HANDLE hSemaphore = NULL;
+#endif
+};
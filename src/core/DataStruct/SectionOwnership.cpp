@@ -0,0 +1,132 @@
+#include "SectionOwnership.h"
+#include "WriterLease.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+// 每自旋这么多次检查一次锁持有者是否仍存在
+constexpr uint32_t kLivenessCheckSpins = 256;
+
+const char* const kSectionNames[SHM_SECTION_COUNT] = {
+    "cpu", "load", "gpu", "adapters", "disks", "smart", "temperatures", "sensors"
+};
+
+} // namespace
+
+SharedLease& SectionOwnership::Lease(SharedMemoryLayout& layout, int producer) {
+    return producer == kPrimary ? layout.header.writer : layout.producerTable.producers[producer - 1];
+}
+
+const SharedLease& SectionOwnership::Lease(const SharedMemoryLayout& layout, int producer) {
+    return producer == kPrimary ? layout.header.writer : layout.producerTable.producers[producer - 1];
+}
+
+bool SectionOwnership::ValidateMask(uint32_t mask, std::string& error) {
+    if (mask == 0 || (mask & ~SHM_ALL_SECTIONS) != 0) {
+        error = "无效的分区掩码 0x" + std::to_string(mask);
+        return false;
+    }
+    const bool names = (mask & (1u << SHM_SECTION_TEMPERATURES)) != 0;
+    const bool values = (mask & (1u << SHM_SECTION_SENSORS)) != 0;
+    if (names != values) {
+        error = "温度传感器名称（temperatures）与数值（sensors）分区必须由同一写端发布";
+        return false;
+    }
+    return true;
+}
+
+bool SectionOwnership::Claim(SharedMemoryLayout& layout, int producer, uint32_t mask, std::string& error) {
+    for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+        if ((mask & (1u << s)) == 0) continue;
+        const int owner = OwnerOf(layout, s);
+        if (owner < 0 || owner == producer) continue;
+        const SharedLease& lease = Lease(layout, owner);
+        if (WriterLease::IsHeldByOther(lease)) {
+            error = std::string("分区 ") + kSectionNames[s] + " 已由写端进程 (PID " +
+                    std::to_string(lease.pid.load(std::memory_order_relaxed)) + ") 发布";
+            return false;
+        }
+    }
+    for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+        std::atomic<uint32_t>& owner = layout.header.sections[s].owner;
+        if ((mask & (1u << s)) != 0) {
+            owner.store(static_cast<uint32_t>(producer + 1), std::memory_order_relaxed);
+        } else if (owner.load(std::memory_order_relaxed) == static_cast<uint32_t>(producer + 1)) {
+            owner.store(0, std::memory_order_relaxed);
+        }
+    }
+    Lease(layout, producer).sectionMask.store(mask, std::memory_order_release);
+    return true;
+}
+
+int SectionOwnership::AcquireProducerSlot(SharedMemoryLayout& layout, uint32_t publishIntervalMs, std::string& error) {
+    for (int producer = 1; producer < SHM_MAX_PRODUCERS; ++producer) {
+        SharedLease& lease = Lease(layout, producer);
+        if (WriterLease::IsHeldByOther(lease)) continue;
+        bool reclaimed = false;
+        if (WriterLease::Acquire(lease, publishIntervalMs, reclaimed, error)) return producer;
+    }
+    error = "附加写端数量已达上限 (" + std::to_string(SHM_MAX_PRODUCERS - 1) + ")";
+    return -1;
+}
+
+void SectionOwnership::Release(SharedMemoryLayout& layout, int producer) {
+    SharedLease& lease = Lease(layout, producer);
+    if (lease.pid.load(std::memory_order_relaxed) != WriterLease::CurrentProcessId()) return;
+    for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+        std::atomic<uint32_t>& owner = layout.header.sections[s].owner;
+        if (owner.load(std::memory_order_relaxed) == static_cast<uint32_t>(producer + 1)) {
+            owner.store(0, std::memory_order_relaxed);
+        }
+    }
+    lease.sectionMask.store(0, std::memory_order_relaxed);
+    WriterLease::Release(lease);
+}
+
+int SectionOwnership::OwnerOf(const SharedMemoryLayout& layout, int section) {
+    const uint32_t owner = layout.header.sections[section].owner.load(std::memory_order_acquire);
+    return owner >= 1 && owner <= static_cast<uint32_t>(SHM_MAX_PRODUCERS) ? static_cast<int>(owner) - 1 : -1;
+}
+
+bool SectionOwnership::HasLiveProducers(const SharedMemoryLayout& layout) {
+    for (int producer = 1; producer < SHM_MAX_PRODUCERS; ++producer) {
+        if (WriterLease::IsHeldByOther(Lease(layout, producer))) return true;
+    }
+    return false;
+}
+
+uint64_t SectionOwnership::LatestPublishNs(const SharedMemoryLayout& layout) {
+    uint64_t latest = 0;
+    for (int producer = 0; producer < SHM_MAX_PRODUCERS; ++producer) {
+        const SharedLease& lease = Lease(layout, producer);
+        if (lease.heartbeat.load(std::memory_order_relaxed) == 0) continue;
+        latest = std::max(latest, lease.lastPublishNs.load(std::memory_order_relaxed));
+    }
+    return latest;
+}
+
+bool SectionOwnership::LockPublish(SharedMemoryHeader& header) {
+    const uint32_t self = WriterLease::CurrentProcessId();
+    for (uint32_t spins = 1;; ++spins) {
+        uint32_t holder = 0;
+        if (header.publishLock.compare_exchange_weak(holder, self, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return false;
+        }
+        // 锁字是本进程 PID：上一个同 PID 的进程（PID 复用）持锁时退出，本进程的发布不会重入
+        if (holder == self) return true;
+        if (holder != 0 && spins % kLivenessCheckSpins == 0 && !WriterLease::IsProcessAlive(holder) &&
+            header.publishLock.compare_exchange_strong(holder, self, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+        if (spins < 64) continue;
+        if (spins < 1024) std::this_thread::yield();
+        else std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+void SectionOwnership::UnlockPublish(SharedMemoryHeader& header) {
+    uint32_t self = WriterLease::CurrentProcessId();
+    header.publishLock.compare_exchange_strong(self, 0, std::memory_order_release, std::memory_order_relaxed);
+}
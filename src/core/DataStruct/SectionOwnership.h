@@ -0,0 +1,37 @@
+#pragma once
+#include "DataStruct.h"
+#include <cstdint>
+#include <string>
+
+// 多写端分区所有权：每个数据分区（SharedMemorySection）由一个写端进程独占发布
+// 编号 0 为创建布局的主写端（租约在头部 writer），1..SHM_MAX_PRODUCERS-1 为附着到已有映射的附加写端
+// （租约在 SharedProducerTable）。各写端独立采集，只有发布（纯内存复制）通过头部 publishLock 串行化，
+// 因此一个写端的慢速采集（如 SMART 扫描）不会推迟其他写端的发布
+class SectionOwnership {
+public:
+    static constexpr int kPrimary = 0;
+
+    static SharedLease& Lease(SharedMemoryLayout& layout, int producer);
+    static const SharedLease& Lease(const SharedMemoryLayout& layout, int producer);
+
+    // 检查分区掩码：传感器名称（TEMPERATURES）与数值（SENSORS）交错存放，必须属于同一写端
+    static bool ValidateMask(uint32_t mask, std::string& error);
+    // 发布锁内调用：为 producer 认领 mask 中的分区，并放弃其不再需要的分区
+    // 任一分区由其他存活写端持有时不做任何修改并返回 false
+    static bool Claim(SharedMemoryLayout& layout, int producer, uint32_t mask, std::string& error);
+    // 发布锁内调用：取得一个空闲（或持有者已退出）的附加写端槽位，返回写端编号，失败返回 -1
+    static int AcquireProducerSlot(SharedMemoryLayout& layout, uint32_t publishIntervalMs, std::string& error);
+    // 放弃 producer 拥有的全部分区并释放其租约；只改写本进程持有的原子字段，退出路径上可不取发布锁
+    static void Release(SharedMemoryLayout& layout, int producer);
+    // 分区当前的所有者编号，无人拥有时返回 -1
+    static int OwnerOf(const SharedMemoryLayout& layout, int section);
+    // 是否有主写端之外的存活写端
+    static bool HasLiveProducers(const SharedMemoryLayout& layout);
+    // 所有写端中最近一次发布的单调时间（纳秒）
+    static uint64_t LatestPublishNs(const SharedMemoryLayout& layout);
+
+    // 发布锁：跨进程自旋锁，锁字保存持有者 PID；持有时间只有一轮内存复制（微秒级）
+    // 持有者进程已退出时由等待者接管并返回 true，调用方需修复其中断的写临界区
+    static bool LockPublish(SharedMemoryHeader& header);
+    static void UnlockPublish(SharedMemoryHeader& header);
+};
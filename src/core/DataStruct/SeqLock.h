@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// 跨进程 seqlock 原语（单写多读，无锁）
+// 写端: BeginWrite -> 写数据 -> EndWrite，写端永不等待读端
+// 读端: 通过 Read 复制数据，期间若写端介入则自动重试，读端不会写共享内存
+class SeqLock {
+public:
+    static constexpr int kDefaultReadAttempts = 10000;
+
+    // 进入写临界区，返回本次使用的奇数序号
+    // 若上一个写端在写入途中崩溃导致 sequence 停在奇数，这里会直接跳到下一个奇数
+    static uint64_t BeginWrite(std::atomic<uint64_t>& sequence) {
+        uint64_t odd = (sequence.load(std::memory_order_relaxed) + 1) | 1;
+        sequence.store(odd, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return odd;
+    }
+
+    // 结束写临界区，sequence 变为偶数，数据对读端可见
+    static void EndWrite(std::atomic<uint64_t>& sequence, uint64_t odd) {
+        sequence.store(odd + 1, std::memory_order_release);
+    }
+
+    static uint64_t ReadBegin(const std::atomic<uint64_t>& sequence) {
+        return sequence.load(std::memory_order_acquire);
+    }
+
+    // 复制完成后调用：返回 true 表示期间发生了写入（或开始时正在写），需要重试
+    static bool ReadRetry(const std::atomic<uint64_t>& sequence, uint64_t begin) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return (begin & 1) != 0 || sequence.load(std::memory_order_relaxed) != begin;
+    }
+
+    // 读取一份一致副本：copy() 在两次序号读取之间执行，可被调用多次
+    // 返回 false 表示在 maxAttempts 次内始终未得到稳定偶数序号（例如写端卡死在写入中）
+    template <typename CopyFn>
+    static bool Read(const std::atomic<uint64_t>& sequence, CopyFn&& copy,
+                     int maxAttempts = kDefaultReadAttempts, uint64_t* retries = nullptr,
+                     uint64_t* sequenceOut = nullptr) {
+        for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+            uint64_t begin = ReadBegin(sequence);
+            if ((begin & 1) == 0) {
+                copy();
+                if (!ReadRetry(sequence, begin)) {
+                    if (sequenceOut) *sequenceOut = begin;
+                    return true;
+                }
+            }
+            if (retries) ++(*retries);
+            if (attempt > 64) std::this_thread::yield();
+        }
+        return false;
+    }
+};
@@ -0,0 +1,256 @@
+#include "SharedMemoryBackend.h"
+#include "../Utils/Logger.h"
+#include <sstream>
+
+#ifdef _WIN32
+#include "../Utils/WinUtils.h"
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SharedMemoryBackend::SharedMemoryBackend(const std::string& name) : name(name) {}
+
+SharedMemoryBackend::~SharedMemoryBackend() {
+    Close();
+}
+
+#ifdef _WIN32
+
+static std::string FormatWin32Error(const char* what, DWORD errorCode) {
+    std::stringstream ss;
+    ss << what << "。错误码: " << errorCode << " (" << WinUtils::FormatWindowsErrorMessage(errorCode) << ")";
+    return ss.str();
+}
+
+bool SharedMemoryBackend::Create(size_t commitSize, size_t reserveSize) {
+    Close();
+    lastError.clear();
+    const size_t mapSize = reserveSize > commitSize ? reserveSize : commitSize;
+
+    try {
+        // Try to enable privileges needed for creating global objects
+        if (!WinUtils::EnablePrivilege(L"SeCreateGlobalPrivilege")) {
+            Logger::Warn("未能启用 SeCreateGlobalPrivilege - 尝试继续");
+        }
+    } catch (...) {
+        Logger::Warn("启用 SeCreateGlobalPrivilege 时发生异常 - 尝试继续");
+    }
+
+    // Create security attributes to allow sharing between processes
+    SECURITY_ATTRIBUTES securityAttributes;
+    SECURITY_DESCRIPTOR securityDescriptor;
+    if (!InitializeSecurityDescriptor(&securityDescriptor, SECURITY_DESCRIPTOR_REVISION)) {
+        lastError = FormatWin32Error("未能初始化安全描述符", ::GetLastError());
+        return false;
+    }
+    // Set the DACL to NULL for unrestricted access
+    if (!SetSecurityDescriptorDacl(&securityDescriptor, TRUE, NULL, FALSE)) {
+        lastError = FormatWin32Error("未能设置安全描述符 DACL", ::GetLastError());
+        return false;
+    }
+    securityAttributes.nLength = sizeof(SECURITY_ATTRIBUTES);
+    securityAttributes.lpSecurityDescriptor = &securityDescriptor;
+    securityAttributes.bInheritHandle = FALSE;
+
+    const ULONGLONG size64 = static_cast<ULONGLONG>(mapSize);
+    const std::wstring baseName = WinUtils::StringToWstring(name);
+    const std::wstring names[] = { L"Global\\" + baseName, L"Local\\" + baseName, baseName };
+    for (size_t i = 0; i < 3 && hMapFile == NULL; ++i) {
+        if (i == 1) Logger::Warn("未能创建全局共享内存，尝试本地命名空间");
+        // SEC_RESERVE：只保留地址范围，页面在 Commit 时才占用提交额度
+        hMapFile = CreateFileMappingW(INVALID_HANDLE_VALUE, &securityAttributes, PAGE_READWRITE | SEC_RESERVE,
+            static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFF), names[i].c_str());
+    }
+    if (hMapFile == NULL) {
+        DWORD errorCode = ::GetLastError();
+        lastError = FormatWin32Error("未能创建共享内存", errorCode);
+        if (errorCode == ERROR_ALREADY_EXISTS) lastError += " (共享内存已存在)";
+        return false;
+    }
+    alreadyExisted = (::GetLastError() == ERROR_ALREADY_EXISTS);
+
+    data = MapViewOfFile(hMapFile, FILE_MAP_ALL_ACCESS, 0, 0, mapSize);
+    if (data == nullptr) {
+        lastError = FormatWin32Error("未能映射共享内存视图", ::GetLastError());
+        CloseHandle(hMapFile);
+        hMapFile = NULL;
+        return false;
+    }
+    size = mapSize;
+    committed = 0;
+    return Commit(commitSize);
+}
+
+bool SharedMemoryBackend::Commit(size_t newSize) {
+    if (!data || newSize > size) {
+        lastError = "提交大小超出预留的共享内存范围";
+        return false;
+    }
+    if (newSize <= committed) return true;
+    if (VirtualAlloc(data, newSize, MEM_COMMIT, PAGE_READWRITE) == nullptr) {
+        lastError = FormatWin32Error("未能提交共享内存页面", ::GetLastError());
+        return false;
+    }
+    committed = newSize;
+    return true;
+}
+
+bool SharedMemoryBackend::Open(size_t mapSize, bool readOnly) {
+    Close();
+    lastError.clear();
+    const DWORD access = readOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS;
+    const std::wstring baseName = WinUtils::StringToWstring(name);
+    const std::wstring names[] = { L"Global\\" + baseName, L"Local\\" + baseName, baseName };
+    for (const auto& n : names) {
+        hMapFile = OpenFileMappingW(access, FALSE, n.c_str());
+        if (hMapFile != NULL) break;
+    }
+    if (hMapFile == NULL) {
+        lastError = FormatWin32Error("未能打开共享内存", ::GetLastError());
+        return false;
+    }
+    data = MapViewOfFile(hMapFile, access, 0, 0, mapSize);
+    if (data == nullptr) {
+        lastError = FormatWin32Error("未能映射共享内存视图", ::GetLastError());
+        CloseHandle(hMapFile);
+        hMapFile = NULL;
+        return false;
+    }
+    if (mapSize == 0) {
+        // 整个视图可能由多个（已提交/仅保留）区域组成，累加属于同一分配的区域得到视图大小
+        MEMORY_BASIC_INFORMATION info{};
+        char* base = static_cast<char*>(data);
+        while (VirtualQuery(base + mapSize, &info, sizeof(info)) == sizeof(info) && info.AllocationBase == data) {
+            mapSize += info.RegionSize;
+        }
+    }
+    size = mapSize;
+    committed = mapSize;
+    alreadyExisted = true;
+    return true;
+}
+
+void SharedMemoryBackend::Close() {
+    if (data) {
+        UnmapViewOfFile(data);
+        data = nullptr;
+    }
+    if (hMapFile) {
+        CloseHandle(hMapFile);
+        hMapFile = NULL;
+    }
+    size = 0;
+    committed = 0;
+}
+
+void SharedMemoryBackend::Unlink(const std::string&) {}
+
+#else
+
+static std::string FormatErrno(const std::string& what) {
+    std::stringstream ss;
+    ss << what << "。errno: " << errno << " (" << std::strerror(errno) << ")";
+    return ss.str();
+}
+
+bool SharedMemoryBackend::Create(size_t commitSize, size_t reserveSize) {
+    Close();
+    lastError.clear();
+    const std::string shmName = "/" + name;
+    const size_t mapSize = reserveSize > commitSize ? reserveSize : commitSize;
+
+    fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+    alreadyExisted = false;
+    if (fd < 0 && errno == EEXIST) {
+        fd = shm_open(shmName.c_str(), O_RDWR, 0666);
+        alreadyExisted = true;
+    }
+    if (fd < 0) {
+        lastError = FormatErrno("shm_open 失败: " + shmName);
+        return false;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        lastError = FormatErrno("fstat 失败: " + shmName);
+        Close();
+        return false;
+    }
+    if (static_cast<size_t>(st.st_size) < mapSize && ftruncate(fd, static_cast<off_t>(mapSize)) != 0) {
+        lastError = FormatErrno("ftruncate 失败: " + shmName);
+        Close();
+        return false;
+    }
+    void* p = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        lastError = FormatErrno("mmap 失败: " + shmName);
+        Close();
+        return false;
+    }
+    data = p;
+    size = mapSize;
+    committed = commitSize;
+    return true;
+}
+
+bool SharedMemoryBackend::Commit(size_t newSize) {
+    // 对象已 ftruncate 到预留大小，tmpfs 按页分配，这里只记录可用范围
+    if (!data || newSize > size) {
+        lastError = "提交大小超出预留的共享内存范围";
+        return false;
+    }
+    if (newSize > committed) committed = newSize;
+    return true;
+}
+
+bool SharedMemoryBackend::Open(size_t mapSize, bool readOnly) {
+    Close();
+    lastError.clear();
+    const std::string shmName = "/" + name;
+    fd = shm_open(shmName.c_str(), readOnly ? O_RDONLY : O_RDWR, 0);
+    if (fd < 0) {
+        lastError = FormatErrno("shm_open 失败: " + shmName);
+        return false;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < mapSize || st.st_size == 0) {
+        lastError = "共享内存尺寸不足: " + shmName;
+        Close();
+        return false;
+    }
+    if (mapSize == 0) mapSize = static_cast<size_t>(st.st_size);
+    void* p = mmap(nullptr, mapSize, readOnly ? PROT_READ : (PROT_READ | PROT_WRITE), MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        lastError = FormatErrno("mmap 失败: " + shmName);
+        Close();
+        return false;
+    }
+    data = p;
+    size = mapSize;
+    committed = mapSize;
+    alreadyExisted = true;
+    return true;
+}
+
+void SharedMemoryBackend::Close() {
+    if (data) {
+        munmap(data, size);
+        data = nullptr;
+    }
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    size = 0;
+    committed = 0;
+}
+
+void SharedMemoryBackend::Unlink(const std::string& name) {
+    shm_unlink(("/" + name).c_str());
+}
+
+#endif
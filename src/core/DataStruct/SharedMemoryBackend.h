@@ -0,0 +1,54 @@
+#pragma once
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <cstddef>
+#include <string>
+
+// 共享内存映射后端
+// Windows: 命名文件映射（依次尝试 Global\ / Local\ / 无前缀）
+// 其他平台: POSIX shm_open + mmap，作为文件映射的替身用于 Linux 上的压力测试
+// 写端一次性预留 reserveSize 的地址空间并映射，只提交实际需要的部分；扩容时地址不变
+// （Windows: SEC_RESERVE + VirtualAlloc(MEM_COMMIT)；POSIX: ftruncate 到预留大小，tmpfs 按页按需分配）
+class SharedMemoryBackend {
+public:
+    static constexpr const char* kDefaultName = "SystemMonitorSharedMemory";
+
+    explicit SharedMemoryBackend(const std::string& name = kDefaultName);
+    ~SharedMemoryBackend();
+    SharedMemoryBackend(const SharedMemoryBackend&) = delete;
+    SharedMemoryBackend& operator=(const SharedMemoryBackend&) = delete;
+
+    // 写端：创建（或打开已有的）映射并以读写方式映射到本进程
+    // commitSize 为初始可用字节数，reserveSize 为可增长到的上限（0 表示与 commitSize 相同）
+    bool Create(size_t commitSize, size_t reserveSize = 0);
+    // 写端：将可用字节数扩大到 newSize（不超过预留大小），映射地址不变
+    bool Commit(size_t newSize);
+    // 读端：打开已存在的映射，size 为需要映射的字节数，0 表示映射整个对象
+    bool Open(size_t size, bool readOnly = true);
+    void Close();
+
+    // 删除命名对象（仅 POSIX 有效；Windows 映射在最后一个句柄关闭时自动释放）
+    static void Unlink(const std::string& name = kDefaultName);
+
+    void* Data() const { return data; }
+    size_t Size() const { return size; }            // 已映射的字节数（写端为预留大小）
+    size_t CommittedSize() const { return committed; }
+    bool IsOpen() const { return data != nullptr; }
+    bool AlreadyExisted() const { return alreadyExisted; }
+    const std::string& GetLastError() const { return lastError; }
+    const std::string& GetName() const { return name; }
+
+private:
+    std::string name;
+    void* data = nullptr;
+    size_t size = 0;
+    size_t committed = 0;
+    bool alreadyExisted = false;
+    std::string lastError;
+#ifdef _WIN32
+    HANDLE hMapFile = NULL;
+#else
+    int fd = -1;
+#endif
+};
@@ -30,212 +30,837 @@
 #endif
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cstring>
 
+#ifdef _WIN32
 // Make sure Windows.h is included before any other headers that might redefine GetLastError
 #include <Windows.h>
+#endif
 
 #include "SharedMemoryManager.h"
+#include "SeqLock.h"
+#include "SnapshotSlots.h"
+#include "SharedMemorySections.h"
+#include "HistoryRing.h"
+#include "WriterLease.h"
+#include "SectionOwnership.h"
 // Fix the include path case sensitivity
 #include "../Utils/WinUtils.h"
 #include "../Utils/Logger.h"
+#include "../disk/SmartCatalog.h"
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
-
-#ifndef WINUTILS_IMPLEMENTED
-// Fallback implementation for FormatWindowsErrorMessage
-inline std::string FallbackFormatWindowsErrorMessage(DWORD errorCode) {
-    std::stringstream ss;
-    ss << "错误码: " << errorCode;
-    return ss.str();
-}
-#endif
-
+#include <string>
 
 // Initialize static members
-HANDLE SharedMemoryManager::hMapFile = NULL;
+SharedMemoryBackend SharedMemoryManager::backend;
+PublishNotifier SharedMemoryManager::notifier;
+SharedMemoryLayout* SharedMemoryManager::pLayout = nullptr;
 SharedMemoryBlock* SharedMemoryManager::pBuffer = nullptr;
 std::string SharedMemoryManager::lastError = "";
-// 跨进程互斥体用于同步共享内存
-static HANDLE g_hMutex = NULL;
+uint64_t SharedMemoryManager::pinnedSinceNs[SHM_SNAPSHOT_SLOTS] = {};
+uint64_t SharedMemoryManager::lastPinCheckNs = 0;
+int SharedMemoryManager::producerIndex = -1;
+uint32_t SharedMemoryManager::ownedSections = 0;
+SharedCollectorStatus SharedMemoryManager::collectorStatus[SHM_MAX_COLLECTORS] = {};
+int SharedMemoryManager::collectorCount = 0;
+bool SharedMemoryManager::collectorStatusDirty = false;
+SharedSelfOverhead SharedMemoryManager::selfOverhead = {};
+bool SharedMemoryManager::selfOverheadDirty = false;
+SharedMemoryBlock SharedMemoryManager::staging = {};
+SystemInfo SharedMemoryManager::previousInfo = {};
+bool SharedMemoryManager::hasPreviousInfo = false;
+bool SharedMemoryManager::dirtyTrackingEnabled = true;
+size_t SharedMemoryManager::lastWriteBytes = 0;
+
+namespace {
+
+// 发布锁的作用域守卫：异常离开写临界区时也会解锁
+class PublishLockGuard {
+public:
+    explicit PublishLockGuard(SharedMemoryHeader& header)
+        : header(header), recovered(SectionOwnership::LockPublish(header)) {}
+    ~PublishLockGuard() { SectionOwnership::UnlockPublish(header); }
+    PublishLockGuard(const PublishLockGuard&) = delete;
+    PublishLockGuard& operator=(const PublishLockGuard&) = delete;
+    // 锁是从已退出的持有者手中接管的
+    bool Recovered() const { return recovered; }
+
+private:
+    SharedMemoryHeader& header;
+    bool recovered;
+};
 
-bool SharedMemoryManager::InitSharedMemory() {
+} // namespace
+
+bool SharedMemoryManager::InitSharedMemory(uint32_t sectionMask) {
     // Clear any previous error
     lastError.clear();
-        
-    try {
-        // Try to enable privileges needed for creating global objects
-        bool hasPrivileges = WinUtils::EnablePrivilege(L"SeCreateGlobalPrivilege");
-        if (!hasPrivileges) {
-            Logger::Warn("未能启用 SeCreateGlobalPrivilege - 尝试继续");
-        }
-    } catch(...) {
-        Logger::Warn("启用 SeCreateGlobalPrivilege 时发生异常 - 尝试继续");
-        // Continue execution as this is not critical
+    if (!SectionOwnership::ValidateMask(sectionMask, lastError)) {
+        Logger::Error(lastError);
+        return false;
     }
 
-    // 创建全局互斥体用于多进程同步
-    if (!g_hMutex) {
-        g_hMutex = CreateMutexW(NULL, FALSE, L"Global\\SystemMonitorSharedMemoryMutex");
-        if (!g_hMutex) {
-            Logger::Error("未能创建全局互斥体用于共享内存同步");
+    // 预留 SHM_MAX_MAPPING_SIZE 的地址空间，先提交固定部分 + 各变长段的最小容量，主机规模更大时再按需提交
+    if (!backend.Create(sizeof(SharedMemoryLayout), SHM_MAX_MAPPING_SIZE)) {
+        lastError = backend.GetLastError();
+        Logger::Error(lastError);
+        return false;
+    }
+
+    // Check if we created a new mapping or opened an existing one
+    if (backend.AlreadyExisted()) {
+        Logger::Info("打开了现有的共享内存映射.");
+    } else {
+        Logger::Info("创建了新的共享内存映射.");
+    }
+
+    pLayout = static_cast<SharedMemoryLayout*>(backend.Data());
+    pBuffer = &pLayout->block;
+    hasPreviousInfo = false; // 新映射（或重新打开）后第一轮全量写入
+
+    // Zero out the shared memory to avoid dirty data (only on first creation)
+    if (!backend.AlreadyExisted()) {
+        memset(static_cast<void*>(pLayout), 0, sizeof(SharedMemoryLayout));
+    }
+    // 布局为当前版本且主写端仍存活时作为附加写端附着，只发布 sectionMask 中的分区；否则作为主写端（重新）初始化布局
+    const SharedMemoryHeader& header = pLayout->header;
+    const bool layoutCurrent = backend.AlreadyExisted() && header.magic == SHM_LAYOUT_MAGIC &&
+                               header.layoutVersion == SHM_LAYOUT_VERSION;
+    const bool attach = layoutCurrent && WriterLease::IsHeldByOther(header.writer);
+    if (!(attach ? AttachProducer(sectionMask) : InitPrimary(sectionMask, layoutCurrent))) {
+        Logger::Error(lastError);
+        pLayout = nullptr;
+        pBuffer = nullptr;
+        backend.Close();
+        return false;
+    }
+    // 通知对象创建失败不影响发布，读端会退回定时轮询
+    if (!notifier.Create()) {
+        Logger::Warn(notifier.GetLastError() + " - 读端将退回定时轮询");
+    }
+
+    if (attach) {
+        Logger::Info("作为附加写端 #" + std::to_string(producerIndex) + " 附着到共享内存，发布分区掩码 " +
+                     std::to_string(ownedSections));
+    } else {
+        Logger::Info("共享内存成功初始化.");
+    }
+    return true;
+}
+
+bool SharedMemoryManager::InitPrimary(uint32_t sectionMask, bool layoutCurrent) {
+    SharedMemoryHeader& header = pLayout->header;
+    if (!layoutCurrent) {
+        // 新映射或旧版本布局：分区状态与附加写端租约在旧版本中是保留字段或变长段数据，从零开始；
+        // 旧兼容块的结构也不同，清空后由各写端重新发布
+        memset(static_cast<void*>(header.sections), 0, sizeof(header.sections));
+        memset(static_cast<void*>(&pLayout->producerTable), 0, sizeof(SharedProducerTable));
+        memset(static_cast<void*>(&pLayout->collectors), 0, sizeof(SharedCollectorTable));
+        memset(static_cast<void*>(&pLayout->overhead), 0, sizeof(SharedOverheadTable));
+        memset(static_cast<void*>(pBuffer), 0, sizeof(SharedMemoryBlock));
+        header.publishLock.store(0, std::memory_order_relaxed);
+        header.readerActivityNs.store(0, std::memory_order_relaxed);
+    }
+    if (pLayout->history.capacity != SHM_HISTORY_CAPACITY || pLayout->history.sampleSize != sizeof(HistorySample)) {
+        HistoryRing::Reset(pLayout->history);
+    }
+    // 主写端租约由存活的其他进程持有时放弃；上一个主写端崩溃时接管并修复其遗留状态
+    bool reclaimed = false;
+    const uint32_t previousWriter = header.writer.pid.load(std::memory_order_relaxed);
+    if (!WriterLease::Acquire(header.writer, kPublishIntervalMs, reclaimed, lastError)) {
+        return false;
+    }
+    PublishLockGuard lock(header);
+    if (reclaimed) {
+        Logger::Warn("上一个写端进程 (PID " + std::to_string(previousWriter) + ") 未正常退出，接管其遗留的共享内存");
+    }
+    if (reclaimed || lock.Recovered()) {
+        RepairInterruptedWrites();
+    }
+    // 附加写端仍在发布时保留现有段表与变长段内容，只为本进程视图提交所需页面
+    if (layoutCurrent && SectionOwnership::HasLiveProducers(*pLayout)) {
+        if (!backend.Commit(header.totalSize.load(std::memory_order_acquire))) {
+            lastError = "共享内存变长段提交失败: " + backend.GetLastError();
+            WriterLease::Release(header.writer);
             return false;
         }
+    } else if (!InitSectionTable()) {
+        WriterLease::Release(header.writer);
+        return false;
+    }
+    if (!SectionOwnership::Claim(*pLayout, SectionOwnership::kPrimary, sectionMask, lastError)) {
+        SectionOwnership::Release(*pLayout, SectionOwnership::kPrimary);
+        return false;
     }
+    producerIndex = SectionOwnership::kPrimary;
+    ownedSections = sectionMask;
+    collectorStatusDirty = collectorCount > 0; // 重新初始化后补发采集器状态与自身开销
+    selfOverheadDirty = selfOverhead.pid != 0;
+    return true;
+}
 
-    // Create security attributes to allow sharing between processes
-    SECURITY_ATTRIBUTES securityAttributes;
-    SECURITY_DESCRIPTOR securityDescriptor;
-
-    // Initialize the security descriptor
-    if (!InitializeSecurityDescriptor(&securityDescriptor, SECURITY_DESCRIPTOR_REVISION)) {
-        DWORD errorCode = ::GetLastError();
-        std::stringstream ss;
-        ss << "未能初始化安全描述符。错误码: " << errorCode
-           << " ("
-           #ifdef WINUTILS_IMPLEMENTED
-                << WinUtils::FormatWindowsErrorMessage(errorCode)
-           #else
-                << FallbackFormatWindowsErrorMessage(errorCode)
-           #endif
-           << ")";
-        lastError = ss.str();
-        Logger::Error(lastError);
+bool SharedMemoryManager::AttachProducer(uint32_t sectionMask) {
+    PublishLockGuard lock(pLayout->header);
+    if (lock.Recovered()) {
+        RepairInterruptedWrites();
+    }
+    const int producer = SectionOwnership::AcquireProducerSlot(*pLayout, kPublishIntervalMs, lastError);
+    if (producer < 0) {
+        return false;
+    }
+    if (!SectionOwnership::Claim(*pLayout, producer, sectionMask, lastError)) {
+        SectionOwnership::Release(*pLayout, producer);
+        return false;
+    }
+    // 变长段可能已被其他写端扩容，按当前大小提交本进程视图
+    if (!backend.Commit(pLayout->header.totalSize.load(std::memory_order_acquire))) {
+        lastError = "共享内存变长段提交失败: " + backend.GetLastError();
+        SectionOwnership::Release(*pLayout, producer);
         return false;
     }
+    producerIndex = producer;
+    ownedSections = sectionMask;
+    collectorStatusDirty = collectorCount > 0; // 重新初始化后补发采集器状态与自身开销
+    selfOverheadDirty = selfOverhead.pid != 0;
+    return true;
+}
 
-    // Set the DACL to NULL for unrestricted access
-    if (!SetSecurityDescriptorDacl(&securityDescriptor, TRUE, NULL, FALSE)) {
-        DWORD errorCode = ::GetLastError();
-        std::stringstream ss;
-        ss << "未能设置安全描述符 DACL。错误码: " << errorCode
-           << " ("
-           #ifdef WINUTILS_IMPLEMENTED
-                << WinUtils::FormatWindowsErrorMessage(errorCode)
-           #else
-                << FallbackFormatWindowsErrorMessage(errorCode)
-           #endif
-           << ")";
-        lastError = ss.str();
-        Logger::Error(lastError);
+void SharedMemoryManager::SetCollectorStatus(const SharedCollectorStatus* entries, int count) {
+    count = std::max(0, std::min(count, SHM_MAX_COLLECTORS));
+    // 状态未变时不重写共享内存
+    if (count == collectorCount && memcmp(collectorStatus, entries, count * sizeof(SharedCollectorStatus)) == 0) return;
+    memcpy(collectorStatus, entries, count * sizeof(SharedCollectorStatus));
+    collectorCount = count;
+    collectorStatusDirty = true;
+}
+
+void SharedMemoryManager::SetSelfOverhead(const SharedSelfOverhead& overhead) {
+    selfOverhead = overhead;
+    selfOverheadDirty = true;
+}
+
+void SharedMemoryManager::CleanupSharedMemory() {
+    // 放弃分区与租约只改写几个原子字段，不取发布锁：控制台关闭回调可能在本进程持锁发布期间调用这里
+    if (pLayout && producerIndex >= 0) {
+        SectionOwnership::Release(*pLayout, producerIndex);
+        pLayout->collectors.counts[producerIndex] = 0;
+        pLayout->overhead.entries[producerIndex].pid = 0;
+    }
+    producerIndex = -1;
+    ownedSections = 0;
+    pBuffer = nullptr;
+    pLayout = nullptr;
+    notifier.Close();
+    backend.Close();
+}
+
+bool SharedMemoryManager::IsReaderAttached(std::chrono::milliseconds window) {
+    if (!pLayout) return false;
+    const uint64_t activityNs = pLayout->header.readerActivityNs.load(std::memory_order_relaxed);
+    if (activityNs == 0) return false;
+    const uint64_t nowNs = WriterLease::MonotonicNowNs();
+    return nowNs < activityNs ||
+           nowNs - activityNs <= static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(window).count());
+}
+
+bool SharedMemoryManager::ReadPublishedCpuUsage(double& usage) {
+    if (!pLayout) return false;
+    double published = 0.0;
+    if (!SharedMemorySections::ReadSections(pLayout->header, 1u << SHM_SECTION_LOAD,
+                                            [&] { published = pLayout->hot.cpuUsage; })) {
         return false;
     }
+    usage = published;
+    return true;
+}
 
-    // Setup security attributes
-    securityAttributes.nLength = sizeof(SECURITY_ATTRIBUTES);
-    securityAttributes.lpSecurityDescriptor = &securityDescriptor;
-    securityAttributes.bInheritHandle = FALSE;
-
-    // Create file mapping object in Global namespace
-    hMapFile = CreateFileMapping(
-        INVALID_HANDLE_VALUE,
-        &securityAttributes,
-        PAGE_READWRITE,
-        0,
-        sizeof(SharedMemoryBlock),
-        L"Global\\SystemMonitorSharedMemory"
-    );
-    if (hMapFile == NULL) {
-        DWORD errorCode = ::GetLastError();
-        // Fallback if Global is not permitted, try Local or no prefix
-        Logger::Warn("未能创建全局共享内存，尝试本地命名空间");
-
-        hMapFile = CreateFileMapping(
-            INVALID_HANDLE_VALUE,
-            &securityAttributes,
-            PAGE_READWRITE,
-            0,
-            sizeof(SharedMemoryBlock),
-            L"Local\\SystemMonitorSharedMemory"
-        );
-        if (hMapFile == NULL) {
-            hMapFile = CreateFileMapping(
-                INVALID_HANDLE_VALUE,
-                &securityAttributes,
-                PAGE_READWRITE,
-                0,
-                sizeof(SharedMemoryBlock),
-                L"SystemMonitorSharedMemory"
-            );
-        }
+std::string SharedMemoryManager::GetLastError() {
+    return lastError;
+}
 
-        // If still NULL after fallbacks, report error
-        if (hMapFile == NULL) {
-            errorCode = ::GetLastError();
-            std::stringstream ss;
-            ss << "未能创建共享内存。错误码: " << errorCode
-               << " ("
-               #ifdef WINUTILS_IMPLEMENTED
-                    << WinUtils::FormatWindowsErrorMessage(errorCode)
-               #else
-                    << FallbackFormatWindowsErrorMessage(errorCode)
-               #endif
-               << ")";
-            // Possibly shared memory already exists
-            if (errorCode == ERROR_ALREADY_EXISTS) {
-                ss << " (共享内存已存在)";
-            }
-            lastError = ss.str();
-            Logger::Error(lastError);
+namespace {
+
+void SafeCopyWideString(wchar_t* dest, size_t destSize, const std::wstring& src) {
+    try {
+        if (dest == nullptr || destSize == 0) return;
+        memset(dest, 0, destSize * sizeof(wchar_t));
+        if (src.empty()) { dest[0] = L'\0'; return; }
+        size_t copyLen = std::min(src.length(), destSize - 1);
+        for (size_t i = 0; i < copyLen; ++i) dest[i] = src[i];
+        dest[copyLen] = L'\0';
+    } catch (...) { if (dest && destSize > 0) dest[0] = L'\0'; }
+}
+
+void SafeCopyFromWideArray(wchar_t* dest, size_t destSize, const wchar_t* src, size_t srcCapacity) {
+    if (!dest || destSize == 0) return;
+    memset(dest, 0, destSize * sizeof(wchar_t));
+    if (!src) return;
+    size_t len = 0;
+    while (len < srcCapacity && src[len] != L'\0') ++len;
+    if (len >= destSize) len = destSize - 1;
+    for (size_t i = 0; i < len; ++i) dest[i] = src[i];
+    dest[len] = L'\0';
+}
+
+// 打包结构（#pragma pack(1)）无填充字节，可直接按字节比较；字符串尾部的残留只会导致误报“已变化”
+template <typename T>
+bool PodVectorEquals(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+bool DisksEqual(const std::vector<DiskData>& a, const std::vector<DiskData>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].letter != b[i].letter || a[i].label != b[i].label || a[i].fileSystem != b[i].fileSystem ||
+            a[i].totalSize != b[i].totalSize || a[i].usedSpace != b[i].usedSpace || a[i].freeSpace != b[i].freeSpace) {
             return false;
         }
     }
+    return true;
+}
 
-    // Check if we created a new mapping or opened an existing one
-    DWORD errorCode = ::GetLastError();
-    if (errorCode == ERROR_ALREADY_EXISTS) {
-        Logger::Info("打开了现有的共享内存映射.");
-    } else {
-        Logger::Info("创建了新的共享内存映射.");
+// ---- 单个元素的转换（兼容块与变长段共用），调用前 dst 应已清零 ----
+
+void FillGpu(GPUData& dst, const GPUData& src) {
+    SafeCopyFromWideArray(dst.name, 128, src.name, 128);
+    SafeCopyFromWideArray(dst.brand, 64, src.brand, 64);
+    dst.memory = src.memory;
+    dst.coreClock = src.coreClock;
+    dst.isVirtual = src.isVirtual;
+}
+
+// GPU（兼容旧字段）：SystemInfo.gpus 为空时由 gpuName 等单值字段构造
+void FillLegacyGpu(GPUData& dst, const SystemInfo& systemInfo) {
+    WinUtils::Utf8ToWideBuffer(systemInfo.gpuName, dst.name, 128);
+    WinUtils::Utf8ToWideBuffer(systemInfo.gpuBrand, dst.brand, 64);
+    dst.memory = systemInfo.gpuMemory;
+    dst.coreClock = systemInfo.gpuCoreFreq;
+    dst.isVirtual = systemInfo.gpuIsVirtual;
+}
+
+size_t GpuSourceCount(const SystemInfo& systemInfo) {
+    if (!systemInfo.gpus.empty()) return systemInfo.gpus.size();
+    return systemInfo.gpuName.empty() ? 0 : 1;
+}
+
+void FillGpuAt(GPUData& dst, size_t i, const SystemInfo& systemInfo) {
+    if (!systemInfo.gpus.empty()) FillGpu(dst, systemInfo.gpus[i]);
+    else FillLegacyGpu(dst, systemInfo);
+}
+
+// 网络适配器（SystemInfo.adapters 里的 NetworkAdapterData 为 wchar_t 数组字段）
+void FillAdapter(NetworkAdapterData& dst, const NetworkAdapterData& src) {
+    SafeCopyFromWideArray(dst.name, 128, src.name, 128);
+    SafeCopyFromWideArray(dst.mac, 32, src.mac, 32);
+    SafeCopyFromWideArray(dst.ipAddress, 64, src.ipAddress, 64);
+    SafeCopyFromWideArray(dst.adapterType, 32, src.adapterType, 32);
+    dst.speed = src.speed;
+}
+
+void FillLegacyAdapter(NetworkAdapterData& dst, const SystemInfo& systemInfo) {
+    WinUtils::Utf8ToWideBuffer(systemInfo.networkAdapterName, dst.name, 128);
+    WinUtils::Utf8ToWideBuffer(systemInfo.networkAdapterMac, dst.mac, 32);
+    WinUtils::Utf8ToWideBuffer(systemInfo.networkAdapterIp, dst.ipAddress, 64);
+    WinUtils::Utf8ToWideBuffer(systemInfo.networkAdapterType, dst.adapterType, 32);
+    dst.speed = systemInfo.networkAdapterSpeed;
+}
+
+size_t AdapterSourceCount(const SystemInfo& systemInfo) {
+    if (!systemInfo.adapters.empty()) return systemInfo.adapters.size();
+    return systemInfo.networkAdapterName.empty() ? 0 : 1;
+}
+
+void FillAdapterAt(NetworkAdapterData& dst, size_t i, const SystemInfo& systemInfo) {
+    if (!systemInfo.adapters.empty()) FillAdapter(dst, systemInfo.adapters[i]);
+    else FillLegacyAdapter(dst, systemInfo);
+}
+
+// 逻辑磁盘（SystemInfo.disks 中 label / fileSystem 是 std::string）
+void FillDisk(SharedMemoryBlock::SharedDiskData& dst, const DiskData& disk) {
+    dst.letter = disk.letter;
+    std::string safeLabel = disk.label;
+    if (safeLabel.empty()) safeLabel = ""; // 未命名允许为空，在UI端替换
+#ifdef _WIN32
+    else if (!WinUtils::IsLikelyUtf8(safeLabel)) {
+        // 退化处理：按当前ACP转 wide 再回 UTF-8，尽量 salvage
+        std::wstring w = WinUtils::Utf8ToWstring(safeLabel); // 若不是utf8会得到空
+        if (w.empty()) {
+            int len = MultiByteToWideChar(CP_ACP, 0, safeLabel.c_str(), (int)safeLabel.size(), nullptr, 0);
+            if (len > 0) { w.resize(len); MultiByteToWideChar(CP_ACP, 0, safeLabel.c_str(), (int)safeLabel.size(), w.data(), len); }
+        }
+        safeLabel = WinUtils::WstringToUtf8(w);
     }
+#endif
+    WinUtils::Utf8ToWideBuffer(safeLabel, dst.label, 128);
+    WinUtils::Utf8ToWideBuffer(disk.fileSystem, dst.fileSystem, 32);
+    dst.totalSize = disk.totalSize;
+    dst.usedSpace = disk.usedSpace;
+    dst.freeSpace = disk.freeSpace;
+}
 
-    // Map to process address space
-    pBuffer = static_cast<SharedMemoryBlock*>(
-        MapViewOfFile(hMapFile, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedMemoryBlock))
-    );
-    if (pBuffer == nullptr) {
-        DWORD errorCode = ::GetLastError();
-        std::stringstream ss;
-        ss << "未能映射共享内存视图。错误码: " << errorCode
-           << " ("
-           #ifdef WINUTILS_IMPLEMENTED
-                << WinUtils::FormatWindowsErrorMessage(errorCode)
-           #else
-                << FallbackFormatWindowsErrorMessage(errorCode)
-           #endif
-           << ")";
-        lastError = ss.str();
-        Logger::Error(lastError);
-        CloseHandle(hMapFile);
-        hMapFile = NULL;
-        return false;
+// 物理磁盘 + SMART（SystemInfo.physicalDisks 里字段已为 wchar_t 数组）
+// 属性只写数值与 SMART 目录下标；名称 / 描述 / 单位已在初始化时发布到目录，目录未收录的属性在读端显示为未知属性
+void FillPhysicalDisk(SharedPhysicalDiskData& pd, const PhysicalDiskSmartData& src) {
+    SafeCopyFromWideArray(pd.model, 128, src.model, 128);
+    SafeCopyFromWideArray(pd.serialNumber, 64, src.serialNumber, 64);
+    SafeCopyFromWideArray(pd.firmwareVersion, 32, src.firmwareVersion, 32);
+    SafeCopyFromWideArray(pd.interfaceType, 32, src.interfaceType, 32);
+    SafeCopyFromWideArray(pd.diskType, 16, src.diskType, 16);
+    pd.capacity = src.capacity;
+    pd.temperature = src.temperature;
+    pd.healthPercentage = src.healthPercentage;
+    pd.isSystemDisk = src.isSystemDisk;
+    pd.smartEnabled = src.smartEnabled;
+    pd.smartSupported = src.smartSupported;
+    pd.powerOnHours = src.powerOnHours;
+    pd.powerCycleCount = src.powerCycleCount;
+    pd.reallocatedSectorCount = src.reallocatedSectorCount;
+    pd.currentPendingSector = src.currentPendingSector;
+    pd.uncorrectableErrors = src.uncorrectableErrors;
+    pd.wearLeveling = src.wearLeveling;
+    pd.totalBytesWritten = src.totalBytesWritten;
+    pd.totalBytesRead = src.totalBytesRead;
+    int ldCount = 0;
+    for (char l : src.logicalDriveLetters) {
+        if (ldCount >= 8 || l == 0) break;
+        if (std::isalpha(static_cast<unsigned char>(l))) pd.logicalDriveLetters[ldCount++] = l;
     }
+    pd.logicalDriveCount = ldCount;
+    int attrCount = src.attributeCount;
+    if (attrCount < 0) attrCount = 0;
+    if (attrCount > 32) attrCount = 32;
+    pd.attributeCount = attrCount;
+    for (int a = 0; a < attrCount; ++a) {
+        const auto& sa = src.attributes[a];
+        auto& da = pd.attributes[a];
+        da.id = sa.id;
+        da.flags = sa.flags;
+        da.current = sa.current;
+        da.worst = sa.worst;
+        da.threshold = sa.threshold;
+        da.rawValue = sa.rawValue;
+        da.isCritical = sa.isCritical;
+        da.physicalValue = sa.physicalValue;
+        da.catalogIndex = SmartCatalog::IndexOf(sa.id);
+    }
+}
 
+// 温度（传感器名字在 vector<pair<string,double>> 中）
+void FillTemperature(TemperatureData& dst, const std::pair<std::string, double>& temp) {
+    WinUtils::Utf8ToWideBuffer(temp.first, dst.sensorName, 64);
+    dst.temperature = temp.second;
+}
 
-    // 不再在共享内存结构体中初始化CriticalSection
+void FillCore(SharedCoreUsage& dst, size_t i, const SystemInfo& systemInfo) {
+    dst.usage = systemInfo.coreUsage[i];
+    dst.coreClass = i < systemInfo.coreClasses.size() ? systemInfo.coreClasses[i] : static_cast<uint8_t>(SHM_CORE_UNKNOWN);
+}
 
-    // Zero out the shared memory to avoid dirty data (only on first creation)
-    if (errorCode != ERROR_ALREADY_EXISTS) {
-        memset(pBuffer, 0, sizeof(SharedMemoryBlock));
+// 按核心类型汇总：[0] 性能核（未知类型也计入），[1] 能效核
+void SummarizeCores(const SystemInfo& systemInfo, SharedCoreClassSummary* summary) {
+    double sums[2] = {};
+    memset(static_cast<void*>(summary), 0, 2 * sizeof(SharedCoreClassSummary));
+    for (size_t i = 0; i < systemInfo.coreUsage.size(); ++i) {
+        const bool efficiency = i < systemInfo.coreClasses.size() && systemInfo.coreClasses[i] == SHM_CORE_EFFICIENCY;
+        SharedCoreClassSummary& target = summary[efficiency ? 1 : 0];
+        const float usage = systemInfo.coreUsage[i];
+        if (target.count == 0 || usage > target.maximum) {
+            target.maximum = usage;
+            target.busiest = static_cast<uint32_t>(i);
+        }
+        sums[efficiency ? 1 : 0] += usage;
+        ++target.count;
+    }
+    for (int c = 0; c < 2; ++c) {
+        if (summary[c].count) summary[c].average = static_cast<float>(sums[c] / summary[c].count);
+    }
+}
+
+// ---- 变长段 ----
+
+struct VariableSection {
+    SharedMemorySectionId id;
+    int dirtySection;      // 对应的 SharedMemorySection，用于脏跟踪与代数
+    uint32_t elementSize;
+    uint32_t minCapacity;  // 不小于兼容块中的固定上限
+    const char* name;
+};
+
+const VariableSection kVariableSections[] = {
+    { SHM_SEC_GPUS, SHM_SECTION_GPU, sizeof(GPUData), 2, "gpus" },
+    { SHM_SEC_ADAPTERS, SHM_SECTION_ADAPTERS, sizeof(NetworkAdapterData), 4, "adapters" },
+    { SHM_SEC_DISKS, SHM_SECTION_DISKS, sizeof(SharedMemoryBlock::SharedDiskData), 8, "disks" },
+    { SHM_SEC_PHYSICAL_DISKS, SHM_SECTION_SMART, sizeof(SharedPhysicalDiskData), 8, "physicalDisks" },
+    { SHM_SEC_TEMPERATURES, SHM_SECTION_TEMPERATURES, sizeof(TemperatureData), 10, "temperatures" },
+    { SHM_SEC_CORES, SHM_SECTION_LOAD, sizeof(SharedCoreUsage), 64, "cores" },
+};
+constexpr int kVariableSectionCount = sizeof(kVariableSections) / sizeof(kVariableSections[0]);
+constexpr size_t kMaxVariableElementSize = std::max({ sizeof(GPUData), sizeof(NetworkAdapterData),
+    sizeof(SharedMemoryBlock::SharedDiskData), sizeof(SharedPhysicalDiskData), sizeof(TemperatureData), sizeof(SharedCoreUsage) });
+constexpr int kFixedSectionCount = 9;   // 兼容块、快照槽、历史环、热点指标区、SMART 目录、附加写端租约、采集器状态、自身开销、钉住登记
+static_assert(kFixedSectionCount + kVariableSectionCount <= SHM_MAX_SECTION_ENTRIES, "段表容量不足");
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+size_t VariableSourceCount(int v, const SystemInfo& systemInfo) {
+    switch (kVariableSections[v].id) {
+    case SHM_SEC_GPUS: return GpuSourceCount(systemInfo);
+    case SHM_SEC_ADAPTERS: return AdapterSourceCount(systemInfo);
+    case SHM_SEC_DISKS: return systemInfo.disks.size();
+    case SHM_SEC_PHYSICAL_DISKS: return systemInfo.physicalDisks.size();
+    case SHM_SEC_TEMPERATURES: return systemInfo.temperatures.size();
+    case SHM_SEC_CORES: return systemInfo.coreUsage.size();
+    default: return 0;
+    }
+}
+
+void FillVariableElement(int v, void* dst, size_t i, const SystemInfo& systemInfo) {
+    memset(dst, 0, kVariableSections[v].elementSize);
+    switch (kVariableSections[v].id) {
+    case SHM_SEC_GPUS: FillGpuAt(*static_cast<GPUData*>(dst), i, systemInfo); break;
+    case SHM_SEC_ADAPTERS: FillAdapterAt(*static_cast<NetworkAdapterData*>(dst), i, systemInfo); break;
+    case SHM_SEC_DISKS: FillDisk(*static_cast<SharedMemoryBlock::SharedDiskData*>(dst), systemInfo.disks[i]); break;
+    case SHM_SEC_PHYSICAL_DISKS: FillPhysicalDisk(*static_cast<SharedPhysicalDiskData*>(dst), systemInfo.physicalDisks[i]); break;
+    case SHM_SEC_TEMPERATURES: FillTemperature(*static_cast<TemperatureData*>(dst), systemInfo.temperatures[i]); break;
+    case SHM_SEC_CORES: FillCore(*static_cast<SharedCoreUsage*>(dst), i, systemInfo); break;
+    default: break;
+    }
+}
+
+// 变长温度段的元素同时含传感器名称（TEMPERATURES）与温度值（SENSORS），代数取两者之和，任一变化都会推进
+uint32_t VariableGeneration(int v, const uint32_t* generations) {
+    if (kVariableSections[v].id == SHM_SEC_TEMPERATURES) {
+        return generations[SHM_SECTION_TEMPERATURES] + generations[SHM_SECTION_SENSORS];
     }
+    return generations[kVariableSections[v].dirtySection];
+}
 
-    Logger::Info("共享内存成功初始化.");
+bool TemperatureValuesEqual(const std::vector<std::pair<std::string, double>>& a,
+                            const std::vector<std::pair<std::string, double>>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].second != b[i].second) return false;
+    }
     return true;
 }
 
-void SharedMemoryManager::CleanupSharedMemory() {
-    if (pBuffer) {
-        UnmapViewOfFile(pBuffer);
-        pBuffer = nullptr;
+bool SensorNamesEqual(const std::vector<std::pair<std::string, double>>& a,
+                      const std::vector<std::pair<std::string, double>>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].first != b[i].first) return false;
     }
-    if (hMapFile) {
-        CloseHandle(hMapFile);
-        hMapFile = NULL;
+    return true;
+}
+
+void SetEntry(SharedMemorySectionEntry& entry, uint32_t id, uint32_t elementSize, uint64_t offset,
+              uint32_t capacity, uint32_t count, const char* name) {
+    entry.id = id;
+    entry.elementSize = elementSize;
+    entry.offset = offset;
+    entry.capacity = capacity;
+    entry.count = count;
+    entry.generation = 0;
+    entry.reserved = 0;
+    memset(entry.name, 0, sizeof(entry.name));
+    memcpy(entry.name, name, std::min(strlen(name), sizeof(entry.name) - 1));
+}
+
+// SMART 目录只依赖编译期的属性表，每次初始化都重写（内容不变）
+// 重新排布变长段会移动所有分区的数据：期间所有分区序号都置为奇数，只读部分分区的读端也会重试
+void BeginAllSections(SharedMemoryHeader& header, uint64_t* sequences) {
+    for (int s = 0; s < SHM_SECTION_COUNT; ++s) sequences[s] = SeqLock::BeginWrite(header.sections[s].sequence);
+}
+
+void EndAllSections(SharedMemoryHeader& header, const uint64_t* sequences) {
+    for (int s = 0; s < SHM_SECTION_COUNT; ++s) SeqLock::EndWrite(header.sections[s].sequence, sequences[s]);
+}
+
+void FillSmartCatalog(SharedSmartCatalog& catalog) {
+    memset(static_cast<void*>(&catalog), 0, sizeof(SharedSmartCatalog));
+    const SmartCatalog::Entry* entries = SmartCatalog::Entries();
+    const size_t count = std::min(SmartCatalog::Count(), static_cast<size_t>(SHM_SMART_CATALOG_CAPACITY));
+    for (size_t i = 0; i < count; ++i) {
+        SmartCatalogEntry& dst = catalog.entries[i];
+        dst.id = entries[i].id;
+        dst.isCritical = entries[i].critical;
+        SafeCopyWideString(dst.name, 64, entries[i].name);
+        SafeCopyWideString(dst.description, 128, entries[i].description);
+        SafeCopyWideString(dst.units, 16, entries[i].units);
     }
+    catalog.count = static_cast<uint32_t>(count);
+    catalog.entrySize = sizeof(SmartCatalogEntry);
 }
 
-std::string SharedMemoryManager::GetLastError() {
-    return lastError;
+} // namespace
+
+bool SharedMemoryManager::SectionChanged(int section, const SystemInfo& a, const SystemInfo& b) {
+    switch (section) {
+    case SHM_SECTION_CPU:
+        return a.cpuName != b.cpuName || a.physicalCores != b.physicalCores || a.logicalCores != b.logicalCores ||
+            a.performanceCores != b.performanceCores || a.efficiencyCores != b.efficiencyCores ||
+            a.performanceCoreFreq != b.performanceCoreFreq || a.efficiencyCoreFreq != b.efficiencyCoreFreq ||
+            a.hyperThreading != b.hyperThreading || a.virtualization != b.virtualization;
+    case SHM_SECTION_LOAD:
+        return a.cpuUsage != b.cpuUsage || a.cpuUsageSampleIntervalMs != b.cpuUsageSampleIntervalMs ||
+            a.totalMemory != b.totalMemory || a.usedMemory != b.usedMemory || a.availableMemory != b.availableMemory ||
+            a.coreUsage != b.coreUsage || a.coreClasses != b.coreClasses || a.cpuUsageRaw != b.cpuUsageRaw ||
+            a.cpuUsageFilter.kind != b.cpuUsageFilter.kind || a.cpuUsageFilter.periodMs != b.cpuUsageFilter.periodMs ||
+            a.cpuUsageFilter.percentile != b.cpuUsageFilter.percentile;
+    case SHM_SECTION_GPU:
+        return !PodVectorEquals(a.gpus, b.gpus) || a.gpuName != b.gpuName || a.gpuBrand != b.gpuBrand || a.gpuMemory != b.gpuMemory ||
+            a.gpuCoreFreq != b.gpuCoreFreq || a.gpuIsVirtual != b.gpuIsVirtual;
+    case SHM_SECTION_ADAPTERS:
+        return !PodVectorEquals(a.adapters, b.adapters) || a.networkAdapterName != b.networkAdapterName ||
+            a.networkAdapterMac != b.networkAdapterMac || a.networkAdapterIp != b.networkAdapterIp ||
+            a.networkAdapterType != b.networkAdapterType || a.networkAdapterSpeed != b.networkAdapterSpeed;
+    case SHM_SECTION_DISKS:
+        return !DisksEqual(a.disks, b.disks);
+    case SHM_SECTION_SMART:
+        return !PodVectorEquals(a.physicalDisks, b.physicalDisks);
+    case SHM_SECTION_TEMPERATURES:
+        return !SensorNamesEqual(a.temperatures, b.temperatures);
+    case SHM_SECTION_SENSORS:
+        return a.cpuTemperature != b.cpuTemperature || a.gpuTemperature != b.gpuTemperature ||
+            !TemperatureValuesEqual(a.temperatures, b.temperatures);
+    default:
+        return true;
+    }
+}
+
+void SharedMemoryManager::FillSection(SharedMemoryBlock* dst, int section, const SystemInfo& systemInfo) {
+    // 先清零整个分区，计数之外的旧元素不会残留
+    SharedMemorySections::Clear(dst, section);
+
+    switch (section) {
+    case SHM_SECTION_CPU:
+        WinUtils::Utf8ToWideBuffer(systemInfo.cpuName, dst->cpuName, 128);
+        dst->physicalCores = systemInfo.physicalCores;
+        dst->logicalCores = systemInfo.logicalCores;
+        dst->performanceCores = systemInfo.performanceCores;
+        dst->efficiencyCores = systemInfo.efficiencyCores;
+        dst->pCoreFreq = systemInfo.performanceCoreFreq;
+        dst->eCoreFreq = systemInfo.efficiencyCoreFreq;
+        dst->hyperThreading = systemInfo.hyperThreading;
+        dst->virtualization = systemInfo.virtualization;
+        break;
+
+    case SHM_SECTION_LOAD:
+        dst->cpuUsage = systemInfo.cpuUsage;
+        dst->cpuUsageSampleIntervalMs = systemInfo.cpuUsageSampleIntervalMs;
+        dst->totalMemory = systemInfo.totalMemory;
+        dst->usedMemory = systemInfo.usedMemory;
+        dst->availableMemory = systemInfo.availableMemory;
+        break;
+
+    case SHM_SECTION_GPU:
+        // 兼容块最多 2 个 GPU，完整列表见变长段
+        dst->gpuCount = static_cast<int>(std::min(GpuSourceCount(systemInfo), static_cast<size_t>(2)));
+        for (int i = 0; i < dst->gpuCount; ++i) FillGpuAt(dst->gpus[i], i, systemInfo);
+        break;
+
+    case SHM_SECTION_ADAPTERS:
+        dst->adapterCount = static_cast<int>(std::min(AdapterSourceCount(systemInfo), static_cast<size_t>(4)));
+        for (int i = 0; i < dst->adapterCount; ++i) FillAdapterAt(dst->adapters[i], i, systemInfo);
+        break;
+
+    case SHM_SECTION_DISKS:
+        dst->diskCount = static_cast<int>(std::min(systemInfo.disks.size(), static_cast<size_t>(8)));
+        for (int i = 0; i < dst->diskCount; ++i) FillDisk(dst->disks[i], systemInfo.disks[i]);
+        break;
+
+    case SHM_SECTION_SMART:
+        dst->physicalDiskCount = static_cast<int>(std::min(systemInfo.physicalDisks.size(), static_cast<size_t>(8)));
+        for (int i = 0; i < dst->physicalDiskCount; ++i) FillPhysicalDisk(dst->physicalDisks[i], systemInfo.physicalDisks[i]);
+        break;
+
+    case SHM_SECTION_TEMPERATURES:
+        dst->tempCount = static_cast<int>(std::min(systemInfo.temperatures.size(), static_cast<size_t>(10)));
+        // 温度值属于 SENSORS 分区，这里只写传感器名称
+        for (int i = 0; i < dst->tempCount; ++i) {
+            WinUtils::Utf8ToWideBuffer(systemInfo.temperatures[i].first, dst->temperatures[i].sensorName, 64);
+        }
+        break;
+
+    case SHM_SECTION_SENSORS: {
+        dst->cpuTemperature = systemInfo.cpuTemperature;
+        dst->gpuTemperature = systemInfo.gpuTemperature;
+        const size_t sensors = std::min(systemInfo.temperatures.size(), static_cast<size_t>(10));
+        for (size_t i = 0; i < sensors; ++i) dst->temperatures[i].temperature = systemInfo.temperatures[i].second;
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+void SharedMemoryManager::FillBlock(SharedMemoryBlock* dst, const SystemInfo& systemInfo, uint32_t sectionMask) {
+    for (int section = 0; section < SHM_SECTION_COUNT; ++section) {
+        if (sectionMask & (1u << section)) FillSection(dst, section, systemInfo);
+    }
+    dst->lastUpdate = systemInfo.lastUpdate;
+}
+
+size_t SharedMemoryManager::AppendVariableSection(uint32_t id, const SystemInfo& systemInfo, std::string& out, uint32_t& elementSize) {
+    elementSize = 0;
+    for (int v = 0; v < kVariableSectionCount; ++v) {
+        if (kVariableSections[v].id != id) continue;
+        elementSize = kVariableSections[v].elementSize;
+        // 先在对齐的缓冲中填充再追加：out 中的位置不保证满足元素的对齐要求
+        alignas(8) char element[kMaxVariableElementSize];
+        const size_t count = VariableSourceCount(v, systemInfo);
+        for (size_t i = 0; i < count; ++i) {
+            FillVariableElement(v, element, i, systemInfo);
+            out.append(element, elementSize);
+        }
+        return count;
+    }
+    return 0;
+}
+
+bool SharedMemoryManager::InitSectionTable() {
+    uint32_t capacities[SHM_MAX_SECTION_ENTRIES] = {};
+    for (int v = 0; v < kVariableSectionCount; ++v) capacities[v] = kVariableSections[v].minCapacity;
+
+    SharedMemoryHeader& header = pLayout->header;
+    const uint64_t writeSequence = SeqLock::BeginWrite(header.sequence);
+    uint64_t sectionSequences[SHM_SECTION_COUNT];
+    BeginAllSections(header, sectionSequences);
+    header.magic = SHM_LAYOUT_MAGIC;
+    header.layoutVersion = SHM_LAYOUT_VERSION;
+    header.headerSize = sizeof(SharedMemoryHeader);
+    header.sectionTableOffset = offsetof(SharedMemoryLayout, sectionTable);
+    header.sectionTableCount = kFixedSectionCount + kVariableSectionCount;
+
+    SharedMemorySectionEntry* table = pLayout->sectionTable;
+    memset(static_cast<void*>(table), 0, sizeof(pLayout->sectionTable));
+    SetEntry(table[0], SHM_SEC_COMPAT_BLOCK, sizeof(SharedMemoryBlock), offsetof(SharedMemoryLayout, block), 1, 1, "compat");
+    SetEntry(table[1], SHM_SEC_SNAPSHOTS, sizeof(SnapshotSlot), offsetof(SharedMemoryLayout, snapshots),
+             SHM_SNAPSHOT_SLOTS, SHM_SNAPSHOT_SLOTS, "snapshots");
+    SetEntry(table[2], SHM_SEC_HISTORY, sizeof(SharedHistoryRing), offsetof(SharedMemoryLayout, history), 1, 1, "history");
+    SetEntry(table[3], SHM_SEC_HOT_METRICS, sizeof(SharedHotMetrics), offsetof(SharedMemoryLayout, hot), 1, 1, "hot");
+    FillSmartCatalog(pLayout->smartCatalog);
+    SetEntry(table[4], SHM_SEC_SMART_CATALOG, sizeof(SmartCatalogEntry), offsetof(SharedMemoryLayout, smartCatalog) +
+             offsetof(SharedSmartCatalog, entries), SHM_SMART_CATALOG_CAPACITY, pLayout->smartCatalog.count, "smartCatalog");
+    pLayout->producerTable.capacity = SHM_MAX_PRODUCERS - 1;
+    pLayout->producerTable.leaseSize = sizeof(SharedLease);
+    SetEntry(table[5], SHM_SEC_PRODUCERS, sizeof(SharedLease), offsetof(SharedMemoryLayout, producerTable) +
+             offsetof(SharedProducerTable, producers), SHM_MAX_PRODUCERS - 1, SHM_MAX_PRODUCERS - 1, "producers");
+    SharedCollectorTable& collectors = pLayout->collectors;
+    collectors.capacity = SHM_MAX_PRODUCERS * SHM_MAX_COLLECTORS;
+    collectors.entrySize = sizeof(SharedCollectorStatus);
+    collectors.perProducer = SHM_MAX_COLLECTORS;
+    SetEntry(table[6], SHM_SEC_COLLECTORS, sizeof(SharedCollectorStatus), offsetof(SharedMemoryLayout, collectors) +
+             offsetof(SharedCollectorTable, entries), collectors.capacity, collectors.capacity, "collectors");
+    pLayout->overhead.capacity = SHM_MAX_PRODUCERS;
+    pLayout->overhead.entrySize = sizeof(SharedSelfOverhead);
+    SetEntry(table[7], SHM_SEC_OVERHEAD, sizeof(SharedSelfOverhead), offsetof(SharedMemoryLayout, overhead) +
+             offsetof(SharedOverheadTable, entries), SHM_MAX_PRODUCERS, SHM_MAX_PRODUCERS, "overhead");
+    // 读端的钉住登记在写端重启之间保留（读端可能仍持有快照）；表头不符（旧布局遗留的内容）时才清空
+    SharedPinTable& pinOwners = pLayout->pinOwners;
+    if (pinOwners.capacity != SHM_MAX_PIN_OWNERS || pinOwners.entrySize != sizeof(SharedPinOwner)) {
+        memset(static_cast<void*>(&pinOwners), 0, sizeof(pinOwners));
+        pinOwners.capacity = SHM_MAX_PIN_OWNERS;
+        pinOwners.entrySize = sizeof(SharedPinOwner);
+    }
+    SetEntry(table[8], SHM_SEC_PIN_OWNERS, sizeof(SharedPinOwner), offsetof(SharedMemoryLayout, pinOwners) +
+             offsetof(SharedPinTable, owners), SHM_MAX_PIN_OWNERS, SHM_MAX_PIN_OWNERS, "pinOwners");
+    const bool ok = LayoutVariableSections(capacities, false);
+    EndAllSections(header, sectionSequences);
+    SeqLock::EndWrite(header.sequence, writeSequence);
+    return ok;
+}
+
+bool SharedMemoryManager::LayoutVariableSections(const uint32_t* capacities, bool preserve) {
+    // 变长段依次排在固定部分之后，各自按 64 字节对齐
+    size_t offset = AlignUp(sizeof(SharedMemoryLayout), 64);
+    size_t offsets[kVariableSectionCount];
+    for (int v = 0; v < kVariableSectionCount; ++v) {
+        offsets[v] = offset;
+        offset = AlignUp(offset + static_cast<size_t>(capacities[v]) * kVariableSections[v].elementSize, 64);
+    }
+    if (!backend.Commit(offset)) {
+        lastError = "共享内存变长段扩容失败: " + backend.GetLastError();
+        return false;
+    }
+    // 容量只增不减，各段只会后移：从最后一段开始搬移，不会覆盖尚未搬移的数据
+    char* base = reinterpret_cast<char*>(pLayout);
+    for (int v = kVariableSectionCount - 1; v >= 0; --v) {
+        SharedMemorySectionEntry& entry = pLayout->sectionTable[kFixedSectionCount + v];
+        const uint32_t count = preserve ? std::min(entry.count, capacities[v]) : 0;
+        const uint32_t generation = preserve ? entry.generation : 0;
+        if (count != 0 && entry.offset != offsets[v]) {
+            memmove(base + offsets[v], base + entry.offset, static_cast<size_t>(count) * kVariableSections[v].elementSize);
+        }
+        SetEntry(entry, kVariableSections[v].id, kVariableSections[v].elementSize, offsets[v], capacities[v], count,
+                 kVariableSections[v].name);
+        entry.generation = generation;
+    }
+    pLayout->header.totalSize.store(offset, std::memory_order_relaxed);
+    return true;
+}
+
+bool SharedMemoryManager::EnsureVariableCapacity(const SystemInfo& systemInfo) {
+    uint32_t capacities[SHM_MAX_SECTION_ENTRIES] = {};
+    bool grow = false;
+    for (int v = 0; v < kVariableSectionCount; ++v) {
+        const SharedMemorySectionEntry& entry = pLayout->sectionTable[kFixedSectionCount + v];
+        capacities[v] = entry.capacity;
+        // 其他写端的段由其所有者按需扩容
+        const size_t needed = Owns(kVariableSections[v].dirtySection) ? VariableSourceCount(v, systemInfo) : 0;
+        while (capacities[v] < needed) {
+            capacities[v] *= 2;
+            grow = true;
+        }
+    }
+    if (!grow) return false;
+
+    uint64_t sectionSequences[SHM_SECTION_COUNT];
+    BeginAllSections(pLayout->header, sectionSequences);
+    const bool ok = LayoutVariableSections(capacities, true);
+    EndAllSections(pLayout->header, sectionSequences);
+    if (!ok) {
+        // 提交失败时段表保持原样，超出容量的元素在写入时截断
+        Logger::Error(lastError);
+        return false;
+    }
+    Logger::Info("共享内存变长段已扩容，当前大小 " + std::to_string(pLayout->header.totalSize.load()) + " 字节");
+    return true;
+}
+
+size_t SharedMemoryManager::WriteVariableSections(const SystemInfo& systemInfo, const bool* dirty,
+                                                  const uint32_t* generations, bool relayout) {
+    size_t bytes = 0;
+    char* base = reinterpret_cast<char*>(pLayout);
+    for (int v = 0; v < kVariableSectionCount; ++v) {
+        const int section = kVariableSections[v].dirtySection;
+        if (!Owns(section)) continue;
+        // 传感器列表未变、只有温度值变化时，只就地更新各元素的温度值
+        const bool valuesOnly = kVariableSections[v].id == SHM_SEC_TEMPERATURES && !relayout &&
+                                !dirty[section] && dirty[SHM_SECTION_SENSORS];
+        if (!relayout && !dirty[section] && !valuesOnly) continue;
+        SharedMemorySectionEntry& entry = pLayout->sectionTable[kFixedSectionCount + v];
+        const size_t count = std::min(VariableSourceCount(v, systemInfo), static_cast<size_t>(entry.capacity));
+        if (valuesOnly) {
+            auto* sensors = reinterpret_cast<TemperatureData*>(base + entry.offset);
+            for (size_t i = 0; i < count; ++i) sensors[i].temperature = systemInfo.temperatures[i].second;
+            bytes += count * sizeof(double);
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                FillVariableElement(v, base + entry.offset + i * entry.elementSize, i, systemInfo);
+            }
+            bytes += count * entry.elementSize;
+        }
+        entry.count = static_cast<uint32_t>(count);
+        entry.generation = VariableGeneration(v, generations);
+    }
+    return bytes;
 }
 
 void SharedMemoryManager::WriteToSharedMemory(const SystemInfo& systemInfo) {
@@ -245,181 +870,241 @@ void SharedMemoryManager::WriteToSharedMemory(const SystemInfo& systemInfo) {
         return;
     }
 
-    DWORD waitResult = WaitForSingleObject(g_hMutex, 5000); // 最多等5秒
-    if (waitResult != WAIT_OBJECT_0) {
-        Logger::Critical("未能获取共享内存互斥体");
-        return;
+    // 1. 与上一轮 SystemInfo 比较，仅把本进程拥有且变化的分区填入写端私有的暂存块
+    //    这一步不持有发布锁，其他写端可同时发布
+    bool dirty[SHM_SECTION_COUNT];
+    for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+        dirty[s] = Owns(s) && (!dirtyTrackingEnabled || !hasPreviousInfo || SectionChanged(s, systemInfo, previousInfo));
     }
-    auto SafeCopyWideString = [](wchar_t* dest, size_t destSize, const std::wstring& src) {
-        try {
-            if (dest == nullptr || destSize == 0) return;
-            memset(dest, 0, destSize * sizeof(wchar_t));
-            if (src.empty()) { dest[0] = L'\0'; return; }
-            size_t copyLen = std::min(src.length(), destSize - 1);
-            for (size_t i = 0; i < copyLen; ++i) dest[i] = src[i];
-            dest[copyLen] = L'\0';
-        } catch (...) { if (dest && destSize > 0) dest[0] = L'\0'; }
-    };
-    auto SafeCopyFromWideArray = [](wchar_t* dest, size_t destSize, const wchar_t* src, size_t srcCapacity) {
-        if (!dest || destSize == 0) return;
-        memset(dest, 0, destSize * sizeof(wchar_t));
-        if (!src) return;
-        size_t len = 0;
-        while (len < srcCapacity && src[len] != L'\0') ++len;
-        if (len >= destSize) len = destSize - 1;
-        for (size_t i = 0; i < len; ++i) dest[i] = src[i];
-        dest[len] = L'\0';
-    };
     try {
-        // 清零主要字符串/数组区域
-        memset(pBuffer->cpuName, 0, sizeof(pBuffer->cpuName));
-        for (int i = 0; i < 2; ++i) { memset(pBuffer->gpus[i].name, 0, sizeof(pBuffer->gpus[i].name)); memset(pBuffer->gpus[i].brand, 0, sizeof(pBuffer->gpus[i].brand)); }
-        for (int i = 0; i < 8; ++i) { memset(&pBuffer->disks[i], 0, sizeof(pBuffer->disks[i])); memset(&pBuffer->physicalDisks[i], 0, sizeof(pBuffer->physicalDisks[i])); }
-        for (int i = 0; i < 10; ++i) { memset(pBuffer->temperatures[i].sensorName, 0, sizeof(pBuffer->temperatures[i].sensorName)); }
-
-        // CPU
-        SafeCopyWideString(pBuffer->cpuName, 128, WinUtils::StringToWstring(systemInfo.cpuName));
-        pBuffer->physicalCores = systemInfo.physicalCores;
-        pBuffer->logicalCores = systemInfo.logicalCores;
-        pBuffer->cpuUsage = systemInfo.cpuUsage;
-        pBuffer->performanceCores = systemInfo.performanceCores;
-        pBuffer->efficiencyCores = systemInfo.efficiencyCores;
-        pBuffer->pCoreFreq = systemInfo.performanceCoreFreq;
-        pBuffer->eCoreFreq = systemInfo.efficiencyCoreFreq;
-        pBuffer->hyperThreading = systemInfo.hyperThreading;
-        pBuffer->virtualization = systemInfo.virtualization;
-
-        // 内存
-        pBuffer->totalMemory = systemInfo.totalMemory;
-        pBuffer->usedMemory = systemInfo.usedMemory;
-        pBuffer->availableMemory = systemInfo.availableMemory;
-
-        // GPU（兼容旧字段）
-        pBuffer->gpuCount = 0;
-        if (!systemInfo.gpuName.empty()) {
-            SafeCopyWideString(pBuffer->gpus[0].name, 128, WinUtils::StringToWstring(systemInfo.gpuName));
-            SafeCopyWideString(pBuffer->gpus[0].brand, 64, WinUtils::StringToWstring(systemInfo.gpuBrand));
-            pBuffer->gpus[0].memory = systemInfo.gpuMemory;
-            pBuffer->gpus[0].coreClock = systemInfo.gpuCoreFreq;
-            pBuffer->gpus[0].isVirtual = systemInfo.gpuIsVirtual;
-            pBuffer->gpuCount = 1;
+        for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+            if (dirty[s]) FillSection(&staging, s, systemInfo);
         }
-        // 如后续要支持 vector<GPUData> 可在此扩展
-
-        // 网络适配器（SystemInfo.adapters 里的 NetworkAdapterData 为 wchar_t 数组字段）
-        pBuffer->adapterCount = 0;
-        int adapterWriteCount = static_cast<int>(std::min(systemInfo.adapters.size(), size_t(4)));
-        for (int i = 0; i < adapterWriteCount; ++i) {
-            const auto& src = systemInfo.adapters[i];
-            SafeCopyFromWideArray(pBuffer->adapters[i].name, 128, src.name, 128);
-            SafeCopyFromWideArray(pBuffer->adapters[i].mac, 32, src.mac, 32);
-            SafeCopyFromWideArray(pBuffer->adapters[i].ipAddress, 64, src.ipAddress, 64);
-            SafeCopyFromWideArray(pBuffer->adapters[i].adapterType, 32, src.adapterType, 32);
-            pBuffer->adapters[i].speed = src.speed;
+        GetSystemTime(&staging.lastUpdate);
+        previousInfo = systemInfo;
+        hasPreviousInfo = true;
+    } catch (const std::exception& e) {
+        lastError = std::string("WriteToSharedMemory 中的异常: ") + e.what();
+        Logger::Error(lastError);
+        hasPreviousInfo = false; // 下一轮全量重写
+    } catch (...) {
+        lastError = "WriteToSharedMemory 中的未知异常";
+        Logger::Error(lastError);
+        hasPreviousInfo = false;
+    }
+
+    size_t bytesWritten = 0;
+    SharedMemoryHeader& header = pLayout->header;
+    {
+        // 以下只有内存复制，发布锁只在各写端之间串行化这一段
+        PublishLockGuard lock(header);
+        if (lock.Recovered()) {
+            RepairInterruptedWrites();
         }
-        pBuffer->adapterCount = adapterWriteCount;
-        if (adapterWriteCount == 0 && !systemInfo.networkAdapterName.empty()) {
-            SafeCopyWideString(pBuffer->adapters[0].name, 128, WinUtils::StringToWstring(systemInfo.networkAdapterName));
-            SafeCopyWideString(pBuffer->adapters[0].mac, 32, WinUtils::StringToWstring(systemInfo.networkAdapterMac));
-            SafeCopyWideString(pBuffer->adapters[0].ipAddress, 64, WinUtils::StringToWstring(systemInfo.networkAdapterIp));
-            SafeCopyWideString(pBuffer->adapters[0].adapterType, 32, WinUtils::StringToWstring(systemInfo.networkAdapterType));
-            pBuffer->adapters[0].speed = systemInfo.networkAdapterSpeed;
-            pBuffer->adapterCount = 1;
+        ReclaimStalePins();
+
+        // 其他写端的分区沿用其当前代数，本进程拥有的变化分区推进一代
+        uint32_t generations[SHM_SECTION_COUNT];
+        for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+            generations[s] = header.sections[s].generation.load(std::memory_order_relaxed) + (dirty[s] ? 1 : 0);
         }
+        // 本轮发布的单调时间：快照槽与租约使用同一个值，读端据此计算数据年龄
+        const uint64_t publishNs = WriterLease::MonotonicNowNs();
 
-        // 逻辑磁盘（SystemInfo.disks 中 label / fileSystem 是 std::string）
-        pBuffer->diskCount = static_cast<int>(std::min(systemInfo.disks.size(), static_cast<size_t>(8)));
-        for (int i = 0; i < pBuffer->diskCount; ++i) {
-            const auto& disk = systemInfo.disks[i];
-            pBuffer->disks[i].letter = disk.letter;
-            std::string safeLabel = disk.label;
-            if (safeLabel.empty()) safeLabel = ""; // 未命名允许为空，在UI端替换
-            else if (!WinUtils::IsLikelyUtf8(safeLabel)) {
-                // 退化处理：按当前ACP转 wide 再回 UTF-8，尽量 salvage
-                std::wstring w = WinUtils::Utf8ToWstring(safeLabel); // 若不是utf8会得到空
-                if (w.empty()) {
-                    int len = MultiByteToWideChar(CP_ACP, 0, safeLabel.c_str(), (int)safeLabel.size(), nullptr, 0);
-                    if (len > 0) { w.resize(len); MultiByteToWideChar(CP_ACP, 0, safeLabel.c_str(), (int)safeLabel.size(), w.data(), len); }
-                }
-                safeLabel = WinUtils::WstringToUtf8(w);
+        // 2. 快照槽：只补齐该槽落后的分区（槽上次发布后可能错过了若干轮变化），再发布
+        //    本进程的分区取自暂存块，其他写端的分区取自兼容区（发布锁保证其内容完整）
+        //    钉住旧快照的慢读者不受影响
+        const int slot = SnapshotSlots::FindFreeSlot(*pLayout);
+        if (slot >= 0) {
+            SnapshotSlot& target = pLayout->snapshots[slot];
+            for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+                if (dirtyTrackingEnabled && target.sectionGeneration[s] == generations[s]) continue;
+                bytesWritten += SharedMemorySections::Copy(&target.block, Owns(s) ? &staging : pBuffer, s);
+                target.sectionGeneration[s] = generations[s];
             }
-            SafeCopyWideString(pBuffer->disks[i].label, 128, WinUtils::StringToWstring(safeLabel));
-            SafeCopyWideString(pBuffer->disks[i].fileSystem, 32, WinUtils::StringToWstring(disk.fileSystem));
-            pBuffer->disks[i].totalSize = disk.totalSize;
-            pBuffer->disks[i].usedSpace = disk.usedSpace;
-            pBuffer->disks[i].freeSpace = disk.freeSpace;
+            bytesWritten += SharedMemorySections::CopyTimestamp(&target.block, &staging);
+            target.publishNs = publishNs;
+            SnapshotSlots::Publish(*pLayout, slot);
+        } else {
+            Logger::Trace("所有快照槽均被读者钉住，本轮仅更新兼容区");
         }
 
-        // 物理磁盘 + SMART（SystemInfo.physicalDisks 里字段已为 wchar_t 数组）
-        pBuffer->physicalDiskCount = static_cast<int>(std::min(systemInfo.physicalDisks.size(), static_cast<size_t>(8)));
-        for (int i = 0; i < pBuffer->physicalDiskCount; ++i) {
-            const auto& src = systemInfo.physicalDisks[i];
-            SafeCopyFromWideArray(pBuffer->physicalDisks[i].model, 128, src.model, 128);
-            SafeCopyFromWideArray(pBuffer->physicalDisks[i].serialNumber, 64, src.serialNumber, 64);
-            SafeCopyFromWideArray(pBuffer->physicalDisks[i].firmwareVersion, 32, src.firmwareVersion, 32);
-            SafeCopyFromWideArray(pBuffer->physicalDisks[i].interfaceType, 32, src.interfaceType, 32);
-            SafeCopyFromWideArray(pBuffer->physicalDisks[i].diskType, 16, src.diskType, 16);
-            pBuffer->physicalDisks[i].capacity = src.capacity;
-            pBuffer->physicalDisks[i].temperature = src.temperature;
-            pBuffer->physicalDisks[i].healthPercentage = src.healthPercentage;
-            pBuffer->physicalDisks[i].isSystemDisk = src.isSystemDisk;
-            pBuffer->physicalDisks[i].smartEnabled = src.smartEnabled;
-            pBuffer->physicalDisks[i].smartSupported = src.smartSupported;
-            pBuffer->physicalDisks[i].powerOnHours = src.powerOnHours;
-            pBuffer->physicalDisks[i].powerCycleCount = src.powerCycleCount;
-            pBuffer->physicalDisks[i].reallocatedSectorCount = src.reallocatedSectorCount;
-            pBuffer->physicalDisks[i].currentPendingSector = src.currentPendingSector;
-            pBuffer->physicalDisks[i].uncorrectableErrors = src.uncorrectableErrors;
-            pBuffer->physicalDisks[i].wearLeveling = src.wearLeveling;
-            pBuffer->physicalDisks[i].totalBytesWritten = src.totalBytesWritten;
-            pBuffer->physicalDisks[i].totalBytesRead = src.totalBytesRead;
-            int ldCount = 0;
-            for (char l : src.logicalDriveLetters) {
-                if (ldCount >= 8 || l == 0) break;
-                if (std::isalpha(static_cast<unsigned char>(l))) pBuffer->physicalDisks[i].logicalDriveLetters[ldCount++] = l;
+        // 3. 兼容区与变长段：全局序号保护整块读取的旧读者，分区序号只在本轮写入的分区上推进，
+        //    只读其他分区的读端不会因本进程的发布而重试
+        //    序号为奇数期间读端会丢弃副本并重试，写端无需等待任何读端
+        const uint64_t writeSequence = SeqLock::BeginWrite(header.sequence);
+        uint64_t sectionSequences[SHM_SECTION_COUNT];
+        bool opened[SHM_SECTION_COUNT] = {};
+        try {
+            // 主机上的设备数超过当前容量时扩容；重新排布后本进程的变长段都需重写
+            const bool relayout = EnsureVariableCapacity(systemInfo);
+            for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+                if (!dirty[s] && !(relayout && Owns(s))) continue;
+                sectionSequences[s] = SeqLock::BeginWrite(header.sections[s].sequence);
+                opened[s] = true;
+            }
+            for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+                if (!dirty[s]) continue;
+                bytesWritten += SharedMemorySections::Copy(pBuffer, &staging, s);
+                header.sections[s].generation.store(generations[s], std::memory_order_relaxed);
             }
-            pBuffer->physicalDisks[i].logicalDriveCount = ldCount;
-            int attrCount = src.attributeCount;
-            if (attrCount < 0) attrCount = 0; if (attrCount > 32) attrCount = 32;
-            pBuffer->physicalDisks[i].attributeCount = attrCount;
-            for (int a = 0; a < attrCount; ++a) {
-                const auto& sa = src.attributes[a];
-                auto& dst = pBuffer->physicalDisks[i].attributes[a];
-                dst.id = sa.id;
-                dst.flags = sa.flags;
-                dst.current = sa.current;
-                dst.worst = sa.worst;
-                dst.threshold = sa.threshold;
-                dst.rawValue = sa.rawValue;
-                dst.isCritical = sa.isCritical;
-                dst.physicalValue = sa.physicalValue;
-                SafeCopyFromWideArray(dst.name, 64, sa.name, 64);
-                SafeCopyFromWideArray(dst.description, 128, sa.description, 128);
-                SafeCopyFromWideArray(dst.units, 16, sa.units, 16);
+            bytesWritten += SharedMemorySections::CopyTimestamp(pBuffer, &staging);
+            if (collectorStatusDirty) {
+                SharedCollectorTable& collectors = pLayout->collectors;
+                memcpy(&collectors.entries[producerIndex * SHM_MAX_COLLECTORS], collectorStatus,
+                       collectorCount * sizeof(SharedCollectorStatus));
+                collectors.counts[producerIndex] = static_cast<uint32_t>(collectorCount);
+                bytesWritten += collectorCount * sizeof(SharedCollectorStatus);
+                collectorStatusDirty = false;
             }
+            if (selfOverheadDirty) {
+                pLayout->overhead.entries[producerIndex] = selfOverhead;
+                bytesWritten += sizeof(SharedSelfOverhead);
+                selfOverheadDirty = false;
+            }
+            bytesWritten += WriteVariableSections(systemInfo, dirty, generations, relayout);
+            bytesWritten += WriteHotMetrics(systemInfo, generations, dirty);
+        } catch (const std::exception& e) {
+            lastError = std::string("写入变长段时发生异常: ") + e.what();
+            Logger::Error(lastError);
+            hasPreviousInfo = false;
+        }
+        for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+            if (opened[s]) SeqLock::EndWrite(header.sections[s].sequence, sectionSequences[s]);
+        }
+        WriterLease::Beat(SectionOwnership::Lease(*pLayout, producerIndex), publishNs);
+        SeqLock::EndWrite(header.sequence, writeSequence);
+
+        // 历史样本以 CPU / 内存为主，由 LOAD 分区的所有者追加
+        if (Owns(SHM_SECTION_LOAD)) AppendHistory();
+    }
+    // 快照槽、兼容区与历史环均已发布完毕，唤醒等待新数据的读端
+    notifier.Notify(header);
+
+    lastWriteBytes = bytesWritten;
+    // 每轮都会执行：先判断等级，被过滤时不构造消息字符串
+    if (Logger::IsEnabled(LOG_TRACE)) Logger::Trace("成功写入系统/磁盘/SMART 信息到共享内存");
+}
+
+size_t SharedMemoryManager::WriteHotMetrics(const SystemInfo& systemInfo, const uint32_t* generations, const bool* dirty) {
+    SharedHotMetrics& hot = pLayout->hot;
+    size_t bytes = 0;
+    if (dirty[SHM_SECTION_LOAD]) {
+        hot.generation = generations[SHM_SECTION_LOAD];
+        hot.cpuUsage = systemInfo.cpuUsage;
+        hot.cpuUsageSampleIntervalMs = systemInfo.cpuUsageSampleIntervalMs;
+        hot.totalMemory = systemInfo.totalMemory;
+        hot.usedMemory = systemInfo.usedMemory;
+        hot.availableMemory = systemInfo.availableMemory;
+        SummarizeCores(systemInfo, hot.coreSummary);
+        hot.cpuUsageRaw = systemInfo.cpuUsageRaw;
+        hot.cpuUsageFilter = systemInfo.cpuUsageFilter;
+        bytes += offsetof(SharedHotMetrics, cpuTemperature) + sizeof(hot.coreSummary) + sizeof(hot.cpuUsageRaw) + sizeof(hot.cpuUsageFilter);
+    }
+    if (dirty[SHM_SECTION_SENSORS]) {
+        hot.sensorCount = static_cast<uint32_t>(std::min(systemInfo.temperatures.size(), static_cast<size_t>(SHM_HOT_SENSORS)));
+        hot.cpuTemperature = systemInfo.cpuTemperature;
+        hot.gpuTemperature = systemInfo.gpuTemperature;
+        for (uint32_t i = 0; i < hot.sensorCount; ++i) hot.sensorTemperatures[i] = systemInfo.temperatures[i].second;
+        bytes += 2 * sizeof(double) + hot.sensorCount * sizeof(double);
+    }
+    return bytes;
+}
+
+void SharedMemoryManager::AppendHistory() {
+    // 发布锁内调用：样本取自兼容区，温度可能来自其他写端
+    HistorySample sample{};
+    sample.timestampMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    sample.cpuUsage = pBuffer->cpuUsage;
+    sample.usedMemory = pBuffer->usedMemory;
+    sample.availableMemory = pBuffer->availableMemory;
+    sample.cpuTemperature = pBuffer->cpuTemperature;
+    sample.gpuTemperature = pBuffer->gpuTemperature;
+    sample.adapterCount = static_cast<uint32_t>(std::min(std::max(pBuffer->adapterCount, 0), SHM_HISTORY_ADAPTERS));
+    for (uint32_t i = 0; i < sample.adapterCount; ++i) sample.adapterSpeed[i] = pBuffer->adapters[i].speed;
+    sample.diskCount = static_cast<uint32_t>(std::min(std::max(pBuffer->diskCount, 0), SHM_HISTORY_DISKS));
+    for (uint32_t i = 0; i < sample.diskCount; ++i) sample.diskUsedSpace[i] = pBuffer->disks[i].usedSpace;
+    HistoryRing::Append(pLayout->history, sample);
+}
+
+void SharedMemoryManager::RepairInterruptedWrites() {
+    // 写端在写临界区内崩溃时其分区序号停在奇数，兼容区与变长段中该分区的内容可能只写了一半：
+    // 清空这些分区并推进其代数，读端在所有者重新发布前看到的是一致的空数据，而不是撕裂的旧数据
+    SharedMemoryHeader& header = pLayout->header;
+    int repaired = 0;
+    const uint64_t writeSequence = SeqLock::BeginWrite(header.sequence);
+    for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+        SharedSectionState& state = header.sections[s];
+        if ((state.sequence.load(std::memory_order_relaxed) & 1) == 0) continue;
+        // 崩溃写端留下的奇数序号直接视为已进入写临界区，结束时恢复为偶数
+        const uint64_t sectionSequence = state.sequence.load(std::memory_order_relaxed);
+        SharedMemorySections::Clear(pBuffer, s);
+        for (int e = kFixedSectionCount; e < SHM_MAX_SECTION_ENTRIES; ++e) {
+            SharedMemorySectionEntry& entry = pLayout->sectionTable[e];
+            if (entry.id != 0 && (SharedMemorySections::SectionsOf(entry.id) & (1u << s)) != 0) entry.count = 0;
         }
+        state.generation.fetch_add(1, std::memory_order_relaxed);
+        SeqLock::EndWrite(state.sequence, sectionSequence);
+        ++repaired;
+    }
+    SeqLock::EndWrite(header.sequence, writeSequence);
+    if (repaired > 0) {
+        Logger::Warn("上一个写端在写入途中退出，已清空 " + std::to_string(repaired) + " 个未写完的分区");
+    }
+    // 历史环停在写入中的样本会在下一次 Append 时被覆盖；崩溃写端遗留的快照槽钉住由读者计数决定，无需处理
+    for (int i = 0; i < SHM_SNAPSHOT_SLOTS; ++i) pinnedSinceNs[i] = 0;
+}
 
-        // 温度数组（传感器名字在 vector<pair<string,double>> 中）
-        pBuffer->tempCount = static_cast<int>(std::min(systemInfo.temperatures.size(), static_cast<size_t>(10)));
-        for (int i = 0; i < pBuffer->tempCount; ++i) {
-            const auto& temp = systemInfo.temperatures[i];
-            SafeCopyWideString(pBuffer->temperatures[i].sensorName, 64, WinUtils::StringToWstring(temp.first));
-            pBuffer->temperatures[i].temperature = temp.second;
+void SharedMemoryManager::ReclaimStalePins() {
+    // 读者崩溃时可能留下 readers > 0 的槽。按发布轮数判断不可靠（快速模式下几十秒就有几百轮），
+    // 存活读者可以任意长时间持有快照：只回收已退出进程登记的钉住，未登记的钉住按持续时间回收
+    const uint64_t published = pLayout->header.publishedSnapshot.load(std::memory_order_relaxed);
+    const int publishedSlot = SnapshotSlots::EpochOf(published) != 0 ? SnapshotSlots::SlotOf(published) : -1;
+    const uint64_t nowNs = WriterLease::MonotonicNowNs();
+    bool suspect = false;
+    for (int i = 0; i < SHM_SNAPSHOT_SLOTS; ++i) {
+        if (i == publishedSlot || pLayout->snapshots[i].readers.load(std::memory_order_relaxed) == 0) {
+            pinnedSinceNs[i] = 0;
+            continue;
         }
+        if (pinnedSinceNs[i] == 0) pinnedSinceNs[i] = nowNs;
+        if (nowNs - pinnedSinceNs[i] >= kPinCheckNs) suspect = true;
+    }
+    if (!suspect || nowNs - lastPinCheckNs < kPinCheckNs) return;
+    lastPinCheckNs = nowNs;
 
-        // 独立 CPU / GPU 温度
-        pBuffer->cpuTemperature = systemInfo.cpuTemperature;
-        pBuffer->gpuTemperature = systemInfo.gpuTemperature;
-        pBuffer->cpuUsageSampleIntervalMs = systemInfo.cpuUsageSampleIntervalMs;
+    // 1. 已退出的登记读端：把它在各槽上的钉住从读者计数中扣除，再释放条目
+    uint32_t tracked[SHM_SNAPSHOT_SLOTS] = {};
+    for (SharedPinOwner& owner : pLayout->pinOwners.owners) {
+        const uint32_t pid = owner.pid.load(std::memory_order_seq_cst);
+        if (pid == 0) continue;
+        if (WriterLease::IsProcessAlive(pid)) {
+            for (int i = 0; i < SHM_SNAPSHOT_SLOTS; ++i) tracked[i] += owner.pins[i].load(std::memory_order_seq_cst);
+            continue;
+        }
+        uint32_t reclaimed = 0;
+        for (int i = 0; i < SHM_SNAPSHOT_SLOTS; ++i) {
+            const uint32_t pins = owner.pins[i].exchange(0, std::memory_order_seq_cst);
+            reclaimed += SnapshotSlots::Release(pLayout->snapshots[i].readers, pins);
+        }
+        uint32_t expected = pid;
+        owner.pid.compare_exchange_strong(expected, 0, std::memory_order_seq_cst);
+        if (reclaimed > 0) {
+            Logger::Warn("读端进程 " + std::to_string(pid) + " 已退出，回收其遗留的 " + std::to_string(reclaimed) + " 个快照槽钉住");
+        }
+    }
 
-        GetSystemTime(&pBuffer->lastUpdate);
-        Logger::Trace("成功写入系统/磁盘/SMART 信息到共享内存");
-    } catch (const std::exception& e) {
-        lastError = std::string("WriteToSharedMemory 中的异常: ") + e.what();
-        Logger::Error(lastError);
-    } catch (...) {
-        lastError = "WriteToSharedMemory 中的未知异常";
-        Logger::Error(lastError);
+    // 2. 未登记的钉住（登记表已满或不使用登记表的读端）：只能按持续时间判断
+    for (int i = 0; i < SHM_SNAPSHOT_SLOTS; ++i) {
+        if (pinnedSinceNs[i] == 0 || nowNs - pinnedSinceNs[i] < kUntrackedPinTimeoutNs) continue;
+        const uint32_t readers = pLayout->snapshots[i].readers.load(std::memory_order_seq_cst);
+        if (readers <= tracked[i]) continue;
+        const uint32_t released = SnapshotSlots::Release(pLayout->snapshots[i].readers, readers - tracked[i]);
+        if (released > 0) {
+            Logger::Warn("快照槽 " + std::to_string(i) + " 有 " + std::to_string(released) + " 个未登记的钉住持续超过 " +
+                         std::to_string(kUntrackedPinTimeoutNs / 1000000000ULL) + " 秒，视为遗留并回收");
+        }
+        pinnedSinceNs[i] = 0;
     }
-    ReleaseMutex(g_hMutex);
 }
@@ -1,28 +1,113 @@
 #pragma once
 #include "DataStruct.h"
-#include <windows.h>
+#include "SharedMemoryBackend.h"
+#include "PublishNotifier.h"
+#include <chrono>
 #include <string>
 
 // Shared memory management class to avoid multiple definitions
 class SharedMemoryManager {
 private:
-    static HANDLE hMapFile;
+    static SharedMemoryBackend backend;
+    static PublishNotifier notifier; // 发布完成后唤醒阻塞等待的读端
+    static SharedMemoryLayout* pLayout;
     static SharedMemoryBlock* pBuffer;
     static std::string lastError; // Store last error message
+    static constexpr uint32_t kPublishIntervalMs = 1000; // 主循环的标称发布周期，写入头部供读端判断数据是否过期
+    // 遗留钉住的回收：未发布的槽持续被钉住 kPinCheckNs 之后才检查登记读端是否存活（至多每 kPinCheckNs 一次）；
+    // 未登记的钉住无法判断归属，持续 kUntrackedPinTimeoutNs 才回收
+    static constexpr uint64_t kPinCheckNs = 2000000000ULL;
+    static constexpr uint64_t kUntrackedPinTimeoutNs = 600000000000ULL;
+    static uint64_t pinnedSinceNs[SHM_SNAPSHOT_SLOTS]; // 写端私有：各槽开始持续被钉住（且未发布）的单调时间，0 表示未被钉住
+    static uint64_t lastPinCheckNs;
+    static int producerIndex;        // 本进程的写端编号（见 SectionOwnership），未初始化时为 -1
+    static uint32_t ownedSections;   // 本进程发布的分区掩码
+    // 采集器状态（SetCollectorStatus 暂存，下一次发布时写入本写端在状态表中的条目）
+    static SharedCollectorStatus collectorStatus[SHM_MAX_COLLECTORS];
+    static int collectorCount;
+    static bool collectorStatusDirty;
+    // 本写端的自身开销（SetSelfOverhead 暂存，下一次发布时写入开销表的 entries[producerIndex]）
+    static SharedSelfOverhead selfOverhead;
+    static bool selfOverheadDirty;
+
+    // 脏分区跟踪（仅写端使用）：staging 为写端私有的完整块，按分区增量更新后再复制到共享内存
+    static SharedMemoryBlock staging;
+    static SystemInfo previousInfo;
+    static bool hasPreviousInfo;
+    static bool dirtyTrackingEnabled;
+    static size_t lastWriteBytes;
+
+    // 比较两份 SystemInfo 在某个分区上是否不同
+    static bool SectionChanged(int section, const SystemInfo& a, const SystemInfo& b);
+    // 将 SystemInfo 中一个分区的内容填充到 dst（先清零该分区）
+    static void FillSection(SharedMemoryBlock* dst, int section, const SystemInfo& sysInfo);
+    static void ReclaimStalePins();
+    static bool Owns(int section) { return (ownedSections & (1u << section)) != 0; }
+    // 作为主写端初始化（或接管）布局；layoutCurrent 表示映射已是当前版本的布局
+    static bool InitPrimary(uint32_t sectionMask, bool layoutCurrent);
+    // 作为附加写端附着到存活主写端的映射
+    static bool AttachProducer(uint32_t sectionMask);
+    // 某个写端在写临界区内退出后（发布锁内调用）：清空停在写入中的分区，修复其 seqlock
+    static void RepairInterruptedWrites();
+    // 写入自然对齐的热点指标区中本轮变化的字段，返回写入字节数
+    static size_t WriteHotMetrics(const SystemInfo& sysInfo, const uint32_t* generations, const bool* dirty);
+    // 将兼容区当前的热点指标追加到历史环
+    static void AppendHistory();
+
+    // 自描述布局：写入头部魔数/版本与段表，变长段使用最小容量
+    static bool InitSectionTable();
+    // 按给定容量重新排布变长段并提交所需页面；preserve 时把各段已有内容搬到新位置（其他写端的段不会丢失）
+    static bool LayoutVariableSections(const uint32_t* capacities, bool preserve);
+    // 本写端的段容量不足时按 2 倍扩容，返回是否重新排布
+    static bool EnsureVariableCapacity(const SystemInfo& sysInfo);
+    // 写入本写端变化的变长段（relayout 时全部重写），返回写入字节数
+    static size_t WriteVariableSections(const SystemInfo& sysInfo, const bool* dirty,
+                                        const uint32_t* generations, bool relayout);
 
 public:
     // Initialize shared memory
-    static bool InitSharedMemory();
+    // sectionMask 为本进程发布的分区（1 << SharedMemorySection）；映射已由存活的主写端持有时作为附加写端附着，
+    // 只认领这些分区，其余分区由其他写端进程发布
+    static bool InitSharedMemory(uint32_t sectionMask = SHM_ALL_SECTIONS);
 
-    // Write system info to shared memory
+    // Write system info to shared memory (按分区增量更新；快照槽发布 + seqlock 兼容区，不阻塞、不等待读端)
+    // 只发布本进程拥有的分区，sysInfo 中其他分区的字段被忽略
     static void WriteToSharedMemory(const SystemInfo& sysInfo);
 
+    // 暂存本进程各数据源的状态，随下一次 WriteToSharedMemory 发布；超过 SHM_MAX_COLLECTORS 的部分被截断
+    static void SetCollectorStatus(const SharedCollectorStatus* entries, int count);
+    // 暂存本进程的自身开销，随下一次 WriteToSharedMemory 发布
+    static void SetSelfOverhead(const SharedSelfOverhead& overhead);
+
+    // window 内有读端读取过（见 SharedMemoryHeader::readerActivityNs）；只读映射的读端无法上报，视为不存在
+    static bool IsReaderAttached(std::chrono::milliseconds window);
+    // 其他写端发布的主机 CPU 占用率：按 SHM_SECTION_LOAD 分区的 seqlock 读取热点指标区（不受其他分区发布的影响）
+    // 未映射或写端持续写入时返回 false，usage 不变
+    static bool ReadPublishedCpuUsage(double& usage);
+
     // Clean up shared memory resources
     static void CleanupSharedMemory();
 
     // Get buffer pointer (if needed)
     static SharedMemoryBlock* GetBuffer() { return pBuffer; }
+    static SharedMemoryHeader* GetHeader() { return pLayout ? &pLayout->header : nullptr; }
+    static SharedMemoryLayout* GetLayout() { return pLayout; }
+    static bool OwnsSection(int section) { return pLayout != nullptr && Owns(section); }
+    static uint32_t GetOwnedSections() { return ownedSections; }
+    static int GetProducerIndex() { return producerIndex; }
     
+    // 按分区把 SystemInfo 填充到 dst（与兼容区布局相同），不访问共享内存；sectionMask 之外的分区保持不变
+    // 用于在不创建映射的情况下导出快照（见 SnapshotWriter）
+    static void FillBlock(SharedMemoryBlock* dst, const SystemInfo& sysInfo, uint32_t sectionMask);
+    // 变长段 id（SharedMemorySectionId）对应的完整设备列表，不受兼容区数组上限的限制：元素与共享内存中的变长段相同，
+    // 追加到 out 并返回元素个数，elementSize 为单个元素的字节数；id 不是变长段时返回 0 且 elementSize 为 0
+    static size_t AppendVariableSection(uint32_t id, const SystemInfo& sysInfo, std::string& out, uint32_t& elementSize);
+
+    // 关闭后每轮全量写入所有分区（用于基准对比）
+    static void SetDirtyTracking(bool enabled) { dirtyTrackingEnabled = enabled; hasPreviousInfo = false; }
+    // 上一次 WriteToSharedMemory 写入共享内存的字节数（快照槽 + 兼容区）
+    static size_t GetLastWriteBytes() { return lastWriteBytes; }
+
     // Get last error message
     static std::string GetLastError();
 };
@@ -0,0 +1,400 @@
+#include "SharedMemoryReader.h"
+#include "SectionOwnership.h"
+#include "SeqLock.h"
+#include "SharedMemorySections.h"
+#include "SnapshotSlots.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+// SYSTEMTIME（UTC）转 Unix 毫秒，按公历日期直接换算，不依赖平台时间函数
+int64_t SystemTimeToUnixMs(const SYSTEMTIME& st) {
+    const int64_t y = static_cast<int64_t>(st.wYear) - (st.wMonth <= 2 ? 1 : 0);
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const int64_t yoe = y - era * 400;
+    const int64_t m = st.wMonth;
+    const int64_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + st.wDay - 1;
+    const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    const int64_t days = era * 146097 + doe - 719468;
+    return ((days * 24 + st.wHour) * 60 + st.wMinute) * 60000 + static_cast<int64_t>(st.wSecond) * 1000 + st.wMilliseconds;
+}
+
+} // namespace
+
+SharedMemoryReader::Snapshot& SharedMemoryReader::Snapshot::operator=(Snapshot&& other) noexcept {
+    if (this != &other) {
+        Release();
+        layout = other.layout;
+        owner = other.owner;
+        block = other.block;
+        slot = other.slot;
+        version = other.version;
+        publishNs = other.publishNs;
+        std::memcpy(generations, other.generations, sizeof(generations));
+        other.layout = nullptr;
+        other.owner = nullptr;
+        other.block = nullptr;
+        other.slot = -1;
+    }
+    return *this;
+}
+
+void SharedMemoryReader::Snapshot::Release() {
+    if (layout && slot >= 0) {
+        SnapshotSlots::Unpin(*layout, slot, owner);
+    }
+    layout = nullptr;
+    owner = nullptr;
+    block = nullptr;
+    slot = -1;
+}
+
+double SharedMemoryReader::Snapshot::AgeMs() const {
+    if (!block) return -1.0;
+    if (publishNs != 0) {
+        const uint64_t nowNs = WriterLease::MonotonicNowNs();
+        return nowNs > publishNs ? static_cast<double>(nowNs - publishNs) / 1e6 : 0.0;
+    }
+    if (block->lastUpdate.wYear == 0) return -1.0;
+    const int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return static_cast<double>(nowMs - SystemTimeToUnixMs(block->lastUpdate));
+}
+
+SharedMemoryReader::SharedMemoryReader(const std::string& name) : backend(name), notifier(name) {}
+
+SharedMemoryReader::~SharedMemoryReader() {
+    Close();
+}
+
+bool SharedMemoryReader::Open(bool readOnlyMapping) {
+    Close();
+    lastError.clear();
+    readOnly = readOnlyMapping;
+    if (!backend.Open(0, readOnly)) {
+        lastError = backend.GetLastError();
+        return false;
+    }
+    if (backend.Size() < sizeof(SharedMemoryLayout)) {
+        lastError = "共享内存映射过小（" + std::to_string(backend.Size()) + " 字节），写端版本过旧";
+        backend.Close();
+        return false;
+    }
+    auto* mapped = static_cast<SharedMemoryLayout*>(backend.Data());
+    if (mapped->header.magic != SHM_LAYOUT_MAGIC) {
+        lastError = "共享内存布局魔数不匹配，写端版本过旧或尚未完成初始化";
+        backend.Close();
+        return false;
+    }
+    if (mapped->header.layoutVersion < SHM_LAYOUT_VERSION) {
+        // 版本 4 起兼容块中的 SMART 属性改为紧凑格式，旧写端的兼容块与本读端的结构不一致
+        lastError = "写端布局版本过旧（" + std::to_string(mapped->header.layoutVersion) + "），需要版本 " +
+                    std::to_string(SHM_LAYOUT_VERSION);
+        backend.Close();
+        return false;
+    }
+    layout = mapped;
+    // 登记本读端：写端据此区分崩溃读者遗留的钉住与存活读者长时间持有的快照
+    if (!readOnly) pinOwner = SnapshotSlots::ClaimOwner(*layout, WriterLease::CurrentProcessId());
+    // 等待者计数需要写权限；只读映射时 WaitForUpdate 退回轮询
+    canNotify = !readOnly && notifier.Open();
+    local = std::make_unique<SharedMemoryBlock>();
+    localValid = false;
+    for (auto& cache : sectionCache) cache = SectionCache{};
+    lastGeneration = layout->header.publishGeneration.load(std::memory_order_acquire);
+    return true;
+}
+
+void SharedMemoryReader::Close() {
+    SnapshotSlots::ReleaseOwner(pinOwner);
+    pinOwner = nullptr;
+    layout = nullptr;
+    canNotify = false;
+    notifier.Close();
+    backend.Close();
+}
+
+SharedMemoryReader::Snapshot SharedMemoryReader::Acquire() {
+    Snapshot snapshot;
+    if (!layout) {
+        lastError = "共享内存未打开";
+        return snapshot;
+    }
+    MarkActivity();
+    // 先取发布代数再读数据：读到的数据不会比该代数更旧
+    const uint32_t generation = layout->header.publishGeneration.load(std::memory_order_acquire);
+
+    if (!readOnly) {
+        uint64_t epoch = 0;
+        const int slot = SnapshotSlots::Pin(*layout, &epoch, 100, pinOwner);
+        if (slot >= 0) {
+            const SnapshotSlot& pinned = layout->snapshots[slot];
+            snapshot.layout = layout;
+            snapshot.owner = pinOwner;
+            snapshot.slot = slot;
+            snapshot.block = &pinned.block;
+            snapshot.version = epoch;
+            snapshot.publishNs = pinned.publishNs;
+            std::memcpy(snapshot.generations, pinned.sectionGeneration, sizeof(snapshot.generations));
+            lastGeneration = generation;
+            return snapshot;
+        }
+    }
+    // 只读映射、尚未发布快照或所有槽竞争失败：退回 seqlock 复制
+    if (AcquireCopy(snapshot)) lastGeneration = generation;
+    return snapshot;
+}
+
+void SharedMemoryReader::MarkActivity() {
+    if (readOnly) return;
+    const uint64_t nowNs = WriterLease::MonotonicNowNs();
+    if (nowNs - lastActivityNs < 250000000ULL) return;
+    lastActivityNs = nowNs;
+    layout->header.readerActivityNs.store(nowNs, std::memory_order_relaxed);
+}
+
+bool SharedMemoryReader::AcquireCopy(Snapshot& snapshot) {
+    const SharedMemoryHeader& header = layout->header;
+    uint32_t current[SHM_SECTION_COUNT];
+    uint32_t seen[SHM_SECTION_COUNT];
+    uint64_t sequence = 0;
+    uint64_t publishNs = 0;
+    const bool ok = SeqLock::Read(header.sequence,
+        [&] {
+            // 各写端在全局写临界区内更新自己租约的发布时间，取最新者作为整块数据的发布时间
+            publishNs = SectionOwnership::LatestPublishNs(*layout);
+            // 每次尝试都从已确认的代数出发：失败尝试中复制了一半的分区在下次尝试时仍会被重新复制
+            for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+                current[s] = header.sections[s].generation.load(std::memory_order_relaxed);
+                seen[s] = localValid ? localGenerations[s] : ~current[s];
+            }
+            SharedMemorySections::CopyChanged(local.get(), &layout->block, seen, current);
+        },
+        SeqLock::kDefaultReadAttempts, &retries, &sequence);
+    if (!ok) {
+        lastError = "写端持续写入中，未能读取到一致快照";
+        return false;
+    }
+    std::memcpy(localGenerations, seen, sizeof(localGenerations));
+    localValid = true;
+
+    snapshot.block = local.get();
+    snapshot.version = sequence;
+    snapshot.publishNs = publishNs;
+    std::memcpy(snapshot.generations, localGenerations, sizeof(snapshot.generations));
+    return true;
+}
+
+template <typename T>
+bool SharedMemoryReader::ReadVariable(uint32_t id, std::vector<T>& out, SectionCache& cache) {
+    if (!layout) {
+        lastError = "共享内存未打开";
+        return false;
+    }
+    const char* base = reinterpret_cast<const char*>(layout);
+    const size_t mappedSize = backend.Size();
+    bool found = false;
+    bool malformed = false;
+    bool unchanged = false;
+    SharedMemorySectionEntry entry{};
+
+    // 只校验该段所属分区的序号：其他写端发布别的分区时不会让本次读取重试
+    const bool ok = SharedMemorySections::ReadSections(layout->header, SharedMemorySections::SectionsOf(id),
+        [&] {
+            found = malformed = unchanged = false;
+            const uint32_t count = std::min<uint32_t>(layout->header.sectionTableCount, SHM_MAX_SECTION_ENTRIES);
+            for (uint32_t i = 0; i < count && !found; ++i) {
+                if (layout->sectionTable[i].id != id) continue;
+                found = true;
+                entry = layout->sectionTable[i];
+            }
+            if (!found) return;
+            // 写端重新排布期间段表可能暂不可信，seqlock 校验会让本次尝试重试
+            if (entry.elementSize != sizeof(T) || entry.count > entry.capacity ||
+                entry.offset + static_cast<uint64_t>(entry.capacity) * sizeof(T) > mappedSize) {
+                malformed = true;
+                return;
+            }
+            if (cache.valid && cache.generation == entry.generation && cache.offset == entry.offset &&
+                out.size() == entry.count) {
+                unchanged = true;
+                return;
+            }
+            out.resize(entry.count);
+            if (entry.count) std::memcpy(static_cast<void*>(out.data()), base + entry.offset, entry.count * sizeof(T));
+        },
+        SeqLock::kDefaultReadAttempts, &retries);
+
+    if (!ok) {
+        lastError = "写端持续写入中，未能读取到一致的变长段";
+        return false;
+    }
+    if (!found || malformed) {
+        lastError = found ? "段表条目与读端结构不一致" : "段表中没有请求的段";
+        cache.valid = false;
+        return false;
+    }
+    if (!unchanged) {
+        cache.generation = entry.generation;
+        cache.offset = entry.offset;
+        cache.valid = true;
+    }
+    return true;
+}
+
+bool SharedMemoryReader::ReadGpus(std::vector<GPUData>& out) {
+    return ReadVariable(SHM_SEC_GPUS, out, sectionCache[SHM_SEC_GPUS]);
+}
+
+bool SharedMemoryReader::ReadAdapters(std::vector<NetworkAdapterData>& out) {
+    return ReadVariable(SHM_SEC_ADAPTERS, out, sectionCache[SHM_SEC_ADAPTERS]);
+}
+
+bool SharedMemoryReader::ReadDisks(std::vector<SharedMemoryBlock::SharedDiskData>& out) {
+    return ReadVariable(SHM_SEC_DISKS, out, sectionCache[SHM_SEC_DISKS]);
+}
+
+bool SharedMemoryReader::ReadPhysicalDisks(std::vector<SharedPhysicalDiskData>& out) {
+    return ReadVariable(SHM_SEC_PHYSICAL_DISKS, out, sectionCache[SHM_SEC_PHYSICAL_DISKS]);
+}
+
+bool SharedMemoryReader::ReadTemperatures(std::vector<TemperatureData>& out) {
+    return ReadVariable(SHM_SEC_TEMPERATURES, out, sectionCache[SHM_SEC_TEMPERATURES]);
+}
+
+bool SharedMemoryReader::ReadCores(std::vector<SharedCoreUsage>& out) {
+    return ReadVariable(SHM_SEC_CORES, out, sectionCache[SHM_SEC_CORES]);
+}
+
+bool SharedMemoryReader::ReadHotMetrics(SharedHotMetrics& out) {
+    if (!layout) {
+        lastError = "共享内存未打开";
+        return false;
+    }
+    MarkActivity();
+    const bool ok = SharedMemorySections::ReadSections(layout->header, SharedMemorySections::SectionsOf(SHM_SEC_HOT_METRICS),
+        [&] { std::memcpy(static_cast<void*>(&out), &layout->hot, sizeof(SharedHotMetrics)); },
+        SeqLock::kDefaultReadAttempts, &retries);
+    if (!ok) lastError = "写端持续写入中，未能读取到一致的热点指标";
+    return ok;
+}
+
+bool SharedMemoryReader::ReadCollectors(std::vector<SharedCollectorStatus>& out) {
+    if (!layout) {
+        lastError = "共享内存未打开";
+        return false;
+    }
+    const SharedCollectorTable& table = layout->collectors;
+    if (table.entrySize != sizeof(SharedCollectorStatus)) {
+        lastError = "采集器状态条目大小不匹配（" + std::to_string(table.entrySize) + "）";
+        return false;
+    }
+    const bool ok = SeqLock::Read(layout->header.sequence,
+        [&] {
+            out.clear();
+            for (int producer = 0; producer < SHM_MAX_PRODUCERS; ++producer) {
+                const uint32_t count = std::min<uint32_t>(table.counts[producer], SHM_MAX_COLLECTORS);
+                const SharedCollectorStatus* first = &table.entries[producer * SHM_MAX_COLLECTORS];
+                out.insert(out.end(), first, first + count);
+            }
+        },
+        SeqLock::kDefaultReadAttempts, &retries);
+    if (!ok) lastError = "写端持续写入中，未能读取到一致的采集器状态";
+    return ok;
+}
+
+bool SharedMemoryReader::ReadInitializingSections(uint32_t& mask) {
+    if (!layout) {
+        lastError = "共享内存未打开";
+        return false;
+    }
+    const SharedCollectorTable& table = layout->collectors;
+    if (table.entrySize != sizeof(SharedCollectorStatus)) {
+        lastError = "采集器状态条目大小不匹配（" + std::to_string(table.entrySize) + "）";
+        return false;
+    }
+    const bool ok = SeqLock::Read(layout->header.sequence,
+        [&] {
+            mask = 0;
+            for (int producer = 0; producer < SHM_MAX_PRODUCERS; ++producer) {
+                const uint32_t count = std::min<uint32_t>(table.counts[producer], SHM_MAX_COLLECTORS);
+                const SharedCollectorStatus* first = &table.entries[producer * SHM_MAX_COLLECTORS];
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (first[i].flags & SHM_COLLECTOR_INITIALIZING) mask |= first[i].sections;
+                }
+            }
+        },
+        SeqLock::kDefaultReadAttempts, &retries);
+    if (!ok) lastError = "写端持续写入中，未能读取到一致的采集器状态";
+    return ok;
+}
+
+bool SharedMemoryReader::ReadOverhead(std::vector<SharedSelfOverhead>& out) {
+    if (!layout) {
+        lastError = "共享内存未打开";
+        return false;
+    }
+    const SharedOverheadTable& table = layout->overhead;
+    if (table.entrySize != sizeof(SharedSelfOverhead)) {
+        lastError = "自身开销条目大小不匹配（" + std::to_string(table.entrySize) + "）";
+        return false;
+    }
+    const bool ok = SeqLock::Read(layout->header.sequence,
+        [&] {
+            out.clear();
+            for (int producer = 0; producer < SHM_MAX_PRODUCERS; ++producer) {
+                if (table.entries[producer].pid != 0) out.push_back(table.entries[producer]);
+            }
+        },
+        SeqLock::kDefaultReadAttempts, &retries);
+    if (!ok) lastError = "写端持续写入中，未能读取到一致的自身开销";
+    return ok;
+}
+
+const SmartCatalogEntry* SharedMemoryReader::SmartAttributeInfo(uint16_t catalogIndex) const {
+    if (!layout) return nullptr;
+    const SharedSmartCatalog& catalog = layout->smartCatalog;
+    if (catalog.entrySize != sizeof(SmartCatalogEntry) || catalogIndex >= catalog.count ||
+        catalogIndex >= SHM_SMART_CATALOG_CAPACITY) {
+        return nullptr;
+    }
+    return &catalog.entries[catalogIndex];
+}
+
+WriterLease::Status SharedMemoryReader::GetWriterStatus(double* ageMsOut) const {
+    if (!layout) {
+        if (ageMsOut) *ageMsOut = -1.0;
+        return WriterLease::Status::Unknown;
+    }
+    return WriterLease::Classify(layout->header.writer, ageMsOut);
+}
+
+WriterLease::Status SharedMemoryReader::GetSectionStatus(int section, double* ageMsOut) const {
+    const int owner = layout && section >= 0 && section < SHM_SECTION_COUNT ? SectionOwnership::OwnerOf(*layout, section) : -1;
+    if (owner < 0) {
+        if (ageMsOut) *ageMsOut = -1.0;
+        return WriterLease::Status::Unknown;
+    }
+    return WriterLease::Classify(SectionOwnership::Lease(*layout, owner), ageMsOut);
+}
+
+bool SharedMemoryReader::WaitForUpdate(int timeoutMs) {
+    if (!layout) {
+        lastError = "共享内存未打开";
+        return false;
+    }
+    if (canNotify) {
+        const auto result = notifier.Wait(layout->header, lastGeneration, timeoutMs);
+        if (result == PublishNotifier::WaitResult::Error) lastError = notifier.GetLastError();
+        return result == PublishNotifier::WaitResult::NewGeneration;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs < 0 ? 0 : timeoutMs);
+    for (;;) {
+        if (layout->header.publishGeneration.load(std::memory_order_acquire) != lastGeneration) return true;
+        if (timeoutMs >= 0 && std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
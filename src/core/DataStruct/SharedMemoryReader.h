@@ -0,0 +1,180 @@
+#pragma once
+#include "DataStruct.h"
+#include "PublishNotifier.h"
+#include "SharedMemoryBackend.h"
+#include "WriterLease.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 只读视图：指向共享内存（或读端私有缓冲）中的一段连续元素，不复制
+template <typename T>
+struct ArrayView {
+    const T* data = nullptr;
+    size_t size = 0;
+
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+    const T& operator[](size_t i) const { return data[i]; }
+    bool empty() const { return size == 0; }
+};
+
+// C++ 读端库：供其他本机工具消费 SystemMonitor 发布的共享内存，无需复制结构体定义或猜测同步协议
+//   Acquire()      钉住当前发布的快照槽，返回零拷贝视图（字符串直接指向映射中的 wchar_t 数组）
+//                  以只读方式打开时无法钉住，退回 seqlock：只复制代数变化过的分区到读端私有缓冲
+//   ReadXxx()      经段表读取超出兼容块上限的完整设备列表（seqlock 保护，代数未变时跳过复制）
+//   ReadHotMetrics 只读取每轮变化的数值，适合高频轮询
+//   ReadCores      各逻辑处理器的占用率；热点指标区里有按大小核的汇总（平均 / 最大 / 最忙的处理器）
+//   ReadCollectors 各数据源最近一次成功采集的时间与过期标志
+//   ReadInitializingSections 仍在后台初始化的数据源负责的分区（尚无数据，不可用）
+//   ReadOverhead   写端进程自身的 CPU / 内存 / 分配 / 句柄开销与每轮耗时分布
+//   SmartAttributeInfo 按 SharedSmartAttribute::catalogIndex 取属性名称 / 描述 / 单位（直接指向映射中的 SMART 目录）
+//   WaitForUpdate  阻塞等待下一次发布（PublishNotifier）
+//   GetWriterStatus 按主写端租约判断数据新鲜 / 过期 / 写端已退出（WriterLease）
+//   GetSectionStatus 按分区所有者的租约判断；多写端部署时（见 SectionOwnership）各分区的新鲜度可能不同
+// 单个 SharedMemoryReader 不是线程安全的；多线程读取时每个线程各用一个实例
+class SharedMemoryReader {
+public:
+    class Snapshot {
+    public:
+        Snapshot() = default;
+        ~Snapshot() { Release(); }
+        Snapshot(Snapshot&& other) noexcept { *this = std::move(other); }
+        Snapshot& operator=(Snapshot&& other) noexcept;
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        bool Valid() const { return block != nullptr; }
+        explicit operator bool() const { return Valid(); }
+        // 是否为钉住的快照槽（零拷贝）；false 表示数据位于读端私有缓冲（seqlock 路径）
+        bool IsPinned() const { return slot >= 0; }
+        // 快照纪元（钉住时）或 seqlock 序号（复制时），相同值表示同一次发布
+        uint64_t Version() const { return version; }
+        // 数据年龄（毫秒）：按发布时的单调时钟计算，不受系统校时影响；
+        // 尚未记录发布时间（首次发布前）时退回 lastUpdate 到当前 UTC 时间的差值
+        double AgeMs() const;
+        const SYSTEMTIME& LastUpdate() const { return block->lastUpdate; }
+        // 各分区代数（SharedMemorySection 为下标），可用于判断分区是否变化
+        const uint32_t* SectionGenerations() const { return generations; }
+
+        const SharedMemoryBlock& Block() const { return *block; }
+        const wchar_t* CpuName() const { return block->cpuName; }
+        double CpuUsage() const { return block->cpuUsage; }
+        uint64_t TotalMemory() const { return block->totalMemory; }
+        uint64_t UsedMemory() const { return block->usedMemory; }
+        uint64_t AvailableMemory() const { return block->availableMemory; }
+        double CpuTemperature() const { return block->cpuTemperature; }
+        double GpuTemperature() const { return block->gpuTemperature; }
+
+        // 兼容块中的设备列表（最多 2/4/8/8/10 个），完整列表见 SharedMemoryReader::ReadXxx
+        ArrayView<GPUData> Gpus() const { return MakeView(block->gpus, block->gpuCount); }
+        ArrayView<NetworkAdapterData> Adapters() const { return MakeView(block->adapters, block->adapterCount); }
+        ArrayView<SharedMemoryBlock::SharedDiskData> Disks() const { return MakeView(block->disks, block->diskCount); }
+        ArrayView<SharedPhysicalDiskData> PhysicalDisks() const { return MakeView(block->physicalDisks, block->physicalDiskCount); }
+        ArrayView<TemperatureData> Temperatures() const { return MakeView(block->temperatures, block->tempCount); }
+
+        // 提前释放钉住（析构时自动释放）
+        void Release();
+
+    private:
+        friend class SharedMemoryReader;
+
+        template <typename T, size_t N>
+        static ArrayView<T> MakeView(const T (&arr)[N], int count) {
+            const size_t n = count < 0 ? 0 : (static_cast<size_t>(count) < N ? static_cast<size_t>(count) : N);
+            return { arr, n };
+        }
+
+        SharedMemoryLayout* layout = nullptr;
+        SharedPinOwner* owner = nullptr;
+        const SharedMemoryBlock* block = nullptr;
+        int slot = -1;
+        uint64_t version = 0;
+        uint64_t publishNs = 0;
+        uint32_t generations[SHM_SECTION_COUNT] = {};
+    };
+
+    explicit SharedMemoryReader(const std::string& name = SharedMemoryBackend::kDefaultName);
+    ~SharedMemoryReader();
+    SharedMemoryReader(const SharedMemoryReader&) = delete;
+    SharedMemoryReader& operator=(const SharedMemoryReader&) = delete;
+
+    // readOnly = false 时以读写方式映射，仅用于修改快照槽的读者计数、等待者计数与读端活动时间，不会改写数据
+    bool Open(bool readOnly = false);
+    void Close();
+    bool IsOpen() const { return layout != nullptr; }
+
+    // 获取一份一致的快照；失败（写端尚未发布或持续写入）时返回无效 Snapshot
+    // 钉住的快照须在 Close 之前释放；seqlock 路径下返回的视图指向私有缓冲，下一次 Acquire 前有效
+    Snapshot Acquire();
+
+    // 经段表读取完整设备列表；代数与偏移均未变化时不复制，直接返回 true
+    // 每个分区应始终传入同一个容器：其容量在多次调用间复用，稳定后不再分配内存
+    bool ReadGpus(std::vector<GPUData>& out);
+    bool ReadAdapters(std::vector<NetworkAdapterData>& out);
+    bool ReadDisks(std::vector<SharedMemoryBlock::SharedDiskData>& out);
+    bool ReadPhysicalDisks(std::vector<SharedPhysicalDiskData>& out);
+    bool ReadTemperatures(std::vector<TemperatureData>& out);
+    // 各逻辑处理器的占用率与核心类型（下标为处理器编号）
+    bool ReadCores(std::vector<SharedCoreUsage>& out);
+
+    // 读取热点指标区（几百字节，seqlock 保护）
+    bool ReadHotMetrics(SharedHotMetrics& out);
+
+    // 读取所有写端的采集器状态（SharedCollectorStatus），读端据此判断各分区数据的年龄与是否过期
+    bool ReadCollectors(std::vector<SharedCollectorStatus>& out);
+    // 仍在后台初始化（SHM_COLLECTOR_INITIALIZING）的数据源负责的分区掩码：这些分区的 0 表示尚无数据而非读数为 0。
+    // 不分配，可高频调用
+    bool ReadInitializingSections(uint32_t& mask);
+    // 读取各写端进程的自身开销（只返回已发布的写端）
+    bool ReadOverhead(std::vector<SharedSelfOverhead>& out);
+
+    // SMART 目录条目；下标越界或为 SHM_SMART_CATALOG_NONE 时返回 nullptr
+    // 目录在写端初始化时写入一次，之后不再变化，因此无需 seqlock
+    const SmartCatalogEntry* SmartAttributeInfo(uint16_t catalogIndex) const;
+
+    // 等待写端发布新数据；返回 true 表示自上次 Acquire 以来已有新发布
+    // 只读打开时无法登记等待者，退回短间隔轮询
+    bool WaitForUpdate(int timeoutMs);
+
+    // 写端状态；ageMsOut 返回距最近一次发布的毫秒数（未知时为 -1）
+    WriterLease::Status GetWriterStatus(double* ageMsOut = nullptr) const;
+    // 发布某个分区（SharedMemorySection）的写端的状态；分区无人拥有时返回 Unknown
+    WriterLease::Status GetSectionStatus(int section, double* ageMsOut = nullptr) const;
+
+    const SharedMemoryHeader* GetHeader() const { return layout ? &layout->header : nullptr; }
+    uint32_t GetLayoutVersion() const { return layout ? layout->header.layoutVersion : 0; }
+    uint64_t GetRetries() const { return retries; }
+    const std::string& GetLastError() const { return lastError; }
+
+private:
+    struct SectionCache {
+        uint32_t generation = 0;
+        uint64_t offset = 0;
+        bool valid = false;
+    };
+
+    template <typename T>
+    bool ReadVariable(uint32_t id, std::vector<T>& out, SectionCache& cache);
+    bool AcquireCopy(Snapshot& snapshot);
+    // 上报读端活动（写端据此决定是否提高采样频率）；头部与 sequence 同一缓存行，因此限制写入频率
+    void MarkActivity();
+
+    SharedMemoryBackend backend;
+    PublishNotifier notifier;
+    SharedMemoryLayout* layout = nullptr;
+    SharedPinOwner* pinOwner = nullptr;     // 本读端的钉住登记（写端只在本进程退出后回收其钉住），表满时为 nullptr
+    bool readOnly = true;
+    bool canNotify = false;
+    // seqlock 路径的私有缓冲及其各分区代数
+    std::unique_ptr<SharedMemoryBlock> local;
+    uint32_t localGenerations[SHM_SECTION_COUNT] = {};
+    bool localValid = false;
+    uint32_t lastGeneration = 0;
+    SectionCache sectionCache[SHM_MAX_SECTION_ENTRIES];
+    uint64_t retries = 0;
+    uint64_t lastActivityNs = 0;
+    std::string lastError;
+};
@@ -0,0 +1,145 @@
+#pragma once
+#include "DataStruct.h"
+#include "SeqLock.h"
+#include <cstddef>
+#include <cstring>
+#include <thread>
+
+// SharedMemoryBlock 各分区的字节范围表（按 offsetof 计算，与 #pragma pack(1) 布局一致）
+// 写端按分区增量复制，读端可按分区代数只复制变化过的部分
+// lastUpdate 不属于任何分区，每次发布都会更新
+// 数组元素中的清单字段与热点字段交错（如温度传感器的名称与温度值），用带步长的范围分别描述
+class SharedMemorySections {
+public:
+    struct Range {
+        size_t offset;
+        size_t size;
+        size_t count;    // 重复次数（数组元素个数），普通字段为 1
+        size_t stride;   // 相邻两次重复之间的字节距离
+    };
+    static constexpr int kMaxRangesPerSection = 4;
+
+    struct Section {
+        const char* name;
+        int rangeCount;
+        Range ranges[kMaxRangesPerSection];
+    };
+
+    static const Section& Get(int section) {
+        constexpr size_t kTempStride = sizeof(TemperatureData);
+        constexpr size_t kTempCount = sizeof(SharedMemoryBlock::temperatures) / sizeof(TemperatureData);
+        static const Section table[SHM_SECTION_COUNT] = {
+            { "cpu", 2, {
+                { offsetof(SharedMemoryBlock, cpuName), offsetof(SharedMemoryBlock, cpuUsage) - offsetof(SharedMemoryBlock, cpuName), 1, 0 },
+                { offsetof(SharedMemoryBlock, performanceCores), offsetof(SharedMemoryBlock, totalMemory) - offsetof(SharedMemoryBlock, performanceCores), 1, 0 } } },
+            { "load", 3, {
+                { offsetof(SharedMemoryBlock, cpuUsage), sizeof(double), 1, 0 },
+                { offsetof(SharedMemoryBlock, totalMemory), offsetof(SharedMemoryBlock, cpuTemperature) - offsetof(SharedMemoryBlock, totalMemory), 1, 0 },
+                { offsetof(SharedMemoryBlock, cpuUsageSampleIntervalMs), sizeof(double), 1, 0 } } },
+            { "gpu", 2, {
+                { offsetof(SharedMemoryBlock, gpus), sizeof(SharedMemoryBlock::gpus), 1, 0 },
+                { offsetof(SharedMemoryBlock, gpuCount), sizeof(int), 1, 0 } } },
+            { "adapters", 2, {
+                { offsetof(SharedMemoryBlock, adapters), sizeof(SharedMemoryBlock::adapters), 1, 0 },
+                { offsetof(SharedMemoryBlock, adapterCount), sizeof(int), 1, 0 } } },
+            { "disks", 2, {
+                { offsetof(SharedMemoryBlock, disks), sizeof(SharedMemoryBlock::disks), 1, 0 },
+                { offsetof(SharedMemoryBlock, diskCount), sizeof(int), 1, 0 } } },
+            { "smart", 2, {
+                { offsetof(SharedMemoryBlock, physicalDisks), sizeof(SharedMemoryBlock::physicalDisks), 1, 0 },
+                { offsetof(SharedMemoryBlock, physicalDiskCount), sizeof(int), 1, 0 } } },
+            { "temperatures", 2, {
+                { offsetof(SharedMemoryBlock, temperatures) + offsetof(TemperatureData, sensorName), sizeof(TemperatureData::sensorName), kTempCount, kTempStride },
+                { offsetof(SharedMemoryBlock, tempCount), sizeof(int), 1, 0 } } },
+            { "sensors", 2, {
+                { offsetof(SharedMemoryBlock, cpuTemperature), offsetof(SharedMemoryBlock, cpuUsageSampleIntervalMs) - offsetof(SharedMemoryBlock, cpuTemperature), 1, 0 },
+                { offsetof(SharedMemoryBlock, temperatures) + offsetof(TemperatureData, temperature), sizeof(double), kTempCount, kTempStride } } },
+        };
+        return table[section];
+    }
+
+    // 清零单个分区
+    static void Clear(SharedMemoryBlock* dst, int section) {
+        const Section& sec = Get(section);
+        for (int i = 0; i < sec.rangeCount; ++i) {
+            const Range& r = sec.ranges[i];
+            for (size_t k = 0; k < r.count; ++k) {
+                std::memset(reinterpret_cast<char*>(dst) + r.offset + k * r.stride, 0, r.size);
+            }
+        }
+    }
+
+    // 复制单个分区，返回复制的字节数
+    static size_t Copy(SharedMemoryBlock* dst, const SharedMemoryBlock* src, int section) {
+        const Section& sec = Get(section);
+        size_t bytes = 0;
+        for (int i = 0; i < sec.rangeCount; ++i) {
+            const Range& r = sec.ranges[i];
+            for (size_t k = 0; k < r.count; ++k) {
+                const size_t offset = r.offset + k * r.stride;
+                std::memcpy(reinterpret_cast<char*>(dst) + offset, reinterpret_cast<const char*>(src) + offset, r.size);
+            }
+            bytes += r.size * r.count;
+        }
+        return bytes;
+    }
+
+    // 复制 lastUpdate 时间戳
+    static size_t CopyTimestamp(SharedMemoryBlock* dst, const SharedMemoryBlock* src) {
+        std::memcpy(&dst->lastUpdate, &src->lastUpdate, sizeof(SYSTEMTIME));
+        return sizeof(SYSTEMTIME);
+    }
+
+    // 段表中的区域所属的数据分区（掩码）；兼容块等整体区域返回全部分区
+    static uint32_t SectionsOf(uint32_t sectionId) {
+        switch (sectionId) {
+        case SHM_SEC_GPUS: return 1u << SHM_SECTION_GPU;
+        case SHM_SEC_ADAPTERS: return 1u << SHM_SECTION_ADAPTERS;
+        case SHM_SEC_DISKS: return 1u << SHM_SECTION_DISKS;
+        case SHM_SEC_PHYSICAL_DISKS: return 1u << SHM_SECTION_SMART;
+        case SHM_SEC_TEMPERATURES: return (1u << SHM_SECTION_TEMPERATURES) | (1u << SHM_SECTION_SENSORS);
+        case SHM_SEC_CORES: return 1u << SHM_SECTION_LOAD;
+        case SHM_SEC_HOT_METRICS: return (1u << SHM_SECTION_LOAD) | (1u << SHM_SECTION_SENSORS);
+        default: return SHM_ALL_SECTIONS;
+        }
+    }
+
+    // 读端辅助：按 mask 中各分区自己的 seqlock 序号读取一致副本，不受其他分区（其他写端）发布的影响
+    // 变长段重新排布时写端会推进所有分区的序号，因此段表条目也可在这里读取
+    template <typename CopyFn>
+    static bool ReadSections(const SharedMemoryHeader& header, uint32_t mask, CopyFn&& copy,
+                             int maxAttempts = SeqLock::kDefaultReadAttempts, uint64_t* retries = nullptr) {
+        uint64_t begin[SHM_SECTION_COUNT] = {};
+        for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+            bool writing = false;
+            for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+                if ((mask & (1u << s)) == 0) continue;
+                begin[s] = SeqLock::ReadBegin(header.sections[s].sequence);
+                writing |= (begin[s] & 1) != 0;
+            }
+            if (!writing) {
+                copy();
+                bool changed = false;
+                for (int s = 0; s < SHM_SECTION_COUNT && !changed; ++s) {
+                    if ((mask & (1u << s)) != 0) changed = SeqLock::ReadRetry(header.sections[s].sequence, begin[s]);
+                }
+                if (!changed) return true;
+            }
+            if (retries) ++(*retries);
+            if (attempt > 64) std::this_thread::yield();
+        }
+        return false;
+    }
+
+    // 读端辅助：只复制代数与 seen 不同的分区，并把 seen 更新为 current；返回复制的字节数
+    static size_t CopyChanged(SharedMemoryBlock* dst, const SharedMemoryBlock* src,
+                              uint32_t* seen, const uint32_t* current) {
+        size_t bytes = CopyTimestamp(dst, src);
+        for (int s = 0; s < SHM_SECTION_COUNT; ++s) {
+            if (seen[s] == current[s]) continue;
+            bytes += Copy(dst, src, s);
+            seen[s] = current[s];
+        }
+        return bytes;
+    }
+};
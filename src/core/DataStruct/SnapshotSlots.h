@@ -0,0 +1,87 @@
+#pragma once
+#include "DataStruct.h"
+
+// 快照槽的发布/钉住协议（RCU 风格，单写多读）
+// 写端: FindFreeSlot -> 填充槽 -> Publish
+// 读端: Pin -> 按需慢慢复制 -> Unpin；钉住期间槽内容保证不变
+// 读端可先 ClaimOwner 登记进程（SharedPinTable），之后的钉住记在该条目下，写端只在进程退出后回收
+// readers 与 publishedSnapshot 均使用 seq_cst：写端“发布后再检查 readers”与读端“钉住后再检查发布”
+// 两者至少一方能看到对方的写入，因此写端不会开始改写一个读者认为有效的槽
+class SnapshotSlots {
+public:
+    static uint64_t Encode(uint64_t epoch, int slot) { return (epoch << 8) | static_cast<uint64_t>(slot); }
+    static uint64_t EpochOf(uint64_t published) { return published >> 8; }
+    static int SlotOf(uint64_t published) { return static_cast<int>(published & 0xFF); }
+
+    // 写端：返回一个既未发布也未被钉住的槽，全部占用时返回 -1
+    static int FindFreeSlot(const SharedMemoryLayout& layout) {
+        const uint64_t published = layout.header.publishedSnapshot.load(std::memory_order_seq_cst);
+        const int publishedSlot = EpochOf(published) != 0 ? SlotOf(published) : -1;
+        for (int i = 0; i < SHM_SNAPSHOT_SLOTS; ++i) {
+            if (i == publishedSlot) continue;
+            if (layout.snapshots[i].readers.load(std::memory_order_seq_cst) == 0) return i;
+        }
+        return -1;
+    }
+
+    // 写端：发布已填好的槽，返回新纪元
+    static uint64_t Publish(SharedMemoryLayout& layout, int slot) {
+        const uint64_t epoch = EpochOf(layout.header.publishedSnapshot.load(std::memory_order_relaxed)) + 1;
+        layout.snapshots[slot].epoch.store(epoch, std::memory_order_relaxed);
+        layout.header.publishedSnapshot.store(Encode(epoch, slot), std::memory_order_seq_cst);
+        return epoch;
+    }
+
+    // 读端：认领一条钉住登记，表满时返回 nullptr（之后的钉住不登记）
+    static SharedPinOwner* ClaimOwner(SharedMemoryLayout& layout, uint32_t pid) {
+        for (SharedPinOwner& owner : layout.pinOwners.owners) {
+            uint32_t expected = 0;
+            if (owner.pid.compare_exchange_strong(expected, pid, std::memory_order_seq_cst)) {
+                for (auto& pins : owner.pins) pins.store(0, std::memory_order_relaxed);
+                return &owner;
+            }
+        }
+        return nullptr;
+    }
+
+    // 读端：释放登记（须先释放全部钉住）
+    static void ReleaseOwner(SharedPinOwner* owner) {
+        if (owner) owner->pid.store(0, std::memory_order_seq_cst);
+    }
+
+    // 读端：钉住当前发布的快照，成功返回槽号并输出纪元；尚未发布或竞争失败返回 -1
+    // owner 非空时先记入登记条目，再增加槽的读者计数
+    static int Pin(SharedMemoryLayout& layout, uint64_t* epochOut = nullptr, int maxAttempts = 100,
+                   SharedPinOwner* owner = nullptr) {
+        for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+            const uint64_t published = layout.header.publishedSnapshot.load(std::memory_order_seq_cst);
+            if (EpochOf(published) == 0) return -1;
+            const int slot = SlotOf(published);
+            if (slot >= SHM_SNAPSHOT_SLOTS) return -1;
+            if (owner) owner->pins[slot].fetch_add(1, std::memory_order_seq_cst);
+            layout.snapshots[slot].readers.fetch_add(1, std::memory_order_seq_cst);
+            if (layout.header.publishedSnapshot.load(std::memory_order_seq_cst) == published) {
+                if (epochOut) *epochOut = EpochOf(published);
+                return slot;
+            }
+            Unpin(layout, slot, owner);
+        }
+        return -1;
+    }
+
+    // 读端：释放钉住（先减槽的读者计数，再减登记条目）；计数不会减到 0 以下（写端可能已回收了未登记的遗留钉住）
+    static void Unpin(SharedMemoryLayout& layout, int slot, SharedPinOwner* owner = nullptr) {
+        Release(layout.snapshots[slot].readers, 1);
+        if (owner) Release(owner->pins[slot], 1);
+    }
+
+    // 把计数减去 count，不低于 0；返回实际减去的数目
+    static uint32_t Release(std::atomic<uint32_t>& counter, uint32_t count) {
+        uint32_t current = counter.load(std::memory_order_relaxed);
+        uint32_t taken = 0;
+        do {
+            taken = current < count ? current : count;
+        } while (taken != 0 && !counter.compare_exchange_weak(current, current - taken, std::memory_order_seq_cst));
+        return taken;
+    }
+};
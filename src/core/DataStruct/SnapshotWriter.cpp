@@ -0,0 +1,469 @@
+// SnapshotWriter.cpp
+#include "SnapshotWriter.h"
+#include "SharedMemoryManager.h"
+#include "SharedMemorySections.h"
+#include "../Utils/WinUtils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+
+void AppendEscaped(std::string& out, const char* text, size_t length) {
+    out.push_back('"');
+    for (size_t i = 0; i < length; ++i) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (c < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            } else {
+                out.push_back(static_cast<char>(c));
+            }
+        }
+    }
+    out.push_back('"');
+}
+
+// 无效的浮点数（NaN / 无穷）写为 null
+void AppendNumber(std::string& out, double value) {
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    char text[32];
+    snprintf(text, sizeof(text), "%.10g", value);
+    out += text;
+}
+
+// 对象：每个字段经 Field 写出 "key": 前缀（字段之间加逗号），End 之前不能再写其他内容
+class JsonObject {
+public:
+    explicit JsonObject(std::string& out) : out(out) { out.push_back('{'); }
+    void End() { out.push_back('}'); }
+
+    std::string& Field(const char* key) {
+        if (!first) out.push_back(',');
+        first = false;
+        AppendEscaped(out, key, strlen(key));
+        out.push_back(':');
+        return out;
+    }
+    void String(const char* key, const std::string& value) {
+        AppendEscaped(Field(key), value.data(), value.size());
+    }
+    // 定长 wchar_t 数组（不一定以 0 结尾）
+    void Wide(const char* key, const wchar_t* value, size_t capacity) {
+        const std::string utf8 = WinUtils::WstringToUtf8(std::wstring(value, wcsnlen(value, capacity)));
+        AppendEscaped(Field(key), utf8.data(), utf8.size());
+    }
+    void Number(const char* key, double value) { AppendNumber(Field(key), value); }
+    void Unsigned(const char* key, uint64_t value) { Field(key) += std::to_string(value); }
+    void Integer(const char* key, int64_t value) { Field(key) += std::to_string(value); }
+    void Bool(const char* key, bool value) { Field(key) += value ? "true" : "false"; }
+
+private:
+    std::string& out;
+    bool first = true;
+};
+
+// 数组：Next 在元素之间加逗号
+class JsonArray {
+public:
+    explicit JsonArray(std::string& out) : out(out) { out.push_back('['); }
+    std::string& Next() {
+        if (!first) out.push_back(',');
+        first = false;
+        return out;
+    }
+    void End() { out.push_back(']'); }
+
+private:
+    std::string& out;
+    bool first = true;
+};
+
+void AppendGpu(std::string& out, const GPUData& gpu) {
+    JsonObject object(out);
+    object.Wide("name", gpu.name, 128);
+    object.Wide("brand", gpu.brand, 64);
+    object.Unsigned("memory", gpu.memory);
+    object.Number("coreClock", gpu.coreClock);
+    object.Bool("isVirtual", gpu.isVirtual);
+    object.End();
+}
+
+void AppendAdapter(std::string& out, const NetworkAdapterData& adapter) {
+    JsonObject object(out);
+    object.Wide("name", adapter.name, 128);
+    object.Wide("mac", adapter.mac, 32);
+    object.Wide("ipAddress", adapter.ipAddress, 64);
+    object.Wide("adapterType", adapter.adapterType, 32);
+    object.Unsigned("speed", adapter.speed);
+    object.End();
+}
+
+void AppendPhysicalDisk(std::string& out, const PhysicalDiskSmartData& disk) {
+    JsonObject object(out);
+    object.Wide("model", disk.model, 128);
+    object.Wide("serialNumber", disk.serialNumber, 64);
+    object.Wide("firmwareVersion", disk.firmwareVersion, 32);
+    object.Wide("interfaceType", disk.interfaceType, 32);
+    object.Wide("diskType", disk.diskType, 16);
+    object.Unsigned("capacity", disk.capacity);
+    object.Number("temperature", disk.temperature);
+    object.Unsigned("healthPercentage", disk.healthPercentage);
+    object.Bool("isSystemDisk", disk.isSystemDisk);
+    object.Bool("smartEnabled", disk.smartEnabled);
+    object.Bool("smartSupported", disk.smartSupported);
+    object.Unsigned("powerOnHours", disk.powerOnHours);
+    object.Unsigned("powerCycleCount", disk.powerCycleCount);
+    object.Unsigned("reallocatedSectorCount", disk.reallocatedSectorCount);
+    object.Unsigned("currentPendingSector", disk.currentPendingSector);
+    object.Unsigned("uncorrectableErrors", disk.uncorrectableErrors);
+    object.Number("wearLeveling", disk.wearLeveling);
+    object.Unsigned("totalBytesWritten", disk.totalBytesWritten);
+    object.Unsigned("totalBytesRead", disk.totalBytesRead);
+    const int driveCount = (std::max)(0, (std::min)(disk.logicalDriveCount, static_cast<int>(sizeof(disk.logicalDriveLetters))));
+    object.String("logicalDrives", std::string(disk.logicalDriveLetters, driveCount));
+    JsonArray attributes(object.Field("attributes"));
+    const int attributeCount = (std::max)(0, (std::min)(disk.attributeCount, 32));
+    for (int i = 0; i < attributeCount; ++i) {
+        const SmartAttributeData& attribute = disk.attributes[i];
+        JsonObject item(attributes.Next());
+        item.Unsigned("id", attribute.id);
+        item.Wide("name", attribute.name, 64);
+        item.Unsigned("flags", attribute.flags);
+        item.Unsigned("current", attribute.current);
+        item.Unsigned("worst", attribute.worst);
+        item.Unsigned("threshold", attribute.threshold);
+        item.Unsigned("rawValue", attribute.rawValue);
+        item.Bool("isCritical", attribute.isCritical);
+        item.Number("physicalValue", attribute.physicalValue);
+        item.Wide("units", attribute.units, 16);
+        item.End();
+    }
+    attributes.End();
+    object.End();
+}
+
+bool Has(uint32_t sectionMask, int section) {
+    return (sectionMask & (1u << section)) != 0;
+}
+
+// 二进制负载中的完整设备列表，按写出顺序
+const uint32_t kListIds[] = { SHM_SEC_GPUS, SHM_SEC_ADAPTERS, SHM_SEC_DISKS, SHM_SEC_PHYSICAL_DISKS, SHM_SEC_TEMPERATURES, SHM_SEC_CORES };
+
+template <typename T>
+bool DecodeList(const SnapshotListHeader& list, const char* elements, std::vector<T>& out) {
+    if (list.elementSize != sizeof(T)) return false;
+    out.resize(list.count);
+    if (list.count) memcpy(static_cast<void*>(out.data()), elements, static_cast<size_t>(list.count) * sizeof(T));
+    return true;
+}
+
+// 一个分区在二进制负载中占用的字节数
+size_t SectionPayloadSize(int section) {
+    const SharedMemorySections::Section& sec = SharedMemorySections::Get(section);
+    size_t bytes = 0;
+    for (int i = 0; i < sec.rangeCount; ++i) bytes += sec.ranges[i].size * sec.ranges[i].count;
+    return bytes;
+}
+
+} // namespace
+
+SnapshotWriter::SnapshotWriter() = default;
+
+SnapshotWriter::~SnapshotWriter() {
+    Close();
+}
+
+bool SnapshotWriter::ParseFormat(const std::string& name, Format& format) {
+    if (name == "json") format = Format::Json;
+    else if (name == "binary") format = Format::Binary;
+    else return false;
+    return true;
+}
+
+bool SnapshotWriter::Open(const std::string& path, Format outputFormat) {
+    Close();
+    format = outputFormat;
+    if (path.empty() || path == "-") {
+        file = stdout;
+        ownsFile = false;
+#ifdef _WIN32
+        // 文本模式会把负载中的 0x0A 改写为 0x0D 0x0A
+        if (format == Format::Binary) _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    } else {
+#ifdef _WIN32
+        file = _wfopen(WinUtils::Utf8ToWstring(path).c_str(), L"wb");
+#else
+        file = fopen(path.c_str(), "wb");
+#endif
+        ownsFile = file != nullptr;
+        if (!file) {
+            lastError = "无法打开输出文件: " + path;
+            return false;
+        }
+    }
+    if (format == Format::Binary && !block) block = std::make_unique<SharedMemoryBlock>();
+    return true;
+}
+
+void SnapshotWriter::Close() {
+    if (file && ownsFile) fclose(file);
+    else if (file) fflush(file);
+    file = nullptr;
+    ownsFile = false;
+}
+
+bool SnapshotWriter::Write(const SystemInfo& info, uint32_t sectionMask, uint32_t index, uint64_t timestampMs) {
+    if (!file) {
+        lastError = "输出未打开";
+        return false;
+    }
+    if (format == Format::Binary) return WriteBinary(info, sectionMask, index, timestampMs);
+
+    buffer = ToJson(info, sectionMask, index, timestampMs);
+    buffer.push_back('\n');
+    if (fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size() || fflush(file) != 0) {
+        lastError = "写入快照失败";
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotWriter::WriteBinary(const SystemInfo& info, uint32_t sectionMask, uint32_t index, uint64_t timestampMs) {
+    SharedMemoryManager::FillBlock(block.get(), info, sectionMask);
+
+    buffer.clear();
+    const char* base = reinterpret_cast<const char*>(block.get());
+    for (int section = 0; section < SHM_SECTION_COUNT; ++section) {
+        if (!Has(sectionMask, section)) continue;
+        const SharedMemorySections::Section& sec = SharedMemorySections::Get(section);
+        for (int i = 0; i < sec.rangeCount; ++i) {
+            const SharedMemorySections::Range& r = sec.ranges[i];
+            for (size_t k = 0; k < r.count; ++k) buffer.append(base + r.offset + k * r.stride, r.size);
+        }
+    }
+    // 兼容区的设备数组有上限，完整列表另行追加（温度列表的元素同时含名称与读数，两个分区任一被请求即写出）
+    for (uint32_t id : kListIds) {
+        if ((SharedMemorySections::SectionsOf(id) & sectionMask) == 0) continue;
+        const size_t listOffset = buffer.size();
+        buffer.append(sizeof(SnapshotListHeader), '\0');
+        SnapshotListHeader list{};
+        list.id = id;
+        list.count = static_cast<uint32_t>(SharedMemoryManager::AppendVariableSection(id, info, buffer, list.elementSize));
+        memcpy(&buffer[listOffset], &list, sizeof(list));
+    }
+
+    SnapshotRecordHeader header{};
+    header.magic = SNAPSHOT_RECORD_MAGIC;
+    header.version = SNAPSHOT_RECORD_VERSION;
+    header.headerSize = sizeof(SnapshotRecordHeader);
+    header.payloadSize = static_cast<uint32_t>(buffer.size());
+    header.sectionMask = sectionMask & SHM_ALL_SECTIONS;
+    header.index = index;
+    header.blockSize = sizeof(SharedMemoryBlock);
+    header.timestampMs = timestampMs;
+    if (fwrite(&header, 1, sizeof(header), file) != sizeof(header) ||
+        fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size() || fflush(file) != 0) {
+        lastError = "写入快照失败";
+        return false;
+    }
+    return true;
+}
+
+size_t SnapshotWriter::DecodeBinary(const void* data, size_t size, SnapshotRecordHeader& header, SharedMemoryBlock* target,
+                                    SnapshotLists* lists) {
+    if (!data || size < sizeof(SnapshotRecordHeader)) return 0;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != SNAPSHOT_RECORD_MAGIC || header.version != SNAPSHOT_RECORD_VERSION ||
+        header.headerSize < sizeof(SnapshotRecordHeader) || header.blockSize != sizeof(SharedMemoryBlock) ||
+        (header.sectionMask & ~SHM_ALL_SECTIONS) != 0) {
+        return 0;
+    }
+    const size_t total = static_cast<size_t>(header.headerSize) + header.payloadSize;
+    if (size < total) return 0;
+    // 兼容区分区部分的长度由 sectionMask 决定，其余为完整设备列表
+    size_t fixedSize = 0;
+    for (int section = 0; section < SHM_SECTION_COUNT; ++section) {
+        if (Has(header.sectionMask, section)) fixedSize += SectionPayloadSize(section);
+    }
+    if (fixedSize > header.payloadSize) return 0;
+
+    const char* payload = static_cast<const char*>(data) + header.headerSize;
+    const char* const payloadEnd = payload + header.payloadSize;
+    char* base = reinterpret_cast<char*>(target);
+    for (int section = 0; section < SHM_SECTION_COUNT; ++section) {
+        if (!Has(header.sectionMask, section)) continue;
+        const SharedMemorySections::Section& sec = SharedMemorySections::Get(section);
+        for (int i = 0; i < sec.rangeCount; ++i) {
+            const SharedMemorySections::Range& r = sec.ranges[i];
+            for (size_t k = 0; k < r.count; ++k) {
+                memcpy(base + r.offset + k * r.stride, payload, r.size);
+                payload += r.size;
+            }
+        }
+    }
+
+    if (lists) *lists = SnapshotLists{};
+    while (payload < payloadEnd) {
+        SnapshotListHeader list;
+        if (static_cast<size_t>(payloadEnd - payload) < sizeof(list)) return 0;
+        memcpy(&list, payload, sizeof(list));
+        payload += sizeof(list);
+        const uint64_t bytes = static_cast<uint64_t>(list.elementSize) * list.count;
+        if (bytes > static_cast<uint64_t>(payloadEnd - payload)) return 0;
+        bool ok = true;
+        if (lists) {
+            switch (list.id) {
+            case SHM_SEC_GPUS: ok = DecodeList(list, payload, lists->gpus); break;
+            case SHM_SEC_ADAPTERS: ok = DecodeList(list, payload, lists->adapters); break;
+            case SHM_SEC_DISKS: ok = DecodeList(list, payload, lists->disks); break;
+            case SHM_SEC_PHYSICAL_DISKS: ok = DecodeList(list, payload, lists->physicalDisks); break;
+            case SHM_SEC_TEMPERATURES: ok = DecodeList(list, payload, lists->temperatures); break;
+            case SHM_SEC_CORES: ok = DecodeList(list, payload, lists->cores); break;
+            default: break;
+            }
+        }
+        if (!ok) return 0;
+        payload += bytes;
+    }
+    return total;
+}
+
+std::string SnapshotWriter::ToJson(const SystemInfo& info, uint32_t sectionMask, uint32_t index, uint64_t timestampMs) {
+    std::string out;
+    out.reserve(1024);
+    JsonObject root(out);
+    root.Unsigned("index", index);
+    root.Unsigned("timestamp", timestampMs);
+    if (!info.osVersion.empty()) root.String("os", info.osVersion);
+
+    if (Has(sectionMask, SHM_SECTION_CPU)) {
+        JsonObject cpu(root.Field("cpu"));
+        cpu.String("name", info.cpuName);
+        cpu.Integer("physicalCores", info.physicalCores);
+        cpu.Integer("logicalCores", info.logicalCores);
+        cpu.Integer("performanceCores", info.performanceCores);
+        cpu.Integer("efficiencyCores", info.efficiencyCores);
+        cpu.Number("performanceCoreFreq", info.performanceCoreFreq);
+        cpu.Number("efficiencyCoreFreq", info.efficiencyCoreFreq);
+        cpu.Bool("hyperThreading", info.hyperThreading);
+        cpu.Bool("virtualization", info.virtualization);
+        cpu.End();
+    }
+    if (Has(sectionMask, SHM_SECTION_LOAD)) {
+        JsonObject load(root.Field("load"));
+        load.Number("cpuUsage", info.cpuUsage);
+        load.Number("cpuUsageSampleIntervalMs", info.cpuUsageSampleIntervalMs);
+        load.Number("cpuUsageRaw", info.cpuUsageRaw);
+        JsonObject filter(load.Field("cpuUsageFilter"));
+        filter.Unsigned("kind", info.cpuUsageFilter.kind);
+        filter.Number("periodMs", info.cpuUsageFilter.periodMs);
+        filter.Number("percentile", info.cpuUsageFilter.percentile);
+        filter.End();
+        load.Unsigned("totalMemory", info.totalMemory);
+        load.Unsigned("usedMemory", info.usedMemory);
+        load.Unsigned("availableMemory", info.availableMemory);
+        // 各逻辑处理器的占用率与核心类型（SharedCoreClass），下标为处理器编号
+        JsonArray cores(load.Field("coreUsage"));
+        for (float usage : info.coreUsage) AppendNumber(cores.Next(), usage);
+        cores.End();
+        JsonArray classes(load.Field("coreClasses"));
+        for (uint8_t coreClass : info.coreClasses) classes.Next() += std::to_string(coreClass);
+        classes.End();
+        load.End();
+    }
+    if (Has(sectionMask, SHM_SECTION_GPU)) {
+        JsonArray gpus(root.Field("gpus"));
+        for (const GPUData& gpu : info.gpus) AppendGpu(gpus.Next(), gpu);
+        // 旧版单 GPU 字段（数据源只填充了 gpuName 时）
+        if (info.gpus.empty() && !info.gpuName.empty()) {
+            JsonObject gpu(gpus.Next());
+            gpu.String("name", info.gpuName);
+            gpu.String("brand", info.gpuBrand);
+            gpu.Unsigned("memory", info.gpuMemory);
+            gpu.Number("coreClock", info.gpuCoreFreq);
+            gpu.Bool("isVirtual", info.gpuIsVirtual);
+            gpu.End();
+        }
+        gpus.End();
+    }
+    if (Has(sectionMask, SHM_SECTION_ADAPTERS)) {
+        JsonArray adapters(root.Field("adapters"));
+        for (const NetworkAdapterData& adapter : info.adapters) AppendAdapter(adapters.Next(), adapter);
+        if (info.adapters.empty() && !info.networkAdapterName.empty()) {
+            JsonObject adapter(adapters.Next());
+            adapter.String("name", info.networkAdapterName);
+            adapter.String("mac", info.networkAdapterMac);
+            adapter.String("ipAddress", info.networkAdapterIp);
+            adapter.String("adapterType", info.networkAdapterType);
+            adapter.Unsigned("speed", info.networkAdapterSpeed);
+            adapter.End();
+        }
+        adapters.End();
+    }
+    if (Has(sectionMask, SHM_SECTION_DISKS)) {
+        JsonArray disks(root.Field("disks"));
+        for (const DiskData& disk : info.disks) {
+            JsonObject item(disks.Next());
+            item.String("letter", disk.letter ? std::string(1, disk.letter) : std::string());
+            item.String("label", disk.label);
+            item.String("fileSystem", disk.fileSystem);
+            item.Unsigned("totalSize", disk.totalSize);
+            item.Unsigned("usedSpace", disk.usedSpace);
+            item.Unsigned("freeSpace", disk.freeSpace);
+            item.End();
+        }
+        disks.End();
+    }
+    if (Has(sectionMask, SHM_SECTION_SMART)) {
+        JsonArray disks(root.Field("physicalDisks"));
+        for (const PhysicalDiskSmartData& disk : info.physicalDisks) AppendPhysicalDisk(disks.Next(), disk);
+        disks.End();
+    }
+    // 传感器名称属于 temperatures 分区，读数属于 sensors 分区
+    const bool names = Has(sectionMask, SHM_SECTION_TEMPERATURES);
+    const bool values = Has(sectionMask, SHM_SECTION_SENSORS);
+    if (names || values) {
+        JsonArray temperatures(root.Field("temperatures"));
+        for (const auto& temperature : info.temperatures) {
+            JsonObject item(temperatures.Next());
+            if (names) item.String("name", temperature.first);
+            if (values) item.Number("value", temperature.second);
+            item.End();
+        }
+        temperatures.End();
+    }
+    if (values) {
+        JsonObject sensors(root.Field("sensors"));
+        sensors.Number("cpuTemperature", info.cpuTemperature);
+        sensors.Number("gpuTemperature", info.gpuTemperature);
+        sensors.End();
+    }
+    root.End();
+    return out;
+}
+
+uint64_t SnapshotWriter::NowUnixMs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
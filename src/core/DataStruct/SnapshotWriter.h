@@ -0,0 +1,96 @@
+// SnapshotWriter.h
+#pragma once
+#include "DataStruct.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+constexpr uint32_t SNAPSHOT_RECORD_MAGIC = 0x4E534D53;  // "SMSN"
+// 2: 负载在兼容区分区之后追加完整的设备列表
+constexpr uint16_t SNAPSHOT_RECORD_VERSION = 2;
+
+// 二进制快照记录头。负载由两部分组成：
+//  1. sectionMask 中各分区按编号升序、每个分区按 SharedMemorySections 的范围表依次拼接的字节
+//     （与兼容区 SharedMemoryBlock 的布局相同），只含请求的分区；读端把这部分按同一范围表散布回清零的
+//     SharedMemoryBlock 即可复用结构定义。其中的设备数组受兼容区上限限制（GPU 2、网卡 4、逻辑 / 物理磁盘各 8、温度 10）
+//  2. 完整设备列表：请求的分区涉及的每个变长段一项，SnapshotListHeader 之后紧随 count 个元素，
+//     元素类型与共享内存中的变长段相同（见 SharedMemorySectionId），数量不受上限限制；一直排列到负载末尾
+// 见 SnapshotWriter::DecodeBinary。布局随写端平台的 wchar_t 宽度而不同，blockSize 不一致的记录应拒绝
+#pragma pack(push, 1)
+struct SnapshotRecordHeader {
+    uint32_t magic;             // SNAPSHOT_RECORD_MAGIC
+    uint16_t version;           // SNAPSHOT_RECORD_VERSION
+    uint16_t headerSize;        // sizeof(SnapshotRecordHeader)
+    uint32_t payloadSize;       // 紧随其后的负载字节数
+    uint32_t sectionMask;       // 负载包含的分区（1 << SharedMemorySection）
+    uint32_t index;             // 快照序号（从 0 开始）
+    uint32_t blockSize;         // 写端的 sizeof(SharedMemoryBlock)
+    uint64_t timestampMs;       // 采集完成时的 Unix 时间（毫秒）
+};
+
+struct SnapshotListHeader {
+    uint32_t id;                // SharedMemorySectionId（SHM_SEC_GPUS 等变长段）
+    uint32_t elementSize;       // 单个元素的字节数
+    uint32_t count;             // 元素个数
+};
+#pragma pack(pop)
+static_assert(sizeof(SnapshotRecordHeader) == 32, "SnapshotRecordHeader 必须固定为 32 字节");
+static_assert(sizeof(SnapshotListHeader) == 12, "SnapshotListHeader 必须固定为 12 字节");
+
+// 二进制记录中的完整设备列表（记录未请求对应分区时为空）
+struct SnapshotLists {
+    std::vector<GPUData> gpus;
+    std::vector<NetworkAdapterData> adapters;
+    std::vector<SharedMemoryBlock::SharedDiskData> disks;
+    std::vector<SharedPhysicalDiskData> physicalDisks;
+    std::vector<TemperatureData> temperatures;
+    std::vector<SharedCoreUsage> cores;
+};
+
+// 快照输出（无界面模式）：把 SystemInfo 中指定分区的内容写成 JSON 或紧凑二进制记录，
+// 不创建共享内存映射。JSON 每个快照一行（JSON Lines），字符串为 UTF-8，无效的浮点数写为 null
+class SnapshotWriter {
+public:
+    enum class Format {
+        Json,
+        Binary,
+    };
+
+    SnapshotWriter();
+    ~SnapshotWriter();
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    // "json" / "binary"
+    static bool ParseFormat(const std::string& name, Format& format);
+
+    // 打开输出：path 为空或 "-" 时写到标准输出（二进制格式下切换为二进制模式）
+    bool Open(const std::string& path, Format format);
+    // 写入一份快照并刷新输出；失败时返回 false（见 GetLastError）
+    bool Write(const SystemInfo& info, uint32_t sectionMask, uint32_t index, uint64_t timestampMs);
+    void Close();
+    const std::string& GetLastError() const { return lastError; }
+
+    // 单个快照的 JSON 对象（不含换行）
+    static std::string ToJson(const SystemInfo& info, uint32_t sectionMask, uint32_t index, uint64_t timestampMs);
+    // 把一条二进制记录的负载散布到 block（先清零记录中的分区），lists 非空时同时取出完整设备列表；
+    // 返回记录总字节数，数据不完整或格式不符时返回 0。未知 id 的列表跳过
+    static size_t DecodeBinary(const void* data, size_t size, SnapshotRecordHeader& header, SharedMemoryBlock* block,
+                               SnapshotLists* lists = nullptr);
+
+    // 当前 Unix 时间（毫秒）
+    static uint64_t NowUnixMs();
+
+private:
+    bool WriteBinary(const SystemInfo& info, uint32_t sectionMask, uint32_t index, uint64_t timestampMs);
+
+    FILE* file = nullptr;
+    bool ownsFile = false;
+    Format format = Format::Json;
+    std::unique_ptr<SharedMemoryBlock> block;   // 二进制格式的填充缓冲（与兼容区同样大小，只分配一次）
+    std::string buffer;                          // 序列化缓冲（容量跨快照沿用）
+    std::string lastError;
+};
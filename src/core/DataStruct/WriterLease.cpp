@@ -0,0 +1,120 @@
+#include "WriterLease.h"
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 持有者进程仍存在、但超过该周期数没有心跳时视为租约过期（PID 可能已被其他进程复用）
+constexpr uint64_t kLeaseExpiryIntervals = 30;
+
+uint64_t IntervalNs(const SharedLease& lease) {
+    const uint32_t intervalMs = lease.publishIntervalMs ? lease.publishIntervalMs : WriterLease::kDefaultPublishIntervalMs;
+    return static_cast<uint64_t>(intervalMs) * 1000000ULL;
+}
+
+uint64_t AgeNs(const SharedLease& lease, uint64_t nowNs) {
+    const uint64_t last = lease.lastPublishNs.load(std::memory_order_acquire);
+    return nowNs > last ? nowNs - last : 0;
+}
+
+} // namespace
+
+uint64_t WriterLease::MonotonicNowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint32_t WriterLease::CurrentProcessId() {
+#ifdef _WIN32
+    return static_cast<uint32_t>(GetCurrentProcessId());
+#else
+    return static_cast<uint32_t>(getpid());
+#endif
+}
+
+bool WriterLease::IsProcessAlive(uint32_t pid) {
+    if (pid == 0) return false;
+#ifdef _WIN32
+    // 非提升权限的读端对提升权限的写端也能取得 PROCESS_QUERY_LIMITED_INFORMATION
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid));
+    if (process == NULL) {
+        // 拒绝访问说明进程存在；其余错误（ERROR_INVALID_PARAMETER）表示该 PID 不存在
+        return ::GetLastError() == ERROR_ACCESS_DENIED;
+    }
+    DWORD exitCode = 0;
+    const bool alive = GetExitCodeProcess(process, &exitCode) && exitCode == STILL_ACTIVE;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+bool WriterLease::IsHeldByOther(const SharedLease& lease) {
+    const uint32_t holder = lease.pid.load(std::memory_order_acquire);
+    if (holder == 0 || holder == CurrentProcessId() || lease.state.load(std::memory_order_acquire) != StateRunning) {
+        return false;
+    }
+    const bool expired = AgeNs(lease, MonotonicNowNs()) > kLeaseExpiryIntervals * IntervalNs(lease);
+    return IsProcessAlive(holder) && !expired;
+}
+
+bool WriterLease::Acquire(SharedLease& lease, uint32_t publishIntervalMs, bool& reclaimed, std::string& error) {
+    reclaimed = false;
+    const uint32_t self = CurrentProcessId();
+    const uint32_t holder = lease.pid.load(std::memory_order_acquire);
+    if (holder != 0 && holder != self && lease.state.load(std::memory_order_acquire) == StateRunning) {
+        if (IsHeldByOther(lease)) {
+            error = "共享内存正由另一个写端进程 (PID " + std::to_string(holder) + ") 发布";
+            return false;
+        }
+        reclaimed = true;
+    }
+    lease.publishIntervalMs = publishIntervalMs ? publishIntervalMs : kDefaultPublishIntervalMs;
+    // 租约年龄从接管时刻算起；heartbeat 不清零，读端看到的计数始终单调
+    lease.lastPublishNs.store(MonotonicNowNs(), std::memory_order_relaxed);
+    lease.pid.store(self, std::memory_order_relaxed);
+    lease.state.store(StateRunning, std::memory_order_release);
+    return true;
+}
+
+void WriterLease::Beat(SharedLease& lease, uint64_t publishNs) {
+    lease.lastPublishNs.store(publishNs, std::memory_order_relaxed);
+    lease.heartbeat.fetch_add(1, std::memory_order_release);
+}
+
+void WriterLease::Release(SharedLease& lease) {
+    if (lease.pid.load(std::memory_order_relaxed) != CurrentProcessId()) return;
+    lease.state.store(StateStopped, std::memory_order_release);
+}
+
+WriterLease::Status WriterLease::Classify(const SharedLease& lease, double* ageMsOut) {
+    if (ageMsOut) *ageMsOut = -1.0;
+    const uint32_t state = lease.state.load(std::memory_order_acquire);
+    const uint32_t pid = lease.pid.load(std::memory_order_relaxed);
+    if (state == StateNone || pid == 0) return Status::Unknown;
+
+    const uint64_t ageNs = AgeNs(lease, MonotonicNowNs());
+    const bool published = lease.heartbeat.load(std::memory_order_acquire) != 0;
+    if (ageMsOut && published) *ageMsOut = static_cast<double>(ageNs) / 1e6;
+    if (state == StateStopped) return Status::Orphaned;
+    if (!published) return IsProcessAlive(pid) ? Status::Unknown : Status::Orphaned;
+    if (ageNs <= kStaleIntervals * IntervalNs(lease)) return Status::Fresh;
+    return IsProcessAlive(pid) ? Status::Stale : Status::Orphaned;
+}
+
+const char* WriterLease::ToString(Status status) {
+    switch (status) {
+    case Status::Fresh: return "fresh";
+    case Status::Stale: return "stale";
+    case Status::Orphaned: return "orphaned";
+    default: return "unknown";
+    }
+}
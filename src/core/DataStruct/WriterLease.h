@@ -0,0 +1,46 @@
+#pragma once
+#include "DataStruct.h"
+#include <cstdint>
+#include <string>
+
+// 写端租约：写端 PID、心跳计数与单调时钟发布时间（SharedLease），主写端的租约位于共享内存头部，
+// 附加写端的租约位于 SharedProducerTable
+// 读端只需读几个原子字段即可判断数据是否新鲜，无需解析 lastUpdate（墙上时间，校时后会跳变）
+// 单调时间取自 steady_clock（Windows: QueryPerformanceCounter，Linux: CLOCK_MONOTONIC），同一主机上跨进程可比
+class WriterLease {
+public:
+    enum State : uint32_t {
+        StateNone = 0,       // 从未有写端持有
+        StateRunning = 1,    // 写端运行中
+        StateStopped = 2,    // 写端已正常退出
+    };
+
+    enum class Status {
+        Fresh,      // 最近一个发布周期内有发布
+        Stale,      // 写端进程仍在，但超过 kStaleIntervals 个周期没有发布（例如卡在 WMI 调用中）
+        Orphaned,   // 写端已退出或崩溃，数据不会再更新
+        Unknown,    // 从未有写端持有或尚未发布过
+    };
+
+    static constexpr uint32_t kDefaultPublishIntervalMs = 1000;
+    static constexpr uint32_t kStaleIntervals = 3;
+
+    static uint64_t MonotonicNowNs();
+    static uint32_t CurrentProcessId();
+    static bool IsProcessAlive(uint32_t pid);
+
+    // 写端启动时调用：租约由存活的其他写端持有时返回 false 并填写 error；
+    // 上一个持有者已崩溃时返回 true，并将 reclaimed 置为 true，由调用方修复其遗留状态
+    static bool Acquire(SharedLease& lease, uint32_t publishIntervalMs, bool& reclaimed, std::string& error);
+    // 租约是否由本进程之外的存活写端持有（进程仍在且心跳未超过过期时间）
+    static bool IsHeldByOther(const SharedLease& lease);
+    // 写端每次发布时调用（seqlock 写临界区内），publishNs 为本轮发布的单调时间
+    static void Beat(SharedLease& lease, uint64_t publishNs);
+    // 写端正常退出时调用，读端随即看到 Orphaned，而不必等待心跳超时
+    static void Release(SharedLease& lease);
+
+    // 读端：按心跳年龄分类；只有心跳超时时才检查写端进程是否存在
+    // ageMsOut 返回距最近一次发布的毫秒数（未知时为 -1）
+    static Status Classify(const SharedLease& lease, double* ageMsOut = nullptr);
+    static const char* ToString(Status status);
+};
@@ -0,0 +1,15 @@
+// AllocationCounter.h
+#pragma once
+#include <cstdint>
+
+// 堆分配计数：本模块替换全局 operator new / delete（全部重载形式），按次数与字节数累计，
+// 开销为每次分配一次无竞争的原子加法。链接 AllocationCounter.cpp 即生效；未链接时不应调用这里的函数
+class AllocationCounter {
+public:
+    // 进程启动以来经 operator new 的分配次数（含数组与对齐形式）
+    static uint64_t Count();
+    // 累计申请的字节数
+    static uint64_t Bytes();
+    // 调用线程自启动以来的分配次数：只统计本线程，其他线程并发的分配不会混入（用于检查某段代码是否分配）
+    static uint64_t ThreadCount();
+};
@@ -3,6 +3,7 @@
 #include <msclr/marshal_cppstd.h>
 #include <iostream>
 #include <windows.h>
+#include <vcclr.h>
 
 // 不需要重复#using，已在头文件中包含
 
@@ -44,9 +45,35 @@ void LibreHardwareMonitorBridge::Cleanup() {
     initialized = false;
 }
 
-std::vector<std::pair<std::string, double>> LibreHardwareMonitorBridge::GetTemperatures() {
-    std::vector<std::pair<std::string, double>> temps;
-    if (!initialized) return temps;
+namespace {
+
+// 托管字符串转 UTF-8 写入已有的 std::string：经栈上缓冲区转换，名称不变时 assign 沿用原有容量
+void AssignUtf8(std::string& target, String^ value) {
+    pin_ptr<const wchar_t> chars = PtrToStringChars(value);
+    if (value->Length == 0) {
+        target.clear();
+        return;
+    }
+    char buffer[256];
+    const int length = WideCharToMultiByte(CP_UTF8, 0, chars, value->Length, buffer, sizeof(buffer), nullptr, nullptr);
+    if (length > 0) {
+        target.assign(buffer, static_cast<size_t>(length));
+        return;
+    }
+    // 超长名称（罕见）：按实际长度转换
+    const int needed = WideCharToMultiByte(CP_UTF8, 0, chars, value->Length, nullptr, 0, nullptr, nullptr);
+    target.resize(needed > 0 ? static_cast<size_t>(needed) : 0);
+    if (needed > 0) WideCharToMultiByte(CP_UTF8, 0, chars, value->Length, &target[0], needed, nullptr, nullptr);
+}
+
+} // namespace
+
+size_t LibreHardwareMonitorBridge::GetTemperatures(std::vector<std::pair<std::string, double>>& temps) {
+    size_t count = 0;
+    if (!initialized) {
+        temps.clear();
+        return 0;
+    }
 
     computer->Accept(visitor);
     for each (IHardware ^ hardware in computer->Hardware) {
@@ -56,11 +83,14 @@ std::vector<std::pair<std::string, double>> LibreHardwareMonitorBridge::GetTempe
             hardware->HardwareType == HardwareType::GpuAmd) {
             for each (ISensor ^ sensor in hardware->Sensors) {
                 if (sensor->SensorType == SensorType::Temperature && sensor->Value.HasValue) {
-                    std::string name = marshal_as<std::string>(sensor->Name);
-                    temps.push_back({ name, sensor->Value.Value });
+                    if (count == temps.size()) temps.emplace_back();
+                    AssignUtf8(temps[count].first, sensor->Name);
+                    temps[count].second = sensor->Value.Value;
+                    ++count;
                 }
             }
         }
     }
-    return temps;
+    temps.resize(count);
+    return count;
 }
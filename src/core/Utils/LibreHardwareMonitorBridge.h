@@ -33,8 +33,8 @@ class LibreHardwareMonitorBridge {
 public:
     static void Initialize();
     static void Cleanup();
-    // 日志语义优化：温度传感器数量
-    static std::vector<std::pair<std::string, double>> GetTemperatures();
+    // 读取 CPU / GPU 温度传感器到 temps（原地改写已有元素的名称，传感器列表不变时不重新分配），返回读数个数
+    static size_t GetTemperatures(std::vector<std::pair<std::string, double>>& temps);
 
 private:
     static bool initialized;
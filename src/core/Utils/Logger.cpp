@@ -1,14 +1,17 @@
 ﻿#include "stdafx.h"
 #include "Logger.h"
+#include <atomic>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
+#ifdef _WIN32
 #include <io.h>
 #include <fcntl.h>
 #include <windows.h> // For MultiByteToWideChar
+#endif
 #include <algorithm> // For std::transform
 #include <vector> // For std::vector used in UTF-8 to UTF-16 conversion
 
@@ -16,7 +19,10 @@ std::ofstream Logger::logFile;
 std::mutex Logger::logMutex;
 bool Logger::consoleOutputEnabled = true; // Initialize console output flag
 LogLevel Logger::currentLogLevel = LOG_DEBUG; // 默认日志等级为INFO
+static std::atomic<uint64_t> callCount{ 0 };
+#ifdef _WIN32
 HANDLE Logger::hConsole = GetStdHandle(STD_OUTPUT_HANDLE); // 初始化控制台句柄
+#endif
 
 void Logger::Initialize(const std::string& logFilePath) {
     logFile.open(logFilePath, std::ios::binary | std::ios::app);
@@ -30,6 +36,7 @@ void Logger::Initialize(const std::string& logFilePath) {
         logFile.write(reinterpret_cast<const char*>(bom), sizeof(bom));
     }
 
+#ifdef _WIN32
     // 设置控制台编码为UTF-8，确保中文显示正确
     SetConsoleCP(65001);
     SetConsoleOutputCP(65001);
@@ -42,6 +49,7 @@ void Logger::Initialize(const std::string& logFilePath) {
         dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
         SetConsoleMode(hOut, dwMode);
     }
+#endif
 }
 
 void Logger::EnableConsoleOutput(bool enable) {
@@ -60,6 +68,15 @@ LogLevel Logger::GetLogLevel() {
     return logFile.is_open();
 }
 
+bool Logger::IsEnabled(LogLevel level) {
+    return level >= currentLogLevel;
+}
+
+uint64_t Logger::CallCount() {
+    return callCount.load(std::memory_order_relaxed);
+}
+
+#ifdef _WIN32
 void Logger::SetConsoleColor(ConsoleColor color) {
     if (hConsole != INVALID_HANDLE_VALUE) {
         SetConsoleTextAttribute(hConsole, static_cast<WORD>(color));
@@ -71,7 +88,27 @@ void Logger::ResetConsoleColor() {
         SetConsoleTextAttribute(hConsole, static_cast<WORD>(7)); // 默认白色，显式转换WORD，消除C4365
     }
 }
+#else
+// 非 Windows 平台使用 ANSI 转义序列着色
+void Logger::SetConsoleColor(ConsoleColor color) {
+    const char* code = "\033[0m";
+    switch (color) {
+    case ConsoleColor::LIGHT_MAGENTA: code = "\033[95m"; break;
+    case ConsoleColor::LIGHT_GREEN:   code = "\033[92m"; break;
+    case ConsoleColor::YELLOW:        code = "\033[93m"; break;
+    case ConsoleColor::LIGHT_RED:     code = "\033[91m"; break;
+    case ConsoleColor::DARK_RED:      code = "\033[31m"; break;
+    default: break;
+    }
+    std::cout << code;
+}
 
+void Logger::ResetConsoleColor() {
+    std::cout << "\033[0m";
+}
+#endif
+
+#ifdef _WIN32
 std::wstring Logger::ConvertToWideString(const std::string& utf8Str) {
     // Handle empty string case
     if (utf8Str.empty()) {
@@ -92,8 +129,11 @@ std::wstring Logger::ConvertToWideString(const std::string& utf8Str) {
     }
     return wideStr;
 }
+#endif
 
 void Logger::WriteLog(const std::string& level, const std::string& message, LogLevel msgLevel, ConsoleColor color) {
+    // 在等级过滤之前计数：被过滤的调用在调用方同样拼接过消息
+    callCount.fetch_add(1, std::memory_order_relaxed);
     // 检查日志等级过滤
     if (msgLevel < currentLogLevel) {
         return; // 跳过低于当前等级的日志
@@ -115,9 +155,15 @@ void Logger::WriteLog(const std::string& level, const std::string& message, LogL
         auto now = std::chrono::system_clock::now();
         auto time_now = std::chrono::system_clock::to_time_t(now);
         std::tm timeinfo;
+#ifdef _WIN32
         if (localtime_s(&timeinfo, &time_now) != 0) {
             throw std::runtime_error("localtime_s 失败");
         }
+#else
+        if (localtime_r(&time_now, &timeinfo) == nullptr) {
+            throw std::runtime_error("localtime_r 失败");
+        }
+#endif
         std::stringstream ss;
         ss << "[" << std::put_time(&timeinfo, "%Y-%m-%d %H:%M:%S") << "]"
            << "[" << level << "] "
@@ -133,6 +179,7 @@ void Logger::WriteLog(const std::string& level, const std::string& message, LogL
         }
         // Enhanced console output with proper UTF-8 support and selective coloring
         if (consoleOutputEnabled) {
+#ifdef _WIN32
             HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
             if (hConsole != INVALID_HANDLE_VALUE) {
                 std::stringstream timeStamp;
@@ -166,6 +213,13 @@ void Logger::WriteLog(const std::string& level, const std::string& message, LogL
                 }
                 WriteConsoleW(hConsole, L"\n", 1, &written, NULL);
             }
+#else
+            std::cout << "[" << std::put_time(&timeinfo, "%Y-%m-%d %H:%M:%S") << "]";
+            SetConsoleColor(color);
+            std::cout << "[" << level << "]";
+            ResetConsoleColor();
+            std::cout << " " << message << std::endl;
+#endif
         }
     } else {
         throw std::runtime_error("日志文件未打开");
@@ -1,9 +1,12 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <fstream>
 #include <mutex>
 #include <algorithm> // Added for std::transform
+#ifdef _WIN32
 #include <windows.h> // For console color support
+#endif
 
 // 日志等级枚举
 enum LogLevel {
@@ -48,9 +51,13 @@ private:
     static std::mutex logMutex;
     static bool consoleOutputEnabled; // Flag for console output
     static LogLevel currentLogLevel; // 当前日志等级过滤器
+#ifdef _WIN32
     static HANDLE hConsole; // 控制台句柄
+#endif
     static void WriteLog(const std::string& level, const std::string& message, LogLevel msgLevel, ConsoleColor color);
+#ifdef _WIN32
     static std::wstring ConvertToWideString(const std::string& utf8Str); // Helper for UTF-8 to wide string conversion
+#endif
     static void SetConsoleColor(ConsoleColor color); // 设置控制台颜色
     static void ResetConsoleColor(); // 重置控制台颜色
 
@@ -60,6 +67,8 @@ public:
     static void SetLogLevel(LogLevel level); // 设置日志等级过滤器
     static LogLevel GetLogLevel(); // 获取当前日志等级
     static bool IsInitialized(); // 检查Logger是否已初始化
+    static bool IsEnabled(LogLevel level); // 该等级的日志是否会输出；热路径上先判断再拼接消息，避免无谓的字符串分配
+    static uint64_t CallCount(); // 日志调用次数（含被等级过滤的）：拼接消息本身会分配，稳态检查据此排除调用过日志的轮次，不受等级过滤影响
     
     // Log level methods (ordered by severity: Trace < Debug < Info < Warning < Error < Critical < Fatal)
     static void Trace(const std::string& message);   // 最详细的信息，通常只在调试时使用 (白色)
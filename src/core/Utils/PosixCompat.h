@@ -0,0 +1,34 @@
+#pragma once
+// 非 Windows 平台的最小兼容层：只提供共享内存结构和写端用到的 Win32 类型/函数，
+// 用于在 Linux 上以 POSIX 共享内存替代文件映射，对 IPC 协议做压力测试
+#ifndef _WIN32
+#include <cstdint>
+#include <ctime>
+#include <sys/time.h>
+
+struct SYSTEMTIME {
+    uint16_t wYear;
+    uint16_t wMonth;
+    uint16_t wDayOfWeek;
+    uint16_t wDay;
+    uint16_t wHour;
+    uint16_t wMinute;
+    uint16_t wSecond;
+    uint16_t wMilliseconds;
+};
+
+inline void GetSystemTime(SYSTEMTIME* st) {
+    timeval tv{};
+    gettimeofday(&tv, nullptr);
+    std::tm tm{};
+    gmtime_r(&tv.tv_sec, &tm);
+    st->wYear = static_cast<uint16_t>(tm.tm_year + 1900);
+    st->wMonth = static_cast<uint16_t>(tm.tm_mon + 1);
+    st->wDayOfWeek = static_cast<uint16_t>(tm.tm_wday);
+    st->wDay = static_cast<uint16_t>(tm.tm_mday);
+    st->wHour = static_cast<uint16_t>(tm.tm_hour);
+    st->wMinute = static_cast<uint16_t>(tm.tm_min);
+    st->wSecond = static_cast<uint16_t>(tm.tm_sec);
+    st->wMilliseconds = static_cast<uint16_t>(tv.tv_usec / 1000);
+}
+#endif
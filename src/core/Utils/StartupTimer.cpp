@@ -0,0 +1,111 @@
+// StartupTimer.cpp
+#include "StartupTimer.h"
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+#endif
+
+StartupTimer::StartupTimer(Clock::time_point origin) : origin(origin), lastMark(origin) {}
+
+void StartupTimer::Record(const std::string& name, Clock::time_point begin, Clock::time_point end) {
+    Phase phase;
+    phase.name = name;
+    phase.startMs = ToMs(begin);
+    phase.durationMs = std::chrono::duration<double, std::milli>(end - begin).count();
+    std::lock_guard<std::mutex> lock(mutex);
+    phases.push_back(phase);
+}
+
+void StartupTimer::Mark(const std::string& name) {
+    const Clock::time_point now = Clock::now();
+    Clock::time_point begin;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        begin = lastMark;
+        lastMark = now;
+    }
+    Record(name, begin, now);
+}
+
+std::vector<StartupTimer::Phase> StartupTimer::Phases() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return phases;
+}
+
+double StartupTimer::ElapsedMs(Clock::time_point now) const {
+    return ToMs(now);
+}
+
+double StartupTimer::ToMs(Clock::time_point time) const {
+    return std::chrono::duration<double, std::milli>(time - origin).count();
+}
+
+std::string StartupTimer::Describe() const {
+    std::vector<Phase> sorted = Phases();
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Phase& a, const Phase& b) { return a.startMs < b.startMs; });
+    double endMs = 0.0;
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "启动阶段耗时（ms，起点 / 耗时 / 阶段）:\n";
+    for (const Phase& phase : sorted) {
+        ss << std::setw(9) << phase.startMs << std::setw(9) << phase.durationMs << "  " << phase.name << "\n";
+        endMs = (std::max)(endMs, phase.startMs + phase.durationMs);
+    }
+    ss << "合计 " << endMs << "ms";
+    return ss.str();
+}
+
+#ifdef _WIN32
+
+StartupTimer::Clock::time_point StartupTimer::ProcessStart() {
+    FILETIME creation{}, exitTime{}, kernel{}, user{};
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) return Clock::now();
+    FILETIME nowTime{};
+    GetSystemTimePreciseAsFileTime(&nowTime);
+    const Clock::time_point now = Clock::now();
+    const auto toTicks = [](const FILETIME& time) {
+        return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    const uint64_t created = toTicks(creation);
+    const uint64_t current = toTicks(nowTime);
+    if (current <= created) return now;
+    // FILETIME 单位为 100ns
+    return now - std::chrono::microseconds((current - created) / 10);
+}
+
+#else
+
+StartupTimer::Clock::time_point StartupTimer::ProcessStart() {
+    const Clock::time_point now = Clock::now();
+    // /proc/self/stat 第 22 个字段：进程启动时刻（开机以来的时钟滴答数，与 CLOCK_BOOTTIME 同一时基）
+    FILE* file = fopen("/proc/self/stat", "r");
+    if (!file) return now;
+    char buffer[1024];
+    const size_t size = fread(buffer, 1, sizeof(buffer) - 1, file);
+    fclose(file);
+    buffer[size] = '\0';
+    // 进程名可能含空格与括号，从最后一个 ')' 之后开始数：其后为第 3 个字段
+    const char* field = strrchr(buffer, ')');
+    if (!field) return now;
+    for (int index = 2; index < 22 && field; ++index) field = strchr(field + 1, ' ');
+    if (!field) return now;
+    const unsigned long long startTicks = strtoull(field + 1, nullptr, 10);
+    const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    timespec boot{};
+    if (ticksPerSecond <= 0 || clock_gettime(CLOCK_BOOTTIME, &boot) != 0) return now;
+    const double ageSeconds = boot.tv_sec + boot.tv_nsec / 1e9 - static_cast<double>(startTicks) / ticksPerSecond;
+    if (ageSeconds <= 0.0) return now;
+    return now - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(ageSeconds));
+}
+
+#endif
@@ -0,0 +1,45 @@
+// StartupTimer.h
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 启动阶段计时：记录进程启动之后各阶段（日志、COM、WMI、各数据源初始化、首次采集……）的起止时间，
+// 用于输出冷启动开销的分解。阶段可以嵌套或重叠（如在某个数据源初始化期间首次连接 WMI），
+// 按起点排列后由起点与耗时即可看出包含关系。可在多个线程上记录（后台初始化的数据源）
+class StartupTimer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Phase {
+        std::string name;
+        double startMs = 0.0;       // 相对计时起点
+        double durationMs = 0.0;
+    };
+
+    // origin 为计时起点；传入 ProcessStart() 时包含进入 main 之前的加载时间（运行库、静态初始化、CLR）
+    explicit StartupTimer(Clock::time_point origin = Clock::now());
+
+    // 记录一个阶段 [begin, end]
+    void Record(const std::string& name, Clock::time_point begin, Clock::time_point end);
+    // 记录从上一次 Mark（或计时起点）到现在的阶段
+    void Mark(const std::string& name);
+
+    std::vector<Phase> Phases() const;
+    // 自计时起点以来的毫秒数
+    double ElapsedMs(Clock::time_point now = Clock::now()) const;
+    // 阶段表：每行为 起点、耗时、名称（按起点排序），末行为总耗时
+    std::string Describe() const;
+
+    // 本进程的创建时刻（换算到单调时钟）；无法获取时返回 Clock::now()
+    static Clock::time_point ProcessStart();
+
+private:
+    double ToMs(Clock::time_point time) const;
+
+    const Clock::time_point origin;
+    mutable std::mutex mutex;
+    Clock::time_point lastMark;
+    std::vector<Phase> phases;
+};
@@ -1,6 +1,10 @@
 ﻿#pragma once
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <string>
+#include <cstdint>
+#include <cstring>
 
 // 所有 std::string <-> std::wstring 转换统一使用 UTF-8
 // 约定: DataStruct.h 中所有 std::string (例如 DiskData.label / fileSystem, SystemInfo.* 字段)
@@ -8,6 +12,7 @@
 class WinUtils {
 public:
     // 基础 UTF-8 转换实现（抛异常安全，失败返回空）
+#ifdef _WIN32
     static std::string WstringToUtf8(const std::wstring& wstr) {
         if (wstr.empty()) return {};
         int size_needed = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (int)wstr.size(), nullptr, 0, nullptr, nullptr);
@@ -24,6 +29,74 @@ public:
         MultiByteToWideChar(CP_UTF8, 0, str.c_str(), (int)str.size(), out.data(), size_needed);
         return out;
     }
+    // 转换到调用方的定长数组（先清零，最多 destSize - 1 个字符，总以 \0 结尾），返回写入的字符数
+    // 不经过临时 std::wstring：发布路径上每轮都要转换的名称不产生堆分配
+    static size_t Utf8ToWideBuffer(const std::string& str, wchar_t* dest, size_t destSize) {
+        if (dest == nullptr || destSize == 0) return 0;
+        memset(dest, 0, destSize * sizeof(wchar_t));
+        if (str.empty()) return 0;
+        const int written = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), (int)str.size(), dest, (int)(destSize - 1));
+        if (written > 0) return static_cast<size_t>(written);
+        // 数组放不下（失败时内容未定义）：完整转换后截断，只在超长名称上发生
+        const std::wstring wide = Utf8ToWstring(str);
+        const size_t length = wide.size() < destSize - 1 ? wide.size() : destSize - 1;
+        memset(dest, 0, destSize * sizeof(wchar_t));
+        memcpy(dest, wide.data(), length * sizeof(wchar_t));
+        return length;
+    }
+#else
+    // 非 Windows 平台 wchar_t 为 UTF-32，手工编解码
+    static std::string WstringToUtf8(const std::wstring& wstr) {
+        std::string out;
+        out.reserve(wstr.size());
+        for (wchar_t wc : wstr) {
+            uint32_t cp = static_cast<uint32_t>(wc);
+            if (cp < 0x80) { out.push_back(static_cast<char>(cp)); }
+            else if (cp < 0x800) { out.push_back(static_cast<char>(0xC0 | (cp >> 6))); out.push_back(static_cast<char>(0x80 | (cp & 0x3F))); }
+            else if (cp < 0x10000) { out.push_back(static_cast<char>(0xE0 | (cp >> 12))); out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F))); out.push_back(static_cast<char>(0x80 | (cp & 0x3F))); }
+            else if (cp < 0x110000) { out.push_back(static_cast<char>(0xF0 | (cp >> 18))); out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F))); out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F))); out.push_back(static_cast<char>(0x80 | (cp & 0x3F))); }
+        }
+        return out;
+    }
+    static std::wstring Utf8ToWstring(const std::string& str) {
+        if (!IsLikelyUtf8(str)) return {};
+        std::wstring out;
+        out.reserve(str.size());
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(str.data());
+        size_t i = 0, len = str.size();
+        while (i < len) {
+            unsigned char c = bytes[i];
+            uint32_t cp = 0; size_t seqLen = 1;
+            if (c < 0x80) cp = c;
+            else if ((c & 0xE0) == 0xC0) { cp = c & 0x1F; seqLen = 2; }
+            else if ((c & 0xF0) == 0xE0) { cp = c & 0x0F; seqLen = 3; }
+            else { cp = c & 0x07; seqLen = 4; }
+            for (size_t k = 1; k < seqLen; ++k) cp = (cp << 6) | (bytes[i + k] & 0x3F);
+            out.push_back(static_cast<wchar_t>(cp));
+            i += seqLen;
+        }
+        return out;
+    }
+    static size_t Utf8ToWideBuffer(const std::string& str, wchar_t* dest, size_t destSize) {
+        if (dest == nullptr || destSize == 0) return 0;
+        memset(dest, 0, destSize * sizeof(wchar_t));
+        if (!IsLikelyUtf8(str)) return 0;
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(str.data());
+        size_t i = 0, len = str.size(), written = 0;
+        while (i < len && written < destSize - 1) {
+            unsigned char c = bytes[i];
+            uint32_t cp = 0; size_t seqLen = 1;
+            if (c < 0x80) cp = c;
+            else if ((c & 0xE0) == 0xC0) { cp = c & 0x1F; seqLen = 2; }
+            else if ((c & 0xF0) == 0xE0) { cp = c & 0x0F; seqLen = 3; }
+            else { cp = c & 0x07; seqLen = 4; }
+            for (size_t k = 1; k < seqLen; ++k) cp = (cp << 6) | (bytes[i + k] & 0x3F);
+            dest[written++] = static_cast<wchar_t>(cp);
+            i += seqLen;
+        }
+        return written;
+    }
+#endif
 
     // 兼容旧命名（保持语义：UTF-8）
     static std::wstring StringToWstring(const std::string& str) { return Utf8ToWstring(str); }
@@ -45,9 +118,11 @@ public:
         return true;
     }
 
+#ifdef _WIN32
     static bool EnablePrivilege(const std::wstring& privilegeName, bool enable = true);
     static bool CheckPrivilege(const std::wstring& privilegeName);
     static bool IsRunAsAdmin();
     static std::string FormatWindowsErrorMessage(DWORD errorCode);
     static std::string GetExecutableDirectory();
+#endif
 };
@@ -12,8 +12,10 @@
 #include <stdexcept>
 
 // Windows specific includes
+#ifdef _WIN32
 #include <windows.h>
 #include <io.h>
+#endif
 #include <fcntl.h>
 
 // C++20 specific headers if needed
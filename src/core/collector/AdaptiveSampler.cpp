@@ -0,0 +1,88 @@
+// AdaptiveSampler.cpp
+#include "AdaptiveSampler.h"
+#include "../Utils/Logger.h"
+#include <cmath>
+#include <sstream>
+
+const char* AdaptiveSampler::ModeName(Mode mode) {
+    switch (mode) {
+    case Mode::Fast: return "加速";
+    case Mode::Idle: return "降频";
+    default: return "常规";
+    }
+}
+
+bool AdaptiveSampler::Observe(const SystemInfo& info) {
+    const double memoryPct = info.totalMemory > 0 ? 100.0 * static_cast<double>(info.usedMemory) / info.totalMemory : 0.0;
+    const bool changed = observed &&
+        (std::fabs(info.cpuUsage - lastCpu) >= config.cpuChange ||
+         std::fabs(memoryPct - lastMemoryPct) >= config.memoryChange ||
+         std::fabs(info.cpuTemperature - lastCpuTemperature) >= config.temperatureChange ||
+         std::fabs(info.gpuTemperature - lastGpuTemperature) >= config.temperatureChange);
+    observed = true;
+    lastCpu = info.cpuUsage;
+    lastMemoryPct = memoryPct;
+    lastCpuTemperature = info.cpuTemperature;
+    lastGpuTemperature = info.gpuTemperature;
+    return changed;
+}
+
+void AdaptiveSampler::UpdateShedding(double hostCpu, Clock::time_point now) {
+    if (config.cpuCeiling <= 0.0) return;
+    if (!current.shed) {
+        if (hostCpu < config.cpuCeiling) {
+            overSince = Clock::time_point{};
+            return;
+        }
+        if (overSince == Clock::time_point{}) overSince = now;
+        if (now - overSince < config.shedAfter) return;
+        current.shed = true;
+        underSince = Clock::time_point{};
+        if (Logger::IsEnabled(LOG_WARNING)) {
+            std::stringstream ss;
+            ss.precision(1);
+            ss << std::fixed << "主机 CPU 占用率 " << hostCpu << "% 持续高于上限 " << config.cpuCeiling
+               << "%，暂停昂贵的数据源";
+            Logger::Warn(ss.str());
+        }
+        return;
+    }
+    if (hostCpu >= config.cpuCeiling - config.ceilingHysteresis) {
+        underSince = Clock::time_point{};
+        return;
+    }
+    if (underSince == Clock::time_point{}) underSince = now;
+    if (now - underSince < config.restoreAfter) return;
+    current.shed = false;
+    overSince = Clock::time_point{};
+    if (Logger::IsEnabled(LOG_INFO)) {
+        std::stringstream ss;
+        ss.precision(1);
+        ss << std::fixed << "主机 CPU 占用率回落到 " << hostCpu << "%，恢复昂贵的数据源";
+        Logger::Info(ss.str());
+    }
+}
+
+AdaptiveSampler::Decision AdaptiveSampler::Update(const SystemInfo& info, double hostCpu, bool readerAttached,
+                                                  Clock::time_point now) {
+    if (startedAt == Clock::time_point{}) startedAt = now;
+    if (Observe(info)) lastChange = now;
+    UpdateShedding(hostCpu, now);
+
+    const bool changing = lastChange != Clock::time_point{} && now - lastChange < config.fastHold;
+    // 启动后尚未变化过时从启动算起，刚启动不直接降频
+    const Clock::time_point stableSince = lastChange != Clock::time_point{} ? lastChange : startedAt;
+    Mode mode = Mode::Normal;
+    if (changing || readerAttached) mode = Mode::Fast;
+    else if (now - stableSince >= config.idleAfter) mode = Mode::Idle;
+    // 主机过载时不加速，监视器自身让路
+    if (current.shed && mode == Mode::Fast) mode = Mode::Normal;
+
+    if (mode != current.mode && Logger::IsEnabled(LOG_INFO)) {
+        Logger::Info(std::string("采样模式: ") + ModeName(current.mode) + " -> " + ModeName(mode) +
+                     (readerAttached ? "（有读端）" : "（无读端）"));
+    }
+    current.mode = mode;
+    current.rateScale = mode == Mode::Fast ? config.fastScale : mode == Mode::Idle ? config.idleScale : 1.0;
+    return current;
+}
@@ -0,0 +1,69 @@
+// AdaptiveSampler.h
+#pragma once
+#include "../DataStruct/DataStruct.h"
+#include <chrono>
+
+// 自适应采样策略：根据被监视指标的变化速度、是否有读端在看以及主机 CPU 负载，
+// 给出自适应数据源的周期倍率（交给 CollectorScheduler::SetRateScale）与是否暂停昂贵的数据源（SetShedding）
+//  - 指标在 fastHold 内快速变化过，或有读端在看：加速（fastScale），捕捉短时尖峰、让读端看到最新数据
+//  - 没有读端且指标平稳超过 idleAfter（启动后从未变化则从启动算起）：降频（idleScale）
+//  - 其余情况（无读端，最近一次变化在 fastHold 与 idleAfter 之间）按配置的周期
+//  - 主机 CPU 持续 shedAfter 高于上限：暂停昂贵的数据源并停止加速，
+//    回落到 上限 - 滞回 以下持续 restoreAfter 后恢复（暂停本身会降低占用率，滞回避免来回切换）
+class AdaptiveSampler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        double cpuCeiling = 90.0;                   // 主机 CPU 占用率上限（%），<= 0 表示不减载
+        double ceilingHysteresis = 10.0;
+        std::chrono::seconds shedAfter{ 3 };
+        std::chrono::seconds restoreAfter{ 10 };
+        double cpuChange = 3.0;                     // 相邻两次观测的 CPU 占用率变化（百分点），占用率已经过平滑
+        double memoryChange = 2.0;                  // 内存占用率变化（百分点）
+        double temperatureChange = 3.0;             // CPU / GPU 温度变化（℃）
+        std::chrono::seconds fastHold{ 10 };
+        std::chrono::seconds idleAfter{ 30 };
+        double fastScale = 0.25;
+        double idleScale = 4.0;
+    };
+
+    enum class Mode {
+        Fast,
+        Normal,
+        Idle,
+    };
+
+    struct Decision {
+        Mode mode = Mode::Normal;
+        double rateScale = 1.0;
+        bool shed = false;
+    };
+
+    AdaptiveSampler() = default;
+    explicit AdaptiveSampler(const Config& config) : config(config) {}
+
+    // 每次合并新数据后调用；hostCpu 为主机 CPU 占用率（%），readerAttached 为近期是否有读端读取
+    // 模式或减载状态变化时记录日志
+    Decision Update(const SystemInfo& info, double hostCpu, bool readerAttached, Clock::time_point now);
+    const Decision& Current() const { return current; }
+
+    static const char* ModeName(Mode mode);
+
+private:
+    // 与上一次观测相比是否有指标快速变化，并记录本次观测
+    bool Observe(const SystemInfo& info);
+    void UpdateShedding(double hostCpu, Clock::time_point now);
+
+    Config config;
+    Decision current;
+    bool observed = false;
+    double lastCpu = 0.0;
+    double lastMemoryPct = 0.0;
+    double lastCpuTemperature = 0.0;
+    double lastGpuTemperature = 0.0;
+    Clock::time_point startedAt{};      // 首次 Update 的时间
+    Clock::time_point lastChange{};     // 最近一次指标快速变化，{} 表示启动后尚未变化
+    Clock::time_point overSince{};      // 持续高于上限的起点，{} 表示当前不高于上限
+    Clock::time_point underSince{};     // 减载期间持续低于恢复阈值的起点
+};
@@ -0,0 +1,203 @@
+// AsyncExecutor.cpp
+#include "AsyncExecutor.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
+// 顶层协程的驱动：结束时自行销毁帧并从执行器注销
+struct AsyncExecutor::Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return Detached{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+AsyncExecutor::Detached AsyncExecutor::Drive(AsyncExecutor* executor, uint64_t id, std::string name, Task<void> task) {
+    try {
+        co_await std::move(task);
+    }
+    catch (const std::exception& e) {
+        Logger::Error("协程 " + name + " 异常结束: " + std::string(e.what()));
+    }
+    catch (...) {
+        Logger::Error("协程 " + name + " 异常结束 - 未知异常");
+    }
+    executor->tasks.erase(id);
+}
+
+AsyncExecutor::AsyncExecutor() {
+#ifndef _WIN32
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        Logger::Error("创建 epoll 实例失败: " + std::string(strerror(errno)));
+    }
+#endif
+}
+
+AsyncExecutor::~AsyncExecutor() {
+    // 先丢弃所有等待登记，再销毁仍挂起的顶层协程（连带销毁其正在等待的子协程）
+    for (auto& entry : waiters) {
+        ReleaseNative(*entry.second);
+    }
+    waiters.clear();
+    ready.clear();
+    std::vector<std::coroutine_handle<>> pending;
+    for (auto& entry : tasks) pending.push_back(entry.second);
+    tasks.clear();
+    for (std::coroutine_handle<> handle : pending) handle.destroy();
+#ifndef _WIN32
+    if (epollFd >= 0) close(epollFd);
+#endif
+}
+
+void AsyncExecutor::Spawn(const std::string& name, Task<void> task) {
+    const uint64_t id = nextTaskId++;
+    Detached driver = Drive(this, id, name, std::move(task));
+    tasks.emplace(id, driver.handle);
+    ready.push_back(driver.handle);
+}
+
+void AsyncExecutor::Run() {
+    RunUntil(Clock::time_point::max());
+}
+
+void AsyncExecutor::RunUntil(Clock::time_point until) {
+    stopping = false;
+    maxLatenessUs = 0.0;
+    while (!stopping && !tasks.empty() && Clock::now() < until) {
+        Step(until);
+    }
+}
+
+bool AsyncExecutor::Register(Waiter& waiter, uint32_t events) {
+    const uint64_t token = nextToken++;
+#ifdef _WIN32
+    (void)events;
+    if (waiter.native != kNoHandle) {
+        size_t handles = 0;
+        for (const auto& entry : waiters) {
+            if (entry.second->native != kNoHandle) ++handles;
+        }
+        if (handles >= MAXIMUM_WAIT_OBJECTS) {
+            Logger::Error("协程执行器同时等待的句柄超过上限 " + std::to_string(MAXIMUM_WAIT_OBJECTS));
+            waiter.result = WaitResult{ true, 0 };
+            return false;
+        }
+    }
+#else
+    if (waiter.native != kNoHandle) {
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.u64 = token;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, waiter.native, &ev) != 0) {
+            Logger::Error("epoll 注册文件描述符 " + std::to_string(waiter.native) + " 失败: " + std::string(strerror(errno)));
+            waiter.result = WaitResult{ true, 0 };
+            return false;
+        }
+    }
+#endif
+    waiters.emplace(token, &waiter);
+    if (waiter.deadline != Clock::time_point::max()) {
+        timers.push(TimerEntry{ waiter.deadline, token });
+    }
+    return true;
+}
+
+void AsyncExecutor::ReleaseNative(Waiter& waiter) {
+#ifndef _WIN32
+    if (waiter.native != kNoHandle && epollFd >= 0) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, waiter.native, nullptr);
+    }
+#else
+    (void)waiter;
+#endif
+}
+
+void AsyncExecutor::Complete(uint64_t token, const WaitResult& result) {
+    auto it = waiters.find(token);
+    if (it == waiters.end()) return;
+    Waiter& waiter = *it->second;
+    waiters.erase(it);
+    ReleaseNative(waiter);
+    waiter.result = result;
+    ready.push_back(waiter.handle);
+}
+
+void AsyncExecutor::Step(Clock::time_point limit) {
+    // 只运行本轮开始时已就绪的协程，反复 Yield 的协程不会饿死定时器与 I/O
+    for (size_t n = ready.size(); n > 0 && !ready.empty(); --n) {
+        std::coroutine_handle<> handle = ready.front();
+        ready.pop_front();
+        handle.resume();
+    }
+
+    // 清理已被 I/O 完成取消的定时器
+    while (!timers.empty() && waiters.find(timers.top().token) == waiters.end()) timers.pop();
+
+    Clock::time_point wakeAt = limit;
+    if (!timers.empty()) wakeAt = (std::min)(wakeAt, timers.top().when);
+    const Clock::time_point now = Clock::now();
+    Clock::duration timeout = ready.empty() && wakeAt > now ? wakeAt - now : Clock::duration::zero();
+    if (tasks.empty()) return;
+    PollNative(timeout);
+
+    const Clock::time_point fired = Clock::now();
+    while (!timers.empty() && timers.top().when <= fired) {
+        const TimerEntry entry = timers.top();
+        timers.pop();
+        if (waiters.find(entry.token) == waiters.end()) continue;
+        ++timerWakeups;
+        maxLatenessUs = (std::max)(maxLatenessUs, std::chrono::duration<double, std::micro>(fired - entry.when).count());
+        Complete(entry.token, WaitResult{ true, 0 });
+    }
+}
+
+void AsyncExecutor::PollNative(Clock::duration timeout) {
+    // 向上取整到毫秒，避免在到期前反复以 0 超时空转；单次最多等待 60 秒
+    const auto timeoutMs = std::chrono::ceil<std::chrono::milliseconds>(timeout).count();
+    const int waitMs = static_cast<int>(timeoutMs < 60000 ? timeoutMs : 60000);
+#ifdef _WIN32
+    std::vector<HANDLE> handles;
+    std::vector<uint64_t> tokens;
+    for (const auto& entry : waiters) {
+        if (entry.second->native == kNoHandle) continue;
+        handles.push_back(entry.second->native);
+        tokens.push_back(entry.first);
+    }
+    if (handles.empty()) {
+        if (waitMs > 0) ::Sleep(static_cast<DWORD>(waitMs));
+        return;
+    }
+    const DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE,
+                                                static_cast<DWORD>(waitMs));
+    if (result < WAIT_OBJECT_0 + handles.size()) {
+        Complete(tokens[result - WAIT_OBJECT_0], WaitResult{ false, 0 });
+    }
+    else if (result >= WAIT_ABANDONED_0 && result < WAIT_ABANDONED_0 + handles.size()) {
+        Complete(tokens[result - WAIT_ABANDONED_0], WaitResult{ false, 0 });
+    }
+    else if (result == WAIT_FAILED) {
+        Logger::Error("协程执行器等待句柄失败: " + std::to_string(::GetLastError()));
+    }
+#else
+    epoll_event events[16];
+    const int count = epoll_wait(epollFd, events, 16, waitMs);
+    if (count < 0 && errno != EINTR) {
+        Logger::Error("epoll_wait 失败: " + std::string(strerror(errno)));
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        Complete(events[i].data.u64, WaitResult{ false, events[i].events });
+    }
+#endif
+}
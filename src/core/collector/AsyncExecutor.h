@@ -0,0 +1,147 @@
+// AsyncExecutor.h
+#pragma once
+#include "AsyncTask.h"
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// 单线程协程执行器：在一个线程上复用任意多个采集协程，协程可以 co_await 定时器与 I/O 就绪，
+// 不必为每个数据源占用一个线程。
+// 等待 I/O 的后端：Linux 为 epoll（文件描述符，含 sysfs 属性的 POLLPRI 变更通知与 netlink 套接字），
+// Windows 为 WaitForMultipleObjects（事件 / 等待句柄，最多 MAXIMUM_WAIT_OBJECTS 个同时等待）。
+// 执行器不是线程安全的：Spawn 与所有 co_await 都必须在运行 Run 的线程上发生
+class AsyncExecutor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    AsyncExecutor();
+    ~AsyncExecutor();
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+
+    // 启动一个顶层协程；协程内未捕获的异常记录日志后结束该协程
+    void Spawn(const std::string& name, Task<void> task);
+
+    // 运行到所有顶层协程结束或调用 Stop
+    void Run();
+    // 运行到 until（或提前到所有协程结束 / Stop）；返回时未完成的协程保持挂起，可再次 Run
+    void RunUntil(Clock::time_point until);
+    void Stop() { stopping = true; }
+
+    size_t ActiveTasks() const { return tasks.size(); }
+    // 最近一次 Run 期间定时器的唤醒延迟（实际恢复时间 - 到期时间）统计，单位微秒
+    double MaxTimerLatenessUs() const { return maxLatenessUs; }
+    uint64_t TimerWakeups() const { return timerWakeups; }
+
+    // 等待器：co_await 的结果说明是否因超时返回
+    struct WaitResult {
+        bool timedOut = false;
+        uint32_t events = 0;    // Linux: 就绪的 epoll 事件
+    };
+
+    // co_await executor.SleepUntil(t) / SleepFor(d)：挂起到指定时间
+    auto SleepUntil(Clock::time_point when) { return WaitAwaiter{ *this, when, kNoHandle, 0 }; }
+    template <typename Rep, typename Period>
+    auto SleepFor(std::chrono::duration<Rep, Period> duration) {
+        return SleepUntil(Clock::now() + std::chrono::duration_cast<Clock::duration>(duration));
+    }
+    // co_await executor.Yield()：让出执行权给其他就绪协程
+    auto Yield() {
+        struct Awaiter {
+            AsyncExecutor& executor;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { executor.ready.push_back(handle); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{ *this };
+    }
+
+#ifdef _WIN32
+    using NativeHandle = HANDLE;
+    // co_await executor.WaitHandle(h, deadline)：等待内核对象变为有信号（或超时）
+    auto WaitHandle(HANDLE handle, Clock::time_point deadline = Clock::time_point::max()) {
+        return WaitAwaiter{ *this, deadline, handle, 0 };
+    }
+#else
+    using NativeHandle = int;
+    // co_await executor.WaitFd(fd, EPOLLIN, deadline)：等待文件描述符就绪（或超时）
+    auto WaitFd(int fd, uint32_t events, Clock::time_point deadline = Clock::time_point::max()) {
+        return WaitAwaiter{ *this, deadline, fd, events };
+    }
+#endif
+
+private:
+#ifdef _WIN32
+    static constexpr HANDLE kNoHandle = nullptr;
+#else
+    static constexpr int kNoHandle = -1;
+#endif
+
+    struct Waiter {
+        std::coroutine_handle<> handle;
+        NativeHandle native;
+        WaitResult result;
+        Clock::time_point deadline;
+    };
+
+    struct WaitAwaiter {
+        AsyncExecutor& executor;
+        Clock::time_point deadline;
+        NativeHandle native;
+        uint32_t events;
+        Waiter waiter{};
+
+        bool await_ready() const noexcept { return native == kNoHandle && deadline <= Clock::now(); }
+        bool await_suspend(std::coroutine_handle<> handle) {
+            waiter.handle = handle;
+            waiter.native = native;
+            waiter.deadline = deadline;
+            return executor.Register(waiter, events);
+        }
+        WaitResult await_resume() const noexcept {
+            if (native == kNoHandle) return WaitResult{ true, 0 };
+            return waiter.result;
+        }
+    };
+
+    struct TimerEntry {
+        Clock::time_point when;
+        uint64_t token;
+        bool operator>(const TimerEntry& other) const {
+            return when != other.when ? when > other.when : token > other.token;
+        }
+    };
+
+    struct Detached;
+    static Detached Drive(AsyncExecutor* executor, uint64_t id, std::string name, Task<void> task);
+
+    // 登记等待；返回 false 表示无需挂起（例如注册失败，结果已写入 waiter）
+    bool Register(Waiter& waiter, uint32_t events);
+    void Complete(uint64_t token, const WaitResult& result);
+    // 运行就绪队列、等待 I/O 或下一个定时器（最多到 limit），触发到期的定时器
+    void Step(Clock::time_point limit);
+    void PollNative(Clock::duration timeout);
+    void ReleaseNative(Waiter& waiter);
+
+    std::deque<std::coroutine_handle<>> ready;
+    std::priority_queue<TimerEntry, std::vector<TimerEntry>, std::greater<TimerEntry>> timers;
+    std::unordered_map<uint64_t, Waiter*> waiters;      // 令牌 -> 挂起中的等待；定时器到期时令牌可能已被 I/O 完成取消
+    std::unordered_map<uint64_t, std::coroutine_handle<>> tasks;
+    uint64_t nextToken = 1;
+    uint64_t nextTaskId = 1;
+    bool stopping = false;
+    double maxLatenessUs = 0.0;
+    uint64_t timerWakeups = 0;
+#ifndef _WIN32
+    int epollFd = -1;
+#endif
+};
@@ -0,0 +1,73 @@
+// CollectorInitializer.cpp
+#include "CollectorInitializer.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <objbase.h>
+#endif
+
+CollectorInitializer::~CollectorInitializer() {
+    Join();
+}
+
+void CollectorInitializer::Join() {
+    std::vector<std::thread> running;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running.swap(threads);
+    }
+    for (std::thread& thread : running) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+void CollectorInitializer::Start(ICollector* collector, const CollectorContext& context) {
+    std::lock_guard<std::mutex> lock(mutex);
+    deferred.push_back(collector);
+    pending.fetch_add(1, std::memory_order_acq_rel);
+    threads.emplace_back(&CollectorInitializer::Run, this, collector, context);
+}
+
+bool CollectorInitializer::IsDeferred(const ICollector* collector) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::find(deferred.begin(), deferred.end(), collector) != deferred.end();
+}
+
+std::vector<CollectorInitializer::Result> CollectorInitializer::TakeFinished() {
+    std::vector<Result> results;
+    if (finishedCount.load(std::memory_order_acquire) == 0) return results;
+    std::lock_guard<std::mutex> lock(mutex);
+    results.swap(finished);
+    finishedCount.store(0, std::memory_order_release);
+    pending.fetch_sub(static_cast<int>(results.size()), std::memory_order_acq_rel);
+    return results;
+}
+
+void CollectorInitializer::Run(ICollector* collector, CollectorContext context) {
+#ifdef _WIN32
+    // 与调度器的工作线程一样加入多线程单元：在这里创建的 WMI 接口指针之后由工作线程使用
+    const bool comInitialized = SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED));
+#endif
+    Result result;
+    result.collector = collector;
+    result.begin = Clock::now();
+    try {
+        result.available = collector->Init(context);
+    }
+    catch (const std::exception& e) {
+        Logger::Error("数据源 " + std::string(collector->Name()) + " 后台初始化失败: " + std::string(e.what()));
+    }
+    catch (...) {
+        Logger::Error("数据源 " + std::string(collector->Name()) + " 后台初始化失败 - 未知异常");
+    }
+    result.end = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.push_back(result);
+        finishedCount.fetch_add(1, std::memory_order_release);
+    }
+#ifdef _WIN32
+    if (comInitialized) CoUninitialize();
+#endif
+}
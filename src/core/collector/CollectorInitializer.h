@@ -0,0 +1,52 @@
+// CollectorInitializer.h
+#pragma once
+#include "ICollector.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 后台初始化：Init 较慢的数据源（Descriptor::slowInit）各在一个后台线程上初始化，主程序不等它们，
+// 先用初始化较快的 CPU / 内存数据源发布第一份快照。调度器把这些源注册为 deferred，状态表标记为初始化中；
+// 主线程经 TakeFinished 取走完成的源，在主线程上填充静态字段后调用 CollectorScheduler::SetReady
+class CollectorInitializer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Result {
+        ICollector* collector = nullptr;
+        bool available = false;         // Init 返回 true 且未抛出异常
+        Clock::time_point begin;
+        Clock::time_point end;
+    };
+
+    CollectorInitializer() = default;
+    // 等待仍在进行的初始化结束（Join）：须先于数据源与 context 引用的资源析构
+    ~CollectorInitializer();
+    CollectorInitializer(const CollectorInitializer&) = delete;
+    CollectorInitializer& operator=(const CollectorInitializer&) = delete;
+
+    // 在新的后台线程上调用 collector->Init（context 按值保存）
+    void Start(ICollector* collector, const CollectorContext& context);
+    // collector 是否交给了本对象初始化（无论是否已完成）
+    bool IsDeferred(const ICollector* collector) const;
+    // 尚未被 TakeFinished 取走的源个数
+    int Pending() const { return pending.load(std::memory_order_acquire); }
+    // 是否有完成初始化、尚未取走的源（不加锁）
+    bool HasFinished() const { return finishedCount.load(std::memory_order_acquire) > 0; }
+    // 取走已完成初始化的源；没有时不加锁、不分配
+    std::vector<Result> TakeFinished();
+    // 等待所有后台线程结束（退出前、清理数据源使用的桥接之前调用）
+    void Join();
+
+private:
+    void Run(ICollector* collector, CollectorContext context);
+
+    mutable std::mutex mutex;
+    std::vector<std::thread> threads;
+    std::vector<const ICollector*> deferred;
+    std::vector<Result> finished;
+    std::atomic<int> pending{ 0 };
+    std::atomic<int> finishedCount{ 0 };
+};
@@ -0,0 +1,88 @@
+// CollectorRegistry.cpp
+#include "CollectorRegistry.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+
+std::vector<CollectorRegistry::Entry>& CollectorRegistry::Entries() {
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+bool CollectorRegistry::Register(const std::string& name, Factory factory) {
+    if (Contains(name)) return false;
+    Entries().push_back(Entry{ name, std::move(factory) });
+    return true;
+}
+
+std::vector<std::string> CollectorRegistry::Names() {
+    std::vector<std::string> names;
+    for (const Entry& entry : Entries()) names.push_back(entry.name);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool CollectorRegistry::Contains(const std::string& name) {
+    const auto& entries = Entries();
+    return std::any_of(entries.begin(), entries.end(), [&](const Entry& entry) { return entry.name == name; });
+}
+
+std::vector<std::unique_ptr<ICollector>> CollectorRegistry::CreateAll(const CollectorContext& context, uint32_t ownedSections,
+                                                                       const std::set<std::string>& disabled, StartupTimer* timer,
+                                                                       CollectorInitializer* background) {
+    std::vector<std::unique_ptr<ICollector>> collectors;
+    for (const Entry& entry : Entries()) {
+        if (disabled.count(entry.name)) {
+            Logger::Info("数据源 " + entry.name + " 已通过 --disable 停用");
+            continue;
+        }
+        try {
+            const StartupTimer::Clock::time_point begin = StartupTimer::Clock::now();
+            std::unique_ptr<ICollector> collector = entry.factory();
+            const ICollector::Descriptor descriptor = collector->Describe();
+            if ((descriptor.schedule.sections & ownedSections) == 0) continue;
+            if (background && descriptor.slowInit) {
+                background->Start(collector.get(), context);
+                collectors.push_back(std::move(collector));
+                continue;
+            }
+            const bool initialized = collector->Init(context);
+            if (timer) timer->Record("初始化数据源 " + entry.name, begin, StartupTimer::Clock::now());
+            if (!initialized) {
+                Logger::Warn("数据源 " + entry.name + " 初始化失败，已跳过");
+                continue;
+            }
+            collectors.push_back(std::move(collector));
+        }
+        catch (const std::exception& e) {
+            Logger::Error("数据源 " + entry.name + " 创建失败: " + std::string(e.what()));
+        }
+        catch (...) {
+            Logger::Error("数据源 " + entry.name + " 创建失败 - 未知异常");
+        }
+    }
+    return collectors;
+}
+
+void CollectorRegistry::Schedule(CollectorScheduler& scheduler, const std::vector<std::unique_ptr<ICollector>>& collectors,
+                                 const CollectorInitializer* background) {
+    for (const auto& collector : collectors) {
+        ICollector* source = collector.get();
+        const ICollector::Descriptor descriptor = source->Describe();
+        CollectorScheduler::Options options = descriptor.schedule;
+        options.sheddable = descriptor.cost == ICollector::Cost::High;
+        options.deferred = background && background->IsDeferred(source);
+        scheduler.Add(source->Name(), options,
+            [source](SystemInfo& info, const CollectorScheduler::RunInfo& run) { source->Sample(info, run); },
+            [source](SystemInfo& dst, const SystemInfo& src) { source->Merge(dst, src); },
+            [source](SystemInfo& scratch, const SystemInfo& current) { source->Prepare(scratch, current); });
+
+        std::string range;
+        if (options.minPeriod.count() > 0 || options.maxPeriod.count() > 0) {
+            range = "（自适应 " + std::to_string(options.minPeriod.count()) + "-" + std::to_string(options.maxPeriod.count()) + "ms）";
+        }
+        Logger::Info("数据源 " + std::string(source->Name()) + ": 周期 " + std::to_string(options.period.count()) + "ms" + range +
+                     ", 声明开销 " + ICollector::CostName(descriptor.cost) + (options.wait ? ", 每轮等待" : ", 后台") +
+                     (options.triggers ? ", 设备变化时立即重新枚举" : "") +
+                     (options.deferred ? ", 后台初始化中" : ""));
+    }
+}
@@ -0,0 +1,46 @@
+// CollectorRegistry.h
+#pragma once
+#include "ICollector.h"
+#include "CollectorInitializer.h"
+#include "../Utils/StartupTimer.h"
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+// 数据源注册表：每个数据源在自己的源文件中用 REGISTER_COLLECTOR 登记工厂，
+// 主程序按本进程拥有的分区与 --disable 创建、初始化并交给调度器，增加或停用数据源不需要修改 main.cpp
+class CollectorRegistry {
+public:
+    using Factory = std::function<std::unique_ptr<ICollector>()>;
+
+    // 登记工厂（静态初始化期间调用）；名称重复时保留先登记的并返回 false
+    static bool Register(const std::string& name, Factory factory);
+    // 已登记的数据源名称（按名称排序）
+    static std::vector<std::string> Names();
+    static bool Contains(const std::string& name);
+
+    // 创建并初始化本进程需要的数据源：负责的分区与 ownedSections 有交集且不在 disabled 中；
+    // Init 失败的数据源记录日志后跳过。timer 非空时把每个数据源的创建与初始化记录为一个启动阶段。
+    // background 非空时 Descriptor::slowInit 的数据源交给它在后台初始化并直接返回（Init 结果之后经 TakeFinished 取得）
+    static std::vector<std::unique_ptr<ICollector>> CreateAll(const CollectorContext& context, uint32_t ownedSections,
+                                                               const std::set<std::string>& disabled, StartupTimer* timer = nullptr,
+                                                               CollectorInitializer* background = nullptr);
+    // 把数据源加入调度器；数据源对象必须比调度器的工作线程活得更久（先 Stop 调度器再销毁数据源）。
+    // 交给 background 初始化的数据源注册为 deferred，初始化完成后由调用方 SetReady
+    static void Schedule(CollectorScheduler& scheduler, const std::vector<std::unique_ptr<ICollector>>& collectors,
+                         const CollectorInitializer* background = nullptr);
+
+private:
+    struct Entry {
+        std::string name;
+        Factory factory;
+    };
+    // 函数内静态对象：各源文件的静态登记不依赖翻译单元间的初始化顺序
+    static std::vector<Entry>& Entries();
+};
+
+// 在数据源的源文件中登记：REGISTER_COLLECTOR("cpu", CpuCollector);
+#define REGISTER_COLLECTOR(name, Type) \
+    static const bool Type##Registered = CollectorRegistry::Register(name, [] { return std::unique_ptr<ICollector>(new Type()); })
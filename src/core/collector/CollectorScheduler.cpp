@@ -0,0 +1,410 @@
+// CollectorScheduler.cpp
+#include "CollectorScheduler.h"
+#include "../Utils/AllocationCounter.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#include <objbase.h>
+#endif
+
+namespace {
+
+uint32_t ToMicroseconds(CollectorScheduler::Clock::duration duration) {
+    const long long us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    if (us <= 0) return 0;
+    return us >= UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(us);
+}
+
+void AddToHistogram(uint32_t (&histogram)[SHM_TIMING_BUCKETS], uint32_t us) {
+    int bucket = 0;
+    while (bucket < SHM_TIMING_BUCKETS - 1 && us >= SHM_TIMING_BUCKET_US[bucket]) ++bucket;
+    ++histogram[bucket];
+}
+
+} // namespace
+
+CollectorScheduler::CollectorScheduler(int workers, std::chrono::milliseconds cycleDeadline)
+    : workerCount((std::max)(workers, 2)), cycleDeadline(cycleDeadline) {
+    for (int i = 0; i < workerCount; ++i) {
+        this->workers.emplace_back(&CollectorScheduler::WorkerLoop, this);
+    }
+}
+
+CollectorScheduler::~CollectorScheduler() {
+    Stop();
+}
+
+void CollectorScheduler::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queue.clear();
+    }
+    workAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void CollectorScheduler::Add(const std::string& name, const Options& options, Collect collect, Merge merge, Prepare prepare) {
+    auto source = std::make_unique<Source>();
+    source->name = name;
+    source->options = options;
+    source->options.period = (std::max)(options.period, std::chrono::milliseconds(1));
+    source->period = source->options.period;
+    source->collect = std::move(collect);
+    source->merge = std::move(merge);
+    source->prepare = std::move(prepare);
+    source->nextDue = Clock::now();
+    source->ready = !options.deferred;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // 同优先级按注册顺序派发
+    auto pos = std::upper_bound(sources.begin(), sources.end(), options.priority,
+        [](int p, const std::unique_ptr<Source>& s) { return p < s->options.priority; });
+    sources.insert(pos, std::move(source));
+    // 每个源最多同时在队列中出现一次：预留后派发不再扩容
+    queue.reserve(sources.size());
+    waited.reserve(sources.size());
+}
+
+int CollectorScheduler::RunCycle(SystemInfo& info) {
+    const Clock::time_point now = Clock::now();
+    const Clock::time_point deadline = now + cycleDeadline;
+    std::unique_lock<std::mutex> lock(mutex);
+    lastCycle = CycleStats{};
+    waited.clear();
+    for (auto& source : sources) {
+        // 上一次仍在运行（或已完成尚未合并）的源本轮不再派发
+        if (source->running || source->completed || now < source->nextDue || !IsActive(*source)) continue;
+        if (source->prepare) {
+            const uint64_t before = AllocationCounter::ThreadCount();
+            source->prepare(source->scratch, info);
+            if (!source->options.wait) lastCycle.backgroundAllocations += AllocationCounter::ThreadCount() - before;
+        }
+        source->running = true;
+        AdvanceSchedule(*source, now);
+        // 插入到同优先级的末尾（队列中可能还有上一轮未开始的后台源）；容量已预留，不分配
+        const auto pos = std::upper_bound(queue.begin(), queue.end(), source->options.priority,
+            [](int p, const Source* s) { return p < s->options.priority; });
+        queue.insert(pos, source.get());
+        if (source->options.wait) waited.push_back(source.get());
+        ++lastCycle.dispatched;
+    }
+    workAvailable.notify_all();
+
+    const auto waitedDone = [&] {
+        return std::none_of(waited.begin(), waited.end(), [](const Source* s) { return s->running; });
+    };
+    if (!jobFinished.wait_until(lock, deadline, waitedDone)) {
+        for (Source* source : waited) {
+            if (!source->running) continue;
+            ++source->missedDeadlines;
+            Logger::Warn("数据源 " + source->name + " 超过本轮截止时间 " + std::to_string(cycleDeadline.count()) +
+                         "ms 未完成，发布其上一次的值");
+        }
+    }
+    lastCycle.merged = MergeLocked(info, &lastCycle);
+    return lastCycle.merged;
+}
+
+int CollectorScheduler::MergeCompleted(SystemInfo& info) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return MergeLocked(info, nullptr);
+}
+
+CollectorScheduler::CycleStats CollectorScheduler::LastCycle() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastCycle;
+}
+
+int CollectorScheduler::MergeLocked(SystemInfo& info, CycleStats* stats) {
+    int merged = 0;
+    for (auto& source : sources) {
+        if (!source->completed) continue;
+        source->completed = false;
+        if (stats && source->options.wait) stats->allocations += source->lastAllocations;
+        // 采集抛出异常时保留上一次的值
+        if (source->failed) continue;
+        const uint64_t before = AllocationCounter::ThreadCount();
+        try {
+            source->merge(info, source->scratch);
+            ++merged;
+        }
+        catch (const std::exception& e) {
+            Logger::Error("数据源 " + source->name + " 合并失败: " + std::string(e.what()));
+        }
+        if (stats && !source->options.wait) {
+            stats->mergedBackground = true;
+            stats->backgroundAllocations += AllocationCounter::ThreadCount() - before;
+        }
+    }
+    return merged;
+}
+
+bool CollectorScheduler::WaitForCompletion(Clock::time_point until) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return jobFinished.wait_until(lock, until, [&] {
+        return std::any_of(sources.begin(), sources.end(), [](const std::unique_ptr<Source>& s) { return s->completed; });
+    });
+}
+
+int CollectorScheduler::PendingFirstRuns() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    // runs 在完成时递增：首次完成后、合并之前 completed 仍为 true
+    return static_cast<int>(std::count_if(sources.begin(), sources.end(), [](const std::unique_ptr<Source>& s) {
+        return !s->unavailable && (s->runs == 0 || (s->runs == 1 && s->completed));
+    }));
+}
+
+bool CollectorScheduler::SetReady(const std::string& name, bool available) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& source : sources) {
+        if (source->name != name) continue;
+        source->ready = available;
+        source->unavailable = !available;
+        // 以就绪时刻为排定网格的起点
+        if (available) source->nextDue = Clock::now();
+        return true;
+    }
+    return false;
+}
+
+CollectorScheduler::Clock::time_point CollectorScheduler::NextDue() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Clock::time_point next = Clock::time_point::max();
+    for (const auto& source : sources) {
+        if (!source->running && IsActive(*source)) next = (std::min)(next, source->nextDue);
+    }
+    return next;
+}
+
+bool CollectorScheduler::SetRateScale(double scale) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Clock::time_point now = Clock::now();
+    bool changed = false;
+    for (auto& source : sources) {
+        const Options& options = source->options;
+        if (options.minPeriod.count() == 0 && options.maxPeriod.count() == 0) continue;
+        std::chrono::milliseconds period(static_cast<long long>(options.period.count() * scale + 0.5));
+        if (options.minPeriod.count() > 0 && period < options.minPeriod) period = options.minPeriod;
+        if (options.maxPeriod.count() > 0 && period > options.maxPeriod) period = options.maxPeriod;
+        if (period.count() < 1) period = std::chrono::milliseconds(1);
+        if (period == source->period) continue;
+        source->period = period;
+        changed = true;
+        // 尚未派发过的源保持首轮立即执行；否则以最近一次排定时刻为新网格的起点
+        if (source->scheduledAt == Clock::time_point{}) continue;
+        const Clock::time_point next = source->scheduledAt + period;
+        source->nextDue = next > now ? next : now;
+    }
+    return changed;
+}
+
+void CollectorScheduler::SetShedding(bool shed) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (shedding == shed) return;
+    shedding = shed;
+    if (shed) return;
+    // 恢复：暂停期间错过的排定采样计入跳过数，网格从现在重新起算，暂停时长不计入开始抖动
+    const Clock::time_point now = Clock::now();
+    for (auto& source : sources) {
+        if (!source->options.sheddable || !source->ready || source->running || source->nextDue >= now) continue;
+        source->skippedPeriods += static_cast<uint32_t>((now - source->nextDue) / source->period);
+        source->nextDue = now;
+    }
+}
+
+int CollectorScheduler::Trigger(uint32_t events) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Clock::time_point now = Clock::now();
+    int triggered = 0;
+    for (auto& source : sources) {
+        if ((source->options.triggers & events) == 0 || !IsActive(*source)) continue;
+        ++triggered;
+        ++source->triggeredRuns;
+        // 正在执行的源枚举到的可能是变化之前的设备清单
+        if (source->running) source->retrigger = true;
+        else if (source->nextDue > now) source->nextDue = now;
+    }
+    return triggered;
+}
+
+std::chrono::milliseconds CollectorScheduler::GetPeriod(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& source : sources) {
+        if (source->name == name) return source->period;
+    }
+    return std::chrono::milliseconds(0);
+}
+
+void CollectorScheduler::AdvanceSchedule(Source& source, Clock::time_point now) {
+    const Clock::time_point scheduled = source.nextDue;
+    const Clock::duration period = source.period;
+    if (source.startedAt != Clock::time_point{}) {
+        source.lastIntervalUs = ToMicroseconds(now - source.startedAt);
+    }
+    source.lastJitterUs = ToMicroseconds(now - scheduled);
+    source.maxJitterUs = (std::max)(source.maxJitterUs, source.lastJitterUs);
+    AddToHistogram(source.jitterHistogram, source.lastJitterUs);
+    source.scheduledAt = scheduled;
+    source.startedAt = now;
+
+    // 下一个排定时刻只由起点与周期决定，与本次实际开始时间无关
+    Clock::time_point next = scheduled + period;
+    if (next <= now) {
+        // 已落后整周期（上一次采集超时或主线程被阻塞）
+        const auto behind = (now - scheduled) / period;
+        if (source.options.overrun == Overrun::CatchUp && behind <= source.options.maxCatchUp) {
+            source.nextDue = next;
+            return;
+        }
+        source.skippedPeriods += static_cast<uint32_t>(behind);
+        next = scheduled + (behind + 1) * period;
+    }
+    source.nextDue = next;
+}
+
+CollectorScheduler::Source* CollectorScheduler::TakeJob() {
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        Source* source = *it;
+        if (!source->options.wait && backgroundRunning >= workerCount - 1) continue;
+        queue.erase(it);
+        if (!source->options.wait) ++backgroundRunning;
+        return source;
+    }
+    return nullptr;
+}
+
+void CollectorScheduler::WorkerLoop() {
+#ifdef _WIN32
+    // WMI 查询需要 COM；工作线程加入主线程所在的多线程单元，WmiManager 的接口指针可直接跨线程使用
+    const bool comInitialized = SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED));
+#endif
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        Source* source = nullptr;
+        workAvailable.wait(lock, [&] { return stopping || (source = TakeJob()) != nullptr; });
+        if (!source) break;
+        const RunInfo run{ source->runs == 0, source->period };
+        lock.unlock();
+
+        const Clock::time_point start = Clock::now();
+        const uint64_t allocationsBefore = AllocationCounter::ThreadCount();
+        bool failed = false;
+        try {
+            source->collect(source->scratch, run);
+        }
+        catch (const std::exception& e) {
+            Logger::Error("数据源 " + source->name + " 采集失败: " + std::string(e.what()));
+            failed = true;
+        }
+        catch (...) {
+            Logger::Error("数据源 " + source->name + " 采集失败 - 未知异常");
+            failed = true;
+        }
+        const Clock::time_point end = Clock::now();
+        const uint64_t allocations = AllocationCounter::ThreadCount() - allocationsBefore;
+
+        lock.lock();
+        source->lastAllocations = allocations;
+        source->lastDurationMs = std::chrono::duration<double, std::milli>(end - start).count();
+        source->maxDurationMs = (std::max)(source->maxDurationMs, source->lastDurationMs);
+        source->totalDurationMs += source->lastDurationMs;
+        source->failed = failed;
+        if (failed) ++source->failures;
+        else source->lastSuccess = end;
+        // 完成时已过下一个排定时刻：本次采集占用了超过一个周期
+        const Clock::time_point nextScheduled = source->scheduledAt + source->period;
+        if (end > nextScheduled) {
+            ++source->overruns;
+            AddToHistogram(source->overrunHistogram, ToMicroseconds(end - nextScheduled));
+        }
+        ++source->runs;
+        if (source->retrigger) {
+            source->retrigger = false;
+            if (source->nextDue > end) source->nextDue = end;
+        }
+        source->running = false;
+        source->completed = true;
+        if (!source->options.wait) {
+            --backgroundRunning;
+            // 让出的线程可能正好能执行被并发上限挡住的后台源
+            workAvailable.notify_one();
+        }
+        jobFinished.notify_all();
+    }
+    lock.unlock();
+#ifdef _WIN32
+    if (comInitialized) CoUninitialize();
+#endif
+}
+
+bool CollectorScheduler::IsStale(const Source& source, Clock::time_point now) const {
+    if (source.failed) return true;
+    if (!source.running) return false;
+    // wait 源的预算是本轮截止时间，后台源的预算是一个采样周期
+    const auto budget = source.options.wait ? cycleDeadline : source.period;
+    return now - source.startedAt > budget;
+}
+
+int CollectorScheduler::ExportStatus(SharedCollectorStatus* out, int capacity) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Clock::time_point now = Clock::now();
+    const int count = (std::min)(capacity, static_cast<int>(sources.size()));
+    for (int i = 0; i < count; ++i) {
+        const Source& source = *sources[i];
+        SharedCollectorStatus& status = out[i];
+        memset(&status, 0, sizeof(status));
+        strncpy(status.name, source.name.c_str(), sizeof(status.name) - 1);
+        status.sections = source.options.sections;
+        status.periodMs = static_cast<uint32_t>(source.period.count());
+        status.basePeriodMs = static_cast<uint32_t>(source.options.period.count());
+        if (source.running) status.flags |= SHM_COLLECTOR_RUNNING;
+        if (IsStale(source, now)) status.flags |= SHM_COLLECTOR_STALE;
+        if (source.failed || source.unavailable) status.flags |= SHM_COLLECTOR_FAILED;
+        if (IsShed(source)) status.flags |= SHM_COLLECTOR_SHED;
+        if (!source.ready && !source.unavailable) status.flags |= SHM_COLLECTOR_INITIALIZING;
+        status.lastDurationUs = static_cast<uint32_t>(source.lastDurationMs * 1000.0);
+        if (source.runs > 0 && source.lastSuccess != Clock::time_point{}) {
+            status.lastSuccessNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                source.lastSuccess.time_since_epoch()).count());
+        }
+        status.runs = source.runs;
+        status.missedDeadlines = source.missedDeadlines;
+        status.lastIntervalUs = source.lastIntervalUs;
+        status.lastJitterUs = source.lastJitterUs;
+        status.maxJitterUs = source.maxJitterUs;
+        status.overruns = source.overruns;
+        status.skippedPeriods = source.skippedPeriods;
+        memcpy(status.jitterHistogram, source.jitterHistogram, sizeof(status.jitterHistogram));
+        memcpy(status.overrunHistogram, source.overrunHistogram, sizeof(status.overrunHistogram));
+        status.failures = source.failures;
+        status.totalDurationUs = static_cast<uint64_t>(source.totalDurationMs * 1000.0);
+    }
+    return count;
+}
+
+std::string CollectorScheduler::Describe() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    for (const auto& source : sources) {
+        ss << source->name << "(" << source->period.count() << "ms" << (IsShed(*source) ? ", 已暂停" : "")
+           << (source->unavailable ? ", 不可用" : !source->ready ? ", 初始化中" : "") << "): 执行 " << source->runs
+           << " 次, 最近 " << source->lastDurationMs << "ms, 平均 " << (source->runs ? source->totalDurationMs / source->runs : 0.0)
+           << "ms, 最长 " << source->maxDurationMs << "ms";
+        if (source->failures) ss << ", 失败 " << source->failures << " 次";
+        if (source->lastAllocations) ss << ", 最近一次分配 " << source->lastAllocations << " 次";
+        if (source->triggeredRuns) ss << ", 事件触发 " << source->triggeredRuns << " 次";
+        if (source->missedDeadlines) ss << ", 超时 " << source->missedDeadlines << " 次";
+        ss << ", 抖动 " << source->lastJitterUs / 1000.0 << "/" << source->maxJitterUs / 1000.0 << "ms";
+        if (source->skippedPeriods) ss << ", 跳过 " << source->skippedPeriods << " 个周期";
+        ss << "; ";
+    }
+    return ss.str();
+}
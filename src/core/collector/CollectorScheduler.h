@@ -0,0 +1,176 @@
+// CollectorScheduler.h
+#pragma once
+#include "../DataStruct/DataStruct.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 采集调度器：每个数据源有独立的采样周期与优先级，在小型工作线程池上并发执行
+// 采样时刻按单调时钟上的绝对时间排定（起点 + k * 周期），唤醒延迟与采集耗时不会累积成漂移；
+// 落后整周期时按数据源的策略跳过或补采，并统计开始时间抖动与超时分布（随采集器状态表发布）。
+// 每轮派发所有到期的源，只等待标记为 wait 的源（最多到本轮截止时间）即返回，由调用方发布；
+// 错过截止时间的源保留上一次的值并标记为过期，完成后再单独合并、发布。
+// 一轮的延迟因此取决于最慢的 wait 源，而不是所有源耗时之和。
+// 自适应源的周期可由 SetRateScale 整体缩放（见 AdaptiveSampler），昂贵的源可由 SetShedding 暂停，
+// 设备清单类的源可由 Trigger 在热插拔时立即执行（见 DeviceChangeMonitor）。
+//
+// 数据源在工作线程上只改写自己的暂存 SystemInfo，完成后由调用线程通过 merge 把自己负责的字段合并到发布用的 SystemInfo。
+// 暂存区与发布用的 SystemInfo 构成双缓冲：暂存区常驻、派发时不再整体复制，各字段的字符串与列表容量在预热后沿用，
+// 稳态下一轮采集不产生堆分配（各源的分配次数见 LastCycle / Describe）。
+// 需要读取其他源字段的数据源通过 prepare 在派发时只复制这些字段
+class CollectorScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    struct RunInfo {
+        bool firstRun = false;              // 该源的首次执行
+        std::chrono::milliseconds period;   // 该源当前的周期（自适应源随倍率变化）
+    };
+    // 在工作线程上执行：只改写 info 中自己负责的字段；抛出异常视为本次失败，保留上一次的值
+    using Collect = std::function<void(SystemInfo& info, const RunInfo& run)>;
+    // 在调用线程上执行：把 src 中该源负责的字段复制到 dst
+    using Merge = std::function<void(SystemInfo& dst, const SystemInfo& src)>;
+    // 派发时在调用线程上执行（可为空）：把采集需要读取的其他源的字段从 current 复制到暂存区
+    using Prepare = std::function<void(SystemInfo& scratch, const SystemInfo& current)>;
+
+    // 落后一个或多个整周期时的处理
+    enum class Overrun {
+        Skip,       // 跳过错过的采样，对齐到下一个排定时刻（差值类数据源：两次采样之间的间隔本身就是结果的一部分）
+        CatchUp,    // 立即连续补采，最多补 maxCatchUp 次，再多则跳过
+    };
+
+    struct Options {
+        std::chrono::milliseconds period{ 1000 };
+        int priority = 0;               // 数值越小越先派发
+        uint32_t sections = 0;          // 负责的共享内存分区掩码（仅用于状态上报）
+        bool wait = false;              // 每轮是否等待该源完成（最多到截止时间）
+        Overrun overrun = Overrun::Skip;
+        int maxCatchUp = 3;
+        // 自适应采样：实际周期 = period * 倍率（SetRateScale），限制在 [minPeriod, maxPeriod]；两者均为 0 时周期固定
+        std::chrono::milliseconds minPeriod{ 0 };
+        std::chrono::milliseconds maxPeriod{ 0 };
+        bool sheddable = false;         // 昂贵的源：减载（SetShedding）期间不再派发
+        uint32_t triggers = 0;          // 事件掩码（DeviceClass）：Trigger 的掩码与之有交集时立即到期，周期只作兜底
+        bool deferred = false;          // 注册时尚未就绪（仍在后台初始化）：SetReady 之前不派发，状态表标记为初始化中
+    };
+
+    // 最近一次 RunCycle 的摘要（用于稳态分配检查）
+    struct CycleStats {
+        int dispatched = 0;             // 派发的源个数
+        int merged = 0;                 // 合并的源个数
+        bool mergedBackground = false;  // 合并了此前完成的后台源（清单类数据，字符串与列表可能重新分配）
+        uint64_t allocations = 0;       // 本轮合并的 wait 源在工作线程上采集时的堆分配次数（需链接 AllocationCounter）
+        uint64_t backgroundAllocations = 0; // 调用线程上为后台源分配的次数（派发时的 prepare 与合并），不属于稳态路径
+    };
+
+    // workers 为工作线程数；后台源（wait = false）最多占用 workers - 1 个线程，始终为 wait 源保留一个
+    explicit CollectorScheduler(int workers = 3, std::chrono::milliseconds cycleDeadline = std::chrono::milliseconds(200));
+    ~CollectorScheduler();
+    CollectorScheduler(const CollectorScheduler&) = delete;
+    CollectorScheduler& operator=(const CollectorScheduler&) = delete;
+
+    // 注册数据源（须在首次 RunCycle 之前）；注册后的首轮会执行所有源一次
+    void Add(const std::string& name, const Options& options, Collect collect, Merge merge, Prepare prepare = nullptr);
+
+    // 派发所有到期的源，等待本轮派发的 wait 源完成或截止时间到达，合并已完成的源；返回合并的源个数
+    int RunCycle(SystemInfo& info);
+    // 合并后台完成的源，返回合并的源个数
+    int MergeCompleted(SystemInfo& info);
+    CycleStats LastCycle() const;
+    // 阻塞到有源完成或到达 until；返回是否有待合并的源
+    bool WaitForCompletion(Clock::time_point until);
+
+    // 最早到期的时间；没有注册任何源时返回 Clock::time_point::max()
+    Clock::time_point NextDue() const;
+    // 首次执行尚未完成并合并的源个数（失败也算完成，初始化失败的源不计）；为 0 时各源负责的字段都已填充过一次
+    int PendingFirstRuns() const;
+    // deferred 源初始化完成：available 时立即到期并开始按周期调度，否则标记为不可用、永不派发；未注册时返回 false
+    bool SetReady(const std::string& name, bool available);
+
+    // 按倍率缩放所有自适应源的周期（1 为配置的周期），返回是否有源的周期发生变化
+    // 新周期从该源最近一次的排定时刻起算，缩短后已过期的源立即到期
+    bool SetRateScale(double scale);
+    // 开启时不再派发 sheddable 源（正在执行的照常完成），关闭时这些源立即到期
+    void SetShedding(bool shed);
+    // 外部事件（如设备热插拔）：triggers 与 events 有交集的源立即到期，并以现在为起点重新排定后续的兜底采样；
+    // 正在执行的源完成后再执行一次。减载中的源不受影响。返回受影响的源个数
+    int Trigger(uint32_t events);
+    // 数据源当前的采样周期；未注册时返回 0
+    std::chrono::milliseconds GetPeriod(const std::string& name) const;
+
+    // 导出各源状态（用于共享内存的采集器状态表），返回条目数
+    int ExportStatus(SharedCollectorStatus* out, int capacity) const;
+    // 各源的周期、执行 / 失败次数与耗时摘要（用于日志）
+    std::string Describe() const;
+
+    // 丢弃尚未开始的源，等待正在执行的源结束并停止工作线程（析构时自动调用）
+    void Stop();
+
+private:
+    struct Source {
+        std::string name;
+        Options options;
+        Collect collect;
+        Merge merge;
+        Prepare prepare;
+        SystemInfo scratch{};           // 工作线程的暂存区（常驻，只有该源负责的字段有意义）
+        std::chrono::milliseconds period{ 0 };  // 当前周期（自适应源随倍率变化）
+        Clock::time_point nextDue;      // 下一个排定时刻（起点 + k * 周期）
+        Clock::time_point scheduledAt;  // 本次执行对应的排定时刻
+        Clock::time_point startedAt;
+        Clock::time_point lastSuccess;
+        bool running = false;
+        bool completed = false;         // 已完成、尚未合并
+        bool failed = false;
+        bool retrigger = false;         // 执行期间收到事件，完成后立即再执行一次
+        bool ready = true;              // 已初始化（deferred 源在 SetReady 之前为 false）
+        bool unavailable = false;       // 后台初始化失败
+        uint64_t runs = 0;
+        uint64_t triggeredRuns = 0;
+        uint64_t failures = 0;
+        uint64_t missedDeadlines = 0;
+        double lastDurationMs = 0.0;
+        double maxDurationMs = 0.0;
+        double totalDurationMs = 0.0;
+        uint64_t lastAllocations = 0;   // 最近一次采集在工作线程上的堆分配次数
+        // 调度时钟统计（微秒）
+        uint32_t lastIntervalUs = 0;
+        uint32_t lastJitterUs = 0;
+        uint32_t maxJitterUs = 0;
+        uint32_t overruns = 0;
+        uint32_t skippedPeriods = 0;
+        uint32_t jitterHistogram[SHM_TIMING_BUCKETS] = {};
+        uint32_t overrunHistogram[SHM_TIMING_BUCKETS] = {};
+    };
+
+    void WorkerLoop();
+    // 持有锁时合并已完成的源；stats 非空时累计本轮摘要
+    int MergeLocked(SystemInfo& info, CycleStats* stats);
+    // 工作线程取下一个可执行的源（按优先级；后台源受并发上限约束）
+    Source* TakeJob();
+    bool IsStale(const Source& source, Clock::time_point now) const;
+    bool IsShed(const Source& source) const { return shedding && source.options.sheddable; }
+    // 可以派发：已就绪且未被减载暂停
+    bool IsActive(const Source& source) const { return source.ready && !IsShed(source); }
+    // 派发时调用：记录开始抖动与真实采样间隔，按策略推进到下一个排定时刻
+    static void AdvanceSchedule(Source& source, Clock::time_point now);
+
+    const int workerCount;
+    const std::chrono::milliseconds cycleDeadline;
+    std::vector<std::unique_ptr<Source>> sources;   // 按优先级排序
+    std::vector<Source*> queue;                     // 待执行，按优先级排序
+    std::vector<Source*> waited;                    // 本轮等待的源（RunCycle 内使用，容量在 Add 时预留）
+    CycleStats lastCycle;
+    int backgroundRunning = 0;
+    bool shedding = false;
+    bool stopping = false;
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable jobFinished;
+    std::vector<std::thread> workers;
+};
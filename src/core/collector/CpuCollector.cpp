@@ -0,0 +1,75 @@
+// CpuCollector.cpp
+#include "CollectorRegistry.h"
+#include "../cpu/CpuInfo.h"
+#include "../Utils/Logger.h"
+#include <memory>
+
+namespace {
+
+// CPU 占用率（整体与逐处理器）与频率：廉价的 PDH 计数器，常规 1 秒，负载变化或有读端时最快 250ms
+class CpuCollector : public ICollector {
+public:
+    static constexpr const char* kName = "cpu";
+
+    const char* Name() const override { return kName; }
+
+    Descriptor Describe() const override {
+        Descriptor descriptor;
+        descriptor.schedule.period = std::chrono::milliseconds(1000);
+        descriptor.schedule.minPeriod = std::chrono::milliseconds(250);
+        descriptor.schedule.maxPeriod = std::chrono::milliseconds(4000);
+        descriptor.schedule.priority = 0;
+        descriptor.schedule.sections = (1u << SHM_SECTION_CPU) | (1u << SHM_SECTION_LOAD);
+        descriptor.schedule.wait = true;
+        descriptor.cost = Cost::Low;
+        return descriptor;
+    }
+
+    // 创建一次、重复使用（避免重复初始化性能计数器）
+    bool Init(const CollectorContext& context) override {
+        cpuInfo = std::make_unique<CpuInfo>();
+        cpuInfo->SetUsageFilter(context.cpuFilter);
+        Logger::Debug("CPU信息对象创建成功");
+        return true;
+    }
+
+    void FillStatic(SystemInfo& info) override {
+        info.cpuName = cpuInfo->GetName();
+        info.physicalCores = cpuInfo->GetLargeCores() + cpuInfo->GetSmallCores();
+        info.logicalCores = cpuInfo->GetTotalCores();
+        info.performanceCores = cpuInfo->GetLargeCores();
+        info.efficiencyCores = cpuInfo->GetSmallCores();
+        info.hyperThreading = cpuInfo->IsHyperThreadingEnabled();
+        info.virtualization = cpuInfo->IsVirtualizationEnabled();
+        info.coreClasses = cpuInfo->GetCoreClasses();
+    }
+
+    void Sample(SystemInfo& snapshot, const CollectorScheduler::RunInfo& run) override {
+        // PDH 两次采样的最小间隔跟随当前周期，略短一些以免调度抖动推迟一整个周期
+        cpuInfo->SetMinSampleInterval(run.period * 95 / 100);
+        snapshot.cpuUsage = cpuInfo->GetUsage();
+        snapshot.cpuUsageRaw = cpuInfo->GetRawUsage();
+        snapshot.cpuUsageFilter = cpuInfo->GetUsageFilter().ToShared();
+        snapshot.performanceCoreFreq = cpuInfo->GetLargeCoreSpeed();
+        snapshot.efficiencyCoreFreq = cpuInfo->GetSmallCoreSpeed() * 0.8;
+        snapshot.cpuUsageSampleIntervalMs = cpuInfo->GetLastSampleIntervalMs();
+        cpuInfo->SampleCores(snapshot.coreUsage);
+    }
+
+    void Merge(SystemInfo& dst, const SystemInfo& src) const override {
+        dst.cpuUsage = src.cpuUsage;
+        dst.cpuUsageRaw = src.cpuUsageRaw;
+        dst.cpuUsageFilter = src.cpuUsageFilter;
+        dst.performanceCoreFreq = src.performanceCoreFreq;
+        dst.efficiencyCoreFreq = src.efficiencyCoreFreq;
+        dst.cpuUsageSampleIntervalMs = src.cpuUsageSampleIntervalMs;
+        dst.coreUsage = src.coreUsage;
+    }
+
+private:
+    std::unique_ptr<CpuInfo> cpuInfo;
+};
+
+} // namespace
+
+REGISTER_COLLECTOR(CpuCollector::kName, CpuCollector);
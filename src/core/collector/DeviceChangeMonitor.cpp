@@ -0,0 +1,261 @@
+// DeviceChangeMonitor.cpp
+#include "DeviceChangeMonitor.h"
+#include "../Utils/Logger.h"
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <cfgmgr32.h>
+#pragma comment(lib, "cfgmgr32.lib")
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+bool StartsWith(const char* value, size_t size, const char* prefix) {
+    const size_t length = strlen(prefix);
+    return size >= length && memcmp(value, prefix, length) == 0;
+}
+
+// 按一个 KEY=VALUE 属性归类
+uint32_t ClassifyProperty(const char* property, size_t size) {
+    const auto equals = [&](const char* expected) {
+        const size_t length = strlen(expected);
+        return size == length && memcmp(property, expected, length) == 0;
+    };
+    if (equals("SUBSYSTEM=net")) return DEVICE_CLASS_NETWORK;
+    if (equals("SUBSYSTEM=block") || equals("SUBSYSTEM=nvme") || equals("SUBSYSTEM=scsi_disk")) return DEVICE_CLASS_DISK;
+    if (equals("SUBSYSTEM=drm")) return DEVICE_CLASS_GPU;
+    // PCI 显示控制器（类代码 0x03xxxx，内核按不补零的十六进制输出）：显卡热插拔 / 驱动重新绑定
+    const char* pciClass = "PCI_CLASS=";
+    const size_t prefix = strlen(pciClass);
+    if (StartsWith(property, size, pciClass) && size > prefix && size - prefix <= 8) {
+        char digits[9] = {};
+        memcpy(digits, property + prefix, size - prefix);
+        char* end = nullptr;
+        const unsigned long value = strtoul(digits, &end, 16);
+        if (end && *end == '\0' && (value >> 16) == 0x03) return DEVICE_CLASS_GPU;
+    }
+    return 0;
+}
+
+// 归类 \0 分隔的属性列表
+uint32_t ClassifyProperties(const char* data, size_t size) {
+    uint32_t classes = 0;
+    size_t offset = 0;
+    while (offset < size) {
+        const void* end = memchr(data + offset, '\0', size - offset);
+        const size_t length = end ? static_cast<const char*>(end) - (data + offset) : size - offset;
+        classes |= ClassifyProperty(data + offset, length);
+        offset += length + 1;
+    }
+    return classes;
+}
+
+int64_t ToNanoseconds(DeviceChangeMonitor::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+} // namespace
+
+DeviceChangeMonitor::DeviceChangeMonitor(std::chrono::milliseconds settle) : settle(settle) {}
+
+DeviceChangeMonitor::~DeviceChangeMonitor() {
+    Stop();
+}
+
+uint32_t DeviceChangeMonitor::ClassifyUevent(const char* data, size_t size) {
+    if (!data || size == 0) return 0;
+    // libudev 格式：固定头之后是属性列表，偏移与长度在头中（主机字节序）
+    if (StartsWith(data, size, "libudev")) {
+        const size_t headerSize = 40;
+        if (size < headerSize) return 0;
+        uint32_t propertiesOffset = 0;
+        uint32_t propertiesLength = 0;
+        memcpy(&propertiesOffset, data + 16, sizeof(propertiesOffset));
+        memcpy(&propertiesLength, data + 20, sizeof(propertiesLength));
+        if (propertiesOffset < headerSize || propertiesOffset > size || propertiesLength > size - propertiesOffset) return 0;
+        return ClassifyProperties(data + propertiesOffset, propertiesLength);
+    }
+    // 内核格式：首个字段为 ACTION@DEVPATH，之后为属性
+    const void* headerEnd = memchr(data, '\0', size);
+    if (!headerEnd || !memchr(data, '@', static_cast<const char*>(headerEnd) - data)) return 0;
+    const size_t propertiesOffset = static_cast<const char*>(headerEnd) - data + 1;
+    return ClassifyProperties(data + propertiesOffset, size - propertiesOffset);
+}
+
+std::string DeviceChangeMonitor::ClassNames(uint32_t classes) {
+    std::string names;
+    if (classes & DEVICE_CLASS_NETWORK) names += "网卡";
+    if (classes & DEVICE_CLASS_DISK) names += std::string(names.empty() ? "" : "/") + "磁盘";
+    if (classes & DEVICE_CLASS_GPU) names += std::string(names.empty() ? "" : "/") + "显卡";
+    return names;
+}
+
+void DeviceChangeMonitor::Record(uint32_t classes) {
+    if (classes == 0) return;
+    lastEventNs.store(ToNanoseconds(Clock::now()), std::memory_order_relaxed);
+    pending.fetch_or(classes, std::memory_order_release);
+    events.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t DeviceChangeMonitor::TakeChanges(Clock::time_point now) {
+#ifndef _WIN32
+    Drain();
+#endif
+    if (pending.load(std::memory_order_acquire) == 0) return 0;
+    // 仍在一串事件当中：等它安静下来再统一重新枚举
+    if (ToNanoseconds(now) - lastEventNs.load(std::memory_order_relaxed) <
+        std::chrono::duration_cast<std::chrono::nanoseconds>(settle).count()) {
+        return 0;
+    }
+    return pending.exchange(0, std::memory_order_acq_rel);
+}
+
+#ifdef _WIN32
+
+struct DeviceNotificationRegistration {
+    DeviceChangeMonitor* monitor = nullptr;
+    uint32_t classes = 0;
+    HCMNOTIFICATION handle = nullptr;
+};
+
+namespace {
+
+// 设备接口类 GUID（ndisguid.h / ntddstor.h / ntddvdeo.h），在此直接定义以免依赖 INITGUID 的包含顺序
+const GUID kInterfaceNet = { 0xcac88484, 0x7515, 0x4c03, { 0x82, 0xe6, 0x71, 0xa8, 0x7a, 0xba, 0xc3, 0x61 } };
+const GUID kInterfaceDisk = { 0x53f56307, 0xb6bf, 0x11d0, { 0x94, 0xf2, 0x00, 0xa0, 0xc9, 0x1e, 0xfb, 0x8b } };
+const GUID kInterfaceVolume = { 0x53f5630d, 0xb6bf, 0x11d0, { 0x94, 0xf2, 0x00, 0xa0, 0xc9, 0x1e, 0xfb, 0x8b } };
+const GUID kInterfaceDisplayAdapter = { 0x5b45201d, 0xf2f2, 0x4f3b, { 0x85, 0xbb, 0x30, 0xff, 0x1f, 0x95, 0x35, 0x99 } };
+
+DWORD CALLBACK OnDeviceNotification(HCMNOTIFICATION, PVOID context, CM_NOTIFY_ACTION action, PCM_NOTIFY_EVENT_DATA, DWORD) {
+    if (action == CM_NOTIFY_ACTION_DEVICEINTERFACEARRIVAL || action == CM_NOTIFY_ACTION_DEVICEINTERFACEREMOVAL) {
+        auto* registration = static_cast<DeviceNotificationRegistration*>(context);
+        registration->monitor->Record(registration->classes);
+    }
+    return ERROR_SUCCESS;
+}
+
+} // namespace
+
+bool DeviceChangeMonitor::Start() {
+    if (!registrations.empty()) return true;
+    const struct {
+        const GUID* guid;
+        uint32_t classes;
+        const char* name;
+    } interfaces[] = {
+        { &kInterfaceNet, DEVICE_CLASS_NETWORK, "网卡" },
+        { &kInterfaceDisk, DEVICE_CLASS_DISK, "磁盘" },
+        { &kInterfaceVolume, DEVICE_CLASS_DISK, "卷" },
+        { &kInterfaceDisplayAdapter, DEVICE_CLASS_GPU, "显卡" },
+    };
+    for (const auto& item : interfaces) {
+        auto registration = std::make_unique<DeviceNotificationRegistration>();
+        registration->monitor = this;
+        registration->classes = item.classes;
+
+        CM_NOTIFY_FILTER filter{};
+        filter.cbSize = sizeof(filter);
+        filter.FilterType = CM_NOTIFY_FILTER_TYPE_DEVICEINTERFACE;
+        filter.u.DeviceInterface.ClassGuid = *item.guid;
+        const CONFIGRET result = CM_Register_Notification(&filter, registration.get(), OnDeviceNotification, &registration->handle);
+        if (result != CR_SUCCESS) {
+            Logger::Warn(std::string("注册") + item.name + "设备变化通知失败，错误码: " + std::to_string(result));
+            continue;
+        }
+        registrations.push_back(std::move(registration));
+    }
+    if (registrations.empty()) {
+        Logger::Warn("设备变化通知不可用，设备清单只按兜底周期重新枚举");
+        return false;
+    }
+    Logger::Info("已注册设备变化通知（" + std::to_string(registrations.size()) + " 类设备接口）");
+    return true;
+}
+
+void DeviceChangeMonitor::Stop() {
+    // CM_Unregister_Notification 会等待正在执行的回调结束，不能在回调中调用
+    for (auto& registration : registrations) {
+        if (registration->handle) CM_Unregister_Notification(registration->handle);
+    }
+    registrations.clear();
+}
+
+#else
+
+bool DeviceChangeMonitor::Start() {
+    if (socketFd >= 0) return true;
+    const int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (fd < 0) {
+        Logger::Warn("创建 uevent 套接字失败: " + std::string(strerror(errno)) + "，设备清单只按兜底周期重新枚举");
+        return false;
+    }
+    sockaddr_nl address{};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = 1;  // 内核广播组（udev 处理之前的原始事件）
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        Logger::Warn("绑定 uevent 套接字失败: " + std::string(strerror(errno)) + "，设备清单只按兜底周期重新枚举");
+        close(fd);
+        return false;
+    }
+    if (!StartFromSocket(fd)) return false;
+    kernelOnly = true;
+    return true;
+}
+
+bool DeviceChangeMonitor::StartFromSocket(int fd) {
+    if (fd < 0) return false;
+    Stop();
+    const int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+        Logger::Warn("设置 uevent 套接字为非阻塞失败: " + std::string(strerror(errno)));
+        close(fd);
+        return false;
+    }
+    socketFd = fd;
+    return true;
+}
+
+void DeviceChangeMonitor::Stop() {
+    if (socketFd >= 0) close(socketFd);
+    socketFd = -1;
+    kernelOnly = false;
+}
+
+void DeviceChangeMonitor::Drain() {
+    if (socketFd < 0) return;
+    char buffer[8192];
+    while (true) {
+        sockaddr_nl sender{};
+        iovec vector{ buffer, sizeof(buffer) };
+        msghdr message{};
+        message.msg_name = &sender;
+        message.msg_namelen = sizeof(sender);
+        message.msg_iov = &vector;
+        message.msg_iovlen = 1;
+        const ssize_t received = recvmsg(socketFd, &message, 0);
+        if (received > 0) {
+            // 内核发出的 uevent 的 nl_pid 为 0；其他值是用户态进程单播的，可能是伪造的
+            if (kernelOnly && (message.msg_namelen < sizeof(sender) || sender.nl_pid != 0)) continue;
+            Record(ClassifyUevent(buffer, static_cast<size_t>(received)));
+            continue;
+        }
+        if (received < 0 && errno == EINTR) continue;
+        // 接收缓冲区溢出：有事件丢失，无法知道涉及哪些设备，全部重新枚举
+        if (received < 0 && errno == ENOBUFS) {
+            Logger::Warn("uevent 接收缓冲区溢出，重新枚举全部设备");
+            Record(DEVICE_CLASS_ALL);
+            continue;
+        }
+        break;
+    }
+}
+
+#endif
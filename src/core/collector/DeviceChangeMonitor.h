@@ -0,0 +1,72 @@
+// DeviceChangeMonitor.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 设备类别（CollectorScheduler::Options::triggers 与 Trigger 使用的事件掩码）
+enum DeviceClass : uint32_t {
+    DEVICE_CLASS_NETWORK = 1u << 0,     // 网卡
+    DEVICE_CLASS_DISK = 1u << 1,        // 磁盘与卷
+    DEVICE_CLASS_GPU = 1u << 2,         // 显卡
+    DEVICE_CLASS_ALL = DEVICE_CLASS_NETWORK | DEVICE_CLASS_DISK | DEVICE_CLASS_GPU,
+};
+
+#ifdef _WIN32
+struct DeviceNotificationRegistration;  // 每类设备接口的通知注册（回调上下文）
+#endif
+
+// 设备热插拔监听：设备清单只在热插拔时变化，收到事件后只重新枚举受影响的子系统，定时枚举只作为兜底
+// Windows 为 CM_Register_Notification（设备接口到达 / 移除，回调在系统线程池上执行），
+// Linux 为 NETLINK_KOBJECT_UEVENT 套接字（内核组，只接受内核发出的消息：任何进程都能向该套接字单播伪造的 uevent）；
+// 也可改为读取任意数据报套接字（不校验来源），测试用 socketpair 注入合成 uevent。
+// 一次热插拔通常产生一串事件，TakeChanges 在最后一个事件之后 settle 时间内没有新事件时才返回，合并为一次重新枚举
+class DeviceChangeMonitor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit DeviceChangeMonitor(std::chrono::milliseconds settle = std::chrono::milliseconds(500));
+    ~DeviceChangeMonitor();
+    DeviceChangeMonitor(const DeviceChangeMonitor&) = delete;
+    DeviceChangeMonitor& operator=(const DeviceChangeMonitor&) = delete;
+
+    // 开始监听系统的设备变化；失败时记录日志并返回 false（只剩定时兜底）
+    bool Start();
+#ifndef _WIN32
+    // 改为从已有的数据报套接字读取 uevent（内核格式或 libudev 格式），接管 fd；不校验发送方
+    bool StartFromSocket(int fd);
+    // 有新事件时可读（用于 epoll / AsyncExecutor::WaitFd）；未启动时为 -1
+    int Fd() const { return socketFd; }
+#endif
+    void Stop();
+
+    // 取走已稳定的设备类别掩码（DeviceClass）；没有变化或仍在突发中时返回 0
+    uint32_t TakeChanges(Clock::time_point now = Clock::now());
+    // 记录一次涉及 classes 的设备事件（平台回调调用，也可直接注入）
+    void Record(uint32_t classes);
+    uint64_t EventCount() const { return events.load(std::memory_order_relaxed); }
+
+    // 解析一条 uevent 消息，返回涉及的设备类别；无关的子系统返回 0
+    // 内核格式: "ACTION@DEVPATH\0KEY=VALUE\0..."；libudev 格式: "libudev\0" 头 + properties_off 处的 KEY=VALUE\0 列表
+    static uint32_t ClassifyUevent(const char* data, size_t size);
+    // 设备类别掩码的可读名称（用于日志），如 "网卡/磁盘"
+    static std::string ClassNames(uint32_t classes);
+
+private:
+#ifndef _WIN32
+    // 非阻塞读完套接字中的所有消息
+    void Drain();
+    int socketFd = -1;
+    bool kernelOnly = false;    // Start 打开的 netlink 套接字：丢弃发送方不是内核（nl_pid != 0）的消息
+#else
+    std::vector<std::unique_ptr<DeviceNotificationRegistration>> registrations;
+#endif
+    const std::chrono::milliseconds settle;
+    std::atomic<uint32_t> pending{ 0 };
+    std::atomic<int64_t> lastEventNs{ 0 };
+    std::atomic<uint64_t> events{ 0 };
+};
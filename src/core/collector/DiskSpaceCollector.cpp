@@ -0,0 +1,47 @@
+// DiskSpaceCollector.cpp
+#include "CollectorRegistry.h"
+#include "DeviceChangeMonitor.h"
+#include "../disk/DiskInfo.h"
+#include "../Utils/Logger.h"
+
+namespace {
+
+// 逻辑磁盘空间：枚举盘符并查询容量；周期采集跟踪剩余空间，插拔磁盘 / U 盘时由设备变化事件立即重新枚举
+class DiskSpaceCollector : public ICollector {
+public:
+    static constexpr const char* kName = "disks";
+
+    const char* Name() const override { return kName; }
+
+    Descriptor Describe() const override {
+        Descriptor descriptor;
+        descriptor.schedule.period = std::chrono::seconds(10);
+        descriptor.schedule.priority = 3;
+        descriptor.schedule.sections = 1u << SHM_SECTION_DISKS;
+        descriptor.schedule.wait = false;
+        descriptor.schedule.triggers = DEVICE_CLASS_DISK;
+        descriptor.cost = Cost::Medium;
+        return descriptor;
+    }
+
+    void Sample(SystemInfo& snapshot, const CollectorScheduler::RunInfo& run) override {
+        DiskInfo diskInfo;
+        // 共享内存的变长段会按需扩容，兼容块只保留前 8 个
+        snapshot.disks = diskInfo.GetDisks();
+        if (run.firstRun) {
+            Logger::Debug("收集到 " + std::to_string(snapshot.disks.size()) + " 个磁盘条目");
+            for (size_t i = 0; i < snapshot.disks.size(); ++i) {
+                const auto& disk = snapshot.disks[i];
+                Logger::Debug("磁盘 " + std::to_string(i) + ": 标签=" + disk.label + ", 文件系统=" + disk.fileSystem);
+            }
+        }
+    }
+
+    void Merge(SystemInfo& dst, const SystemInfo& src) const override {
+        dst.disks = src.disks;
+    }
+};
+
+} // namespace
+
+REGISTER_COLLECTOR(DiskSpaceCollector::kName, DiskSpaceCollector);
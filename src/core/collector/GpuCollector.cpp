@@ -0,0 +1,138 @@
+// GpuCollector.cpp
+#include "CollectorRegistry.h"
+#include "DeviceChangeMonitor.h"
+#include "../gpu/GpuInfo.h"
+#include "../Utils/Logger.h"
+#include "../Utils/WinUtils.h"
+#include <cstring>
+
+namespace {
+
+// 品牌判断
+std::string GetGpuBrand(const std::wstring& name) {
+    if (name.find(L"NVIDIA") != std::wstring::npos) return "NVIDIA";
+    if (name.find(L"AMD") != std::wstring::npos) return "AMD";
+    if (name.find(L"Intel") != std::wstring::npos) return "Intel";
+    return "未知";
+}
+
+// GPU：经 WMI 枚举并选出主 GPU（优先非虚拟）；显卡插拔 / 驱动重新安装时由设备变化事件触发重新枚举，
+// 周期采集只作兜底。枚举在工作线程上进行，不推迟启动
+class GpuCollector : public ICollector {
+public:
+    static constexpr const char* kName = "gpu";
+
+    const char* Name() const override { return kName; }
+
+    Descriptor Describe() const override {
+        Descriptor descriptor;
+        descriptor.schedule.period = std::chrono::minutes(30);
+        descriptor.schedule.priority = 5;
+        descriptor.schedule.sections = 1u << SHM_SECTION_GPU;
+        descriptor.schedule.wait = false;
+        descriptor.schedule.triggers = DEVICE_CLASS_GPU;
+        descriptor.cost = Cost::High;
+        descriptor.slowInit = true;
+        return descriptor;
+    }
+
+    bool Init(const CollectorContext& context) override {
+        wmi = context.Wmi();
+        return wmi != nullptr;
+    }
+
+    void Sample(SystemInfo& snapshot, const CollectorScheduler::RunInfo& run) override {
+        Detect(run.firstRun);
+
+        snapshot.gpuName = name;
+        snapshot.gpuBrand = brand;
+        snapshot.gpuMemory = memory;
+        snapshot.gpuCoreFreq = coreFreq;
+        snapshot.gpuIsVirtual = isVirtual;
+
+        snapshot.gpus.clear();
+        if (name.empty() || name == "未检测到GPU") {
+            if (run.firstRun) Logger::Debug("未检测到有效GPU，跳过GPU数据填充");
+            return;
+        }
+        GPUData gpu;
+        memset(&gpu, 0, sizeof(GPUData));
+        wcsncpy_s(gpu.name, sizeof(gpu.name) / sizeof(wchar_t), WinUtils::StringToWstring(name).c_str(), _TRUNCATE);
+        wcsncpy_s(gpu.brand, sizeof(gpu.brand) / sizeof(wchar_t), WinUtils::StringToWstring(brand).c_str(), _TRUNCATE);
+        gpu.memory = memory;
+        // 核心频率不在合理范围内时置 0 而不是发布异常值
+        if (coreFreq > 0 && coreFreq < 10000) {
+            gpu.coreClock = coreFreq;
+        } else if (run.firstRun && coreFreq >= 10000) {
+            Logger::Warn("GPU核心频率异常: " + std::to_string(coreFreq) + "MHz，已重置为0");
+        }
+        gpu.isVirtual = isVirtual;
+        snapshot.gpus.push_back(gpu);
+
+        if (run.firstRun) {
+            Logger::Debug("已添加GPU到数组: " + name + " (内存: " + std::to_string(memory >> 20) + " MB" +
+                          ", 频率: " + std::to_string(gpu.coreClock) + "MHz" + ", 虚拟: " + (isVirtual ? "是" : "否") + ")");
+        }
+    }
+
+    void Merge(SystemInfo& dst, const SystemInfo& src) const override {
+        dst.gpus = src.gpus;
+        dst.gpuName = src.gpuName;
+        dst.gpuBrand = src.gpuBrand;
+        dst.gpuMemory = src.gpuMemory;
+        dst.gpuCoreFreq = src.gpuCoreFreq;
+        dst.gpuIsVirtual = src.gpuIsVirtual;
+    }
+
+private:
+    void Detect(bool firstRun) {
+        // 枚举失败时异常交给调度器记录，保留上一次的结果
+        Logger::Info(firstRun ? "正在初始化GPU信息" : "重新枚举GPU");
+        GpuInfo gpuInfo(*wmi);
+        const auto& gpus = gpuInfo.GetGpuData();
+        for (const auto& gpu : gpus) {
+            const std::string gpuName = WinUtils::WstringToString(gpu.name);
+            Logger::Info("检测到GPU: " + gpuName +
+                         " (虚拟: " + (gpu.isVirtual ? "是" : "否") +
+                         ", NVIDIA: " + (gpuName.find("NVIDIA") != std::string::npos ? "是" : "否") +
+                         ", 集成: " + (gpuName.find("Intel") != std::string::npos ||
+                                     gpuName.find("AMD") != std::string::npos ? "是" : "否") + ")");
+        }
+
+        // 优先选择非虚拟GPU，没有时选择第一个
+        const GpuInfo::GpuData* selected = nullptr;
+        for (const auto& gpu : gpus) {
+            if (!gpu.isVirtual) {
+                selected = &gpu;
+                break;
+            }
+        }
+        if (!selected && !gpus.empty()) selected = &gpus[0];
+        if (!selected) {
+            Logger::Warn("未检测到任何GPU");
+            name = "未检测到GPU";
+            brand = "未知";
+            memory = 0;
+            coreFreq = 0;
+            isVirtual = false;
+            return;
+        }
+        name = WinUtils::WstringToString(selected->name);
+        brand = GetGpuBrand(selected->name);
+        memory = selected->dedicatedMemory;
+        coreFreq = static_cast<uint32_t>(selected->coreClock);
+        isVirtual = selected->isVirtual;
+        Logger::Info("选择主GPU: " + name + " (虚拟: " + (isVirtual ? "是" : "否") + ")");
+    }
+
+    WmiManager* wmi = nullptr;
+    std::string name = "未检测到GPU";
+    std::string brand = "未知";
+    uint64_t memory = 0;
+    uint32_t coreFreq = 0;
+    bool isVirtual = false;
+};
+
+} // namespace
+
+REGISTER_COLLECTOR(GpuCollector::kName, GpuCollector);
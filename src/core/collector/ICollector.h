@@ -0,0 +1,65 @@
+// ICollector.h
+#pragma once
+#include "CollectorScheduler.h"
+#include "../DataStruct/DataStruct.h"
+#include "../cpu/UsageFilter.h"
+#include <functional>
+
+class WmiManager;
+
+// 初始化数据源时可用的共享资源（由主程序创建，生命周期覆盖所有数据源）
+struct CollectorContext {
+    // 取得共享的 WMI 管理器，不可用时为 nullptr。按需创建：无界面模式只在第一个需要 WMI 的数据源初始化时连接，
+    // 不使用 WMI 的数据源组合不付出 COM 安全初始化与连接 WMI 服务的开销
+    std::function<WmiManager*()> wmi;
+
+    WmiManager* Wmi() const { return wmi ? wmi() : nullptr; }
+
+    // 整体 CPU 占用率的平滑方式（--cpu-filter）
+    UsageFilterConfig cpuFilter;
+};
+
+// 数据源接口：声明周期、开销与负责的分区，Init 一次后由调度器在工作线程上周期性调用 Sample
+// Sample 只改写自己负责的字段；失败时直接抛出异常，由调度器统一记录失败次数、保留上一次的值并把分区标记为过期，
+// 数据源内部不需要各自的 try/catch。同一数据源的 Sample 不会并发执行
+class ICollector {
+public:
+    // 声明的单次采集开销；High 的数据源在主机过载时暂停（见 AdaptiveSampler），实测开销随采集器状态表发布
+    enum class Cost {
+        Low,        // 计数器 / 单次系统调用
+        Medium,     // 枚举设备、读取多个文件
+        High,       // WMI 全表查询、SMART、硬件监控桥接
+    };
+
+    struct Descriptor {
+        CollectorScheduler::Options schedule;   // 周期（及自适应范围）、优先级、负责的分区、每轮是否等待
+        Cost cost = Cost::Low;
+        // Init 较慢（加载硬件监控桥接、连接 WMI）：主程序在后台线程上初始化（见 CollectorInitializer），
+        // 先发布其他数据源的第一份快照，就绪之前负责的分区标记为初始化中
+        bool slowInit = false;
+    };
+
+    virtual ~ICollector() = default;
+
+    virtual const char* Name() const = 0;
+    virtual Descriptor Describe() const = 0;
+    // 调用一次（slowInit 的数据源在后台初始化线程上，其余在主线程上）；返回 false 表示该数据源在本机不可用，不会被调度
+    virtual bool Init(const CollectorContext& context) { (void)context; return true; }
+    // Init 成功之后在主线程上调用一次，填充只需获取一次的静态字段
+    virtual void FillStatic(SystemInfo& info) { (void)info; }
+    // 派发时在调用线程上调用：把采集需要读取的其他数据源的字段从 current 复制到暂存区（默认不需要）
+    virtual void Prepare(SystemInfo& snapshot, const SystemInfo& current) const { (void)snapshot; (void)current; }
+    // 在工作线程上采集到 snapshot（该数据源常驻的暂存区，保留上一次采集的内容）；
+    // 稳态下应原地改写已有的字符串与列表，不重新分配
+    virtual void Sample(SystemInfo& snapshot, const CollectorScheduler::RunInfo& run) = 0;
+    // 在调用线程上把 src 中自己负责的字段复制到 dst
+    virtual void Merge(SystemInfo& dst, const SystemInfo& src) const = 0;
+
+    static const char* CostName(Cost cost) {
+        switch (cost) {
+        case Cost::High: return "高";
+        case Cost::Medium: return "中";
+        default: return "低";
+        }
+    }
+};
@@ -0,0 +1,317 @@
+// LinuxCollectors.cpp
+#ifdef __linux__
+#include "LinuxCollectors.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <sys/epoll.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+namespace {
+
+// 同步读取短文本文件（只用于启动时与传感器列表扫描）
+std::string ReadSmallFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return std::string();
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+std::string Trim(const std::string& text) {
+    const size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return std::string();
+    const size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+// 解析 "0-3,8,10-11" 形式的 CPU 列表
+std::vector<int> ParseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(Trim(text));
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.empty()) continue;
+        const size_t dash = range.find('-');
+        try {
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        }
+        catch (const std::exception&) {
+            // 忽略无法解析的片段
+        }
+    }
+    return cpus;
+}
+
+std::vector<std::string> ListDirectory(const std::string& path, const std::string& prefix) {
+    std::vector<std::string> names;
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return names;
+    while (dirent* entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (name.compare(0, prefix.size(), prefix) == 0) names.push_back(name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+// meminfo 中某一项的值（kB），不存在时返回 0
+uint64_t MemInfoValue(const std::string& text, const char* key) {
+    const size_t pos = text.find(key);
+    if (pos == std::string::npos) return 0;
+    return std::strtoull(text.c_str() + pos + strlen(key), nullptr, 10);
+}
+
+constexpr auto kSensorRescanPeriod = std::chrono::seconds(60);
+
+} // namespace
+
+LinuxCollectors::LinuxCollectors(AsyncExecutor& executor) : executor(executor) {
+    // 混合架构（Intel 大小核）下内核分别导出 cpu_core 与 cpu_atom 两个 PMU 的 CPU 列表
+    performanceCpus = ParseCpuList(ReadSmallFile("/sys/devices/cpu_core/cpus"));
+    efficiencyCpus = ParseCpuList(ReadSmallFile("/sys/devices/cpu_atom/cpus"));
+    if (performanceCpus.empty()) {
+        performanceCpus = ParseCpuList(ReadSmallFile("/sys/devices/system/cpu/online"));
+        efficiencyCpus.clear();
+    }
+}
+
+LinuxCollectors::~LinuxCollectors() {
+    for (auto& entry : fds) {
+        if (entry.second >= 0) close(entry.second);
+    }
+}
+
+int LinuxCollectors::OpenCached(const std::string& path) {
+    auto it = fds.find(path);
+    if (it != fds.end()) return it->second;
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    // 打开失败也缓存，不存在的属性（如虚拟机中的 cpufreq）不会每轮重试
+    fds.emplace(path, fd);
+    return fd;
+}
+
+Task<bool> LinuxCollectors::ReadFile(const std::string& path, std::string& out) {
+    const int fd = OpenCached(path);
+    if (fd < 0) co_return false;
+
+    out.clear();
+    char buffer[4096];
+    off_t offset = 0;
+    while (true) {
+        const ssize_t n = pread(fd, buffer, sizeof(buffer), offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            // 设备已移除等情况：关闭并丢弃缓存的描述符，下次重新打开
+            close(fd);
+            fds.erase(path);
+            co_return false;
+        }
+        if (n == 0) break;
+        out.append(buffer, static_cast<size_t>(n));
+        offset += n;
+    }
+    // 让其他数据源的协程有机会执行
+    co_await executor.Yield();
+    co_return true;
+}
+
+Task<bool> LinuxCollectors::WaitAttributeChange(const std::string& path, AsyncExecutor::Clock::time_point deadline) {
+    // sysfs 要求先读取一次属性才会在下次变更时通知
+    std::string current;
+    if (!co_await ReadFile(path, current)) co_return false;
+    const int fd = OpenCached(path);
+    if (fd < 0) co_return false;
+    const AsyncExecutor::WaitResult result = co_await executor.WaitFd(fd, EPOLLPRI | EPOLLERR, deadline);
+    co_return !result.timedOut;
+}
+
+Task<void> LinuxCollectors::CollectLoad(SystemInfo& info) {
+    std::string text;
+    if (!co_await ReadFile("/proc/stat", text)) {
+        Logger::Warn("读取 /proc/stat 失败");
+        co_return;
+    }
+    // 首行：cpu user nice system idle iowait irq softirq steal guest guest_nice（guest 已计入 user）
+    std::istringstream line(text.substr(0, text.find('\n')));
+    std::string label;
+    uint64_t values[8] = {};
+    line >> label;
+    for (uint64_t& value : values) line >> value;
+
+    CpuTimes now;
+    for (uint64_t value : values) now.total += value;
+    now.busy = now.total - values[3] - values[4];
+
+    const AsyncExecutor::Clock::time_point sampleTime = AsyncExecutor::Clock::now();
+    if (lastCpu.total > 0 && now.total > lastCpu.total) {
+        const double busy = static_cast<double>(now.busy - lastCpu.busy);
+        const double total = static_cast<double>(now.total - lastCpu.total);
+        info.cpuUsageRaw = (std::min)(100.0, (std::max)(0.0, busy * 100.0 / total));
+        info.cpuUsageSampleIntervalMs = std::chrono::duration<double, std::milli>(sampleTime - lastCpuSample).count();
+        info.cpuUsage = cpuFilter->Update(info.cpuUsageRaw, info.cpuUsageSampleIntervalMs);
+        info.cpuUsageFilter = cpuFilterConfig.ToShared();
+    }
+    lastCpu = now;
+    lastCpuSample = sampleTime;
+
+    // 各处理器的 cpuN 行紧随其后，同一份文本解析，不再另读文件
+    ParseProcStatCores(text.data(), text.size(), coreTracker.Current());
+    if (coreTracker.Update(info.coreUsage) && info.coreClasses.size() != info.coreUsage.size()) {
+        // 核心类型只在处理器数变化时重建：cpu_atom 中的为能效核，其余在线处理器为性能核
+        info.coreClasses.assign(info.coreUsage.size(), SHM_CORE_UNKNOWN);
+        for (int cpu : performanceCpus) {
+            if (cpu >= 0 && static_cast<size_t>(cpu) < info.coreClasses.size()) info.coreClasses[cpu] = SHM_CORE_PERFORMANCE;
+        }
+        for (int cpu : efficiencyCpus) {
+            if (cpu >= 0 && static_cast<size_t>(cpu) < info.coreClasses.size()) info.coreClasses[cpu] = SHM_CORE_EFFICIENCY;
+        }
+    }
+}
+
+void LinuxCollectors::SetCpuFilter(const UsageFilterConfig& config) {
+    cpuFilterConfig = config;
+    cpuFilter = UsageFilter::Create(config);
+}
+
+Task<void> LinuxCollectors::CollectMemory(SystemInfo& info) {
+    std::string text;
+    if (!co_await ReadFile("/proc/meminfo", text)) {
+        Logger::Warn("读取 /proc/meminfo 失败");
+        co_return;
+    }
+    info.totalMemory = MemInfoValue(text, "MemTotal:") * 1024;
+    info.availableMemory = MemInfoValue(text, "MemAvailable:") * 1024;
+    info.usedMemory = info.totalMemory > info.availableMemory ? info.totalMemory - info.availableMemory : 0;
+}
+
+Task<void> LinuxCollectors::CollectCpuFrequency(SystemInfo& info) {
+    std::string text;
+    double sums[2] = {};
+    int counts[2] = {};
+    const std::vector<int>* groups[2] = { &performanceCpus, &efficiencyCpus };
+    for (int group = 0; group < 2; ++group) {
+        for (int cpu : *groups[group]) {
+            const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpufreq/scaling_cur_freq";
+            if (!co_await ReadFile(path, text)) continue;
+            sums[group] += std::strtod(text.c_str(), nullptr) / 1000.0; // kHz -> MHz
+            ++counts[group];
+        }
+    }
+
+    if (counts[0] == 0) {
+        // 没有 cpufreq（常见于虚拟机）：退回 /proc/cpuinfo 中的 "cpu MHz"
+        if (co_await ReadFile("/proc/cpuinfo", text)) {
+            for (size_t pos = text.find("cpu MHz"); pos != std::string::npos; pos = text.find("cpu MHz", pos + 1)) {
+                const size_t colon = text.find(':', pos);
+                if (colon == std::string::npos) break;
+                sums[0] += std::strtod(text.c_str() + colon + 1, nullptr);
+                ++counts[0];
+            }
+        }
+    }
+    info.performanceCoreFreq = counts[0] ? sums[0] / counts[0] : 0.0;
+    info.efficiencyCoreFreq = counts[1] ? sums[1] / counts[1] : 0.0;
+}
+
+void LinuxCollectors::RefreshSensorList() {
+    static const std::set<std::string> cpuDrivers = { "coretemp", "k10temp", "zenpower", "cpu_thermal", "x86_pkg_temp" };
+    static const std::set<std::string> gpuDrivers = { "amdgpu", "radeon", "nouveau", "i915", "xe" };
+
+    sensors.clear();
+    const std::string hwmonRoot = "/sys/class/hwmon/";
+    for (const std::string& hwmon : ListDirectory(hwmonRoot, "hwmon")) {
+        const std::string dir = hwmonRoot + hwmon + "/";
+        const std::string driver = Trim(ReadSmallFile(dir + "name"));
+        for (const std::string& file : ListDirectory(dir, "temp")) {
+            const size_t suffix = file.find("_input");
+            if (suffix == std::string::npos || suffix + 6 != file.size()) continue;
+            std::string label = Trim(ReadSmallFile(dir + file.substr(0, suffix) + "_label"));
+            if (label.empty()) label = file.substr(0, suffix);
+            sensors.push_back({ driver + " " + label, dir + file, cpuDrivers.count(driver) > 0, gpuDrivers.count(driver) > 0 });
+        }
+    }
+    // 没有 hwmon 驱动时退回 thermal zone（ARM 与部分笔记本）
+    if (sensors.empty()) {
+        const std::string thermalRoot = "/sys/class/thermal/";
+        for (const std::string& zone : ListDirectory(thermalRoot, "thermal_zone")) {
+            const std::string type = Trim(ReadSmallFile(thermalRoot + zone + "/type"));
+            sensors.push_back({ type.empty() ? zone : type, thermalRoot + zone + "/temp", cpuDrivers.count(type) > 0, false });
+        }
+    }
+    sensorsScanned = AsyncExecutor::Clock::now();
+}
+
+Task<void> LinuxCollectors::CollectTemperatures(SystemInfo& info) {
+    // hwmon 设备可能随驱动加载 / 卸载出现或消失，定期重新扫描
+    if (sensorsScanned == AsyncExecutor::Clock::time_point{} || AsyncExecutor::Clock::now() - sensorsScanned > kSensorRescanPeriod) {
+        RefreshSensorList();
+    }
+
+    std::string text;
+    info.temperatures.clear();
+    info.cpuTemperature = 0.0;
+    info.gpuTemperature = 0.0;
+    for (const Sensor& sensor : sensors) {
+        if (!co_await ReadFile(sensor.path, text)) continue;
+        const double celsius = std::strtod(text.c_str(), nullptr) / 1000.0; // 毫摄氏度
+        info.temperatures.emplace_back(sensor.name, celsius);
+        if (sensor.isCpu) info.cpuTemperature = (std::max)(info.cpuTemperature, celsius);
+        if (sensor.isGpu) info.gpuTemperature = (std::max)(info.gpuTemperature, celsius);
+    }
+}
+
+void LinuxCollectors::FillStaticInfo(SystemInfo& info) {
+    const std::string cpuinfo = ReadSmallFile("/proc/cpuinfo");
+    std::istringstream lines(cpuinfo);
+    std::string line;
+    std::set<std::pair<int, int>> cores;
+    int physicalId = 0;
+    int logical = 0;
+    bool virtualization = false;
+    while (std::getline(lines, line)) {
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        const std::string key = Trim(line.substr(0, colon));
+        const std::string value = Trim(line.substr(colon + 1));
+        if (key == "processor") ++logical;
+        else if (key == "model name" && info.cpuName.empty()) info.cpuName = value;
+        else if (key == "physical id") physicalId = std::atoi(value.c_str());
+        else if (key == "core id") cores.insert({ physicalId, std::atoi(value.c_str()) });
+        else if (key == "flags" && !virtualization) {
+            const std::string flags = " " + value + " ";
+            virtualization = flags.find(" vmx ") != std::string::npos || flags.find(" svm ") != std::string::npos;
+        }
+    }
+    info.logicalCores = logical;
+    info.physicalCores = cores.empty() ? logical : static_cast<int>(cores.size());
+    info.hyperThreading = info.logicalCores > info.physicalCores;
+    info.virtualization = virtualization;
+    // 小核不支持超线程：小核数即 cpu_atom 的逻辑 CPU 数
+    const int atoms = static_cast<int>(ParseCpuList(ReadSmallFile("/sys/devices/cpu_atom/cpus")).size());
+    info.efficiencyCores = atoms;
+    info.performanceCores = (std::max)(0, info.physicalCores - atoms);
+
+    std::string osName = "Linux";
+    std::istringstream release(ReadSmallFile("/etc/os-release"));
+    while (std::getline(release, line)) {
+        if (line.compare(0, 12, "PRETTY_NAME=") != 0) continue;
+        osName = line.substr(12);
+        osName.erase(std::remove(osName.begin(), osName.end(), '"'), osName.end());
+        break;
+    }
+    utsname uts{};
+    if (uname(&uts) == 0) osName += std::string(" (") + uts.sysname + " " + uts.release + ")";
+    info.osVersion = osName;
+}
+#endif
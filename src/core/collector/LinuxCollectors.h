@@ -0,0 +1,72 @@
+// LinuxCollectors.h
+#pragma once
+#ifdef __linux__
+#include "AsyncExecutor.h"
+#include "../DataStruct/DataStruct.h"
+#include "../cpu/CoreUsage.h"
+#include "../cpu/UsageFilter.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Linux 采集后端：从 /proc 与 /sys 读取负载、内存、CPU 频率与温度，作为协程在 AsyncExecutor 上运行
+// procfs / sysfs 的读取由内核直接生成内容、不会阻塞在磁盘上，因此每个文件读取后让出执行权，
+// 多个数据源在一个线程上交错执行；文件描述符打开一次后以 pread 重复读取。
+// 支持变更通知的 sysfs 属性（sysfs_notify，如 hwmon 报警位）可用 WaitAttributeChange 挂起等待 POLLPRI
+class LinuxCollectors {
+public:
+    explicit LinuxCollectors(AsyncExecutor& executor);
+    ~LinuxCollectors();
+    LinuxCollectors(const LinuxCollectors&) = delete;
+    LinuxCollectors& operator=(const LinuxCollectors&) = delete;
+
+    // 读取整个 /proc 或 /sys 文件（内容较短）；失败时返回 false
+    Task<bool> ReadFile(const std::string& path, std::string& out);
+    // 挂起直到 sysfs 属性发出变更通知或到达 deadline；返回是否收到通知
+    Task<bool> WaitAttributeChange(const std::string& path, AsyncExecutor::Clock::time_point deadline);
+
+    // /proc/stat 总体与各逻辑处理器的占用率（两次采样之间的差值）与采样间隔；总体占用率按 SetCpuFilter 平滑
+    Task<void> CollectLoad(SystemInfo& info);
+    // 更换总体占用率的平滑方式（清空已有状态）
+    void SetCpuFilter(const UsageFilterConfig& config);
+    // /proc/meminfo
+    Task<void> CollectMemory(SystemInfo& info);
+    // /sys/devices/system/cpu/cpu*/cpufreq：混合架构（cpu_core / cpu_atom）下分别取两类核心的平均频率（MHz）
+    Task<void> CollectCpuFrequency(SystemInfo& info);
+    // /sys/class/hwmon 与 /sys/class/thermal
+    Task<void> CollectTemperatures(SystemInfo& info);
+
+    // 静态信息：CPU 名称、核心数、系统版本（启动时同步读取一次）
+    static void FillStaticInfo(SystemInfo& info);
+
+private:
+    int OpenCached(const std::string& path);
+    void RefreshSensorList();
+
+    struct CpuTimes {
+        uint64_t busy = 0;
+        uint64_t total = 0;
+    };
+
+    struct Sensor {
+        std::string name;
+        std::string path;
+        bool isCpu = false;
+        bool isGpu = false;
+    };
+
+    AsyncExecutor& executor;
+    std::unordered_map<std::string, int> fds;
+    CpuTimes lastCpu;
+    CoreUsageTracker coreTracker;
+    UsageFilterConfig cpuFilterConfig;
+    std::unique_ptr<UsageFilter> cpuFilter = UsageFilter::Create(UsageFilterConfig{});
+    AsyncExecutor::Clock::time_point lastCpuSample;
+    std::vector<int> performanceCpus;
+    std::vector<int> efficiencyCpus;
+    std::vector<Sensor> sensors;
+    AsyncExecutor::Clock::time_point sensorsScanned;
+};
+#endif
@@ -0,0 +1,42 @@
+// MemoryCollector.cpp
+#include "CollectorRegistry.h"
+#include "../memory/MemoryInfo.h"
+
+namespace {
+
+// 物理内存：一次 GlobalMemoryStatusEx
+class MemoryCollector : public ICollector {
+public:
+    static constexpr const char* kName = "memory";
+
+    const char* Name() const override { return kName; }
+
+    Descriptor Describe() const override {
+        Descriptor descriptor;
+        descriptor.schedule.period = std::chrono::milliseconds(500);
+        descriptor.schedule.minPeriod = std::chrono::milliseconds(250);
+        descriptor.schedule.maxPeriod = std::chrono::milliseconds(2000);
+        descriptor.schedule.priority = 1;
+        descriptor.schedule.sections = 1u << SHM_SECTION_LOAD;
+        descriptor.schedule.wait = true;
+        descriptor.cost = Cost::Low;
+        return descriptor;
+    }
+
+    void Sample(SystemInfo& snapshot, const CollectorScheduler::RunInfo&) override {
+        MemoryInfo mem;
+        snapshot.totalMemory = mem.GetTotalPhysical();
+        snapshot.usedMemory = mem.GetTotalPhysical() - mem.GetAvailablePhysical();
+        snapshot.availableMemory = mem.GetAvailablePhysical();
+    }
+
+    void Merge(SystemInfo& dst, const SystemInfo& src) const override {
+        dst.totalMemory = src.totalMemory;
+        dst.usedMemory = src.usedMemory;
+        dst.availableMemory = src.availableMemory;
+    }
+};
+
+} // namespace
+
+REGISTER_COLLECTOR(MemoryCollector::kName, MemoryCollector);
@@ -0,0 +1,79 @@
+// NetworkCollector.cpp
+#include "CollectorRegistry.h"
+#include "DeviceChangeMonitor.h"
+#include "../network/NetworkAdapter.h"
+#include "../Utils/WinUtils.h"
+
+namespace {
+
+// 网卡清单：每次构造 NetworkAdapter 都是一次 WMI 全表查询
+// 清单只在网卡插拔时变化，由设备变化事件触发重新枚举，周期采集只作兜底
+class NetworkCollector : public ICollector {
+public:
+    static constexpr const char* kName = "network";
+
+    const char* Name() const override { return kName; }
+
+    Descriptor Describe() const override {
+        Descriptor descriptor;
+        descriptor.schedule.period = std::chrono::minutes(10);
+        descriptor.schedule.priority = 4;
+        descriptor.schedule.sections = 1u << SHM_SECTION_ADAPTERS;
+        descriptor.schedule.wait = false;
+        descriptor.schedule.triggers = DEVICE_CLASS_NETWORK;
+        descriptor.cost = Cost::High;
+        descriptor.slowInit = true;
+        return descriptor;
+    }
+
+    bool Init(const CollectorContext& context) override {
+        wmi = context.Wmi();
+        return wmi != nullptr;
+    }
+
+    void Sample(SystemInfo& snapshot, const CollectorScheduler::RunInfo&) override {
+        NetworkAdapter netAdapter(*wmi);
+        const auto& adapters = netAdapter.GetAdapters();
+        snapshot.adapters.clear();
+        for (const auto& adapter : adapters) {
+            NetworkAdapterData data;
+            // 名称、MAC、IP和类型为wstring，需转为wchar_t数组
+            wcsncpy_s(data.name, adapter.name.c_str(), _TRUNCATE);
+            wcsncpy_s(data.mac, adapter.mac.c_str(), _TRUNCATE);
+            wcsncpy_s(data.ipAddress, adapter.ip.c_str(), _TRUNCATE);
+            wcsncpy_s(data.adapterType, adapter.adapterType.c_str(), _TRUNCATE);
+            data.speed = adapter.speed;
+            snapshot.adapters.push_back(data);
+        }
+        // 兼容旧字段，取第一个适配器
+        if (!adapters.empty()) {
+            snapshot.networkAdapterName = WinUtils::WstringToString(adapters[0].name);
+            snapshot.networkAdapterMac = WinUtils::WstringToString(adapters[0].mac);
+            snapshot.networkAdapterIp = WinUtils::WstringToString(adapters[0].ip);
+            snapshot.networkAdapterType = WinUtils::WstringToString(adapters[0].adapterType);
+            snapshot.networkAdapterSpeed = adapters[0].speed;
+        } else {
+            snapshot.networkAdapterName = "未检测到网络适配器";
+            snapshot.networkAdapterMac = "00-00-00-00-00-00";
+            snapshot.networkAdapterIp = "N/A";
+            snapshot.networkAdapterType = "未知";
+            snapshot.networkAdapterSpeed = 0;
+        }
+    }
+
+    void Merge(SystemInfo& dst, const SystemInfo& src) const override {
+        dst.adapters = src.adapters;
+        dst.networkAdapterName = src.networkAdapterName;
+        dst.networkAdapterMac = src.networkAdapterMac;
+        dst.networkAdapterIp = src.networkAdapterIp;
+        dst.networkAdapterType = src.networkAdapterType;
+        dst.networkAdapterSpeed = src.networkAdapterSpeed;
+    }
+
+private:
+    WmiManager* wmi = nullptr;
+};
+
+} // namespace
+
+REGISTER_COLLECTOR(NetworkCollector::kName, NetworkCollector);
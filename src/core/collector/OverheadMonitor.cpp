@@ -0,0 +1,241 @@
+// OverheadMonitor.cpp
+#include "OverheadMonitor.h"
+#include "../DataStruct/WriterLease.h"
+#include "../Utils/AllocationCounter.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+uint32_t Saturate(uint64_t value) {
+    return value >= UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(value);
+}
+
+struct ProcessCounters {
+    uint64_t residentBytes = 0;
+    uint64_t peakResidentBytes = 0;
+    uint64_t privateBytes = 0;
+    uint32_t handles = 0;
+    uint32_t threads = 0;
+    uint64_t ioSyscalls = 0;
+    uint64_t pageFaults = 0;
+    uint64_t contextSwitches = 0;
+};
+
+#ifdef _WIN32
+
+void ReadProcessCounters(ProcessCounters& out) {
+    const HANDLE process = GetCurrentProcess();
+    PROCESS_MEMORY_COUNTERS_EX memory{};
+    if (GetProcessMemoryInfo(process, reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&memory), sizeof(memory))) {
+        out.residentBytes = memory.WorkingSetSize;
+        out.peakResidentBytes = memory.PeakWorkingSetSize;
+        out.privateBytes = memory.PrivateUsage;
+        out.pageFaults = memory.PageFaultCount;
+    }
+    DWORD handles = 0;
+    if (GetProcessHandleCount(process, &handles)) out.handles = handles;
+    IO_COUNTERS io{};
+    if (GetProcessIoCounters(process, &io)) {
+        out.ioSyscalls = io.ReadOperationCount + io.WriteOperationCount + io.OtherOperationCount;
+    }
+    // 线程数与上下文切换需要枚举全系统的线程 / 进程信息，开销与被测量的东西同量级，不统计
+}
+
+#else
+
+// 读取整个 /proc/self 文件到栈上缓冲区（以 \0 结尾）；不用 stdio / dirent，它们会在堆上分配 FILE 与 DIR
+size_t ReadProcFile(const char* path, char* buffer, size_t size) {
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    size_t length = 0;
+    while (length < size - 1) {
+        const ssize_t n = read(fd, buffer + length, size - 1 - length);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        length += static_cast<size_t>(n);
+    }
+    close(fd);
+    buffer[length] = '\0';
+    return length;
+}
+
+// 缓冲区中 "Key: value" 或 "key value" 形式的单个数值（key 须位于行首）
+bool FindProcValue(const char* text, const char* key, uint64_t& out) {
+    const size_t keyLength = strlen(key);
+    for (const char* line = text; *line; ) {
+        if (strncmp(line, key, keyLength) == 0) {
+            out = strtoull(line + keyLength, nullptr, 10);
+            return true;
+        }
+        const char* next = strchr(line, '\n');
+        if (!next) break;
+        line = next + 1;
+    }
+    return false;
+}
+
+// 目录项个数（不含 . 与 ..），直接用 getdents64 读取
+uint32_t CountDirectoryEntries(const char* path) {
+    const int fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    alignas(8) char buffer[4096];
+    uint32_t count = 0;
+    while (true) {
+        const long n = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+        if (n <= 0) break;
+        for (long offset = 0; offset < n; ) {
+            // linux_dirent64: d_ino(8) d_off(8) d_reclen(2) d_type(1) d_name[]
+            unsigned short recordLength = 0;
+            memcpy(&recordLength, buffer + offset + 16, sizeof(recordLength));
+            if (buffer[offset + 19] != '.') ++count;
+            offset += recordLength;
+        }
+    }
+    close(fd);
+    // 不计枚举本身打开的描述符
+    return count > 0 ? count - 1 : 0;
+}
+
+void ReadProcessCounters(ProcessCounters& out) {
+    const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    char text[4096];
+    if (ReadProcFile("/proc/self/statm", text, sizeof(text)) > 0) {
+        unsigned long long size = 0, resident = 0, shared = 0, textPages = 0, lib = 0, data = 0;
+        if (sscanf(text, "%llu %llu %llu %llu %llu %llu", &size, &resident, &shared, &textPages, &lib, &data) == 6) {
+            out.residentBytes = resident * pageSize;
+            out.privateBytes = data * pageSize;
+        }
+    }
+    uint64_t value = 0;
+    if (ReadProcFile("/proc/self/status", text, sizeof(text)) > 0 && FindProcValue(text, "Threads:", value)) {
+        out.threads = Saturate(value);
+    }
+    // /proc/self/io 在部分容器中不可读，此时系统调用数保持为 0
+    uint64_t reads = 0, writes = 0;
+    if (ReadProcFile("/proc/self/io", text, sizeof(text)) > 0 && FindProcValue(text, "syscr:", reads) &&
+        FindProcValue(text, "syscw:", writes)) {
+        out.ioSyscalls = reads + writes;
+    }
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        out.peakResidentBytes = static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+        out.pageFaults = static_cast<uint64_t>(usage.ru_minflt + usage.ru_majflt);
+        out.contextSwitches = static_cast<uint64_t>(usage.ru_nvcsw + usage.ru_nivcsw);
+    }
+    out.handles = CountDirectoryEntries("/proc/self/fd");
+}
+
+#endif
+
+} // namespace
+
+OverheadMonitor::OverheadMonitor(std::chrono::milliseconds sampleInterval) : sampleInterval(sampleInterval) {
+#ifdef _WIN32
+    current.pid = GetCurrentProcessId();
+#else
+    current.pid = static_cast<uint32_t>(getpid());
+#endif
+    current.sampleIntervalMs = static_cast<uint32_t>(sampleInterval.count());
+}
+
+uint64_t OverheadMonitor::ProcessCpuTimeUs() {
+#ifdef _WIN32
+    FILETIME creation{}, exit{}, kernel{}, user{};
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) return 0;
+    const auto toUs = [](const FILETIME& time) {
+        return ((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10;   // 100ns -> us
+    };
+    return toUs(kernel) + toUs(user);
+#else
+    timespec time{};
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) return 0;
+    return static_cast<uint64_t>(time.tv_sec) * 1000000 + static_cast<uint64_t>(time.tv_nsec) / 1000;
+#endif
+}
+
+void OverheadMonitor::BeginCycle(Clock::time_point now) {
+    const uint64_t cpuUs = ProcessCpuTimeUs();
+    const uint64_t allocations = AllocationCounter::Count();
+    if (cycleStart != Clock::time_point{}) {
+        current.lastCycleCpuUs = Saturate(cpuUs > cycleStartCpuUs ? cpuUs - cycleStartCpuUs : 0);
+        current.maxCycleCpuUs = (std::max)(current.maxCycleCpuUs, current.lastCycleCpuUs);
+        current.lastCycleAllocations = Saturate(allocations - cycleStartAllocations);
+        current.maxCycleAllocations = (std::max)(current.maxCycleAllocations, current.lastCycleAllocations);
+    }
+    current.cpuTimeUs = cpuUs;
+    current.allocations = allocations;
+    current.allocatedBytes = AllocationCounter::Bytes();
+    cycleStart = now;
+    cycleStartCpuUs = cpuUs;
+    cycleStartAllocations = allocations;
+    inCycle = true;
+}
+
+void OverheadMonitor::EndCycle(Clock::time_point now) {
+    if (!inCycle) return;
+    inCycle = false;
+    const uint32_t wallUs = Saturate(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(now - cycleStart).count()));
+    current.lastCycleWallUs = wallUs;
+    current.maxCycleWallUs = (std::max)(current.maxCycleWallUs, wallUs);
+    current.totalCycleWallUs += wallUs;
+    int bucket = 0;
+    while (bucket < SHM_CYCLE_BUCKETS - 1 && wallUs >= SHM_CYCLE_BUCKET_US[bucket]) ++bucket;
+    ++current.cycleHistogram[bucket];
+    ++current.cycles;
+}
+
+const SharedSelfOverhead& OverheadMonitor::Snapshot(Clock::time_point now) {
+    if (lastRefresh == Clock::time_point{} || now - lastRefresh >= sampleInterval) RefreshProcessCounters(now);
+    current.updatedNs = WriterLease::MonotonicNowNs();
+    return current;
+}
+
+void OverheadMonitor::RefreshProcessCounters(Clock::time_point now) {
+    ProcessCounters counters;
+    ReadProcessCounters(counters);
+    current.residentBytes = counters.residentBytes;
+    current.peakResidentBytes = (std::max)(counters.peakResidentBytes, counters.residentBytes);
+    current.privateBytes = counters.privateBytes;
+    current.handles = counters.handles;
+    current.threads = counters.threads;
+    current.ioSyscalls = counters.ioSyscalls;
+    current.pageFaults = counters.pageFaults;
+    current.contextSwitches = counters.contextSwitches;
+
+    const uint64_t cpuUs = ProcessCpuTimeUs();
+    if (lastRefresh != Clock::time_point{}) {
+        const double wallUs = std::chrono::duration<double, std::micro>(now - lastRefresh).count();
+        current.cpuPercent = wallUs > 0.0 ? 100.0 * static_cast<double>(cpuUs - lastRefreshCpuUs) / wallUs : 0.0;
+    }
+    lastRefresh = now;
+    lastRefreshCpuUs = cpuUs;
+}
+
+std::string OverheadMonitor::Describe() const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2) << "CPU " << current.cpuPercent << "%（每轮 " << current.lastCycleCpuUs / 1000.0
+       << "ms）, 每轮耗时 " << current.lastCycleWallUs / 1000.0 << "/" << current.maxCycleWallUs / 1000.0 << "ms"
+       << std::setprecision(1) << ", 常驻内存 " << current.residentBytes / 1048576.0 << "MB"
+       << ", 分配 " << current.lastCycleAllocations << " 次/轮（累计 " << current.allocations << "）"
+       << ", 句柄 " << current.handles;
+    return ss.str();
+}
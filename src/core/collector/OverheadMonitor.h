@@ -0,0 +1,41 @@
+// OverheadMonitor.h
+#pragma once
+#include "../DataStruct/DataStruct.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// 监视器自身开销：在主循环每轮的开始 / 结束处打点，统计本进程每轮消耗的 CPU 时间、堆分配与墙钟耗时，
+// 并按 sampleInterval 刷新进程级计数（常驻内存、句柄、系统调用、缺页、上下文切换），
+// 结果写入共享内存的自身开销表（SharedMemoryManager::SetSelfOverhead），泄漏或开销回归直接体现在遥测中。
+// 每轮打点只读取进程 CPU 时间与分配计数器；进程级计数需要多次系统调用，因此限频
+class OverheadMonitor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit OverheadMonitor(std::chrono::milliseconds sampleInterval = std::chrono::milliseconds(1000));
+
+    // 一轮开始（派发之前）：结算自上一轮开始以来进程（含工作线程）消耗的 CPU 时间与堆分配次数
+    void BeginCycle(Clock::time_point now = Clock::now());
+    // 一轮结束（发布之后）：记录本轮墙钟耗时
+    void EndCycle(Clock::time_point now = Clock::now());
+    // 当前统计（墙钟耗时为最近一轮已结束的）；距上次刷新超过 sampleInterval 时先刷新进程级计数
+    const SharedSelfOverhead& Snapshot(Clock::time_point now = Clock::now());
+    // 摘要（用于日志）
+    std::string Describe() const;
+
+    // 本进程所有线程累计的用户 + 内核 CPU 时间（微秒）
+    static uint64_t ProcessCpuTimeUs();
+
+private:
+    void RefreshProcessCounters(Clock::time_point now);
+
+    const std::chrono::milliseconds sampleInterval;
+    SharedSelfOverhead current{};
+    Clock::time_point cycleStart{};
+    uint64_t cycleStartCpuUs = 0;
+    uint64_t cycleStartAllocations = 0;
+    bool inCycle = false;
+    Clock::time_point lastRefresh{};
+    uint64_t lastRefreshCpuUs = 0;
+};
@@ -0,0 +1,51 @@
+// PhysicalDiskCollector.cpp
+#include "CollectorRegistry.h"
+#include "DeviceChangeMonitor.h"
+#include "../disk/DiskInfo.h"
+
+namespace {
+
+// 物理磁盘与 SMART：三次 WMI 查询，数据很少变化；磁盘插拔时由设备变化事件立即重新枚举
+class PhysicalDiskCollector : public ICollector {
+public:
+    static constexpr const char* kName = "physicalDisks";
+
+    const char* Name() const override { return kName; }
+
+    Descriptor Describe() const override {
+        Descriptor descriptor;
+        descriptor.schedule.period = std::chrono::minutes(5);
+        descriptor.schedule.priority = 6;
+        descriptor.schedule.sections = 1u << SHM_SECTION_SMART;
+        descriptor.schedule.wait = false;
+        descriptor.schedule.triggers = DEVICE_CLASS_DISK;
+        descriptor.cost = Cost::High;
+        descriptor.slowInit = true;
+        return descriptor;
+    }
+
+    bool Init(const CollectorContext& context) override {
+        wmi = context.Wmi();
+        return wmi != nullptr;
+    }
+
+    // 逻辑磁盘列表由 disks 数据源负责，派发时复制到暂存区，用于关联盘符
+    void Prepare(SystemInfo& snapshot, const SystemInfo& current) const override {
+        snapshot.disks = current.disks;
+    }
+
+    void Sample(SystemInfo& snapshot, const CollectorScheduler::RunInfo&) override {
+        DiskInfo::CollectPhysicalDisks(*wmi, snapshot.disks, snapshot);
+    }
+
+    void Merge(SystemInfo& dst, const SystemInfo& src) const override {
+        dst.physicalDisks = src.physicalDisks;
+    }
+
+private:
+    WmiManager* wmi = nullptr;
+};
+
+} // namespace
+
+REGISTER_COLLECTOR(PhysicalDiskCollector::kName, PhysicalDiskCollector);
@@ -0,0 +1,93 @@
+// SensorCollector.cpp
+#include "CollectorRegistry.h"
+#include "../temperature/TemperatureWrapper.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace {
+
+// 温度传感器：经硬件监控桥接（LibreHardwareMonitor）读取，一次读取开销较大
+class SensorCollector : public ICollector {
+public:
+    static constexpr const char* kName = "sensors";
+
+    const char* Name() const override { return kName; }
+
+    // 不快于配置周期，无人查看时降频，主机过载时暂停
+    Descriptor Describe() const override {
+        Descriptor descriptor;
+        descriptor.schedule.period = std::chrono::milliseconds(1000);
+        descriptor.schedule.minPeriod = std::chrono::milliseconds(1000);
+        descriptor.schedule.maxPeriod = std::chrono::milliseconds(4000);
+        descriptor.schedule.priority = 2;
+        descriptor.schedule.sections = (1u << SHM_SECTION_TEMPERATURES) | (1u << SHM_SECTION_SENSORS);
+        descriptor.schedule.wait = true;
+        descriptor.cost = Cost::High;
+        descriptor.slowInit = true;
+        return descriptor;
+    }
+
+    // 复用主程序的 WMI 连接读取本地 GPU 温度，不再单独建立第二个连接
+    bool Init(const CollectorContext& context) override {
+        try {
+            TemperatureWrapper::Initialize(context.Wmi());
+            Logger::Debug("硬件监控桥接初始化成功");
+        }
+        catch (const std::exception& e) {
+            // 继续调度：桥接不可用时读数为空，温度分区保持为 0
+            Logger::Error("硬件监控桥接初始化失败: " + std::string(e.what()));
+        }
+        return true;
+    }
+
+    // 读数缓冲区与暂存区中的名称都原地改写：传感器列表不变时一次采集不分配
+    void Sample(SystemInfo& snapshot, const CollectorScheduler::RunInfo& run) override {
+        const size_t count = TemperatureWrapper::GetTemperatures(readings);
+        auto& temperatures = snapshot.temperatures;
+        temperatures.resize(count);
+        snapshot.cpuTemperature = 0;
+        snapshot.gpuTemperature = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const auto& temp = readings[i];
+            if (ContainsIgnoreCase(temp.first, "gpu") || ContainsIgnoreCase(temp.first, "graphics")) {
+                snapshot.gpuTemperature = temp.second;
+                temperatures[i].first.assign("GPU");
+            } else if (ContainsIgnoreCase(temp.first, "cpu") || ContainsIgnoreCase(temp.first, "package")) {
+                snapshot.cpuTemperature = temp.second;
+                temperatures[i].first.assign("CPU");
+            } else {
+                temperatures[i].first.assign(temp.first);
+            }
+            temperatures[i].second = temp.second;
+        }
+        if (run.firstRun) {
+            Logger::Debug("收集到 " + std::to_string(count) + " 个温度读数");
+            for (const auto& temp : snapshot.temperatures) {
+                Logger::Debug("温度传感器: " + temp.first + " = " + std::to_string(temp.second) + "°C");
+            }
+            Logger::Debug("CPU温度: " + std::to_string(snapshot.cpuTemperature) + ", GPU温度: " + std::to_string(snapshot.gpuTemperature));
+        }
+    }
+
+    void Merge(SystemInfo& dst, const SystemInfo& src) const override {
+        dst.temperatures = src.temperatures;
+        dst.cpuTemperature = src.cpuTemperature;
+        dst.gpuTemperature = src.gpuTemperature;
+    }
+
+private:
+    // 不区分大小写的子串查找（needle 为小写 ASCII），不复制 haystack
+    static bool ContainsIgnoreCase(const std::string& haystack, const char* needle) {
+        const auto it = std::search(haystack.begin(), haystack.end(), needle, needle + strlen(needle),
+            [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; });
+        return it != haystack.end();
+    }
+
+    std::vector<std::pair<std::string, double>> readings;   // 桥接读数（工作线程独占，跨采集复用）
+};
+
+} // namespace
+
+REGISTER_COLLECTOR(SensorCollector::kName, SensorCollector);
@@ -0,0 +1,116 @@
+// CoreUsage.cpp
+#include "CoreUsage.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t kMantissaMask = (1ull << 52) - 1;
+
+// 以下辅助函数只用 64 位加减、逻辑移位与位运算（SSE2 均有对应的向量指令），不含比较与分支，
+// 编译器可把 ComputeCoreUsage 的循环整体向量化；64 位整数比较要到 SSE4.2、到 double 的转换要到 AVX-512 才有向量指令
+
+// 差值；计数器回退（/proc/stat 的 iowait 在 NO_HZ 下可能回退）时按 0 处理。计数器远小于 2^63
+inline uint64_t Delta(uint64_t now, uint64_t previous) {
+    const uint64_t delta = now - previous;
+    return delta & ((delta >> 63) - 1);
+}
+
+inline uint64_t Min(uint64_t a, uint64_t b) {
+    const uint64_t aLess = 0 - ((a - b) >> 63);
+    return b ^ ((a ^ b) & aLess);
+}
+
+// 取低 52 位放进 double 的尾数再减去 2^52：差值远小于 2^52（100ns 为单位约 14 年），转换是精确的
+inline double ToDouble(uint64_t value) {
+    const uint64_t bits = (value & kMantissaMask) | 0x4330000000000000ull;
+    double result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result - 4503599627370496.0;
+}
+
+inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+} // namespace
+
+void CoreTicks::Resize(size_t count) {
+    busy.resize(count);
+    total.resize(count);
+}
+
+void ComputeCoreUsage(const uint64_t* busy, const uint64_t* total, const uint64_t* previousBusy, const uint64_t* previousTotal,
+                      float* usage, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t totalDelta = Delta(total[i], previousTotal[i]);
+        // 两列分别采样时 busy 可能略超 total：截断后占用率不超过 100；Δtotal 为 0 时 Δbusy 也为 0，分母取 1
+        const uint64_t busyDelta = Min(Delta(busy[i], previousBusy[i]), totalDelta);
+        const uint64_t denominator = totalDelta | ((totalDelta - 1) >> 63);
+        usage[i] = static_cast<float>(ToDouble(busyDelta) * 100.0 / ToDouble(denominator));
+    }
+}
+
+size_t ParseProcStatCores(const char* text, size_t length, CoreTicks& ticks) {
+    const char* const end = text + length;
+    size_t count = 0;
+    // 第一遍只找最大编号，处理器数不变时第二遍直接覆盖写入，不分配
+    for (const char* line = text; line < end;) {
+        const char* next = static_cast<const char*>(memchr(line, '\n', end - line));
+        next = next ? next + 1 : end;
+        if (next - line > 4 && memcmp(line, "cpu", 3) == 0 && IsDigit(line[3])) {
+            size_t cpu = 0;
+            for (const char* p = line + 3; p < next && IsDigit(*p); ++p) cpu = cpu * 10 + (*p - '0');
+            count = std::max(count, cpu + 1);
+        }
+        else if (count > 0) {
+            // cpuN 行是连续的，之后的 intr / ctxt 等行无需扫描
+            break;
+        }
+        line = next;
+    }
+    if (ticks.Size() != count) ticks.Resize(count);
+    std::fill(ticks.busy.begin(), ticks.busy.end(), 0);
+    std::fill(ticks.total.begin(), ticks.total.end(), 0);
+
+    for (const char* line = text; line < end;) {
+        const char* next = static_cast<const char*>(memchr(line, '\n', end - line));
+        next = next ? next + 1 : end;
+        if (!(next - line > 4 && memcmp(line, "cpu", 3) == 0 && IsDigit(line[3]))) {
+            if (line != text) break;
+            line = next;    // 汇总的 "cpu" 行
+            continue;
+        }
+        const char* p = line + 3;
+        size_t cpu = 0;
+        for (; p < next && IsDigit(*p); ++p) cpu = cpu * 10 + (*p - '0');
+        // user nice system idle iowait irq softirq steal（guest / guest_nice 已计入 user / nice）
+        uint64_t values[8] = {};
+        for (int field = 0; field < 8; ++field) {
+            while (p < next && *p == ' ') ++p;
+            if (p >= next || !IsDigit(*p)) break;
+            uint64_t value = 0;
+            for (; p < next && IsDigit(*p); ++p) value = value * 10 + static_cast<uint64_t>(*p - '0');
+            values[field] = value;
+        }
+        uint64_t sum = 0;
+        for (uint64_t value : values) sum += value;
+        ticks.total[cpu] = sum;
+        ticks.busy[cpu] = sum - values[3] - values[4];
+        line = next;
+    }
+    return count;
+}
+
+bool CoreUsageTracker::Update(std::vector<float>& usage) {
+    const CoreTicks& now = ticks[current];
+    const CoreTicks& previous = ticks[current ^ 1];
+    const bool valid = hasPrevious && previous.Size() == now.Size();
+    if (valid) {
+        if (usage.size() != now.Size()) usage.resize(now.Size());
+        ComputeCoreUsage(now.busy.data(), now.total.data(), previous.busy.data(), previous.total.data(), usage.data(), now.Size());
+    }
+    hasPrevious = true;
+    current ^= 1;
+    return valid;
+}
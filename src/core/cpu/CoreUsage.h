@@ -0,0 +1,41 @@
+// CoreUsage.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 各逻辑处理器的累计时间（结构数组）：busy / total 各自连续存放，下标为逻辑处理器编号。
+// 单位由来源决定（Windows 为 100ns，/proc/stat 为 USER_HZ），只用于求两次采样之差
+struct CoreTicks {
+    std::vector<uint64_t> busy;     // 非空闲时间
+    std::vector<uint64_t> total;    // 非空闲 + 空闲时间
+
+    size_t Size() const { return total.size(); }
+    // 调整处理器数；新增的处理器计数为 0。数目不变时不分配
+    void Resize(size_t count);
+};
+
+// 逐处理器占用率：usage[i] = 100 * Δbusy / Δtotal，Δtotal 为 0（离线 / 两次采样之间未推进）时为 0。
+// 循环无分支、各处理器独立，供编译器向量化（截断与转换都用位运算实现，SSE2 即可）
+void ComputeCoreUsage(const uint64_t* busy, const uint64_t* total, const uint64_t* previousBusy, const uint64_t* previousTotal,
+                      float* usage, size_t count);
+
+// 解析 /proc/stat 中的 "cpuN ..." 行到 ticks（跳过汇总的 "cpu" 行）；离线处理器不出现在文件中，其计数保持为 0。
+// 返回处理器数（最大编号 + 1）；数目不变时不分配。text 不必以 0 结尾
+size_t ParseProcStatCores(const char* text, size_t length, CoreTicks& ticks);
+
+// 两次采样之差：调用方把本轮的累计时间写入 Current()，再调用 Update
+class CoreUsageTracker {
+public:
+    // 本轮的缓冲（与上一轮交替使用，处理器数不变时不分配）
+    CoreTicks& Current() { return ticks[current]; }
+    // 以 Current() 与上一轮之差计算占用率写入 usage（大小调整为处理器数）；
+    // 首轮或处理器数变化（热插拔）时只记录基准，返回 false，usage 保持不变
+    bool Update(std::vector<float>& usage);
+    void Reset() { hasPrevious = false; }
+
+private:
+    CoreTicks ticks[2];
+    int current = 0;
+    bool hasPrevious = false;
+};
@@ -1,10 +1,12 @@
 ﻿#include "CpuInfo.h"
 #include "Logger.h"
+#include "../DataStruct/DataStruct.h"
 #include <intrin.h>
 #include <windows.h>
 #include <vector>
 #include <pdh.h>
 #include <algorithm>
+#include <winternl.h>
 
 #pragma comment(lib, "pdh.lib")
 
@@ -17,6 +19,21 @@
 #define PDH_CSTATUS_NEW_DATA 0x00000001L
 #endif
 
+namespace {
+
+// NtQuerySystemInformation 只返回调用线程所在处理器组的处理器；Ex 版本以组号为输入，可逐组读取
+typedef NTSTATUS(WINAPI* NtQuerySystemInformationExPtr)(SYSTEM_INFORMATION_CLASS, PVOID, ULONG, PVOID, ULONG, PULONG);
+
+NtQuerySystemInformationExPtr QuerySystemInformationEx() {
+    static const NtQuerySystemInformationExPtr function = []() -> NtQuerySystemInformationExPtr {
+        HMODULE ntdll = GetModuleHandleW(L"ntdll.dll");
+        return ntdll ? (NtQuerySystemInformationExPtr)GetProcAddress(ntdll, "NtQuerySystemInformationEx") : nullptr;
+    }();
+    return function;
+}
+
+} // namespace
+
 CpuInfo::CpuInfo() :
     totalCores(0),
     largeCores(0),
@@ -24,12 +41,11 @@ CpuInfo::CpuInfo() :
     cpuUsage(0.0),
     counterInitialized(false),
     lastUpdateTime(0),
-    lastSampleTick(0),
-    prevSampleTick(0),
     lastSampleIntervalMs(0.0) {
 
     try {
         DetectCores();
+        DetectCoreClasses();
         cpuName = GetNameFromRegistry();
         InitializeCounter();
         UpdateCoreSpeeds();  // 初始化频率信息
@@ -125,6 +141,97 @@ void CpuInfo::DetectCores() {
     }
 }
 
+void CpuInfo::DetectCoreClasses() {
+    // 逻辑处理器按处理器组依次编号，与 SampleCores 的顺序一致
+    const WORD groupCount = GetActiveProcessorGroupCount();
+    std::vector<DWORD> groupBase(groupCount + 1, 0);
+    for (WORD group = 0; group < groupCount; ++group) {
+        groupBase[group + 1] = groupBase[group] + GetActiveProcessorCount(group);
+    }
+    coreClasses.assign(groupBase[groupCount], SHM_CORE_UNKNOWN);
+
+    DWORD bufferSize = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &bufferSize);
+    if (bufferSize == 0) return;
+    std::vector<unsigned char> buffer(bufferSize);
+    if (!GetLogicalProcessorInformationEx(RelationProcessorCore,
+        reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &bufferSize)) {
+        Logger::Warn("无法获取核心类型信息，错误代码: " + std::to_string(GetLastError()));
+        return;
+    }
+
+    // EfficiencyClass 越大性能越高：最高一类为性能核，其余为能效核；全部相同（非混合架构）时都算性能核
+    BYTE maxClass = 0, minClass = 0xFF;
+    for (DWORD offset = 0; offset < bufferSize;) {
+        const auto* info = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+        maxClass = (std::max)(maxClass, info->Processor.EfficiencyClass);
+        minClass = (std::min)(minClass, info->Processor.EfficiencyClass);
+        offset += info->Size;
+    }
+    for (DWORD offset = 0; offset < bufferSize;) {
+        const auto* info = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+        const uint8_t coreClass = (maxClass == minClass || info->Processor.EfficiencyClass == maxClass)
+            ? SHM_CORE_PERFORMANCE : SHM_CORE_EFFICIENCY;
+        for (WORD g = 0; g < info->Processor.GroupCount; ++g) {
+            const GROUP_AFFINITY& affinity = info->Processor.GroupMask[g];
+            if (affinity.Group >= groupCount) continue;
+            for (DWORD bit = 0; bit < sizeof(KAFFINITY) * 8; ++bit) {
+                if (!(affinity.Mask & (static_cast<KAFFINITY>(1) << bit))) continue;
+                const DWORD index = groupBase[affinity.Group] + bit;
+                if (index < groupBase[affinity.Group + 1]) coreClasses[index] = coreClass;
+            }
+        }
+        offset += info->Size;
+    }
+}
+
+bool CpuInfo::SampleCores(std::vector<float>& usage) {
+    const auto currentTime = std::chrono::steady_clock::now();
+    if (lastCoreSampleTime != std::chrono::steady_clock::time_point{} &&
+        currentTime - lastCoreSampleTime < minSampleInterval) {
+        return false;
+    }
+
+    NtQuerySystemInformationExPtr queryEx = QuerySystemInformationEx();
+    if (!queryEx) return false;
+
+    const WORD groupCount = GetActiveProcessorGroupCount();
+    DWORD processorCount = 0;
+    for (WORD group = 0; group < groupCount; ++group) processorCount += GetActiveProcessorCount(group);
+
+    CoreTicks& ticks = coreTracker.Current();
+    if (ticks.Size() != processorCount) ticks.Resize(processorCount);
+    size_t index = 0;
+    for (WORD group = 0; group < groupCount; ++group) {
+        const DWORD count = GetActiveProcessorCount(group);
+        const ULONG bytes = count * sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION);
+        if (coreBuffer.size() < bytes) coreBuffer.resize(bytes);
+        ULONG returned = 0;
+        USHORT groupNumber = group;
+        const NTSTATUS status = queryEx(SystemProcessorPerformanceInformation, &groupNumber, sizeof(groupNumber),
+            coreBuffer.data(), bytes, &returned);
+        if (!NT_SUCCESS(status)) {
+            Logger::Warn("无法获取处理器组 " + std::to_string(group) + " 的占用时间，状态: " + std::to_string(status));
+            coreTracker.Reset();
+            return false;
+        }
+        const auto* info = reinterpret_cast<const SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION*>(coreBuffer.data());
+        const DWORD valid = (std::min)(count, static_cast<DWORD>(returned / sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION)));
+        for (DWORD i = 0; i < count; ++i, ++index) {
+            if (i >= valid) {
+                ticks.busy[index] = ticks.total[index] = 0;
+                continue;
+            }
+            // KernelTime 包含空闲时间
+            const uint64_t total = static_cast<uint64_t>(info[i].KernelTime.QuadPart) + static_cast<uint64_t>(info[i].UserTime.QuadPart);
+            ticks.total[index] = total;
+            ticks.busy[index] = total - static_cast<uint64_t>(info[i].IdleTime.QuadPart);
+        }
+    }
+    lastCoreSampleTime = currentTime;
+    return coreTracker.Update(usage);
+}
+
 void CpuInfo::UpdateCoreSpeeds() {
     // 检查更新间隔
     DWORD currentTime = GetTickCount();
@@ -137,14 +244,18 @@ void CpuInfo::UpdateCoreSpeeds() {
     DWORD speed;
     DWORD size = sizeof(DWORD);
 
-    // 清空旧数据
+    // 清空旧数据（保留容量：每秒一次的刷新不再分配）
+    largeCoresSpeeds.reserve(totalCores);
+    smallCoresSpeeds.reserve(totalCores);
     largeCoresSpeeds.clear();
     smallCoresSpeeds.clear();
 
-    // 遍历所有核心
+    // 遍历所有核心（注册表路径在栈上拼接）
+    wchar_t keyPath[96];
     for (int i = 0; i < totalCores; ++i) {
-        std::wstring keyPath = L"HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\" + std::to_wstring(i);
-        if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, keyPath.c_str(), 0, KEY_READ, &hKey) == ERROR_SUCCESS) {
+        swprintf_s(keyPath, L"HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\%d", i);
+        size = sizeof(DWORD);
+        if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, keyPath, 0, KEY_READ, &hKey) == ERROR_SUCCESS) {
             if (RegQueryValueExW(hKey, L"~MHz", NULL, NULL, (LPBYTE)&speed, &size) == ERROR_SUCCESS) {
                 // 根据核心类型分类存储频率
                 if (i < largeCores * 2) { // 考虑超线程，每个物理核心有两个逻辑核心
@@ -159,22 +270,27 @@ void CpuInfo::UpdateCoreSpeeds() {
     }
 }
 
+void CpuInfo::SetUsageFilter(const UsageFilterConfig& config) {
+    filterConfig = config;
+    usageFilter = UsageFilter::Create(config);
+    Logger::Debug("CPU使用率平滑方式: " + config.Describe());
+}
+
 double CpuInfo::updateUsage() {
     if (!counterInitialized) {
         Logger::Warn("CPU性能计数器未初始化");
         return cpuUsage;
     }
 
-    // 检查时间间隔，确保两次采样之间有足够间隔
-    static DWORD lastCollectTime = 0;
-    DWORD currentTime = GetTickCount();
-    DWORD delta = currentTime - lastCollectTime;
-    if (delta < 1000) { // 至少1秒间隔
+    // 检查时间间隔，确保两次采样之间有足够间隔（minSampleInterval）
+    // 使用单调高精度时钟：GetTickCount 的 15.6ms 粒度加上调度抖动，会让本应在第 1000ms 的采样
+    // 时而推迟到下一个调用周期，采样间隔在 1000/1250ms 之间跳动
+    const auto currentTime = std::chrono::steady_clock::now();
+    if (lastSampleTime != std::chrono::steady_clock::time_point{} &&
+        currentTime - lastSampleTime < minSampleInterval) {
         return cpuUsage; // 返回上次的值
     }
 
-    lastCollectTime = currentTime;
-
     PDH_STATUS status = PdhCollectQueryData(queryHandle);
     if (status != ERROR_SUCCESS) {
         Logger::Error("无法收集CPU使用率数据，错误代码: " + std::to_string(status));
@@ -192,22 +308,25 @@ double CpuInfo::updateUsage() {
         return cpuUsage;
     }
 
-    // 记录采样间隔
-    prevSampleTick = lastSampleTick;
-    lastSampleTick = currentTime;
-    if (prevSampleTick != 0) {
-        lastSampleIntervalMs = static_cast<double>(lastSampleTick - prevSampleTick);
+    // 记录真实采样间隔：PDH 的使用率正是这两次 PdhCollectQueryData 之间的平均值
+    if (lastSampleTime != std::chrono::steady_clock::time_point{}) {
+        lastSampleIntervalMs = std::chrono::duration<double, std::milli>(currentTime - lastSampleTime).count();
     }
+    lastSampleTime = currentTime;
 
     // 验证数据有效性
     if (counterValue.CStatus == PDH_CSTATUS_VALID_DATA || counterValue.CStatus == PDH_CSTATUS_NEW_DATA) {
         double newUsage = counterValue.doubleValue;
         if (newUsage < 0.0) newUsage = 0.0;
         if (newUsage > 100.0) newUsage = 100.0;
-        if (cpuUsage > 0.0) cpuUsage = (cpuUsage * 0.8) + (newUsage * 0.2); else cpuUsage = newUsage;
-        static int updateCounter = 0;
-        if (++updateCounter % 60 == 0) {
-            Logger::Debug("CPU使用率更新: " + std::to_string(cpuUsage) + "% (采样间隔=" + std::to_string(lastSampleIntervalMs) + "ms)");
+        // 按实际间隔折算平滑权重；首次采样没有上一次的时刻，按最小间隔计
+        const double dtMs = lastSampleIntervalMs > 0.0
+            ? lastSampleIntervalMs : std::chrono::duration<double, std::milli>(minSampleInterval).count();
+        rawUsage = newUsage;
+        cpuUsage = usageFilter->Update(newUsage, dtMs);
+        if (++updateCount % 60 == 0) {
+            Logger::Debug("CPU使用率更新: " + std::to_string(cpuUsage) + "% (原始=" + std::to_string(rawUsage) +
+                "%, 采样间隔=" + std::to_string(lastSampleIntervalMs) + "ms)");
         }
     } else {
         Logger::Warn("CPU使用率数据无效，状态: " + std::to_string(counterValue.CStatus));
@@ -219,8 +338,7 @@ double CpuInfo::GetUsage() {
     double currentUsage = updateUsage();
     
     // 减少调试信息的频率
-    static int debugCounter = 0;
-    if (++debugCounter % 30 == 0) { // 每30次调用记录一次（约30秒）
+    if (++queryCount % 120 == 0) { // 每120次调用记录一次（250ms 采样周期下约30秒）
         Logger::Info("CPU使用率: " + std::to_string(currentUsage) + "%");
     }
     
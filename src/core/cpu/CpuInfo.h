@@ -1,16 +1,26 @@
 ﻿#pragma once
+#include <chrono>
 #include <string>
 #include <windows.h>
 #include <pdh.h>
 #include <queue>
 #include <vector>
+#include "CoreUsage.h"
+#include "UsageFilter.h"
+#include <memory>
 
 class CpuInfo {
 public:
     CpuInfo();
     ~CpuInfo();
 
+    // 平滑后的整体占用率（见 SetUsageFilter）；两次采样不足最小间隔时返回上一次的值
     double GetUsage();
+    // 最近一次采样的原始占用率（未平滑）
+    double GetRawUsage() const { return rawUsage; }
+    // 更换平滑方式（清空已有状态），缺省为时间常数 4480ms 的指数平滑
+    void SetUsageFilter(const UsageFilterConfig& config);
+    const UsageFilterConfig& GetUsageFilter() const { return filterConfig; }
     std::string GetName();
     int GetTotalCores() const;
     int GetSmallCores() const;
@@ -23,9 +33,18 @@ public:
 
     // 新增：获取最近一次 CPU 使用率采样间隔（毫秒）
     double GetLastSampleIntervalMs() const { return lastSampleIntervalMs; }
+    // 两次 PDH 采样之间的最小间隔：应略短于调用周期（自适应采样时随周期调整）
+    void SetMinSampleInterval(std::chrono::milliseconds interval) { minSampleInterval = interval; }
+
+    // 各逻辑处理器的占用率（NtQuerySystemInformationEx 按处理器组读取累计时间后求差，覆盖 64 个以上的处理器）。
+    // 与 GetUsage 相同的最小间隔；首轮或未到间隔时返回 false，usage 保持不变。稳定后不分配
+    bool SampleCores(std::vector<float>& usage);
+    // 各逻辑处理器的核心类型（SharedCoreClass，下标与 SampleCores 一致）
+    const std::vector<uint8_t>& GetCoreClasses() const { return coreClasses; }
 
 private:
     void DetectCores();
+    void DetectCoreClasses();
     void InitializeCounter();
     void CleanupCounter();
     void UpdateCoreSpeeds();             // 新增：更新核心频率
@@ -38,6 +57,11 @@ private:
     int smallCores;
     int largeCores;
     double cpuUsage;
+    double rawUsage = 0.0;
+    UsageFilterConfig filterConfig;
+    std::unique_ptr<UsageFilter> usageFilter = UsageFilter::Create(UsageFilterConfig{});
+    int updateCount = 0;                 // 日志限频（每个实例各自计数）
+    int queryCount = 0;
 
     // 频率信息
     std::vector<DWORD> largeCoresSpeeds; // 性能核心频率
@@ -45,10 +69,17 @@ private:
     DWORD lastUpdateTime;                // 上次更新时间（频率）
 
     // 采样延迟追踪
-    DWORD lastSampleTick = 0;            // 上次成功采样 Tick
-    DWORD prevSampleTick = 0;            // 上一次之前的 Tick
+    // 最小采样间隔：略短于调用周期，调度抖动不会把采样推迟一整个周期
+    std::chrono::milliseconds minSampleInterval{ 950 };
+    std::chrono::steady_clock::time_point lastSampleTime{}; // 上次成功采样时间（单调时钟）
     double lastSampleIntervalMs = 0.0;   // 最近一次采样间隔(毫秒)
 
+    // 逐处理器占用率
+    CoreUsageTracker coreTracker;
+    std::vector<uint8_t> coreClasses;
+    std::vector<unsigned char> coreBuffer;  // SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION[]（复用）
+    std::chrono::steady_clock::time_point lastCoreSampleTime{};
+
     // PDH 计数器相关
     PDH_HQUERY queryHandle;
     PDH_HCOUNTER counterHandle;
@@ -0,0 +1,226 @@
+// UsageFilter.cpp
+#include "UsageFilter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+constexpr double kMinDtMs = 1.0;
+
+double ClampDt(double dtMs) {
+    return dtMs > kMinDtMs ? dtMs : kMinDtMs;
+}
+
+// 解析非负的十进制数（整串）
+bool ParseNumber(const std::string& text, double& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return end == text.c_str() + text.size() && std::isfinite(value) && value >= 0.0;
+}
+
+class RawFilter : public UsageFilter {
+public:
+    double Update(double value, double) override { return value; }
+    void Reset() override {}
+};
+
+// 连续时间一阶低通的离散化：权重 1 - exp(-dt / τ)。
+// 固定权重 α 的 EMA 相当于 τ = -周期 / ln(1 - α)，周期一变等效时间常数也跟着变
+class EmaFilter : public UsageFilter {
+public:
+    explicit EmaFilter(double timeConstantMs) : timeConstantMs(timeConstantMs) {}
+
+    double Update(double value, double dtMs) override {
+        if (!initialized) {
+            state = value;
+            initialized = true;
+            return state;
+        }
+        const double alpha = timeConstantMs > 0.0 ? 1.0 - std::exp(-ClampDt(dtMs) / timeConstantMs) : 1.0;
+        state += alpha * (value - state);
+        return state;
+    }
+
+    void Reset() override { initialized = false; }
+
+private:
+    const double timeConstantMs;
+    double state = 0.0;
+    bool initialized = false;
+};
+
+// 滑动窗口：保留覆盖最近 windowMs 的采样（最老的一个可能部分落在窗口之外，仍完整计入），
+// 每个采样按其间隔加权。采样存放在环形缓冲中，只在窗口内的采样数超过容量时扩容
+class WindowFilter : public UsageFilter {
+public:
+    explicit WindowFilter(double windowMs) : windowMs(windowMs) {}
+
+    double Update(double value, double dtMs) override {
+        Push(value, ClampDt(dtMs));
+        return Evaluate();
+    }
+
+    void Reset() override {
+        head = 0;
+        count = 0;
+        totalDtMs = 0.0;
+    }
+
+protected:
+    struct Sample {
+        double value;
+        double dtMs;
+    };
+
+    virtual double Evaluate() = 0;
+
+    const Sample& At(size_t i) const { return ring[(head + i) % ring.size()]; }
+
+    size_t count = 0;
+    double totalDtMs = 0.0;
+
+private:
+    void Push(double value, double dtMs) {
+        if (count == ring.size()) {
+            // 按时间顺序搬到新缓冲的开头
+            std::vector<Sample> grown(ring.empty() ? 16 : ring.size() * 2);
+            for (size_t i = 0; i < count; ++i) grown[i] = At(i);
+            ring.swap(grown);
+            head = 0;
+        }
+        ring[(head + count) % ring.size()] = Sample{ value, dtMs };
+        ++count;
+        totalDtMs += dtMs;
+        // 去掉之后其余采样仍能覆盖整个窗口的最老采样
+        while (count > 1 && totalDtMs - ring[head].dtMs >= windowMs) {
+            totalDtMs -= ring[head].dtMs;
+            head = (head + 1) % ring.size();
+            --count;
+        }
+    }
+
+    const double windowMs;
+    std::vector<Sample> ring;
+    size_t head = 0;
+};
+
+class WindowMeanFilter : public WindowFilter {
+public:
+    using WindowFilter::WindowFilter;
+
+protected:
+    double Evaluate() override {
+        // 逐个求和而非增量维护，避免长时间运行后的舍入累积；窗口内通常只有几十个采样
+        double weighted = 0.0, total = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            weighted += At(i).value * At(i).dtMs;
+            total += At(i).dtMs;
+        }
+        return total > 0.0 ? weighted / total : 0.0;
+    }
+};
+
+// 时间加权百分位：按值排序后累计间隔，取累计达到 percentile% 的采样值
+class WindowPercentileFilter : public WindowFilter {
+public:
+    WindowPercentileFilter(double windowMs, double percentile) : WindowFilter(windowMs), percentile(percentile) {}
+
+protected:
+    double Evaluate() override {
+        if (percentile >= 100.0) {
+            double maximum = At(0).value;
+            for (size_t i = 1; i < count; ++i) maximum = (std::max)(maximum, At(i).value);
+            return maximum;
+        }
+        sorted.clear();
+        for (size_t i = 0; i < count; ++i) sorted.push_back(At(i));
+        std::sort(sorted.begin(), sorted.end(), [](const Sample& a, const Sample& b) { return a.value < b.value; });
+        double total = 0.0;
+        for (const Sample& sample : sorted) total += sample.dtMs;
+        const double target = total * percentile / 100.0;
+        double seen = 0.0;
+        for (const Sample& sample : sorted) {
+            seen += sample.dtMs;
+            if (seen >= target) return sample.value;
+        }
+        return sorted.back().value;
+    }
+
+private:
+    const double percentile;
+    std::vector<Sample> sorted;     // 排序用的暂存（复用）
+};
+
+} // namespace
+
+bool UsageFilterConfig::Parse(const std::string& text, UsageFilterConfig& config) {
+    UsageFilterConfig parsed = config;
+    const size_t colon = text.find(':');
+    const std::string name = text.substr(0, colon);
+    const bool hasValue = colon != std::string::npos;
+    double value = 0.0;
+    if (hasValue && (!ParseNumber(text.substr(colon + 1), value) || value <= 0.0)) return false;
+
+    if (name == "raw") {
+        if (hasValue) return false;
+        parsed.kind = Kind::Raw;
+    }
+    else if (name == "ema" || name == "mean" || name == "max") {
+        parsed.kind = name == "ema" ? Kind::Ema : name == "mean" ? Kind::WindowMean : Kind::WindowPercentile;
+        if (name == "max") parsed.percentile = 100.0;
+        if (hasValue) parsed.periodMs = value;
+    }
+    else if (name.size() > 1 && name[0] == 'p') {
+        double percentile = 0.0;
+        if (!ParseNumber(name.substr(1), percentile) || percentile <= 0.0 || percentile > 100.0) return false;
+        parsed.kind = Kind::WindowPercentile;
+        parsed.percentile = percentile;
+        if (hasValue) parsed.periodMs = value;
+    }
+    else {
+        return false;
+    }
+    config = parsed;
+    return true;
+}
+
+std::string UsageFilterConfig::Describe() const {
+    char text[64];
+    switch (kind) {
+    case Kind::Raw: return "raw";
+    case Kind::Ema: snprintf(text, sizeof(text), "ema:%g", periodMs); break;
+    case Kind::WindowMean: snprintf(text, sizeof(text), "mean:%g", periodMs); break;
+    case Kind::WindowPercentile:
+        if (percentile >= 100.0) snprintf(text, sizeof(text), "max:%g", periodMs);
+        else snprintf(text, sizeof(text), "p%g:%g", percentile, periodMs);
+        break;
+    }
+    return text;
+}
+
+SharedUsageFilter UsageFilterConfig::ToShared() const {
+    SharedUsageFilter shared{};
+    switch (kind) {
+    case Kind::Raw: shared.kind = SHM_FILTER_RAW; break;
+    case Kind::Ema: shared.kind = SHM_FILTER_EMA; break;
+    case Kind::WindowMean: shared.kind = SHM_FILTER_WINDOW_MEAN; break;
+    case Kind::WindowPercentile: shared.kind = SHM_FILTER_WINDOW_PERCENTILE; break;
+    }
+    shared.percentile = kind == Kind::WindowPercentile ? static_cast<float>(percentile) : 0.0f;
+    shared.periodMs = kind == Kind::Raw ? 0.0 : periodMs;
+    return shared;
+}
+
+std::unique_ptr<UsageFilter> UsageFilter::Create(const UsageFilterConfig& config) {
+    switch (config.kind) {
+    case UsageFilterConfig::Kind::Raw: return std::make_unique<RawFilter>();
+    case UsageFilterConfig::Kind::Ema: return std::make_unique<EmaFilter>(config.periodMs);
+    case UsageFilterConfig::Kind::WindowMean: return std::make_unique<WindowMeanFilter>(config.periodMs);
+    case UsageFilterConfig::Kind::WindowPercentile:
+        return std::make_unique<WindowPercentileFilter>(config.periodMs, config.percentile);
+    }
+    return std::make_unique<RawFilter>();
+}
@@ -0,0 +1,43 @@
+// UsageFilter.h
+#pragma once
+#include "../DataStruct/DataStruct.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 占用率平滑的配置：命令行 --cpu-filter=raw | ema:<时间常数ms> | mean:<窗口ms> | max:<窗口ms> | p<百分位>:<窗口ms>
+struct UsageFilterConfig {
+    enum class Kind {
+        Raw,            // 不平滑
+        Ema,            // 指数平滑，按实际采样间隔折算权重
+        WindowMean,     // 最近 windowMs 内的时间加权平均
+        WindowPercentile, // 最近 windowMs 内的时间加权百分位（percentile = 100 即窗口最大值）
+    };
+
+    Kind kind = Kind::Ema;
+    // 时间常数（Ema）或窗口长度（WindowMean / WindowPercentile）。
+    // 缺省 4480ms：1 秒采样时与旧的固定权重 0.8 * 旧值 + 0.2 * 新值相同（-1s / ln 0.8）
+    double periodMs = 4480.0;
+    double percentile = 100.0;
+
+    // 解析失败时返回 false，config 不变
+    static bool Parse(const std::string& text, UsageFilterConfig& config);
+    // 与 Parse 的格式相同，用于日志
+    std::string Describe() const;
+    // 随占用率一起发布，读端据此解释 cpuUsage
+    SharedUsageFilter ToShared() const;
+};
+
+// 占用率平滑级：每个采样值是过去 dtMs 内的平均占用率，各实现按 dtMs 折算权重，
+// 采样周期变化（自适应采样、调度抖动）时平滑程度不变。稳态下 Update 不分配
+class UsageFilter {
+public:
+    virtual ~UsageFilter() = default;
+
+    // 加入一个采样并返回平滑后的值；dtMs <= 0（间隔未知，如首次采样）时按 1ms 计
+    virtual double Update(double value, double dtMs) = 0;
+    virtual void Reset() = 0;
+
+    static std::unique_ptr<UsageFilter> Create(const UsageFilterConfig& config);
+};
@@ -0,0 +1,78 @@
+﻿// SmartCatalog.cpp
+#include "SmartCatalog.h"
+#include "../DataStruct/DataStruct.h"
+
+namespace {
+
+// 按 ID 升序排列；关键属性与常见 SMART 工具的判定一致
+const SmartCatalog::Entry kEntries[] = {
+    { 0x01, false, L"读取错误率", L"读取磁盘表面数据时发生的硬件读取错误的比率", L"" },
+    { 0x02, false, L"吞吐性能", L"硬盘整体吞吐性能", L"" },
+    { 0x03, false, L"主轴起旋时间", L"主轴从静止加速到工作转速所需的平均时间", L"ms" },
+    { 0x04, false, L"启停计数", L"主轴启动 / 停止的次数", L"次" },
+    { 0x05, true,  L"重新分配扇区计数", L"已被重新映射到备用区的坏扇区数量", L"个" },
+    { 0x07, false, L"寻道错误率", L"磁头寻道时发生错误的比率", L"" },
+    { 0x08, false, L"寻道性能", L"磁头寻道的平均性能", L"" },
+    { 0x09, false, L"通电时间", L"设备处于通电状态的累计时间", L"小时" },
+    { 0x0A, true,  L"主轴起旋重试计数", L"主轴未能在一次尝试内达到工作转速的次数", L"次" },
+    { 0x0B, false, L"校准重试计数", L"磁头校准的重试次数", L"次" },
+    { 0x0C, false, L"通电周期计数", L"设备完整通电 / 断电的次数", L"次" },
+    { 0x0D, false, L"软读取错误率", L"读取时发生但已被纠正的错误比率", L"" },
+    { 0xAA, false, L"可用备用块", L"SSD 剩余可用的备用块比例", L"%" },
+    { 0xAB, false, L"编程失败计数", L"SSD 闪存编程失败的次数", L"次" },
+    { 0xAC, false, L"擦除失败计数", L"SSD 闪存擦除失败的次数", L"次" },
+    { 0xAD, false, L"平均擦写次数", L"SSD 闪存块的平均擦写次数（磨损均衡）", L"次" },
+    { 0xAE, false, L"意外断电计数", L"未经正常关机流程的断电次数", L"次" },
+    { 0xB1, false, L"磨损均衡计数", L"SSD 磨损均衡操作的次数", L"次" },
+    { 0xB4, false, L"未使用的备用块", L"尚未使用的备用块总数", L"个" },
+    { 0xB7, false, L"SATA 降速错误计数", L"接口因错误降速的次数", L"次" },
+    { 0xB8, true,  L"端到端错误", L"数据在缓存与介质之间传输时的奇偶校验错误", L"次" },
+    { 0xBB, true,  L"无法纠正错误计数", L"ECC 无法纠正的错误数量", L"个" },
+    { 0xBC, true,  L"命令超时", L"因超时而中止的操作次数", L"次" },
+    { 0xBD, false, L"高飞写入", L"磁头飞行高度超出正常范围时的写入次数", L"次" },
+    { 0xBE, false, L"气流温度", L"硬盘内部气流温度", L"°C" },
+    { 0xBF, false, L"加速度错误率", L"因外部冲击或振动导致的错误次数", L"次" },
+    { 0xC0, false, L"断电磁头收回计数", L"断电或紧急收回磁头的次数", L"次" },
+    { 0xC1, false, L"磁头加载 / 卸载计数", L"磁头进入停泊区的循环次数", L"次" },
+    { 0xC2, false, L"温度", L"当前设备温度", L"°C" },
+    { 0xC3, false, L"硬件 ECC 恢复", L"由硬件 ECC 即时纠正的错误次数", L"次" },
+    { 0xC4, true,  L"重新分配事件计数", L"重新映射操作的总次数", L"次" },
+    { 0xC5, true,  L"当前待处理扇区", L"等待重新映射的不稳定扇区数量", L"个" },
+    { 0xC6, true,  L"无法修正的扇区计数", L"离线扫描中发现的无法纠正的扇区数量", L"个" },
+    { 0xC7, false, L"UltraDMA CRC 错误计数", L"接口传输中的 CRC 错误次数（通常与数据线有关）", L"次" },
+    { 0xC8, false, L"写入错误率", L"写入数据时发生错误的比率", L"" },
+    { 0xCA, false, L"数据地址标记错误", L"数据地址标记错误的次数", L"次" },
+    { 0xDC, false, L"盘片偏移", L"盘片相对主轴的偏移距离", L"" },
+    { 0xDF, false, L"加载重试计数", L"磁头加载重试的次数", L"次" },
+    { 0xE1, false, L"加载 / 卸载周期计数", L"磁头加载到盘片的循环次数", L"次" },
+    { 0xE7, false, L"剩余寿命", L"SSD 剩余寿命百分比", L"%" },
+    { 0xE8, false, L"可用预留空间", L"SSD 剩余预留空间百分比", L"%" },
+    { 0xE9, false, L"介质磨损指示", L"SSD 闪存的磨损程度", L"" },
+    { 0xF0, false, L"磁头飞行时间", L"磁头处于工作位置的累计时间", L"小时" },
+    { 0xF1, false, L"总写入量", L"主机写入的逻辑块总数", L"LBA" },
+    { 0xF2, false, L"总读取量", L"主机读取的逻辑块总数", L"LBA" },
+};
+constexpr size_t kEntryCount = sizeof(kEntries) / sizeof(kEntries[0]);
+static_assert(kEntryCount <= SHM_SMART_CATALOG_CAPACITY, "SMART 目录超出共享内存容量");
+
+} // namespace
+
+const SmartCatalog::Entry* SmartCatalog::Entries() {
+    return kEntries;
+}
+
+size_t SmartCatalog::Count() {
+    return kEntryCount;
+}
+
+uint16_t SmartCatalog::IndexOf(uint8_t id) {
+    // 目录按 ID 升序，二分查找
+    size_t lo = 0;
+    size_t hi = kEntryCount;
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (kEntries[mid].id < id) lo = mid + 1;
+        else hi = mid;
+    }
+    return (lo < kEntryCount && kEntries[lo].id == id) ? static_cast<uint16_t>(lo) : SHM_SMART_CATALOG_NONE;
+}
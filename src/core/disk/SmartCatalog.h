@@ -0,0 +1,22 @@
+﻿// SmartCatalog.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// SMART 属性目录：ATA 标准属性 ID 对应的名称 / 描述 / 单位
+// 共享内存只为每个属性保存数值与目录下标，文本由写端初始化时一次性发布（SharedSmartCatalog）
+class SmartCatalog {
+public:
+    struct Entry {
+        uint8_t id;
+        bool critical;
+        const wchar_t* name;
+        const wchar_t* description;
+        const wchar_t* units;
+    };
+
+    static const Entry* Entries();
+    static size_t Count();
+    // 按属性 ID 查目录下标，未收录时返回 SHM_SMART_CATALOG_NONE（0xFFFF）
+    static uint16_t IndexOf(uint8_t id);
+};
@@ -12,6 +12,7 @@
 bool TemperatureWrapper::initialized = false;
 static GpuInfo* gpuInfo = nullptr;
 static WmiManager* wmiManager = nullptr;
+static bool ownsWmiManager = false;     // wmiManager 是否由本类创建（复用的共享连接不在 Cleanup 中释放）
 static int temperatureCallCount = 0; // 添加调用计数器
 
 // 输出真实GPU名称列表（过滤虚拟GPU）- 只在详细日志时显示
@@ -36,12 +37,15 @@ static void LogRealGpuNames(const std::vector<GpuInfo::GpuData>& gpus, bool isDe
     }
 }
 
-void TemperatureWrapper::Initialize() {
+void TemperatureWrapper::Initialize(WmiManager* sharedWmi) {
     try {
         LibreHardwareMonitorBridge::Initialize();
         initialized = true;
         // 初始化GpuInfo
-        if (!wmiManager) wmiManager = new WmiManager();
+        if (!wmiManager) {
+            ownsWmiManager = sharedWmi == nullptr;
+            wmiManager = sharedWmi ? sharedWmi : new WmiManager();
+        }
         if (!gpuInfo && wmiManager && wmiManager->IsInitialized()) {
             gpuInfo = new GpuInfo(*wmiManager);
             Logger::Debug("TemperatureWrapper: GpuInfo初始化成功");
@@ -62,34 +66,37 @@ void TemperatureWrapper::Cleanup() {
         initialized = false;
     }
     if (gpuInfo) { delete gpuInfo; gpuInfo = nullptr; }
-    if (wmiManager) { delete wmiManager; wmiManager = nullptr; }
+    if (wmiManager) {
+        if (ownsWmiManager) delete wmiManager;
+        wmiManager = nullptr;
+        ownsWmiManager = false;
+    }
 }
 
-std::vector<std::pair<std::string, double>> TemperatureWrapper::GetTemperatures() {
-    std::vector<std::pair<std::string, double>> temps;
-    
+size_t TemperatureWrapper::GetTemperatures(std::vector<std::pair<std::string, double>>& temps) {
     // 增加调用计数器
     temperatureCallCount++;
     
-    // 只在每5次调用时显示详细日志（与主循环的详细日志周期同步）
-    bool isDetailedLogging = (temperatureCallCount % 5 == 1);
+    // 只在每5次调用时显示详细日志（与主循环的详细日志周期同步）；调试日志被过滤时不拼接消息
+    bool isDetailedLogging = (temperatureCallCount % 5 == 1) && Logger::IsEnabled(LOG_DEBUG);
     
-    // 1. 先获取libre的
+    // 1. 先获取libre的（桥接原地改写 temps 的前 count 个元素）
+    size_t count = 0;
     if (initialized) {
         try {
-            auto libreTemps = LibreHardwareMonitorBridge::GetTemperatures();
+            count = LibreHardwareMonitorBridge::GetTemperatures(temps);
             if (isDetailedLogging) {
-                Logger::Debug("TemperatureWrapper: 从libre获取温度传感器数量: " + std::to_string(libreTemps.size()));
+                Logger::Debug("TemperatureWrapper: 从libre获取温度传感器数量: " + std::to_string(count));
             }
-            temps.insert(temps.end(), libreTemps.begin(), libreTemps.end());
         } catch (...) {
+            count = 0;
             if (isDetailedLogging) {
                 Logger::Warn("TemperatureWrapper: 获取libre温度异常");
             }
         }
     }
     
-    // 2. 再获取GpuInfo的（过滤虚拟GPU）
+    // 2. 再获取GpuInfo的（过滤虚拟GPU），名称逐字符写入已有元素，不构造临时字符串
     if (gpuInfo) {
         const auto& gpus = gpuInfo->GetGpuData();
         if (isDetailedLogging) {
@@ -104,26 +111,32 @@ std::vector<std::pair<std::string, double>> TemperatureWrapper::GetTemperatures(
                 }
                 continue;
             }
-            std::string gpuName(gpu.name.begin(), gpu.name.end());
+            if (count == temps.size()) temps.emplace_back();
+            std::string& name = temps[count].first;
+            name.clear();
+            name += "GPU: ";
+            for (wchar_t c : gpu.name) name.push_back(static_cast<char>(c));
+            temps[count].second = static_cast<double>(gpu.temperature);
+            ++count;
             if (isDetailedLogging) {
-                Logger::Debug("TemperatureWrapper: GpuInfo检测到GPU: " + gpuName + ", 温度: " + std::to_string(gpu.temperature));
+                Logger::Debug("TemperatureWrapper: GpuInfo检测到GPU: " + name + ", 温度: " + std::to_string(gpu.temperature));
             }
-            temps.emplace_back("GPU: " + gpuName, static_cast<double>(gpu.temperature));
         }
     } else {
         if (isDetailedLogging) {
             Logger::Warn("TemperatureWrapper: GpuInfo未初始化");
         }
     }
+    temps.resize(count);
     
     if (isDetailedLogging) {
-        Logger::Debug("TemperatureWrapper: 总温度数量: " + std::to_string(temps.size()));
+        Logger::Debug("TemperatureWrapper: 总温度数量: " + std::to_string(count));
     }
     
     // 防止计数器溢出
     if (temperatureCallCount >= 100) temperatureCallCount = 0;
     
-    return temps;
+    return count;
 }
 
 bool TemperatureWrapper::IsInitialized() {
@@ -5,12 +5,16 @@
 #include <utility>
 #include "../gpu/GpuInfo.h"
 
+class WmiManager;
+
 // 本机C++包装器类，用于调用托管的LibreHardwareMonitorBridge
 class TemperatureWrapper {
 public:
-    static void Initialize();
+    // sharedWmi 非空时复用主程序的 WMI 连接（须比本类活得更久），否则自行创建一个
+    static void Initialize(WmiManager* sharedWmi = nullptr);
     static void Cleanup();
-    static std::vector<std::pair<std::string, double>> GetTemperatures();
+    // 读取全部温度（硬件监控桥接 + 非虚拟 GPU）到 temps，原地改写已有元素，返回读数个数
+    static size_t GetTemperatures(std::vector<std::pair<std::string, double>>& temps);
     static bool IsInitialized();
 
 private:
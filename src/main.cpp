@@ -19,6 +19,8 @@
 
 // 然后包含标准库头文件
 #include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -28,6 +30,7 @@
 #include <fcntl.h>
 #include <algorithm> // Include for std::transform
 #include <vector> // Include for std::vector
+#include <set>
 #include <mutex>     // 添加线程同步支持
 #include <atomic>    // 添加原子操作支持
 #include <locale>   // 添加locale支持以使用setlocale
@@ -35,19 +38,24 @@
 #include <stdexcept> // 添加标准异常支持
 
 // 最后包含项目头文件
-#include "core/cpu/CpuInfo.h"
-#include "core/gpu/GpuInfo.h"
-#include "core/memory/MemoryInfo.h"
-#include "core/network/NetworkAdapter.h"
 #include "core/os/OSInfo.h"
 #include "core/utils/Logger.h"
 #include "core/utils/TimeUtils.h"
 #include "core/utils/WinUtils.h"
 #include "core/utils/WmiManager.h"
-#include "core/disk/DiskInfo.h"
 #include "core/DataStruct/DataStruct.h"
 #include "core/DataStruct/SharedMemoryManager.h"  // Include the new shared memory manager
-#include "core/temperature/TemperatureWrapper.h"  // 使用TemperatureWrapper而不是直接调用LibreHardwareMonitorBridge
+#include "core/DataStruct/SharedMemorySections.h"
+#include "core/DataStruct/SnapshotWriter.h"
+#include "core/collector/AdaptiveSampler.h"
+#include "core/collector/CollectorInitializer.h"
+#include "core/collector/CollectorRegistry.h"
+#include "core/collector/CollectorScheduler.h"
+#include "core/collector/DeviceChangeMonitor.h"
+#include "core/collector/OverheadMonitor.h"
+#include "core/temperature/TemperatureWrapper.h"
+#include "core/utils/AllocationCounter.h"  // 使用TemperatureWrapper而不是直接调用LibreHardwareMonitorBridge
+#include "core/utils/StartupTimer.h"
 
 #pragma comment(lib, "kernel32.lib")
 #pragma comment(lib, "user32.lib")
@@ -272,14 +280,6 @@ std::string TranslateHardwareName(const std::string& name) {
     return name;
 }
 
-// 品牌判断
-std::string GetGpuBrand(const std::wstring& name) {
-    if (name.find(L"NVIDIA") != std::wstring::npos) return "NVIDIA";
-    if (name.find(L"AMD") != std::wstring::npos) return "AMD";
-    if (name.find(L"Intel") != std::wstring::npos) return "Intel";
-    return "未知";
-}
-
 // 网络速度单位
 std::string FormatNetworkSpeed(double speedBps) {
     std::stringstream ss;
@@ -500,93 +500,417 @@ bool IsRunAsAdmin() {
     return isAdmin == TRUE;
 }
 
-// 线程安全的GPU信息缓存类
-class ThreadSafeGpuCache {
-private:
-    mutable std::mutex mtx_;
-    bool initialized_ = false;
-    std::string cachedGpuName_ = "未检测到GPU";
-    std::string cachedGpuBrand_ = "未知";
-    uint64_t cachedGpuMemory_ = 0;
-    uint32_t cachedGpuCoreFreq_ = 0;
-    bool cachedGpuIsVirtual_ = false;
+// 解析 --sections=cpu,load,...：本进程发布的共享内存分区（名称见 SharedMemorySections），缺省为全部分区
+// 例如非提升权限的进程使用 --sections=cpu,load,gpu,adapters,disks，
+// 提升权限的辅助进程使用 --sections=smart,temperatures,sensors，两者各自采集、独立发布
+bool ParseSectionMask(int argc, char* argv[], uint32_t& mask) {
+    mask = SHM_ALL_SECTIONS;
+    const std::string prefix = "--sections=";
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix) != 0) continue;
+        mask = 0;
+        std::stringstream names(arg.substr(prefix.size()));
+        std::string name;
+        while (std::getline(names, name, ',')) {
+            int section = 0;
+            while (section < SHM_SECTION_COUNT && name != SharedMemorySections::Get(section).name) ++section;
+            if (section == SHM_SECTION_COUNT) {
+                Logger::Error("未知的共享内存分区: " + name);
+                return false;
+            }
+            mask |= 1u << section;
+        }
+    }
+    return mask != 0;
+}
 
-public:
-    void Initialize(WmiManager& wmiManager) {
-        std::lock_guard<std::mutex> lock(mtx_);
-        if (initialized_) return;
-        
+// 解析 --cpu-ceiling=90：主机 CPU 占用率持续高于该值（%）时暂停昂贵的数据源（SMART、WMI 清单、温度传感器），0 表示不减载
+bool ParseCpuCeiling(int argc, char* argv[], double& ceiling) {
+    const std::string prefix = "--cpu-ceiling=";
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix) != 0) continue;
         try {
-            Logger::Info("正在初始化GPU信息");
-            
-            GpuInfo gpuInfo(wmiManager);
-            const auto& gpus = gpuInfo.GetGpuData();
-            
-            // 记录所有检测到的GPU
-            for (const auto& gpu : gpus) {
-                std::string gpuName = WinUtils::WstringToString(gpu.name);
-                Logger::Info("检测到GPU: " + gpuName + 
-                           " (虚拟: " + (gpu.isVirtual ? "是" : "否") + 
-                           ", NVIDIA: " + (gpuName.find("NVIDIA") != std::string::npos ? "是" : "否") + 
-                           ", 集成: " + (gpuName.find("Intel") != std::string::npos ||
-                                       gpuName.find("AMD") != std::string::npos ? "是" : "否") + ")");
+            size_t used = 0;
+            ceiling = std::stod(arg.substr(prefix.size()), &used);
+            if (used != arg.size() - prefix.size()) return false;
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+    }
+    return ceiling >= 0.0 && ceiling <= 100.0;
+}
+
+// 解析 --cpu-filter=ema:4480：整体 CPU 占用率的平滑方式（raw | ema:<时间常数ms> | mean:<窗口ms> | max:<窗口ms> | p<百分位>:<窗口ms>），
+// 平滑按实际采样间隔加权，与采样周期无关；原始值与平滑后的值同时发布
+bool ParseCpuFilter(int argc, char* argv[], UsageFilterConfig& config) {
+    const std::string prefix = "--cpu-filter=";
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix) != 0) continue;
+        if (!UsageFilterConfig::Parse(arg.substr(prefix.size()), config)) return false;
+    }
+    return true;
+}
+
+// 解析 --disable=sensors,gpu：不创建这些数据源（名称见 CollectorRegistry::Names），对应分区保持为初始值
+bool ParseDisabledCollectors(int argc, char* argv[], std::set<std::string>& disabled) {
+    const std::string prefix = "--disable=";
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix) != 0) continue;
+        std::stringstream names(arg.substr(prefix.size()));
+        std::string name;
+        while (std::getline(names, name, ',')) {
+            if (!CollectorRegistry::Contains(name)) {
+                Logger::Error("未知的数据源: " + name);
+                return false;
             }
-            
-            // 优先选择非虚拟GPU
-            const GpuInfo::GpuData* selectedGpu = nullptr;
-            for (const auto& gpu : gpus) {
-                if (!gpu.isVirtual) {
-                    selectedGpu = &gpu;
-                    break;
+            disabled.insert(name);
+        }
+    }
+    return true;
+}
+
+// 是否给出了不带值的开关参数（如 --check-allocations）
+bool HasFlag(int argc, char* argv[], const char* flag) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], flag) == 0) return true;
+    }
+    return false;
+}
+
+// 只有 SMART 与温度传感器需要管理员权限；不发布这些分区的进程无需提权
+const uint32_t kPrivilegedSections = (1u << SHM_SECTION_SMART) | (1u << SHM_SECTION_TEMPERATURES) | (1u << SHM_SECTION_SENSORS);
+
+// 无界面模式参数（--once 或 --count=N 时开启）
+struct HeadlessOptions {
+    bool enabled = false;
+    int count = 1;                                      // 快照份数
+    std::chrono::milliseconds interval{ 1000 };         // 相邻快照的间隔
+    std::chrono::milliseconds timeout{ 10000 };         // 第一份快照等待各数据源首次完成的上限
+    SnapshotWriter::Format format = SnapshotWriter::Format::Json;
+    std::string output;                                 // 输出文件，空为标准输出
+    std::set<std::string> collectors;                   // 只创建这些数据源，空为全部
+};
+
+// 解析 [minimum, maximum] 范围内的整数
+bool ParseBoundedInteger(const std::string& text, long long minimum, long long maximum, long long& value) {
+    try {
+        size_t used = 0;
+        value = std::stoll(text, &used);
+        return used == text.size() && value >= minimum && value <= maximum;
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+}
+
+// 第 index 个命令行参数的 UTF-8 文本：argv 按 ANSI 代码页编码，其中不可表示的字符（如非 ASCII 路径）已丢失，
+// 因此从宽字符命令行重新取出。两者参数个数不一致时退回 argv 中的文本
+std::string CommandLineArgumentUtf8(int argc, char* argv[], int index) {
+    int wideCount = 0;
+    LPWSTR* wideArgv = CommandLineToArgvW(GetCommandLineW(), &wideCount);
+    if (!wideArgv) return argv[index];
+    std::string argument = wideCount == argc ? WinUtils::WstringToUtf8(wideArgv[index]) : std::string(argv[index]);
+    LocalFree(wideArgv);
+    return argument;
+}
+
+// 解析无界面模式参数：
+//   --once / --count=N        采集 1 / N 份快照后退出
+//   --interval=ms             相邻快照的间隔（默认 1000）
+//   --format=json|binary      输出格式（默认 json，每份快照一行；binary 见 SnapshotRecordHeader，与 json 一样含完整设备列表）
+//   --output=path             输出文件（默认标准输出）
+//   --collectors=cpu,memory   只创建并初始化这些数据源（名称见 CollectorRegistry::Names）
+//   --timeout=ms              第一份快照等待各数据源首次完成的上限（默认 10000）
+bool ParseHeadlessOptions(int argc, char* argv[], HeadlessOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        std::string value;
+        const auto option = [&](const char* prefix) {
+            const size_t length = strlen(prefix);
+            if (arg.compare(0, length, prefix) != 0) return false;
+            value = arg.substr(length);
+            return true;
+        };
+        long long number = 0;
+        if (arg == "--once") {
+            options.enabled = true;
+            options.count = 1;
+        }
+        else if (option("--count=")) {
+            if (!ParseBoundedInteger(value, 1, 1000000, number)) {
+                Logger::Error("--count 参数无效: " + value);
+                return false;
+            }
+            options.enabled = true;
+            options.count = static_cast<int>(number);
+        }
+        else if (option("--interval=")) {
+            if (!ParseBoundedInteger(value, 0, 24LL * 3600 * 1000, number)) {
+                Logger::Error("--interval 参数无效: " + value);
+                return false;
+            }
+            options.interval = std::chrono::milliseconds(number);
+        }
+        else if (option("--timeout=")) {
+            if (!ParseBoundedInteger(value, 0, 10LL * 60 * 1000, number)) {
+                Logger::Error("--timeout 参数无效: " + value);
+                return false;
+            }
+            options.timeout = std::chrono::milliseconds(number);
+        }
+        else if (option("--format=")) {
+            if (!SnapshotWriter::ParseFormat(value, options.format)) {
+                Logger::Error("--format 参数无效（可用 json / binary）: " + value);
+                return false;
+            }
+        }
+        else if (option("--output=")) {
+            // 路径按 UTF-8 保存（SnapshotWriter::Open 再转为宽字符打开）
+            const std::string wide = CommandLineArgumentUtf8(argc, argv, i);
+            options.output = wide.compare(0, strlen("--output="), "--output=") == 0 ? wide.substr(strlen("--output=")) : value;
+        }
+        else if (option("--collectors=")) {
+            std::stringstream names(value);
+            std::string name;
+            while (std::getline(names, name, ',')) {
+                if (!CollectorRegistry::Contains(name)) {
+                    Logger::Error("未知的数据源: " + name);
+                    return false;
                 }
+                options.collectors.insert(name);
             }
-            
-            // 如果没有非虚拟GPU，选择第一个GPU
-            if (!selectedGpu && !gpus.empty()) {
-                selectedGpu = &gpus[0];
+            if (options.collectors.empty()) return false;
+        }
+    }
+    return true;
+}
+
+// 初始化本线程的 COM（多线程模式，冲突时退回单线程模式）
+bool InitializeCom() {
+    try {
+        HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        if (FAILED(hr)) {
+            if (hr == RPC_E_CHANGED_MODE) {
+                Logger::Warn("COM初始化模式冲突: 线程已初始化为不同的模式，尝试单线程模式");
+                // 尝试单线程模式
+                hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
+                if (FAILED(hr)) {
+                    Logger::Error("COM初始化失败: 0x" + std::to_string(hr));
+                    return false;
+                }
             }
-            
-            if (selectedGpu) {
-                cachedGpuName_ = WinUtils::WstringToString(selectedGpu->name);
-                cachedGpuBrand_ = GetGpuBrand(selectedGpu->name);
-                cachedGpuMemory_ = selectedGpu->dedicatedMemory;
-                cachedGpuCoreFreq_ = static_cast<uint32_t>(selectedGpu->coreClock);
-                cachedGpuIsVirtual_ = selectedGpu->isVirtual;
-                
-                Logger::Info("选择主GPU: " + cachedGpuName_ + 
-                           " (虚拟: " + (cachedGpuIsVirtual_ ? "是" : "否") + ")");
-            } else {
-                Logger::Warn("未检测到任何GPU");
+            else {
+                Logger::Error("COM初始化失败: 0x" + std::to_string(hr));
+                return false;
+            }
+        }
+        g_comInitialized = true;
+        Logger::Debug("COM初始化成功");
+        return true;
+    }
+    catch (const std::exception& e) {
+        Logger::Error("COM初始化过程中发生异常: " + std::string(e.what()));
+        return false;
+    }
+}
+
+// 共享的 WMI 连接：第一次有数据源需要时才连接（可能在后台初始化线程上，多个线程同时请求时只连接一次），
+// 连接耗时记为一个启动阶段。连接失败时返回 nullptr，依赖 WMI 的数据源自行降级；须比数据源活得更久
+class SharedWmi {
+public:
+    explicit SharedWmi(StartupTimer& timer) : timer(timer) {}
+
+    WmiManager* Get() {
+        std::call_once(once, [this] { Connect(); });
+        return manager.get();
+    }
+
+private:
+    void Connect() {
+        const StartupTimer::Clock::time_point begin = StartupTimer::Clock::now();
+        try {
+            manager = std::make_unique<WmiManager>();
+            if (!manager->IsInitialized()) {
+                Logger::Error("WMI初始化失败，依赖 WMI 的数据源将不可用");
+                manager.reset();
+            }
+            else {
+                Logger::Debug("WMI管理器初始化成功");
             }
-            
-            initialized_ = true;
-            Logger::Info("GPU信息初始化完成，后续循环将使用缓存信息");
         }
         catch (const std::exception& e) {
-            Logger::Error("GPU信息初始化失败: " + std::string(e.what()));
-            // 保持默认值
-            initialized_ = true; // 标记为已初始化以避免重复尝试
+            Logger::Error("WMI管理器创建失败: " + std::string(e.what()));
+            manager.reset();
         }
+        catch (...) {
+            Logger::Error("WMI管理器创建失败 - 未知异常");
+            manager.reset();
+        }
+        timer.Record("连接 WMI", begin, StartupTimer::Clock::now());
     }
-    
-    void GetCachedInfo(std::string& name, std::string& brand, uint64_t& memory, 
-                       uint32_t& coreFreq, bool& isVirtual) const {
-        std::lock_guard<std::mutex> lock(mtx_);
-        name = cachedGpuName_;
-        brand = cachedGpuBrand_;
-        memory = cachedGpuMemory_;
-        coreFreq = cachedGpuCoreFreq_;
-        isVirtual = cachedGpuIsVirtual_;
+
+    StartupTimer& timer;
+    std::once_flag once;
+    std::unique_ptr<WmiManager> manager;
+};
+
+// 无界面模式：不提权、不创建共享内存，只初始化请求的数据源（需要时才连接 WMI），
+// 按 起点 + k * 间隔 采集 count 份快照写到输出后退出。标准输出只留给快照，日志只写文件，
+// 各启动阶段的耗时写到标准错误与日志。返回进程退出码
+int RunHeadless(const HeadlessOptions& options, uint32_t sectionMask, std::set<std::string> disabled,
+                const UsageFilterConfig& cpuFilter, StartupTimer& timer) {
+    using Clock = CollectorScheduler::Clock;
+    Logger::EnableConsoleOutput(false);
+    Logger::Info("无界面模式: " + std::to_string(options.count) + " 份快照，间隔 " + std::to_string(options.interval.count()) + "ms");
+    const auto fail = [](const std::string& message) {
+        Logger::Critical(message);
+        fprintf(stderr, "%s\n", message.c_str());
+    };
+
+    if ((sectionMask & kPrivilegedSections) != 0 && !IsRunAsAdmin()) {
+        Logger::Warn("无界面模式不会提权：未以管理员身份运行时 SMART 与温度传感器可能为空");
     }
-    
-    bool IsInitialized() const {
-        std::lock_guard<std::mutex> lock(mtx_);
-        return initialized_;
+    if (!options.collectors.empty()) {
+        for (const std::string& name : CollectorRegistry::Names()) {
+            if (!options.collectors.count(name)) disabled.insert(name);
+        }
+    }
+
+    if (!InitializeCom()) {
+        fail("COM初始化失败");
+        return 1;
+    }
+    timer.Mark("初始化 COM");
+
+    // WMI 按需连接：只有请求的数据源中有需要 WMI 的才付出这部分开销
+    SharedWmi sharedWmi(timer);
+    CollectorContext collectorContext;
+    collectorContext.wmi = [&sharedWmi] { return sharedWmi.Get(); };
+    collectorContext.cpuFilter = cpuFilter;
+    const std::vector<std::unique_ptr<ICollector>> collectors =
+        CollectorRegistry::CreateAll(collectorContext, sectionMask, disabled, &timer);
+    timer.Mark("创建数据源");
+    if (collectors.empty()) {
+        fail("无界面模式: 没有可用的数据源（见 --sections / --collectors / --disable）");
+        if (g_comInitialized.exchange(false)) CoUninitialize();
+        return 2;
     }
-}; // 添加缺少的分号
+    // 只输出请求的分区中有数据源负责的部分
+    uint32_t outputSections = 0;
+    for (const auto& collector : collectors) outputSections |= collector->Describe().schedule.sections;
+    outputSections &= sectionMask;
+
+    SystemInfo sysInfo{};
+    int exitCode = 0;
+    {
+        CollectorScheduler scheduler(3, std::chrono::milliseconds(200));
+        CollectorRegistry::Schedule(scheduler, collectors);
+        try {
+            OSInfo os;
+            sysInfo.osVersion = os.GetVersion();
+            for (const auto& collector : collectors) collector->FillStatic(sysInfo);
+        }
+        catch (const std::exception& e) {
+            Logger::Error("系统信息初始化失败: " + std::string(e.what()));
+        }
+        timer.Mark("静态信息");
+
+        SnapshotWriter writer;
+        if (!writer.Open(options.output, options.format)) {
+            fail(writer.GetLastError());
+            exitCode = 1;
+        }
+        const Clock::time_point start = Clock::now();
+        for (int index = 0; exitCode == 0 && index < options.count && !g_shouldExit.load(); ++index) {
+            // 按绝对时刻采集，输出耗时不会累积成漂移
+            const Clock::time_point due = start + options.interval * index;
+            for (Clock::time_point now = Clock::now(); now < due && !g_shouldExit.load(); now = Clock::now()) {
+                std::this_thread::sleep_for((std::min)(std::chrono::duration_cast<Clock::duration>(due - now),
+                                                       std::chrono::duration_cast<Clock::duration>(std::chrono::milliseconds(50))));
+            }
+            const Clock::time_point cycleBegin = Clock::now();
+            scheduler.RunCycle(sysInfo);
+            if (index == 0) {
+                // 第一份快照等所有数据源（含后台的清单类数据源）首次完成，最多到 --timeout；超时的保留初始值
+                const Clock::time_point deadline = cycleBegin + options.timeout;
+                while (scheduler.PendingFirstRuns() > 0 && !g_shouldExit.load() && Clock::now() < deadline) {
+                    if (scheduler.WaitForCompletion((std::min)(deadline, Clock::now() + std::chrono::milliseconds(50)))) {
+                        scheduler.MergeCompleted(sysInfo);
+                    }
+                }
+                const int pending = scheduler.PendingFirstRuns();
+                if (pending > 0) {
+                    Logger::Warn(std::to_string(pending) + " 个数据源未在 " + std::to_string(options.timeout.count()) +
+                                 "ms 内完成首次采集，输出其初始值; 数据源: " + scheduler.Describe());
+                }
+                timer.Record("首次采集", cycleBegin, Clock::now());
+                // 各数据源首次采集的耗时（均在本轮开始时派发）
+                SharedCollectorStatus status[SHM_MAX_COLLECTORS];
+                const int count = scheduler.ExportStatus(status, SHM_MAX_COLLECTORS);
+                for (int i = 0; i < count; ++i) {
+                    if (status[i].runs == 0) continue;
+                    timer.Record("采集 " + std::string(status[i].name), cycleBegin,
+                                 cycleBegin + std::chrono::microseconds(status[i].lastDurationUs));
+                }
+            }
+            else {
+                scheduler.MergeCompleted(sysInfo);
+            }
+
+            const Clock::time_point writeBegin = Clock::now();
+            GetSystemTime(&sysInfo.lastUpdate);
+            if (!writer.Write(sysInfo, outputSections, static_cast<uint32_t>(index), SnapshotWriter::NowUnixMs())) {
+                fail(writer.GetLastError());
+                exitCode = 1;
+            }
+            if (index == 0) timer.Record("输出第一份快照", writeBegin, Clock::now());
+        }
+        writer.Close();
+        // 等待工作线程上的采集结束，再清理它们使用的硬件监控桥接
+        scheduler.Stop();
+    }
+
+    try {
+        TemperatureWrapper::Cleanup();
+    }
+    catch (const std::exception& e) {
+        Logger::Error("清理硬件监控桥接时发生错误: " + std::string(e.what()));
+    }
+    if (g_comInitialized.exchange(false)) CoUninitialize();
+
+    const std::string timing = timer.Describe();
+    Logger::Info(timing);
+    fprintf(stderr, "%s\n", timing.c_str());
+    return exitCode;
+}
+
+// 提权重启时原样转发的参数：原始命令行去掉程序名之后的部分。
+// 不经 argv 重新拼接：argv 是 ANSI 代码页且已去掉引号与转义，重新加引号会破坏内嵌引号与结尾反斜杠（如 --output=C:\out\）。
+// 程序名按 CommandLineToArgvW 的规则划分：以引号开头时到下一个引号为止，否则到第一个空白为止
+std::wstring ArgumentsAfterProgramName(const wchar_t* commandLine) {
+    const wchar_t* p = commandLine;
+    if (*p == L'"') {
+        ++p;
+        while (*p && *p != L'"') ++p;
+        if (*p == L'"') ++p;
+    } else {
+        while (*p && *p != L' ' && *p != L'\t') ++p;
+    }
+    while (*p == L' ' || *p == L'\t') ++p;
+    return p;
+}
 
 // 主函数 - 控制台模式
 int main(int argc, char* argv[]) {
+    // 启动计时从进程创建算起（含运行库与 CLR 的加载），无界面模式输出各阶段耗时
+    StartupTimer startupTimer(StartupTimer::ProcessStart());
+    startupTimer.Mark("进程启动至 main");
+
     // 设置结构化异常处理
     _set_se_translator(SEHTranslator);
     
@@ -618,16 +942,56 @@ int main(int argc, char* argv[]) {
             printf("日志系统初始化失败: %s\n", e.what());
             return 1;
         }
+        startupTimer.Mark("初始化日志");
+
+        uint32_t sectionMask = SHM_ALL_SECTIONS;
+        if (!ParseSectionMask(argc, argv, sectionMask)) {
+            Logger::Critical("--sections 参数无效，可用分区: cpu,load,gpu,adapters,disks,smart,temperatures,sensors");
+            return 1;
+        }
+        std::set<std::string> disabledCollectors;
+        if (!ParseDisabledCollectors(argc, argv, disabledCollectors)) {
+            std::string names;
+            for (const std::string& name : CollectorRegistry::Names()) names += (names.empty() ? "" : ",") + name;
+            Logger::Critical("--disable 参数无效，可用数据源: " + names);
+            return 1;
+        }
+        double cpuCeiling = AdaptiveSampler::Config().cpuCeiling;
+        if (!ParseCpuCeiling(argc, argv, cpuCeiling)) {
+            Logger::Critical("--cpu-ceiling 参数无效，应为 0 到 100 之间的占用率（%），0 表示不减载");
+            return 1;
+        }
+        UsageFilterConfig cpuFilter;
+        if (!ParseCpuFilter(argc, argv, cpuFilter)) {
+            Logger::Critical("--cpu-filter 参数无效，可用: raw | ema:<时间常数ms> | mean:<窗口ms> | max:<窗口ms> | p<百分位>:<窗口ms>");
+            return 1;
+        }
+        // --check-allocations：稳态分配检查（测试钩子）。稳定运行之后，一轮采集与发布（RunCycle + 发布，
+        // 不含调用过日志（含被等级过滤的）或合并了后台清单源的轮次）在主线程或本轮等待的数据源上只要有一次堆分配，就记录错误并以状态 3 退出
+        const bool checkAllocations = HasFlag(argc, argv, "--check-allocations");
+        if (checkAllocations) Logger::Info("已开启稳态分配检查");
+        HeadlessOptions headlessOptions;
+        if (!ParseHeadlessOptions(argc, argv, headlessOptions)) {
+            Logger::Critical("无界面模式参数无效，用法: --once | --count=N [--interval=ms] [--format=json|binary] "
+                             "[--output=path] [--collectors=名称,...] [--timeout=ms]");
+            return 1;
+        }
+        // 无界面模式（单次 / 批量快照）：不提权、不创建共享内存，完成后退出
+        if (headlessOptions.enabled) {
+            return RunHeadless(headlessOptions, sectionMask, disabledCollectors, cpuFilter, startupTimer);
+        }
 
         // 检查管理员权限
-        if (!IsRunAsAdmin()) {
+        if ((sectionMask & kPrivilegedSections) != 0 && !IsRunAsAdmin()) {
             wchar_t szPath[MAX_PATH];
             GetModuleFileNameW(NULL, szPath, MAX_PATH);
+            const std::wstring params = ArgumentsAfterProgramName(GetCommandLineW());
 
             // 以管理员权限重启自身
             SHELLEXECUTEINFOW sei = { sizeof(sei) };
             sei.lpVerb = L"runas";
             sei.lpFile = szPath;
+            sei.lpParameters = params.empty() ? NULL : params.c_str();
             sei.hwnd = NULL;
             sei.nShow = SW_NORMAL;
 
@@ -642,34 +1006,14 @@ int main(int argc, char* argv[]) {
         }
 
         // 安全初始化COM为多线程模式
-        try {
-            HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
-            if (FAILED(hr)) {
-                if (hr == RPC_E_CHANGED_MODE) {
-                    Logger::Warn("COM初始化模式冲突: 线程已初始化为不同的模式，尝试单线程模式");
-                    // 尝试单线程模式
-                    hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
-                    if (FAILED(hr)) {
-                        Logger::Error("COM初始化失败: 0x" + std::to_string(hr));
-                        return -1;
-                    }
-                }
-                else {
-                    Logger::Error("COM初始化失败: 0x" + std::to_string(hr));
-                    return -1;
-                }
-            }
-            g_comInitialized = true;
-            Logger::Debug("COM初始化成功");
-        }
-        catch (const std::exception& e) {
-            Logger::Error("COM初始化过程中发生异常: " + std::string(e.what()));
+        if (!InitializeCom()) {
             return -1;
         }
+        startupTimer.Mark("初始化 COM");
 
         // 初始化共享内存 - 增强错误处理
         try {
-            if (!SharedMemoryManager::InitSharedMemory()) {
+            if (!SharedMemoryManager::InitSharedMemory(sectionMask)) {
                 std::string error = SharedMemoryManager::GetLastError();
                 Logger::Error("共享内存初始化失败: " + error);
                 
@@ -677,7 +1021,7 @@ int main(int argc, char* argv[]) {
                 Logger::Info("尝试重新初始化共享内存...");
                 std::this_thread::sleep_for(std::chrono::milliseconds(1000));
                 
-                if (!SharedMemoryManager::InitSharedMemory()) {
+                if (!SharedMemoryManager::InitSharedMemory(sectionMask)) {
                     Logger::Critical("共享内存重新初始化失败，程序无法继续运行");
                     SafeExit(1);
                 }
@@ -688,634 +1032,333 @@ int main(int argc, char* argv[]) {
             Logger::Error("共享内存初始化过程中发生异常: " + std::string(e.what()));
             SafeExit(1);
         }
+        startupTimer.Mark("初始化共享内存");
+
+        // WMI 在第一个需要它的数据源初始化时才连接（通常在后台初始化线程上），不推迟第一次发布。
+        // 连接失败时依赖 WMI 的数据源不可用，CPU / 内存照常发布
+        SharedWmi sharedWmi(startupTimer);
+        CollectorContext collectorContext;
+        collectorContext.wmi = [&sharedWmi] { return sharedWmi.Get(); };
+        collectorContext.cpuFilter = cpuFilter;
 
-        // 创建WMI管理器并初始化 - 增强内存分配异常处理
-        std::unique_ptr<WmiManager> wmiManager;
+        // 创建本进程发布的分区对应的数据源（见 --sections 与 --disable），各数据源在自己的源文件中登记。
+        // 初始化较慢的数据源（WMI 清单、硬件监控桥接）交给 initializer 在后台初始化，
+        // CPU / 内存不等它们即可发布第一份快照；initializer 在 collectors 之后构造，先于它们析构（等待后台线程结束）
+        std::vector<std::unique_ptr<ICollector>> collectors;
+        CollectorInitializer initializer;
+        collectors = CollectorRegistry::CreateAll(collectorContext, SharedMemoryManager::GetOwnedSections(), disabledCollectors,
+                                                  &startupTimer, &initializer);
+        startupTimer.Mark("创建数据源");
+
+        // 注册数据源：周期按数据的变化频率设定，同时到期时按优先级派发到工作线程
+        // CPU / 内存 / 温度每轮等待（最多到截止时间）；WMI 清单类查询在后台执行，完成后单独发布
+        // CPU / 内存 / 温度的周期随自适应采样策略缩放，声明为高开销的数据源在主机过载时暂停
+        // 调度器在 collectors 之后构造，先于它们析构：工作线程结束后才销毁数据源
+        // 后台初始化中的数据源先不派发，状态表标记为初始化中（读端据此把它们的分区视为不可用）
+        CollectorScheduler scheduler(3, std::chrono::milliseconds(200));
+        CollectorRegistry::Schedule(scheduler, collectors, &initializer);
+        // 设备清单（网卡 / 磁盘 / 显卡）在热插拔时立即重新枚举受影响的数据源，周期采集只作兜底；
+        // 在调度器之后构造，先于它注销通知
+        DeviceChangeMonitor deviceMonitor;
+        deviceMonitor.Start();
+        Logger::Info("程序启动完成");
+        const auto owns = [](int section) { return SharedMemoryManager::OwnsSection(section); };
+
+        // 持续更新的系统信息：各数据源只改写自己负责的字段，未到期的源保留上一次采集的值
+        SystemInfo sysInfo{};
         try {
-            wmiManager = std::make_unique<WmiManager>();
-            if (!wmiManager) {
-                Logger::Fatal("WMI管理器对象创建失败 - 内存分配返回null");
-                SafeExit(1);
-            }
-            if (!wmiManager->IsInitialized()) {
-                Logger::Error("WMI初始化失败");
-                MessageBoxA(NULL, "WMI初始化失败，无法获取系统信息。", "错误", MB_OK | MB_ICONERROR);
-                SafeExit(1);
+            sysInfo.cpuUsage = 0.0;
+            sysInfo.performanceCoreFreq = 0.0;
+            sysInfo.efficiencyCoreFreq = 0.0;
+            sysInfo.totalMemory = 0;
+            sysInfo.usedMemory = 0;
+            sysInfo.availableMemory = 0;
+            sysInfo.gpuMemory = 0;
+            sysInfo.gpuCoreFreq = 0.0;
+            sysInfo.gpuIsVirtual = false;
+            sysInfo.networkAdapterSpeed = 0;
+            // 安全地初始化 SYSTEMTIME 结构
+            ZeroMemory(&sysInfo.lastUpdate, sizeof(sysInfo.lastUpdate));
+            GetSystemTime(&sysInfo.lastUpdate); // 设置当前时间
+            
+            // 验证系统时间是否合理
+            if (sysInfo.lastUpdate.wYear < 2020 || sysInfo.lastUpdate.wYear > 2050) {
+                Logger::Warn("系统时间异常: " + std::to_string(sysInfo.lastUpdate.wYear));
             }
-            Logger::Debug("WMI管理器初始化成功");
-        }
-        catch (const std::bad_alloc& e) {
-            Logger::Fatal("WMI管理器创建失败 - 内存分配失败: " + std::string(e.what()));
-            SafeExit(1);
         }
         catch (const std::exception& e) {
-            Logger::Error("WMI管理器创建失败: " + std::string(e.what()));
-            SafeExit(1);
-        }
-        catch (...) {
-            Logger::Fatal("WMI管理器创建失败 - 未知异常");
-            SafeExit(1);
+            Logger::Error("SystemInfo初始化失败: " + std::string(e.what()));
         }
 
-        // 初始化硬件监控桥接
+        // 静态系统信息（只在启动时获取一次）
         try {
-            TemperatureWrapper::Initialize();
-            Logger::Debug("硬件监控桥接初始化成功");
-        }
-        catch (const std::exception& e) {
-            Logger::Error("硬件监控桥接初始化失败: " + std::string(e.what()));
-            // 不退出程序，继续运行但温度数据可能不可用
-        }
+            Logger::Info("正在初始化系统信息");
 
-        Logger::Info("程序启动完成");
-        
-        // 初始化循环计数器，减少频繁的日志记录
-        int loopCounter = 1; // 从1开始计数，更符合人类习惯
-        bool isFirstRun = true; // 首次运行标志
-        
-        // 缓存静态系统信息（只在首次获取）
-        static std::atomic<bool> systemInfoCached{false};
-        static std::string cachedOsVersion;
-        static std::string cachedCpuName;
-        static uint32_t cachedPhysicalCores = 0;
-        static uint32_t cachedLogicalCores = 0;
-        static uint32_t cachedPerformanceCores = 0;
-        static uint32_t cachedEfficiencyCores = 0;
-        static bool cachedHyperThreading = false;
-        static bool cachedVirtualization = false;
-        
-        // 创建CPU对象一次，重复使用（避免重复初始化性能计数器）- 增强异常处理
-        std::unique_ptr<CpuInfo> cpuInfo;
-        try {
-            cpuInfo = std::make_unique<CpuInfo>();
-            if (!cpuInfo) {
-                Logger::Fatal("CPU信息对象创建失败 - 内存分配返回null");
-                SafeExit(1);
+            // 操作系统信息
+            OSInfo os;
+            sysInfo.osVersion = os.GetVersion();
+
+            // 各数据源的静态字段（CPU 名称、核心数等）；后台初始化的数据源在初始化完成后填充
+            for (const auto& collector : collectors) {
+                if (!initializer.IsDeferred(collector.get())) collector->FillStatic(sysInfo);
             }
-            Logger::Debug("CPU信息对象创建成功");
-        }
-        catch (const std::bad_alloc& e) {
-            Logger::Fatal("CPU信息对象创建失败 - 内存分配失败: " + std::string(e.what()));
-            SafeExit(1);
+            Logger::Info("系统信息初始化完成");
         }
         catch (const std::exception& e) {
-            Logger::Error("CPU信息对象创建失败: " + std::string(e.what()));
-            SafeExit(1);
-        }
-        catch (...) {
-            Logger::Fatal("CPU信息对象创建失败 - 未知异常");
-            SafeExit(1);
+            Logger::Error("系统信息初始化失败: " + std::string(e.what()));
+            // 设置默认值
+            sysInfo.osVersion = "未知";
+            sysInfo.cpuName = "未知";
         }
-        
-        // 线程安全的GPU缓存
-        ThreadSafeGpuCache gpuCache;
-        
-        while (!g_shouldExit.load()) {
+        startupTimer.Mark("静态信息");
+
+        // 发布前验证数据，再写入共享内存
+        const auto publish = [&](bool isDetailedLogging) {
+            // 写入共享内存前验证数据 - 增强数据验证
             try {
-                auto loopStart = std::chrono::high_resolution_clock::now();
-                
-                // 只在每5次循环记录一次详细信息（约5秒）
-                bool isDetailedLogging = (loopCounter % 5 == 1); // 第1, 6, 11, 16, 21... 次循环
-                
-                if (isDetailedLogging) {
-                    Logger::Debug("开始执行主监控循环第 #" + std::to_string(loopCounter) + " 次迭代");
+                // CPU使用率验证
+                if (sysInfo.cpuUsage < 0.0 || sysInfo.cpuUsage > 100.0) {
+                    Logger::Warn("CPU使用率数据异常: " + std::to_string(sysInfo.cpuUsage) + "%, 重置为0");
+                    sysInfo.cpuUsage = 0.0;
                 }
                 
-                // 在第5次循环后，监控已稳定运行
-                if (loopCounter == 5) {
-                    g_monitoringStarted = true;
-                    Logger::Info("程序已稳定运行");
+                // 内存数据验证
+                if (sysInfo.totalMemory > 0) {
+                    if (sysInfo.usedMemory > sysInfo.totalMemory) {
+                        Logger::Warn("已用内存超过总内存，数据异常");
+                        sysInfo.usedMemory = sysInfo.totalMemory;
+                    }
+                    if (sysInfo.availableMemory > sysInfo.totalMemory) {
+                        Logger::Warn("可用内存超过总内存，数据异常");
+                        sysInfo.availableMemory = sysInfo.totalMemory;
+                    }
                 }
                 
-                // 获取系统信息
-                SystemInfo sysInfo;
-                
-                // 安全初始化所有字段以避免未定义行为 - 增强异常处理
-                try {
-                    sysInfo.cpuUsage = 0.0;
+                // 频率数据验证
+                if (std::isnan(sysInfo.performanceCoreFreq) || std::isinf(sysInfo.performanceCoreFreq)) {
                     sysInfo.performanceCoreFreq = 0.0;
+                }
+                if (std::isnan(sysInfo.efficiencyCoreFreq) || std::isinf(sysInfo.efficiencyCoreFreq)) {
                     sysInfo.efficiencyCoreFreq = 0.0;
-                    sysInfo.totalMemory = 0;
-                    sysInfo.usedMemory = 0;
-                    sysInfo.availableMemory = 0;
-                    sysInfo.gpuMemory = 0;
+                }
+                if (std::isnan(sysInfo.gpuCoreFreq) || std::isinf(sysInfo.gpuCoreFreq)) {
                     sysInfo.gpuCoreFreq = 0.0;
-                    sysInfo.gpuIsVirtual = false;
-                    sysInfo.networkAdapterSpeed = 0;
-                    // 安全地初始化 SYSTEMTIME 结构
-                    ZeroMemory(&sysInfo.lastUpdate, sizeof(sysInfo.lastUpdate));
-                    GetSystemTime(&sysInfo.lastUpdate); // 设置当前时间
-                    
-                    // 验证系统时间是否合理
-                    if (sysInfo.lastUpdate.wYear < 2020 || sysInfo.lastUpdate.wYear > 2050) {
-                        Logger::Warn("系统时间异常: " + std::to_string(sysInfo.lastUpdate.wYear));
-                    }
                 }
-                catch (const std::exception& e) {
-                    Logger::Error("SystemInfo初始化失败: " + std::string(e.what()));
-                    continue; // 跳过当前循环
+                
+                // 温度数据验证
+                if (std::isnan(sysInfo.cpuTemperature) || std::isinf(sysInfo.cpuTemperature)) {
+                    sysInfo.cpuTemperature = 0.0;
                 }
-                catch (...) {
-                    Logger::Error("SystemInfo初始化失败 - 未知异常");
-                    continue; // 跳过当前循环
+                if (std::isnan(sysInfo.gpuTemperature) || std::isinf(sysInfo.gpuTemperature)) {
+                    sysInfo.gpuTemperature = 0.0;
                 }
+                
+                // 网络速度验证
+                if (sysInfo.networkAdapterSpeed > 1000000000000ULL) { // 大于1TB/s可能异常
+                    Logger::Warn("网络适配器速度异常: " + std::to_string(sysInfo.networkAdapterSpeed));
+                    sysInfo.networkAdapterSpeed = 0;
+                }
+            }
+            catch (const std::exception& e) {
+                Logger::Error("数据验证过程中发生异常: " + std::string(e.what()));
+            }
+            catch (...) {
+                Logger::Error("数据验证过程中发生未知异常");
+            }
 
-                // 静态系统信息（只在首次获取）
-                if (!systemInfoCached.load()) {
-                    try {
-                        Logger::Info("正在初始化系统信息");
-                        
-                        // 操作系统信息
-                        OSInfo os;
-                        cachedOsVersion = os.GetVersion();
-
-                        // CPU基本信息（使用cpuInfo对象）
-                        if (cpuInfo) {
-                            cachedCpuName = cpuInfo->GetName();
-                            cachedPhysicalCores = cpuInfo->GetLargeCores() + cpuInfo->GetSmallCores();
-                            cachedLogicalCores = cpuInfo->GetTotalCores();
-                            cachedPerformanceCores = cpuInfo->GetLargeCores();
-                            cachedEfficiencyCores = cpuInfo->GetSmallCores();
-                            cachedHyperThreading = cpuInfo->IsHyperThreadingEnabled();
-                            cachedVirtualization = cpuInfo->IsVirtualizationEnabled();
-                        }
-                        
-                        systemInfoCached = true;
-                        Logger::Info("系统信息初始化完成");
+            // 写入共享内存 - 增强异常处理
+            try {
+                if (SharedMemoryManager::GetBuffer()) {
+                    SharedMemoryManager::WriteToSharedMemory(sysInfo);
+                    if (isDetailedLogging) {
+                        Logger::Debug("成功更新共享内存");
                     }
-                    catch (const std::exception& e) {
-                        Logger::Error("系统信息初始化失败: " + std::string(e.what()));
-                        // 设置默认值
-                        cachedOsVersion = "未知";
-                        cachedCpuName = "未知";
-                        systemInfoCached = true; // 防止重复尝试
+                } else {
+                    Logger::Error("共享内存缓冲区不可用");
+                    // 尝试重新初始化
+                    if (SharedMemoryManager::InitSharedMemory(sectionMask)) {
+                        SharedMemoryManager::WriteToSharedMemory(sysInfo);
+                        if (isDetailedLogging) {
+                            Logger::Info("重新初始化并更新共享内存");
+                        }
+                    } else {
+                        Logger::Error("重新初始化共享内存失败: " + SharedMemoryManager::GetLastError());
                     }
                 }
                 
-                // 使用缓存的静态信息
-                sysInfo.osVersion = cachedOsVersion;
-                sysInfo.cpuName = cachedCpuName;
-                sysInfo.physicalCores = cachedPhysicalCores;
-                sysInfo.logicalCores = cachedLogicalCores;
-                sysInfo.performanceCores = cachedPerformanceCores;
-                sysInfo.efficiencyCores = cachedEfficiencyCores;
-                sysInfo.hyperThreading = cachedHyperThreading;
-                sysInfo.virtualization = cachedVirtualization;
-
-                // 动态CPU信息（每次循环都需要获取）
-                try {
-                    if (cpuInfo) {
-                        sysInfo.cpuUsage = cpuInfo->GetUsage();
-                        sysInfo.performanceCoreFreq = cpuInfo->GetLargeCoreSpeed();
-                        sysInfo.efficiencyCoreFreq = cpuInfo->GetSmallCoreSpeed() * 0.8;
-                        sysInfo.cpuUsageSampleIntervalMs = cpuInfo->GetLastSampleIntervalMs();
-                    }
-                }
-                catch (const std::exception& e) {
-                    Logger::Error("获取CPU动态信息失败: " + std::string(e.what()));
-                    // 保持默认值
+                if (isDetailedLogging) {
+                    Logger::Debug("系统信息已更新到共享内存");
                 }
+            }
+            catch (const std::bad_alloc& e) {
+                Logger::Error("处理系统信息时内存不足: " + std::string(e.what()));
+            }
+            catch (const std::exception& e) {
+                Logger::Error("处理系统信息时发生异常: " + std::string(e.what()));
+            }
+            catch (...) {
+                Logger::Error("处理系统信息时发生未知异常");
+            }
+        };
 
-                // 内存信息（每次循环都获取以确保数据实时性）
-                try {
-                    MemoryInfo mem;
-                    sysInfo.totalMemory = mem.GetTotalPhysical();
-                    sysInfo.usedMemory = mem.GetTotalPhysical() - mem.GetAvailablePhysical();
-                    sysInfo.availableMemory = mem.GetAvailablePhysical();
-                }
-                catch (const std::exception& e) {
-                    Logger::Error("获取内存信息失败: " + std::string(e.what()));
-                    // 保持默认值
-                }
+        // 自适应采样：指标快速变化或有读端时加速，无人查看且指标平稳时降频；
+        // 主机 CPU 持续高于 --cpu-ceiling 时暂停昂贵的数据源。只发布部分分区的进程（如提权的辅助进程）
+        // 不采集占用率（SHM_SECTION_LOAD），按其他写端发布的值判断，读取失败时沿用上一次的值
+        AdaptiveSampler::Config samplerConfig;
+        samplerConfig.cpuCeiling = cpuCeiling;
+        AdaptiveSampler sampler(samplerConfig);
+        double hostCpu = 0.0;
+        const auto adapt = [&] {
+            if (owns(SHM_SECTION_LOAD)) hostCpu = sysInfo.cpuUsage;
+            else SharedMemoryManager::ReadPublishedCpuUsage(hostCpu);
+            const AdaptiveSampler::Decision decision =
+                sampler.Update(sysInfo, hostCpu, SharedMemoryManager::IsReaderAttached(std::chrono::seconds(3)), CollectorScheduler::Clock::now());
+            scheduler.SetRateScale(decision.rateScale);
+            scheduler.SetShedding(decision.shed);
+        };
 
-                // GPU信息 - 使用线程安全的缓存机制
-                if (!gpuCache.IsInitialized()) {
+        // 发布时附带各数据源的状态（运行中 / 过期 / 失败 / 暂停），读端据此判断哪些分区是旧值，
+        // 以及监视器自身的开销（CPU / 内存 / 分配 / 句柄 / 每轮耗时）
+        SharedCollectorStatus collectorStatus[SHM_MAX_COLLECTORS];
+        OverheadMonitor overhead;
+        using Clock = CollectorScheduler::Clock;
+        Clock::time_point lastPublish = Clock::now();
+        const auto publishWithStatus = [&](bool isDetailedLogging) {
+            adapt();
+            const int count = scheduler.ExportStatus(collectorStatus, SHM_MAX_COLLECTORS);
+            SharedMemoryManager::SetCollectorStatus(collectorStatus, count);
+            SharedMemoryManager::SetSelfOverhead(overhead.Snapshot());
+            publish(isDetailedLogging);
+            lastPublish = Clock::now();
+        };
+
+        // 启动时间线：第一次发布（只含初始化较快的数据源）与全部分区就绪（后台初始化完成且各数据源首次采集完成）
+        bool firstPublished = false;
+        bool allReady = false;
+        const auto traceStartup = [&] {
+            if (!firstPublished) {
+                firstPublished = true;
+                startupTimer.Mark("首次发布");
+                Logger::Info("启动时间线: 首次发布 +" + std::to_string(static_cast<int>(startupTimer.ElapsedMs())) + "ms（进程创建起），" +
+                             std::to_string(initializer.Pending()) + " 个数据源仍在后台初始化");
+            }
+            if (!allReady && initializer.Pending() == 0 && scheduler.PendingFirstRuns() == 0) {
+                allReady = true;
+                startupTimer.Mark("全部分区就绪");
+                Logger::Info(startupTimer.Describe());
+            }
+        };
+        // 后台初始化完成的数据源：在主线程上填充静态字段后开始调度，失败的在状态表中标记为失败
+        const auto takeInitialized = [&]() -> bool {
+            if (initializer.Pending() == 0) return false;
+            const std::vector<CollectorInitializer::Result> finished = initializer.TakeFinished();
+            for (const CollectorInitializer::Result& result : finished) {
+                const std::string name = result.collector->Name();
+                startupTimer.Record("后台初始化 " + name, result.begin, result.end);
+                if (result.available) {
                     try {
-                        gpuCache.Initialize(*wmiManager);
+                        result.collector->FillStatic(sysInfo);
                     }
                     catch (const std::exception& e) {
-                        Logger::Error("GPU缓存初始化失败: " + std::string(e.what()));
+                        Logger::Error("数据源 " + name + " 静态信息初始化失败: " + std::string(e.what()));
                     }
+                    Logger::Info("数据源 " + name + " 后台初始化完成，耗时 " +
+                                 std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(result.end - result.begin).count()) + "ms");
                 }
-                
-                // 获取缓存的GPU信息
-                try {
-                    std::string cachedGpuName, cachedGpuBrand;
-                    uint64_t cachedGpuMemory;
-                    uint32_t cachedGpuCoreFreq;
-                    bool cachedGpuIsVirtual;
-                    
-                    gpuCache.GetCachedInfo(cachedGpuName, cachedGpuBrand, cachedGpuMemory, 
-                                          cachedGpuCoreFreq, cachedGpuIsVirtual);
-                    
-                    sysInfo.gpuName = cachedGpuName;
-                    sysInfo.gpuBrand = cachedGpuBrand;
-                    sysInfo.gpuMemory = cachedGpuMemory;
-                    sysInfo.gpuCoreFreq = cachedGpuCoreFreq;
-                    sysInfo.gpuIsVirtual = cachedGpuIsVirtual;
-
-                    // 修复GPU数组填充 - 添加数据验证和清理
-                    sysInfo.gpus.clear();
-                    if (!cachedGpuName.empty() && cachedGpuName != "未检测到GPU") {
-                        GPUData gpu;
-                        
-                        // 初始化GPU结构体以避免垃圾数据
-                        memset(&gpu, 0, sizeof(GPUData));
-                        
-                        // 安全地复制GPU名称和品牌到wchar_t数组
-                        std::wstring gpuNameW = WinUtils::StringToWstring(cachedGpuName);
-                        std::wstring gpuBrandW = WinUtils::StringToWstring(cachedGpuBrand);
-                        
-                        // 限制字符串长度以防止缓冲区溢出
-                        if (gpuNameW.length() >= sizeof(gpu.name)/sizeof(wchar_t)) {
-                            gpuNameW = gpuNameW.substr(0, sizeof(gpu.name)/sizeof(wchar_t) - 1);
-                        }
-                        if (gpuBrandW.length() >= sizeof(gpu.brand)/sizeof(wchar_t)) {
-                            gpuBrandW = gpuBrandW.substr(0, sizeof(gpu.brand)/sizeof(wchar_t) - 1);
-                        }
-                        
-                        wcsncpy_s(gpu.name, sizeof(gpu.name)/sizeof(wchar_t), gpuNameW.c_str(), _TRUNCATE);
-                        wcsncpy_s(gpu.brand, sizeof(gpu.brand)/sizeof(wchar_t), gpuBrandW.c_str(), _TRUNCATE);
-                        
-                        // 验证和清理GPU数据 - 避免异常值
-                        gpu.memory = (cachedGpuMemory > 0 && cachedGpuMemory < UINT64_MAX) ? cachedGpuMemory : 0;
-                        
-                        // 修复GPU核心频率 - 确保在合理范围内
-                        if (cachedGpuCoreFreq > 0 && cachedGpuCoreFreq < 10000) {
-                            gpu.coreClock = cachedGpuCoreFreq;
-                        } else {
-                            gpu.coreClock = 0; // 设置为0而不是异常值
-                            if (isFirstRun && cachedGpuCoreFreq > 10000) {
-                                Logger::Warn("GPU核心频率异常: " + std::to_string(cachedGpuCoreFreq) + "MHz，已重置为0");
-                            }
-                        }
-                        
-                        gpu.isVirtual = cachedGpuIsVirtual;
-                        
-                        sysInfo.gpus.push_back(gpu);
-                        
-                        if (isFirstRun) {
-                            Logger::Debug("已添加GPU到数组: " + cachedGpuName + 
-                                         " (内存: " + FormatSize(cachedGpuMemory) + 
-                                         ", 频率: " + std::to_string(gpu.coreClock) + "MHz" +
-                                         ", 虚拟: " + (cachedGpuIsVirtual ? "是" : "否") + ")");
-                        }
-                    } else {
-                        if (isFirstRun) {
-                            Logger::Debug("未检测到有效GPU，跳过GPU数据填充");
-                        }
-                    }
-                }
-                catch (const std::bad_alloc& e) {
-                    Logger::Error("GPU缓存信息处理失败 - 内存不足: " + std::string(e.what()));
-                    // 清空GPU数据以避免显示错误信息
-                    sysInfo.gpus.clear();
-                    sysInfo.gpuName = "内存不足";
-                    sysInfo.gpuBrand = "未知";
-                    sysInfo.gpuMemory = 0;
-                    sysInfo.gpuCoreFreq = 0;
-                    sysInfo.gpuIsVirtual = false;
-                }
-                catch (const std::exception& e) {
-                    Logger::Error("获取GPU缓存信息失败: " + std::string(e.what()));
-                    // 清空GPU数据以避免显示错误信息
-                    sysInfo.gpus.clear();
-                    sysInfo.gpuName = "GPU信息获取失败";
-                    sysInfo.gpuBrand = "未知";
-                    sysInfo.gpuMemory = 0;
-                    sysInfo.gpuCoreFreq = 0;
-                    sysInfo.gpuIsVirtual = false;
-                }
-                catch (...) {
-                    Logger::Error("获取GPU缓存信息失败 - 未知异常");
-                    sysInfo.gpus.clear();
-                    sysInfo.gpuName = "未知异常";
-                    sysInfo.gpuBrand = "未知";
-                    sysInfo.gpuMemory = 0;
-                    sysInfo.gpuCoreFreq = 0;
-                    sysInfo.gpuIsVirtual = false;
+                else {
+                    Logger::Warn("数据源 " + name + " 初始化失败，已停用");
                 }
+                scheduler.SetReady(name, result.available);
+            }
+            return !finished.empty();
+        };
 
-                // 初始化网络适配器信息（避免无效数据导致崩溃）
-                sysInfo.networkAdapterName = "未检测到网络适配器";
-                sysInfo.networkAdapterMac = "00-00-00-00-00-00";
-                sysInfo.networkAdapterSpeed = 0;
-                sysInfo.networkAdapterIp = "N/A"; // 添加默认IP地址
-                sysInfo.networkAdapterType = "未知"; // 添加默认网卡类型
+        // 主循环：睡到最早到期的数据源，并发执行所有到期的源，等待 wait 源（最多到截止时间）后发布；
+        // 后台源完成时单独合并、发布，慢速的 WMI 查询不会推迟 CPU / 内存的更新。
+        // 没有源到期时至少每秒发布一次，维持写端租约的心跳
+        const auto heartbeatPeriod = std::chrono::milliseconds(1000);
+        const auto detailedLogPeriod = std::chrono::seconds(5);
+        const Clock::time_point monitorStart = Clock::now();
+        Clock::time_point lastDetailedLog{};
+        int loopCounter = 1; // 从1开始计数，更符合人类习惯
+        uint64_t steadyCycles = 0; // 通过稳态分配检查的轮数
+        while (!g_shouldExit.load()) {
+            try {
+                const Clock::time_point loopStart = Clock::now();
 
-                // 填充所有网络适配器信息
-                try {
-                    sysInfo.adapters.clear();
-                    NetworkAdapter netAdapter(*wmiManager);
-                    const auto& adapters = netAdapter.GetAdapters();
-                    if (!adapters.empty()) {
-                        for (const auto& adapter : adapters) {
-                            NetworkAdapterData data;
-                            // 名称、MAC、IP和类型为wstring，需转为wchar_t数组
-                            wcsncpy_s(data.name, adapter.name.c_str(), _TRUNCATE);
-                            wcsncpy_s(data.mac, adapter.mac.c_str(), _TRUNCATE);
-                            wcsncpy_s(data.ipAddress, adapter.ip.c_str(), _TRUNCATE); // 添加IP地址
-                            wcsncpy_s(data.adapterType, adapter.adapterType.c_str(), _TRUNCATE); // 添加网卡类型
-                            data.speed = adapter.speed;
-                            sysInfo.adapters.push_back(data);
-                        }
-                        // 兼容旧字段，取第一个适配器
-                        sysInfo.networkAdapterName = WinUtils::WstringToString(adapters[0].name);
-                        sysInfo.networkAdapterMac = WinUtils::WstringToString(adapters[0].mac);
-                        sysInfo.networkAdapterIp = WinUtils::WstringToString(adapters[0].ip); // 添加IP地址
-                        sysInfo.networkAdapterType = WinUtils::WstringToString(adapters[0].adapterType); // 添加网卡类型
-                        sysInfo.networkAdapterSpeed = adapters[0].speed;
-                    } else {
-                        sysInfo.networkAdapterName = "未检测到网络适配器";
-                        sysInfo.networkAdapterMac = "00-00-00-00-00-00";
-                        sysInfo.networkAdapterIp = "N/A"; // 添加默认IP地址
-                        sysInfo.networkAdapterType = "未知"; // 添加默认网卡类型
-                        sysInfo.networkAdapterSpeed = 0;
-                    }
-                } catch (const std::bad_alloc& e) {
-                    Logger::Error("获取网络适配器信息失败 - 内存不足: " + std::string(e.what()));
-                    sysInfo.adapters.clear();
-                    sysInfo.networkAdapterName = "内存不足";
-                    sysInfo.networkAdapterMac = "00-00-00-00-00-00";
-                    sysInfo.networkAdapterIp = "N/A"; 
-                    sysInfo.networkAdapterType = "未知";
-                    sysInfo.networkAdapterSpeed = 0;
-                } catch (const std::exception& e) {
-                    Logger::Error("获取网络适配器信息失败: " + std::string(e.what()));
-                    sysInfo.adapters.clear();
-                    sysInfo.networkAdapterName = "未检测到网络适配器";
-                    sysInfo.networkAdapterMac = "00-00-00-00-00-00";
-                    sysInfo.networkAdapterIp = "N/A"; // 添加默认IP地址
-                    sysInfo.networkAdapterType = "未知"; // 添加默认网卡类型
-                    sysInfo.networkAdapterSpeed = 0;
-                } catch (...) {
-                    Logger::Error("获取网络适配器信息失败 - 未知异常");
-                    sysInfo.adapters.clear();
-                    sysInfo.networkAdapterName = "未知异常";
-                    sysInfo.networkAdapterMac = "00-00-00-00-00-00";
-                    sysInfo.networkAdapterIp = "N/A";
-                    sysInfo.networkAdapterType = "未知";
-                    sysInfo.networkAdapterSpeed = 0;
+                // 每约5秒记录一次详细信息
+                const bool isDetailedLogging = loopStart - lastDetailedLog >= detailedLogPeriod;
+                if (isDetailedLogging) {
+                    lastDetailedLog = loopStart;
+                    Logger::Debug("开始执行主监控循环第 #" + std::to_string(loopCounter) + " 次迭代");
                 }
 
-                // 添加温度数据采集（每次循环都获取以确保数据实时性）
-                try {
-                    auto temperatures = TemperatureWrapper::GetTemperatures();
-                    sysInfo.temperatures.clear();
-                    sysInfo.cpuTemperature = 0;
-                    sysInfo.gpuTemperature = 0;
-                    for (const auto& temp : temperatures) {
-                        std::string nameLower = temp.first;
-                        std::transform(nameLower.begin(), nameLower.end(), nameLower.begin(), ::tolower);
-                        if (nameLower.find("gpu") != std::string::npos || nameLower.find("graphics") != std::string::npos) {
-                            sysInfo.gpuTemperature = temp.second;
-                            sysInfo.temperatures.push_back({"GPU", temp.second});
-                        } else if (nameLower.find("cpu") != std::string::npos || nameLower.find("package") != std::string::npos) {
-                            sysInfo.cpuTemperature = temp.second;
-                            sysInfo.temperatures.push_back({"CPU", temp.second});
-                        } else {
-                            sysInfo.temperatures.push_back(temp);
-                        }
-                    }
-                    if (isFirstRun) {
-                        Logger::Debug("收集到 " + std::to_string(temperatures.size()) + " 个温度读数");
-                        // 添加详细的温度传感器信息输出
-                        for (const auto& temp : sysInfo.temperatures) {
-                            Logger::Debug("温度传感器: " + temp.first + " = " + std::to_string(temp.second) + "°C");
-                        }
-                        Logger::Debug("CPU温度: " + std::to_string(sysInfo.cpuTemperature) + ", GPU温度: " + std::to_string(sysInfo.gpuTemperature));
-                    }
-                }
-                catch (const std::bad_alloc& e) {
-                    Logger::Error("获取温度数据失败 - 内存不足: " + std::string(e.what()));
-                    // 清空温度数据以避免显示过时数据
-                    sysInfo.temperatures.clear();
-                    sysInfo.cpuTemperature = 0;
-                    sysInfo.gpuTemperature = 0;
-                }
-                catch (const std::exception& e) {
-                    Logger::Error("获取温度数据失败: " + std::string(e.what()));
-                    // 清空温度数据以避免显示过时数据
-                    sysInfo.temperatures.clear();
-                    sysInfo.cpuTemperature = 0;
-                    sysInfo.gpuTemperature = 0;
-                }
-                catch (...) {
-                    Logger::Error("获取温度数据失败 - 未知异常");
-                    sysInfo.temperatures.clear();
-                    sysInfo.cpuTemperature = 0;
-                    sysInfo.gpuTemperature = 0;
+                // 启动约5秒后，监控已稳定运行
+                if (!g_monitoringStarted && loopStart - monitorStart >= std::chrono::seconds(5)) {
+                    g_monitoringStarted = true;
+                    Logger::Info("程序已稳定运行");
                 }
 
-                // 添加磁盘信息采集（每次循环都获取以确保数据实时性）
-                try {
-                    DiskInfo diskInfo;
-                    auto disks = diskInfo.GetDisks();
-                    if (disks.size() > 8) {
-                        Logger::Error("磁盘数量超过最大允许值（8）。跳过磁盘数据更新。");
-                        sysInfo.disks.clear();
-                    } else {
-                        sysInfo.disks = disks;
-                        if (isFirstRun) {
-                            Logger::Debug("收集到 " + std::to_string(disks.size()) + " 个磁盘条目");
-                            for (size_t i = 0; i < disks.size(); ++i) {
-                                const auto& disk = disks[i];
-                                Logger::Debug("磁盘 " + std::to_string(i) + ": 标签=" + disk.label + ", 文件系统=" + disk.fileSystem);
-                            }
-                        }
-                    }
-                    // 采集物理磁盘并建立逻辑盘映射
-                    if (wmiManager) {
-                        DiskInfo::CollectPhysicalDisks(*wmiManager, sysInfo.disks, sysInfo);
-                    }
-                }
-                catch (const std::bad_alloc& e) {
-                    Logger::Error("获取磁盘/物理磁盘数据失败 - 内存不足: " + std::string(e.what()));
-                    sysInfo.disks.clear();
-                    sysInfo.physicalDisks.clear();
-                }
-                catch (const std::exception& e) {
-                    Logger::Error("获取磁盘/物理磁盘数据失败: " + std::string(e.what()));
-                    sysInfo.disks.clear();
-                    sysInfo.physicalDisks.clear();
+                const uint64_t logsBefore = Logger::CallCount();
+                const uint64_t allocationsBefore = AllocationCounter::ThreadCount();
+                overhead.BeginCycle();
+                const bool initialized = takeInitialized();
+                const int merged = scheduler.RunCycle(sysInfo);
+                if (merged > 0 || initialized || Clock::now() - lastPublish >= heartbeatPeriod) {
+                    publishWithStatus(isDetailedLogging);
                 }
-                catch (...) {
-                    Logger::Error("获取磁盘/物理磁盘数据失败 - 未知异常");
-                    sysInfo.disks.clear();
-                    sysInfo.physicalDisks.clear();
-                }
-
-                // 写入共享内存前验证数据 - 增强数据验证
-                try {
-                    // CPU使用率验证
-                    if (sysInfo.cpuUsage < 0.0 || sysInfo.cpuUsage > 100.0) {
-                        Logger::Warn("CPU使用率数据异常: " + std::to_string(sysInfo.cpuUsage) + "%, 重置为0");
-                        sysInfo.cpuUsage = 0.0;
-                    }
-                    
-                    // 内存数据验证
-                    if (sysInfo.totalMemory > 0) {
-                        if (sysInfo.usedMemory > sysInfo.totalMemory) {
-                            Logger::Warn("已用内存超过总内存，数据异常");
-                            sysInfo.usedMemory = sysInfo.totalMemory;
-                        }
-                        if (sysInfo.availableMemory > sysInfo.totalMemory) {
-                            Logger::Warn("可用内存超过总内存，数据异常");
-                            sysInfo.availableMemory = sysInfo.totalMemory;
-                        }
+                if (!allReady) traceStartup();
+                overhead.EndCycle();
+                if (checkAllocations && g_monitoringStarted) {
+                    const CollectorScheduler::CycleStats cycle = scheduler.LastCycle();
+                    // 派发 / 合并后台源时在主线程上的分配（如物理磁盘复制逻辑磁盘列表）不计入
+                    const uint64_t allocations = AllocationCounter::ThreadCount() - allocationsBefore - cycle.backgroundAllocations +
+                                                 cycle.allocations;
+                    // 记录日志（无论是否被等级过滤）与合并清单类数据本身会分配，不属于稳态
+                    const bool steady = !isDetailedLogging && !cycle.mergedBackground && Logger::CallCount() == logsBefore;
+                    if (steady && allocations > 0) {
+                        Logger::Error("稳态分配检查失败: 第 #" + std::to_string(loopCounter) + " 轮分配 " + std::to_string(allocations) +
+                                      " 次（其中等待的数据源 " + std::to_string(cycle.allocations) + " 次）; 数据源: " + scheduler.Describe());
+                        scheduler.Stop();
+                        SafeExit(3);
                     }
-                    
-                    // 频率数据验证
-                    if (std::isnan(sysInfo.performanceCoreFreq) || std::isinf(sysInfo.performanceCoreFreq)) {
-                        sysInfo.performanceCoreFreq = 0.0;
-                    }
-                    if (std::isnan(sysInfo.efficiencyCoreFreq) || std::isinf(sysInfo.efficiencyCoreFreq)) {
-                        sysInfo.efficiencyCoreFreq = 0.0;
-                    }
-                    if (std::isnan(sysInfo.gpuCoreFreq) || std::isinf(sysInfo.gpuCoreFreq)) {
-                        sysInfo.gpuCoreFreq = 0.0;
-                    }
-                    
-                    // 温度数据验证
-                    if (std::isnan(sysInfo.cpuTemperature) || std::isinf(sysInfo.cpuTemperature)) {
-                        sysInfo.cpuTemperature = 0.0;
-                    }
-                    if (std::isnan(sysInfo.gpuTemperature) || std::isinf(sysInfo.gpuTemperature)) {
-                        sysInfo.gpuTemperature = 0.0;
-                    }
-                    
-                    // 网络速度验证
-                    if (sysInfo.networkAdapterSpeed > 1000000000000ULL) { // 大于1TB/s可能异常
-                        Logger::Warn("网络适配器速度异常: " + std::to_string(sysInfo.networkAdapterSpeed));
-                        sysInfo.networkAdapterSpeed = 0;
-                    }
-                }
-                catch (const std::exception& e) {
-                    Logger::Error("数据验证过程中发生异常: " + std::string(e.what()));
+                    if (steady) ++steadyCycles;
                 }
-                catch (...) {
-                    Logger::Error("数据验证过程中发生未知异常");
+                if (isDetailedLogging) {
+                    Logger::Debug("数据源: " + scheduler.Describe());
+                    Logger::Debug("自身开销: " + overhead.Describe());
+                    if (checkAllocations) Logger::Debug("稳态分配检查: 已通过 " + std::to_string(steadyCycles) + " 轮");
                 }
 
-                // 写入共享内存 - 增强异常处理
-                try {
-                    if (SharedMemoryManager::GetBuffer()) {
-                        SharedMemoryManager::WriteToSharedMemory(sysInfo);
-                        if (isDetailedLogging) {
-                            Logger::Debug("成功更新共享内存");
-                        }
-                    } else {
-                        Logger::Error("共享内存缓冲区不可用");
-                        // 尝试重新初始化
-                        if (SharedMemoryManager::InitSharedMemory()) {
-                            SharedMemoryManager::WriteToSharedMemory(sysInfo);
-                            if (isDetailedLogging) {
-                                Logger::Info("重新初始化并更新共享内存");
-                            }
-                        } else {
-                            Logger::Error("重新初始化共享内存失败: " + SharedMemoryManager::GetLastError());
-                        }
+                // 休眠到下一个数据源到期（或下一次心跳），期间有后台源完成时立即合并发布，
+                // 每 50ms 检查一次退出标志
+                Clock::time_point wakeAt = (std::min)(scheduler.NextDue(), lastPublish + heartbeatPeriod);
+                while (!g_shouldExit.load()) {
+                    const Clock::time_point now = Clock::now();
+                    if (now >= wakeAt) break;
+                    // 数据源完成后台初始化：立即到期，回到 RunCycle 派发
+                    if (initializer.HasFinished()) break;
+                    // 设备变化（一串事件平息之后）：受影响的数据源立即到期，回到 RunCycle 派发
+                    const uint32_t changed = deviceMonitor.TakeChanges(now);
+                    if (changed != 0) {
+                        const int triggered = scheduler.Trigger(changed);
+                        Logger::Info("检测到设备变化（" + DeviceChangeMonitor::ClassNames(changed) + "），重新枚举 " +
+                                     std::to_string(triggered) + " 个数据源");
+                        if (triggered > 0) break;
                     }
-                    
-                    if (isDetailedLogging) {
-                        Logger::Debug("系统信息已更新到共享内存");
+                    if (scheduler.WaitForCompletion((std::min)(wakeAt, now + std::chrono::milliseconds(50))) &&
+                        scheduler.MergeCompleted(sysInfo) > 0) {
+                        publishWithStatus(isDetailedLogging);
+                        wakeAt = (std::min)(scheduler.NextDue(), lastPublish + heartbeatPeriod);
                     }
                 }
-                catch (const std::bad_alloc& e) {
-                    Logger::Error("处理系统信息时内存不足: " + std::string(e.what()));
-                }
-                catch (const std::exception& e) {
-                    Logger::Error("处理系统信息时发生异常: " + std::string(e.what()));
-                }
-                catch (...) {
-                    Logger::Error("处理系统信息时发生未知异常");
-                }
 
-                // 计算循环执行时间并自适应休眠 - 优化刷新速度，增强异常处理
-                try {
-                    auto loopEnd = std::chrono::high_resolution_clock::now();
-                    auto loopDuration = std::chrono::duration_cast<std::chrono::milliseconds>(loopEnd - loopStart);
-                    
-                    // 1秒循环时间
-                    int targetCycleTime = 1000;
-                    int sleepTime = (std::max)(targetCycleTime - static_cast<int>(loopDuration.count()), 100); // 最少休眠100ms
-                    
-                    if (isDetailedLogging) {
-                        // 将毫秒转换为秒，保留2位小数
-                        double loopTimeSeconds = loopDuration.count() / 1000.0;
-                        double sleepTimeSeconds = sleepTime / 1000.0;
-                        
-                        // 验证计算结果的合理性
-                        if (loopTimeSeconds < 0 || loopTimeSeconds > 60) {
-                            Logger::Warn("循环时间计算异常: " + std::to_string(loopTimeSeconds) + "秒");
-                        }
-                        
-                        std::stringstream ss;
-                        ss << std::fixed << std::setprecision(2);
-                        ss << "主监控循环第 #" << loopCounter << " 次执行耗时 " 
-                           << loopTimeSeconds << "秒，将休眠 " << sleepTimeSeconds << "秒";
-                        
-                        Logger::Debug(ss.str());
-                    }
-                    
-                    // 休眠时检查退出标志 - 使用更短的检查间隔提升响应性
-                    auto sleepStart = std::chrono::high_resolution_clock::now();
-                    while (!g_shouldExit.load()) {
-                        try {
-                            auto now = std::chrono::high_resolution_clock::now();
-                            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - sleepStart);
-                            if (elapsed.count() >= sleepTime) {
-                                break;
-                            }
-                            std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 50ms检查间隔
-                        }
-                        catch (const std::exception& e) {
-                            Logger::Warn("休眠过程中发生异常: " + std::string(e.what()));
-                            break; // 退出休眠循环
-                        }
-                        catch (...) {
-                            Logger::Warn("休眠过程中发生未知异常");
-                            break;
-                        }
-                    }
-                }
-                catch (const std::exception& e) {
-                    Logger::Error("计算循环时间时发生异常: " + std::string(e.what()));
-                    // 使用默认休眠时间
-                    try {
-                        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-                    } catch (...) {
-                        // 如果连休眠都失败，记录错误但继续执行
-                        Logger::Fatal("系统休眠功能异常");
-                    }
-                }
-                catch (...) {
-                    Logger::Error("计算循环时间时发生未知异常");
-                    try {
-                        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-                    } catch (...) {
-                        Logger::Fatal("系统休眠功能异常");
-                    }
-                }
-                
                 // 安全增加循环计数器
-                try {
-                    loopCounter++;
-                    
-                    // 防止循环计数器溢出（虽然几乎不可能发生）
-                    if (loopCounter < 0 || loopCounter > 2000000000) {
-                        Logger::Warn("循环计数器异常，重置为1");
-                        loopCounter = 1;
-                    }
-                }
-                catch (...) {
-                    Logger::Error("循环计数器更新失败");
-                    loopCounter = 1; // 重置为安全值
-                }
-                
-                // 首次运行后设置标志
-                if (isFirstRun) {
-                    isFirstRun = false;
+                loopCounter++;
+                // 防止循环计数器溢出（虽然几乎不可能发生）
+                if (loopCounter < 0 || loopCounter > 2000000000) {
+                    Logger::Warn("循环计数器异常，重置为1");
+                    loopCounter = 1;
                 }
             }
             catch (const std::bad_alloc& e) {
@@ -1352,6 +1395,9 @@ int main(int argc, char* argv[]) {
         }
         
         Logger::Info("程序收到退出信号，开始清理");
+        // 等待工作线程上的采集与仍在进行的后台初始化结束，再清理它们使用的硬件监控桥接
+        scheduler.Stop();
+        initializer.Join();
         SafeExit(0);
     }
     catch (const std::exception& e) {